@@ -0,0 +1,48 @@
+/**
+ * Tests that the session cursor cache reports its hits, misses and evictions in the
+ * wiredTiger.session section of serverStatus, and breaks them down by URI at verbosity 2.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+    "use strict";
+
+    const conn = MongoRunner.runMongod({
+        setParameter: {wiredTigerCursorCacheSize: 4, wiredTigerCursorCacheMaxSize: 64}
+    });
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    const testDB = conn.getDB("test");
+    if (testDB.serverStatus().storageEngine.name !== "wiredTiger") {
+        jsTestLog("Skipping test because storageEngine is not wiredTiger");
+        MongoRunner.stopMongod(conn);
+        return;
+    }
+
+    const numColls = 16;
+    for (let i = 0; i < numColls; i++) {
+        assert.commandWorked(testDB.createCollection("coll" + i));
+    }
+
+    const collURI = testDB.coll0.stats().wiredTiger.uri.replace("statistics:", "");
+
+    // Sessions add their counts to serverStatus in batches, so keep cycling over more collections
+    // than the minimum cache size until they show up.
+    let round = 0;
+    assert.soon(function() {
+        for (let i = 0; i < numColls; i++) {
+            assert.writeOK(testDB["coll" + i].insert({round: round}));
+        }
+        round++;
+
+        const cursorCache = testDB.serverStatus({wiredTiger: 2}).wiredTiger.session["cursor cache"];
+        assert(cursorCache.hasOwnProperty("uris"), tojson(cursorCache));
+        return cursorCache.hits > 0 && cursorCache.misses > 0 && cursorCache.evictions > 0 &&
+            cursorCache.uris.hasOwnProperty(collURI) && cursorCache.uris[collURI].misses > 0;
+    }, "cursor cache statistics were never reported");
+
+    // The breakdown by URI is only included when asked for.
+    const cursorCache = testDB.serverStatus().wiredTiger.session["cursor cache"];
+    assert(!cursorCache.hasOwnProperty("uris"), tojson(cursorCache));
+
+    MongoRunner.stopMongod(conn);
+})();
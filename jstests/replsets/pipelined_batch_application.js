@@ -0,0 +1,74 @@
+/**
+ * Tests that a secondary running with replPipelinedBatchApplication applies every batch, including
+ * batches that were written to its oplog while the previous batch was still being applied, and that
+ * batches containing commands are still applied on their own.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+    "use strict";
+
+    const name = "pipelined_batch_application";
+    const rst = new ReplSetTest({
+        name: name,
+        nodes: [
+            {},
+            {
+              rsConfig: {priority: 0},
+              setParameter:
+                  {replPipelinedBatchApplication: true, replWriterDynamicScheduling: true}
+            }
+        ]
+    });
+    rst.startSet();
+    rst.initiate();
+
+    const primary = rst.getPrimary();
+    const secondary = rst.getSecondary();
+    const coll = primary.getDB(name)["coll"];
+
+    assert.writeOK(coll.insert({_id: "hot", counter: 0}));
+    rst.awaitReplication();
+
+    function getPipelinedBatches() {
+        return assert.commandWorked(secondary.adminCommand({serverStatus: 1}))
+            .metrics.repl.apply.pipelinedBatches;
+    }
+    const pipelinedBatchesBefore = getPipelinedBatches();
+
+    // Keep batches small and let a backlog build up on the secondary, so that several batches are
+    // ready to be applied back to back once application resumes.
+    assert.commandWorked(secondary.adminCommand({setParameter: 1, replBatchLimitOperations: 100}));
+    assert.commandWorked(
+        secondary.adminCommand({configureFailPoint: "rsSyncApplyStop", mode: "alwaysOn"}));
+
+    for (let round = 0; round < 10; round++) {
+        let bulk = coll.initializeOrderedBulkOp();
+        for (let i = 0; i < 200; i++) {
+            bulk.insert({_id: round * 200 + i, round: round});
+            bulk.find({_id: "hot"}).updateOne({$inc: {counter: 1}});
+        }
+        assert.writeOK(bulk.execute());
+
+        // Commands are always applied in a batch of their own.
+        assert.commandWorked(coll.createIndex({["round" + round]: 1}));
+    }
+
+    assert.commandWorked(
+        secondary.adminCommand({configureFailPoint: "rsSyncApplyStop", mode: "off"}));
+    rst.awaitReplication();
+
+    const secondaryColl = secondary.getDB(name)["coll"];
+    assert.eq(2001, secondaryColl.find().itcount());
+    assert.eq(2000, secondaryColl.findOne({_id: "hot"}).counter);
+    assert.eq(11, secondaryColl.getIndexes().length);
+
+    const storageEngine = jsTest.options().storageEngine || "wiredTiger";
+    if (storageEngine !== "mmapv1") {
+        assert.gt(getPipelinedBatches(),
+                  pipelinedBatchesBefore,
+                  "expected some batches to be written to the oplog ahead of time");
+    }
+
+    rst.stopSet();
+})();
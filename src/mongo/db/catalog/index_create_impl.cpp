@@ -125,6 +125,28 @@ public:
 
 } exportedMaxIndexBuildMemoryUsageParameter;
 
+AtomicInt32 maxIndexBuildSortThreads(1);
+
+class ExportedMaxIndexBuildSortThreadsParameter
+    : public ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime> {
+public:
+    ExportedMaxIndexBuildSortThreadsParameter()
+        : ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>(
+              ServerParameterSet::getGlobal(),
+              "maxIndexBuildSortThreads",
+              &maxIndexBuildSortThreads) {}
+
+    virtual Status validate(const std::int32_t& potentialNewValue) {
+        if (potentialNewValue < 1 || potentialNewValue > 128) {
+            return Status(ErrorCodes::BadValue,
+                          "maxIndexBuildSortThreads must be between 1 and 128");
+        }
+
+        return Status::OK();
+    }
+
+} exportedMaxIndexBuildSortThreadsParameter;
+
 
 /**
  * On rollback sets MultiIndexBlockImpl::_needToCleanup to true.
@@ -288,7 +310,8 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlockImpl::init(const std::vector<BSO
         if (!_buildInBackground) {
             // Bulk build process requires foreground building as it assumes nothing is changing
             // under it.
-            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes);
+            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes,
+                                                  maxIndexBuildSortThreads.load());
         }
 
         const IndexDescriptor* descriptor = index.block->getEntry()->descriptor();
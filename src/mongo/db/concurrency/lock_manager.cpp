@@ -41,6 +41,7 @@
 #include "mongo/config.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/stringutils.h"
@@ -379,7 +380,7 @@ void LockHead::migratePartitionedLockHeads() {
     // Migration time: lock each partition in turn and transfer its requests, if any
     while (partitioned()) {
         LockManager::Partition* partition = partitions.back();
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<SpinLock> scopedLock(partition->mutex);
 
         LockManager::Partition::Map::iterator it = partition->data.find(resourceId);
         if (it != partition->data.end()) {
@@ -410,15 +411,31 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
 
-LockManager::LockManager() {
-    _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
+// Balance scalability of intent locks against potential added cost of conflicting locks, which
+// must visit every partition holding intent requests for the resource. Scale with the number of
+// hardware threads so that concurrently running lockers rarely share a partition, but keep a power
+// of two so the partition can be picked with a mask.
+unsigned computeNumPartitions() {
+    const unsigned kMinPartitions = 32;
+    const unsigned kMaxPartitions = 1024;
+    const unsigned target = 2 * stdx::thread::hardware_concurrency();
+
+    unsigned numPartitions = kMinPartitions;
+    while (numPartitions < target && numPartitions < kMaxPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
 }
 
+}  // namespace
+
+LockManager::LockManager()
+    : _lockBuckets(_numLockBuckets),
+      _numPartitions(computeNumPartitions()),
+      _partitions(_numPartitions) {}
+
 LockManager::~LockManager() {
     cleanupUnusedLocks();
 
@@ -426,9 +443,6 @@ LockManager::~LockManager() {
         // TODO: dump more information about the non-empty bucket to see what locks were leaked
         invariant(_lockBuckets[i].data.empty());
     }
-
-    delete[] _lockBuckets;
-    delete[] _partitions;
 }
 
 LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mode) {
@@ -442,7 +456,7 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
     // For intent modes, try the PartitionedLockHead
     if (request->partitioned) {
         Partition* partition = _getPartition(request);
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<SpinLock> scopedLock(partition->mutex);
 
         // Fast path for intent locks
         PartitionedLockHead* partitionedLock = partition->find(resId);
@@ -465,7 +479,7 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
     // Start a partitioned lock if possible
     if (request->partitioned && !(lock->grantedModes & (~intentModes)) && !lock->conflictModes) {
         Partition* partition = _getPartition(request);
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<SpinLock> scopedLock(partition->mutex);
         PartitionedLockHead* partitionedLock = partition->findOrInsert(resId);
         invariant(partitionedLock);
         lock->partitions.push_back(partition);
@@ -574,7 +588,7 @@ bool LockManager::unlock(LockRequest* request) {
         invariant(request->status == LockRequest::STATUS_GRANTED ||
                   request->status == LockRequest::STATUS_CONVERTING);
         Partition* partition = _getPartition(request);
-        stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
+        stdx::lock_guard<SpinLock> scopedLock(partition->mutex);
         //  Fast path: still partitioned.
         if (request->partitionedLock) {
             request->partitionedLock->grantedList.remove(request);
@@ -810,7 +824,7 @@ LockManager::LockBucket* LockManager::_getBucket(ResourceId resId) const {
 }
 
 LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
-    return &_partitions[request->locker->getId() % _numPartitions];
+    return &_partitions[request->locker->getId() & (_numPartitions - 1)];
 }
 
 void LockManager::dump() const {
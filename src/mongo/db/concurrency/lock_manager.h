@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -43,6 +44,8 @@
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -150,14 +153,24 @@ private:
     // Each locker maps to a partition that is used for resources acquired in intent modes
     // modes and potentially other modes that don't conflict with themselves. This avoids
     // contention on the regular LockHead in the lock manager.
+    //
+    // There are enough partitions for lockers running on different cores to rarely share one, so
+    // the partition lock is a spin lock: its critical sections are a hash lookup and a few pointer
+    // updates, and when uncontended it costs a single atomic exchange.
     struct Partition {
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
         typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
-        SimpleMutex mutex;
+        SpinLock mutex;
         Map data;
     };
 
+    // Buckets and partitions are padded to a cache line each, so that lockers working on
+    // different ones do not invalidate each other's caches.
+    template <typename T>
+    using CacheAlignedVector =
+        std::vector<CacheAligned<T>, boost::alignment::aligned_allocator<CacheAligned<T>>>;
+
     /**
      * Retrieves the bucket in which the particular resource must reside. There is no need to
      * hold a lock when calling this function.
@@ -212,10 +225,11 @@ private:
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
     static const unsigned _numLockBuckets;
-    LockBucket* _lockBuckets;
+    mutable CacheAlignedVector<LockBucket> _lockBuckets;
 
-    static const unsigned _numPartitions;
-    Partition* _partitions;
+    // Power of two, scaled with the number of hardware threads.
+    const unsigned _numPartitions;
+    mutable CacheAlignedVector<Partition> _partitions;
 };
 
 
@@ -316,6 +316,35 @@ TEST(LockManager, Conflict) {
     ASSERT(request2.numNotifies == 1);
 }
 
+TEST(LockManager, ConflictWithIntentRequestsOnManyPartitions) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    // More lockers than there can be partitions, so that every partition holds intent requests.
+    const int kNumIntentLockers = 1100;
+    std::vector<std::unique_ptr<MMAPV1LockerImpl>> lockers;
+    std::vector<std::unique_ptr<LockRequestCombo>> requests;
+    for (int i = 0; i < kNumIntentLockers; i++) {
+        lockers.push_back(stdx::make_unique<MMAPV1LockerImpl>());
+        requests.push_back(stdx::make_unique<LockRequestCombo>(lockers.back().get()));
+        ASSERT(LOCK_OK == lockMgr.lock(resId, requests.back().get(), i % 2 ? MODE_IS : MODE_IX));
+    }
+
+    // The exclusive request must wait for all intent requests, wherever they are partitioned
+    MMAPV1LockerImpl exclusiveLocker;
+    LockRequestCombo exclusiveRequest(&exclusiveLocker);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &exclusiveRequest, MODE_X));
+
+    for (int i = 0; i < kNumIntentLockers; i++) {
+        ASSERT(exclusiveRequest.numNotifies == 0);
+        lockMgr.unlock(requests[i].get());
+    }
+
+    ASSERT(exclusiveRequest.numNotifies == 1);
+    ASSERT(exclusiveRequest.lastResult == LOCK_OK);
+    lockMgr.unlock(&exclusiveRequest);
+}
+
 TEST(LockManager, MultipleConflict) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
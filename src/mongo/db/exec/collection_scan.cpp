@@ -69,6 +69,8 @@ CollectionScan::CollectionScan(OperationContext* opCtx,
     _specificStats.direction = params.direction;
     _specificStats.maxTs = params.maxTs;
     invariant(!_params.shouldTrackLatestOplogTimestamp || _params.collection->ns().isOplog());
+    invariant((_params.resumeAfterRecordId.isNull() && _params.maxRecord.isNull()) ||
+              _params.direction == CollectionScanParams::FORWARD);
 
     if (params.maxTs) {
         _endConditionBSON = BSON("$gte" << *(params.maxTs));
@@ -141,6 +143,10 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                     *out = WorkingSetCommon::allocateStatusMember(_workingSet, status);
                     return PlanStage::DEAD;
                 }
+            } else if (!_params.resumeAfterRecordId.isNull()) {
+                // Only scan the records after 'resumeAfterRecordId'. The cursor keeps this
+                // position across yields until it returns its first record.
+                _cursor->positionAfter(_params.resumeAfterRecordId);
             }
 
             return PlanStage::NEED_TIME;
@@ -182,6 +188,11 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (!_params.maxRecord.isNull() && record->id > _params.maxRecord) {
+        _commonStats.isEOF = true;
+        return PlanStage::IS_EOF;
+    }
+
     _lastSeenId = record->id;
     if (_params.shouldTrackLatestOplogTimestamp) {
         auto status = setLatestOplogEntryTimestamp(*record);
@@ -49,6 +49,13 @@ struct CollectionScanParams {
     // not being invalidated before the first call to work(...).
     RecordId start;
 
+    // If not null, a forward scan begins with the first record after this one, which need not
+    // exist. Requires that the collection's cursors support SeekableRecordCursor::positionAfter().
+    RecordId resumeAfterRecordId;
+
+    // If not null, a forward scan returns EOF once it reaches a record after this one.
+    RecordId maxRecord;
+
     // If present, the collection scan will stop and return EOF the first time it sees a document
     // that does not pass the filter and has 'ts' greater than 'maxTs'.
     boost::optional<Timestamp> maxTs;
@@ -223,7 +223,8 @@ public:
 
         BulkBuilder(const IndexAccessMethod* index,
                     const IndexDescriptor* descriptor,
-                    size_t maxMemoryUsageBytes);
+                    size_t maxMemoryUsageBytes,
+                    size_t numSortThreads);
 
         std::unique_ptr<Sorter> _sorter;
         const IndexAccessMethod* _real;
@@ -247,8 +248,10 @@ public:
      *
      * maxMemoryUsageBytes: amount of memory consumed before the external sorter starts spilling to
      *                      disk
+     * numSortThreads: number of threads the external sorter may use to sort, spill and merge keys
      */
-    std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes);
+    std::unique_ptr<BulkBuilder> initiateBulk(size_t maxMemoryUsageBytes,
+                                              size_t numSortThreads = 1);
 
     /**
      * Call this when you are ready to finish your bulk work.
@@ -64,6 +64,12 @@ const WorkerMultikeyPathInfo& MultikeyPathTracker::getMultikeyPathInfo() const {
     return _multikeyPathInfo;
 }
 
+WorkerMultikeyPathInfo MultikeyPathTracker::releaseMultikeyPathInfo() {
+    WorkerMultikeyPathInfo released;
+    released.swap(_multikeyPathInfo);
+    return released;
+}
+
 const boost::optional<MultikeyPaths> MultikeyPathTracker::getMultikeyPathInfo(
     const NamespaceString& nss, const std::string& indexName) {
     for (const auto& multikeyPathInfo : _multikeyPathInfo) {
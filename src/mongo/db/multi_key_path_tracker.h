@@ -72,6 +72,12 @@ public:
      */
     const WorkerMultikeyPathInfo& getMultikeyPathInfo() const;
 
+    /**
+     * Returns the multikey path information that has been saved and clears it, so that operations
+     * applied later with the same OperationContext report only their own multikey paths.
+     */
+    WorkerMultikeyPathInfo releaseMultikeyPathInfo();
+
     /**
      * Returns the multikey path information for the given inputs, or boost::none if none exist.
      */
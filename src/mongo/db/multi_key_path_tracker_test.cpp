@@ -91,5 +91,23 @@ TEST(MultikeyPathTracker, TestMergeMultikeyPaths) {
         assertMultikeyPathsAreEqual(mutablePaths, {{0, 1}, {0, 1}, {0, 1, 2}});
     }
 }
+
+TEST(MultikeyPathTracker, ReleaseMultikeyPathInfoClearsTheTrackedPaths) {
+    NamespaceString nss("test.coll");
+    MultikeyPathTracker tracker;
+    tracker.startTrackingMultikeyPathInfo();
+
+    tracker.addMultikeyPathInfo({nss, "a_1", {{0}}});
+    auto released = tracker.releaseMultikeyPathInfo();
+    ASSERT_EQ(released.size(), 1UL);
+    ASSERT_EQ(released[0].indexName, "a_1");
+    ASSERT(tracker.getMultikeyPathInfo().empty());
+
+    tracker.addMultikeyPathInfo({nss, "b_1", {{0}}});
+    released = tracker.releaseMultikeyPathInfo();
+    ASSERT_EQ(released.size(), 1UL);
+    ASSERT_EQ(released[0].indexName, "b_1");
+    ASSERT(!tracker.getMultikeyPathInfo(nss, "a_1"));
+}
 }  // namespace
 }  // namespace mongo
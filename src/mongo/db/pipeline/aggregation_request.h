@@ -56,6 +56,7 @@ public:
     static constexpr StringData kCollationName = "collation"_sd;
     static constexpr StringData kExplainName = "explain"_sd;
     static constexpr StringData kAllowDiskUseName = "allowDiskUse"_sd;
+    static constexpr StringData kAllowParallelScanName = "allowParallelScan"_sd;
     static constexpr StringData kHintName = "hint"_sd;
     static constexpr StringData kCommentName = "comment"_sd;
 
@@ -151,6 +152,15 @@ public:
         return _allowDiskUse;
     }
 
+    /**
+     * Returns true if the collection scan feeding this pipeline may be split across several
+     * threads. Whether it actually is also depends on the server's configuration and on the shape
+     * of the pipeline.
+     */
+    bool shouldAllowParallelScan() const {
+        return _allowParallelScan;
+    }
+
     bool shouldBypassDocumentValidation() const {
         return _bypassDocumentValidation;
     }
@@ -218,6 +228,10 @@ public:
         _allowDiskUse = allowDiskUse;
     }
 
+    void setAllowParallelScan(bool allowParallelScan) {
+        _allowParallelScan = allowParallelScan;
+    }
+
     void setFromMongos(bool isFromMongos) {
         _fromMongos = isFromMongos;
     }
@@ -276,6 +290,7 @@ private:
     boost::optional<ExplainOptions::Verbosity> _explainMode;
 
     bool _allowDiskUse = false;
+    bool _allowParallelScan = false;
     bool _fromMongos = false;
     bool _needsMerge = false;
     bool _bypassDocumentValidation = false;
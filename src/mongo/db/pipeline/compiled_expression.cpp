@@ -0,0 +1,564 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/compiled_expression.h"
+
+#include <cmath>
+
+#include "mongo/platform/overflow_arithmetic.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+std::unique_ptr<CompiledExpression> CompiledExpression::compile(
+    const intrusive_ptr<ExpressionContext>& expCtx, const intrusive_ptr<Expression>& expression) {
+    std::unique_ptr<CompiledExpression> compiled(new CompiledExpression(expCtx, expression));
+    // A program which only loads fields and evaluates subtrees does the same work as the tree, on
+    // top of dispatching its instructions.
+    for (auto&& instruction : compiled->_program) {
+        if (instruction.op != OpCode::kEvaluate && instruction.op != OpCode::kLoadField) {
+            return compiled;
+        }
+    }
+    return nullptr;
+}
+
+CompiledExpression::CompiledExpression(const intrusive_ptr<ExpressionContext>& expCtx,
+                                       const intrusive_ptr<Expression>& expression)
+    : _expCtx(expCtx), _expression(expression) {
+    _result = compileNode(_expression.get());
+
+    // Only a constant is compiled without any instructions.
+    _resultIsConstant = _program.empty();
+}
+
+size_t CompiledExpression::addRegister(Value initialValue) {
+    _registers.emplace_back();
+    _registers.back().set(std::move(initialValue));
+    return _registers.size() - 1;
+}
+
+size_t CompiledExpression::emit(Instruction instruction) {
+    _program.push_back(std::move(instruction));
+    return _program.size() - 1;
+}
+
+size_t CompiledExpression::compileNode(const Expression* expression) {
+    if (auto constant = dynamic_cast<const ExpressionConstant*>(expression)) {
+        return addRegister(constant->getValue());
+    }
+
+    if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expression)) {
+        // Field paths over user variables have to be looked up in Variables.
+        Instruction instruction(fieldPath->isRootFieldPath() ? OpCode::kLoadField
+                                                             : OpCode::kEvaluate);
+        instruction.dst = addRegister();
+        instruction.expression = expression;
+        instruction.fieldPath = &fieldPath->getFieldPath();
+        emit(instruction);
+        return instruction.dst;
+    }
+
+    if (auto add = dynamic_cast<const ExpressionAdd*>(expression)) {
+        _sums.emplace_back();
+        return compileAccumulation(
+            add, OpCode::kAddBegin, OpCode::kAdd, OpCode::kAddEnd, _sums.size() - 1);
+    }
+
+    if (auto multiply = dynamic_cast<const ExpressionMultiply*>(expression)) {
+        _products.emplace_back();
+        return compileAccumulation(multiply,
+                                   OpCode::kMultiplyBegin,
+                                   OpCode::kMultiply,
+                                   OpCode::kMultiplyEnd,
+                                   _products.size() - 1);
+    }
+
+    if (auto andExpression = dynamic_cast<const ExpressionAnd*>(expression)) {
+        return compileShortCircuit(andExpression, false);
+    }
+
+    if (auto orExpression = dynamic_cast<const ExpressionOr*>(expression)) {
+        return compileShortCircuit(orExpression, true);
+    }
+
+    if (auto subtract = dynamic_cast<const ExpressionSubtract*>(expression)) {
+        Instruction instruction(OpCode::kSubtract);
+        instruction.lhs = compileNode(subtract->getOperandList()[0].get());
+        instruction.rhs = compileNode(subtract->getOperandList()[1].get());
+        instruction.dst = addRegister();
+        emit(instruction);
+        return instruction.dst;
+    }
+
+    if (auto compareExpression = dynamic_cast<const ExpressionCompare*>(expression)) {
+        Instruction instruction(OpCode::kCompare);
+        instruction.lhs = compileNode(compareExpression->getOperandList()[0].get());
+        instruction.rhs = compileNode(compareExpression->getOperandList()[1].get());
+        instruction.cmpOp = compareExpression->getOp();
+        instruction.dst = addRegister();
+        emit(instruction);
+        return instruction.dst;
+    }
+
+    if (auto notExpression = dynamic_cast<const ExpressionNot*>(expression)) {
+        Instruction instruction(OpCode::kNot);
+        instruction.lhs = compileNode(notExpression->getOperandList()[0].get());
+        instruction.dst = addRegister();
+        emit(instruction);
+        return instruction.dst;
+    }
+
+    if (auto coerceToBool = dynamic_cast<const ExpressionCoerceToBool*>(expression)) {
+        Instruction instruction(OpCode::kCoerceToBool);
+        instruction.lhs = compileNode(coerceToBool->getExpression().get());
+        instruction.dst = addRegister();
+        emit(instruction);
+        return instruction.dst;
+    }
+
+    if (auto cond = dynamic_cast<const ExpressionCond*>(expression)) {
+        const auto& operands = cond->getOperandList();
+        const size_t dst = addRegister();
+
+        Instruction jumpToElse(OpCode::kJumpIfFalse);
+        jumpToElse.lhs = compileNode(operands[0].get());
+        const size_t jumpToElseIndex = emit(jumpToElse);
+
+        Instruction moveThen(OpCode::kMove);
+        moveThen.lhs = compileNode(operands[1].get());
+        moveThen.dst = dst;
+        emit(moveThen);
+        const size_t jumpToEndIndex = emit(Instruction(OpCode::kJump));
+
+        _program[jumpToElseIndex].jump = _program.size();
+        Instruction moveElse(OpCode::kMove);
+        moveElse.lhs = compileNode(operands[2].get());
+        moveElse.dst = dst;
+        emit(moveElse);
+
+        _program[jumpToEndIndex].jump = _program.size();
+        return dst;
+    }
+
+    Instruction instruction(OpCode::kEvaluate);
+    instruction.dst = addRegister();
+    instruction.expression = expression;
+    emit(instruction);
+    return instruction.dst;
+}
+
+size_t CompiledExpression::compileAccumulation(
+    const ExpressionNary* expression, OpCode begin, OpCode accumulate, OpCode end, size_t state) {
+    const size_t dst = addRegister();
+
+    Instruction beginInstruction(begin);
+    beginInstruction.state = state;
+    emit(beginInstruction);
+
+    // Each operand is accumulated as soon as it is evaluated, since a null operand means the
+    // remaining operands are never evaluated.
+    std::vector<size_t> shortCircuits;
+    for (auto&& operand : expression->getOperandList()) {
+        Instruction instruction(accumulate);
+        instruction.lhs = compileNode(operand.get());
+        instruction.dst = dst;
+        instruction.state = state;
+        shortCircuits.push_back(emit(instruction));
+    }
+
+    Instruction endInstruction(end);
+    endInstruction.dst = dst;
+    endInstruction.state = state;
+    emit(endInstruction);
+
+    for (auto index : shortCircuits) {
+        _program[index].jump = _program.size();
+    }
+    return dst;
+}
+
+size_t CompiledExpression::compileShortCircuit(const ExpressionNary* expression,
+                                               bool shortCircuitOn) {
+    const size_t dst = addRegister();
+
+    std::vector<size_t> shortCircuits;
+    for (auto&& operand : expression->getOperandList()) {
+        Instruction instruction(OpCode::kShortCircuit);
+        instruction.lhs = compileNode(operand.get());
+        instruction.dst = dst;
+        instruction.boolean = shortCircuitOn;
+        shortCircuits.push_back(emit(instruction));
+    }
+
+    Instruction instruction(OpCode::kLoadBool);
+    instruction.dst = dst;
+    instruction.boolean = !shortCircuitOn;
+    emit(instruction);
+
+    for (auto index : shortCircuits) {
+        _program[index].jump = _program.size();
+    }
+    return dst;
+}
+
+Value CompiledExpression::evaluate(const Document& root) const {
+    // The program and registers are not resized once compiled, so neither needs to be reloaded
+    // after every instruction which writes to a register.
+    Register* const registers = _registers.data();
+    const Instruction* const program = _program.data();
+    const size_t programSize = _program.size();
+
+    size_t pc = 0;
+    while (pc < programSize) {
+        const Instruction& instruction = program[pc++];
+        switch (instruction.op) {
+            case OpCode::kEvaluate:
+                registers[instruction.dst].set(instruction.expression->evaluate(root));
+                break;
+            case OpCode::kLoadField:
+                loadField(instruction, root, &registers[instruction.dst]);
+                break;
+            case OpCode::kMove:
+                registers[instruction.dst].set(registers[instruction.lhs]);
+                break;
+            case OpCode::kJump:
+                pc = instruction.jump;
+                break;
+            case OpCode::kJumpIfFalse:
+                if (!registers[instruction.lhs].coerceToBool()) {
+                    pc = instruction.jump;
+                }
+                break;
+            case OpCode::kShortCircuit:
+                if (registers[instruction.lhs].coerceToBool() == instruction.boolean) {
+                    registers[instruction.dst].setBool(instruction.boolean);
+                    pc = instruction.jump;
+                }
+                break;
+            case OpCode::kLoadBool:
+                registers[instruction.dst].setBool(instruction.boolean);
+                break;
+            case OpCode::kCoerceToBool:
+                registers[instruction.dst].setBool(registers[instruction.lhs].coerceToBool());
+                break;
+            case OpCode::kNot:
+                registers[instruction.dst].setBool(!registers[instruction.lhs].coerceToBool());
+                break;
+            case OpCode::kCompare: {
+                const int cmp = compare(registers[instruction.lhs], registers[instruction.rhs]);
+                if (instruction.cmpOp == ExpressionCompare::CMP) {
+                    registers[instruction.dst].setInt(cmp < 0 ? -1 : cmp > 0 ? 1 : 0);
+                } else {
+                    registers[instruction.dst].setBool(
+                        ExpressionCompare::evaluateComparison(instruction.cmpOp, cmp).getBool());
+                }
+                break;
+            }
+            case OpCode::kSubtract:
+                subtract(registers[instruction.lhs],
+                         registers[instruction.rhs],
+                         &registers[instruction.dst]);
+                break;
+            case OpCode::kAddBegin: {
+                auto& state = _sums[instruction.state];
+                state.integralTotal = 0;
+                state.integralTotalType = NumberInt;
+                state.sum = boost::none;
+                break;
+            }
+            case OpCode::kAdd:
+                if (!add(registers[instruction.lhs], &_sums[instruction.state])) {
+                    registers[instruction.dst].set(Value(BSONNULL));
+                    pc = instruction.jump;
+                }
+                break;
+            case OpCode::kAddEnd: {
+                const auto& state = _sums[instruction.state];
+                if (state.sum) {
+                    registers[instruction.dst].set(state.sum->getValue());
+                } else if (state.integralTotalType == NumberInt &&
+                           state.integralTotal == static_cast<int>(state.integralTotal)) {
+                    registers[instruction.dst].setInt(state.integralTotal);
+                } else {
+                    registers[instruction.dst].setLong(state.integralTotal);
+                }
+                break;
+            }
+            case OpCode::kMultiplyBegin: {
+                auto& state = _products[instruction.state];
+                state.productType = NumberInt;
+                state.longProduct = 1;
+                state.doubleProduct = 1;
+                state.product = boost::none;
+                break;
+            }
+            case OpCode::kMultiply:
+                if (!multiply(registers[instruction.lhs], &_products[instruction.state])) {
+                    registers[instruction.dst].set(Value(BSONNULL));
+                    pc = instruction.jump;
+                }
+                break;
+            case OpCode::kMultiplyEnd: {
+                const auto& state = _products[instruction.state];
+                if (state.product) {
+                    registers[instruction.dst].set(state.product->getValue());
+                } else if (state.productType == NumberDouble) {
+                    registers[instruction.dst].setDouble(state.doubleProduct);
+                } else if (state.productType == NumberInt &&
+                           state.longProduct == static_cast<int>(state.longProduct)) {
+                    registers[instruction.dst].setInt(state.longProduct);
+                } else {
+                    registers[instruction.dst].setLong(state.longProduct);
+                }
+                break;
+            }
+        }
+    }
+
+    // Unless the result is a constant, its register is overwritten by the next evaluation anyway,
+    // so a boxed result can be moved out of it.
+    return _resultIsConstant ? registers[_result].get() : registers[_result].release();
+}
+
+void CompiledExpression::loadField(const Instruction& instruction,
+                                   const Document& root,
+                                   Register* dst) const {
+    // The first component of the path is the variable, $$ROOT or $$CURRENT, both of which are the
+    // input document here. The common cases of a top-level field and of the whole document are
+    // stored straight into 'dst', without an intermediate Value to move from.
+    const FieldPath& path = *instruction.fieldPath;
+    const size_t pathLength = path.getPathLength();
+    if (pathLength == 1) {
+        dst->set(Value(root));
+        return;
+    } else if (pathLength == 2) {
+        dst->set(root[path.getFieldName(1)]);
+        return;
+    }
+
+    Value current = root[path.getFieldName(1)];
+    for (size_t i = 2; i < pathLength; ++i) {
+        switch (current.getType()) {
+            case Object:
+                current = current.getDocument()[path.getFieldName(i)];
+                break;
+            case Array:
+                // Traversing an array collects the path from each of its elements, which only the
+                // tree implements.
+                dst->set(instruction.expression->evaluate(root));
+                return;
+            default:
+                dst->set(Value());
+                return;
+        }
+    }
+    dst->set(std::move(current));
+}
+
+int CompiledExpression::compare(const Register& lhs, const Register& rhs) const {
+    // Numbers compare the same under every collation. Doubles take the fast path only when
+    // neither is NaN, since NaN compares equal to itself and less than any other number.
+    if (lhs.type == NumberInt && rhs.type == NumberInt) {
+        return lhs.intValue < rhs.intValue ? -1 : lhs.intValue > rhs.intValue ? 1 : 0;
+    } else if (lhs.isIntegral() && rhs.isIntegral()) {
+        const long long left = lhs.getIntegral();
+        const long long right = rhs.getIntegral();
+        return left < right ? -1 : left > right ? 1 : 0;
+    } else if (lhs.type == NumberDouble && rhs.type == NumberDouble &&
+               !std::isnan(lhs.doubleValue) && !std::isnan(rhs.doubleValue)) {
+        return lhs.doubleValue < rhs.doubleValue ? -1 : lhs.doubleValue > rhs.doubleValue ? 1 : 0;
+    }
+
+    return _expCtx->getValueComparator().compare(lhs.get(), rhs.get());
+}
+
+bool CompiledExpression::add(const Register& operand, AddState* state) {
+    if (!state->sum) {
+        long long newTotal;
+        if (operand.isIntegral() &&
+            !mongoSignedAddOverflow64(state->integralTotal, operand.getIntegral(), &newTotal)) {
+            state->integralTotal = newTotal;
+            if (operand.type == NumberLong) {
+                state->integralTotalType = NumberLong;
+            }
+            return true;
+        }
+
+        // Only an operand which is not a NumberInt or NumberLong makes the type of the total
+        // matter, so the total so far can be handed over as either.
+        state->sum.emplace();
+        state->sum->add(state->integralTotalType == NumberLong
+                            ? Value(state->integralTotal)
+                            : Value::createIntOrLong(state->integralTotal));
+    }
+    return state->sum->add(operand.get());
+}
+
+bool CompiledExpression::multiply(const Register& operand, MultiplyState* state) {
+    if (!state->product) {
+        // These mirror ExpressionMultiply::Product::multiply(). Once the product is a double, the
+        // long long product is never looked at again, so it is no longer kept up to date.
+        if (operand.type == NumberDouble) {
+            state->productType = NumberDouble;
+            state->doubleProduct *= operand.doubleValue;
+            return true;
+        } else if (operand.isIntegral()) {
+            state->doubleProduct *= operand.getIntegral();
+            if (state->productType != NumberDouble) {
+                if (operand.type == NumberLong) {
+                    state->productType = NumberLong;
+                }
+                if (mongoSignedMultiplyOverflow64(
+                        state->longProduct, operand.getIntegral(), &state->longProduct)) {
+                    state->productType = NumberDouble;
+                }
+            }
+            return true;
+        }
+
+        // A NumberDecimal operand only looks at the product so far as a double if it is one, and
+        // otherwise as a long long, so handing over either one alone loses nothing.
+        state->product.emplace();
+        state->product->multiply(state->productType == NumberDouble
+                                     ? Value(state->doubleProduct)
+                                     : Value(state->longProduct));
+    }
+    return state->product->multiply(operand.get());
+}
+
+void CompiledExpression::subtract(const Register& lhs, const Register& rhs, Register* difference) {
+    // These mirror the numeric cases of ExpressionSubtract::apply().
+    if (lhs.type == NumberInt && rhs.type == NumberInt) {
+        const long long result = static_cast<long long>(lhs.intValue) - rhs.intValue;
+        if (result == static_cast<int>(result)) {
+            difference->setInt(result);
+        } else {
+            difference->setLong(result);
+        }
+    } else if (lhs.isIntegral() && rhs.isIntegral()) {
+        difference->setLong(lhs.getIntegral() - rhs.getIntegral());
+    } else if ((lhs.type == NumberDouble && (rhs.type == NumberDouble || rhs.isIntegral())) ||
+               (rhs.type == NumberDouble && lhs.isIntegral())) {
+        const double left = lhs.type == NumberDouble ? lhs.doubleValue : lhs.getIntegral();
+        const double right = rhs.type == NumberDouble ? rhs.doubleValue : rhs.getIntegral();
+        difference->setDouble(left - right);
+    } else {
+        difference->set(ExpressionSubtract::apply(lhs.get(), rhs.get()));
+    }
+}
+
+void CompiledExpression::Register::set(const Value& newValue) {
+    if (!setUnboxed(newValue)) {
+        type = newValue.getType();
+        value = newValue;
+    }
+}
+
+void CompiledExpression::Register::set(Value&& newValue) {
+    if (!setUnboxed(newValue)) {
+        type = newValue.getType();
+        value = std::move(newValue);
+    }
+}
+
+bool CompiledExpression::Register::setUnboxed(const Value& newValue) {
+    switch (newValue.getType()) {
+        case NumberInt:
+            setInt(newValue.getInt());
+            return true;
+        case NumberLong:
+            setLong(newValue.getLong());
+            return true;
+        case NumberDouble:
+            setDouble(newValue.getDouble());
+            return true;
+        case Bool:
+            setBool(newValue.getBool());
+            return true;
+        default:
+            return false;
+    }
+}
+
+void CompiledExpression::Register::set(const Register& other) {
+    type = other.type;
+    longValue = other.longValue;
+    if (other.type != NumberInt && other.type != NumberLong && other.type != NumberDouble &&
+        other.type != Bool) {
+        value = other.value;
+    }
+}
+
+Value CompiledExpression::Register::get() const {
+    switch (type) {
+        case NumberInt:
+            return Value(intValue);
+        case NumberLong:
+            return Value(longValue);
+        case NumberDouble:
+            return Value(doubleValue);
+        case Bool:
+            return Value(boolValue);
+        default:
+            return value;
+    }
+}
+
+Value CompiledExpression::Register::release() {
+    switch (type) {
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case Bool:
+            return get();
+        default:
+            return std::move(value);
+    }
+}
+
+bool CompiledExpression::Register::coerceToBool() const {
+    switch (type) {
+        case NumberInt:
+            return intValue;
+        case NumberLong:
+            return longValue;
+        case NumberDouble:
+            return doubleValue != 0;
+        case Bool:
+            return boolValue;
+        default:
+            return value.coerceToBool();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,262 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+/**
+ * An optimized Expression tree flattened into a linear program, which evaluates to the same result
+ * as the tree without a virtual call and a returned Value per node.
+ *
+ * The program runs over a file of registers, one per compiled node. Constants are loaded into their
+ * registers once, when compiling. Field paths rooted at $$ROOT or $$CURRENT read the input without
+ * going through Variables, and arithmetic and comparisons take a typed fast path when their
+ * operands are numbers. $and, $or and $cond become jumps, so short-circuiting is unchanged. Any
+ * node the compiler does not know how to flatten is evaluated by walking its subtree as usual, so
+ * the operators it does know are compiled wherever they appear in the tree.
+ *
+ * Operands are evaluated in the same order as the tree would evaluate them, and an operand the
+ * tree would skip is skipped, so a compiled expression also throws the same errors as the tree.
+ *
+ * The registers are part of the CompiledExpression, so only one thread may evaluate it at a time,
+ * as is true of the Expression tree itself.
+ */
+class CompiledExpression {
+    MONGO_DISALLOW_COPYING(CompiledExpression);
+
+public:
+    /**
+     * Compiles 'expression', which should already have been optimized. Returns nullptr if no
+     * operator in the tree can be compiled, since evaluating the tree directly is then cheaper.
+     */
+    static std::unique_ptr<CompiledExpression> compile(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const boost::intrusive_ptr<Expression>& expression);
+
+    /**
+     * Returns what the compiled Expression would return when evaluated against 'root'.
+     */
+    Value evaluate(const Document& root) const;
+
+private:
+    enum class OpCode {
+        // Evaluates 'expression' by walking its tree into 'dst'.
+        kEvaluate,
+
+        // Reads 'fieldPath', which is rooted at the input document, into 'dst'.
+        kLoadField,
+
+        // Copies 'lhs' into 'dst'.
+        kMove,
+
+        // Continues from 'jump'.
+        kJump,
+
+        // Continues from 'jump' if 'lhs' is false.
+        kJumpIfFalse,
+
+        // If 'lhs' coerces to 'boolean', stores 'boolean' in 'dst' and continues from 'jump'.
+        kShortCircuit,
+
+        // Stores 'boolean' in 'dst'.
+        kLoadBool,
+
+        // Stores 'lhs' coerced to a bool, or its negation for kNot, in 'dst'.
+        kCoerceToBool,
+        kNot,
+
+        // Stores the result of comparing 'lhs' to 'rhs' with 'cmpOp' in 'dst'.
+        kCompare,
+
+        // Stores 'lhs' minus 'rhs' in 'dst'.
+        kSubtract,
+
+        // Resets, adds 'lhs' to and stores in 'dst' the running total number 'state' of a $add.
+        // If 'lhs' is null or missing, kAdd stores null in 'dst' and continues from 'jump'.
+        // Running totals start out as a long long, and are only handed over to an
+        // ExpressionAdd::Sum once an operand is not a NumberInt or NumberLong.
+        kAddBegin,
+        kAdd,
+        kAddEnd,
+
+        // The same as the instructions above, for the running product of a $multiply. Products
+        // are kept unboxed until an operand is a NumberDecimal, and are only then handed over to
+        // an ExpressionMultiply::Product.
+        kMultiplyBegin,
+        kMultiply,
+        kMultiplyEnd,
+    };
+
+    struct Instruction {
+        explicit Instruction(OpCode op) : op(op) {}
+
+        OpCode op;
+        size_t dst = 0;
+        size_t lhs = 0;
+        size_t rhs = 0;
+        size_t state = 0;
+        size_t jump = 0;
+        bool boolean = false;
+        ExpressionCompare::CmpOp cmpOp = ExpressionCompare::EQ;
+        const Expression* expression = nullptr;
+        const FieldPath* fieldPath = nullptr;
+    };
+
+    /**
+     * Holds the result of an instruction. NumberInt, NumberLong, NumberDouble and Bool results are
+     * held unboxed, so that the instructions passing them along do not pay for a Value each time.
+     */
+    struct Register {
+        void setInt(int newValue) {
+            type = NumberInt;
+            intValue = newValue;
+        }
+        void setLong(long long newValue) {
+            type = NumberLong;
+            longValue = newValue;
+        }
+        void setDouble(double newValue) {
+            type = NumberDouble;
+            doubleValue = newValue;
+        }
+        void setBool(bool newValue) {
+            type = Bool;
+            boolValue = newValue;
+        }
+        void set(const Value& newValue);
+        void set(Value&& newValue);
+        void set(const Register& other);
+
+        // Stores 'newValue' unboxed and returns true if it is of one of the types below.
+        bool setUnboxed(const Value& newValue);
+
+        Value get() const;
+
+        // Returns the same as get(), but may leave this register holding a moved-from Value.
+        Value release();
+        bool coerceToBool() const;
+
+        bool isIntegral() const {
+            return type == NumberInt || type == NumberLong;
+        }
+        long long getIntegral() const {
+            return type == NumberInt ? intValue : longValue;
+        }
+
+        BSONType type = EOO;
+        union {
+            int intValue;
+            long long longValue = 0;
+            double doubleValue;
+            bool boolValue;
+        };
+
+        // Holds the result when it is not one of the types above.
+        Value value;
+    };
+
+    /**
+     * The running total of a $add.
+     */
+    struct AddState {
+        long long integralTotal = 0;
+        BSONType integralTotalType = NumberInt;
+
+        // Holds the total instead of the members above once it has been handed over. It is
+        // constructed in place when that happens, since copying a Sum over it costs more than the
+        // additions themselves.
+        boost::optional<ExpressionAdd::Sum> sum;
+    };
+
+    /**
+     * The running product of a $multiply. Like ExpressionMultiply::Product, the product is kept
+     * both as a long long and as a double, for as long as it may still be returned as either.
+     */
+    struct MultiplyState {
+        BSONType productType = NumberInt;
+        long long longProduct = 1;
+        double doubleProduct = 1;
+
+        // Holds the product instead of the members above once it has been handed over.
+        boost::optional<ExpressionMultiply::Product> product;
+    };
+
+    CompiledExpression(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       const boost::intrusive_ptr<Expression>& expression);
+
+    /**
+     * Appends the instructions evaluating 'expression' to the program, returning the register
+     * holding its result once they have run.
+     */
+    size_t compileNode(const Expression* expression);
+
+    /**
+     * Helpers for compileNode(), for $add and $multiply, and for $and and $or respectively.
+     */
+    size_t compileAccumulation(const ExpressionNary* expression,
+                               OpCode begin,
+                               OpCode accumulate,
+                               OpCode end,
+                               size_t state);
+    size_t compileShortCircuit(const ExpressionNary* expression, bool shortCircuitOn);
+
+    size_t addRegister(Value initialValue = Value());
+    size_t emit(Instruction instruction);
+
+    void loadField(const Instruction& instruction, const Document& root, Register* dst) const;
+    int compare(const Register& lhs, const Register& rhs) const;
+    static bool add(const Register& operand, AddState* state);
+    static bool multiply(const Register& operand, MultiplyState* state);
+    static void subtract(const Register& lhs, const Register& rhs, Register* difference);
+
+    const boost::intrusive_ptr<ExpressionContext> _expCtx;
+
+    // The Expression tree which was compiled, which owns every node the program points to.
+    const boost::intrusive_ptr<Expression> _expression;
+
+    std::vector<Instruction> _program;
+
+    // The register holding the result once the program has run.
+    size_t _result = 0;
+    bool _resultIsConstant = false;
+
+    mutable std::vector<Register> _registers;
+    mutable std::vector<AddState> _sums;
+    mutable std::vector<MultiplyState> _products;
+};
+
+}  // namespace mongo
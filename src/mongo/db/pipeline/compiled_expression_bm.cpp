@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/compiled_expression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+
+namespace mongo {
+namespace {
+
+const int kNumDocs = 1024;
+
+/**
+ * Evaluates the expression given by 'json' against kNumDocs documents with integral fields 'a'
+ * and 'b', a double field 'c', and a subdocument 'x' holding integral fields 'y' and 'z', either by
+ * walking the expression tree or by running its compiled form.
+ */
+void BM_Evaluate(benchmark::State& state, const char* json, bool compile) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    const BSONObj spec = fromjson(std::string("{expr: ") + json + "}");
+    auto expression =
+        Expression::parseOperand(expCtx, spec.firstElement(), expCtx->variablesParseState)
+            ->optimize();
+    auto compiled = CompiledExpression::compile(expCtx, expression);
+    invariant(compiled);
+
+    std::vector<Document> documents;
+    for (int i = 0; i < kNumDocs; i++) {
+        documents.push_back(Document{{"_id", i},
+                                     {"a", i % 100},
+                                     {"b", (i * 7) % 100},
+                                     {"c", i * 0.5},
+                                     {"x", Document{{"y", i}, {"z", -i}}}});
+    }
+
+    for (auto keepRunning : state) {
+        for (auto&& document : documents) {
+            benchmark::DoNotOptimize(compile ? compiled->evaluate(document)
+                                             : expression->evaluate(document));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumDocs);
+}
+
+#define BENCHMARK_EXPRESSION(name, json)                        \
+    BENCHMARK_CAPTURE(BM_Evaluate, name##_tree, json, false);   \
+    BENCHMARK_CAPTURE(BM_Evaluate, name##_compiled, json, true)
+
+BENCHMARK_EXPRESSION(Compare, "{$gt: ['$a', 50]}");
+BENCHMARK_EXPRESSION(CompareFields, "{$lte: ['$a', '$b']}");
+BENCHMARK_EXPRESSION(Not, "{$not: ['$a']}");
+BENCHMARK_EXPRESSION(Add, "{$add: ['$a', '$b']}");
+BENCHMARK_EXPRESSION(AddDouble, "{$add: ['$a', '$c', 1]}");
+BENCHMARK_EXPRESSION(Subtract, "{$subtract: ['$a', '$b']}");
+BENCHMARK_EXPRESSION(Multiply, "{$multiply: ['$a', '$b', 2]}");
+BENCHMARK_EXPRESSION(NestedFields, "{$add: ['$x.y', '$x.z']}");
+BENCHMARK_EXPRESSION(Arithmetic,
+                     "{$add: [{$multiply: ['$a', 2]}, {$subtract: ['$b', 1]}, '$a', '$b']}");
+BENCHMARK_EXPRESSION(And, "{$and: [{$gte: ['$a', 10]}, {$lt: ['$b', 90]}, {$ne: ['$a', '$b']}]}");
+BENCHMARK_EXPRESSION(Cond, "{$cond: [{$gt: ['$a', '$b']}, {$subtract: ['$a', '$b']}, 0]}");
+
+}  // namespace
+}  // namespace mongo
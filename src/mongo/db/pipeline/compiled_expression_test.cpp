@@ -0,0 +1,189 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+#include <limits>
+
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/compiled_expression.h"
+#include "mongo/db/pipeline/document_value_test_util.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+using boost::intrusive_ptr;
+
+const int kIntMax = std::numeric_limits<int>::max();
+const long long kLongMax = std::numeric_limits<long long>::max();
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+class CompiledExpressionTest : public AggregationContextFixture {
+protected:
+    intrusive_ptr<Expression> parse(const std::string& json) {
+        auto expCtx = getExpCtx();
+        const BSONObj spec = fromjson("{expr: " + json + "}");
+        return Expression::parseOperand(expCtx, spec.firstElement(), expCtx->variablesParseState)
+            ->optimize();
+    }
+
+    /**
+     * Asserts that 'json' compiles, and that the compiled form evaluates to the same result as the
+     * tree against each of 'documents', down to its type and the sign of a zero.
+     */
+    void assertSameResults(const std::string& json, const std::vector<Document>& documents) {
+        auto expression = parse(json);
+        auto compiled = CompiledExpression::compile(getExpCtx(), expression);
+        ASSERT(compiled) << json;
+
+        for (auto&& document : documents) {
+            const Value expected = expression->evaluate(document);
+            const Value actual = compiled->evaluate(document);
+            ASSERT_VALUE_EQ(actual, expected);
+            ASSERT_EQ(actual.getType(), expected.getType()) << json << " on " << document;
+            if (expected.getType() == NumberDouble) {
+                ASSERT_EQ(std::signbit(actual.getDouble()), std::signbit(expected.getDouble()));
+            }
+        }
+    }
+
+    /**
+     * Asserts that both the tree and the compiled form of 'json' throw 'code' against 'document'.
+     */
+    void assertSameError(const std::string& json, const Document& document, int code) {
+        auto expression = parse(json);
+        auto compiled = CompiledExpression::compile(getExpCtx(), expression);
+        ASSERT(compiled) << json;
+
+        ASSERT_THROWS_CODE(expression->evaluate(document), AssertionException, code);
+        ASSERT_THROWS_CODE(compiled->evaluate(document), AssertionException, code);
+    }
+
+    std::vector<Document> numericDocuments() {
+        return {Document{{"a", 5}, {"b", 7}},
+                Document{{"a", 5}, {"b", -7.5}},
+                Document{{"a", 5LL}, {"b", 7}},
+                Document{{"a", kIntMax}, {"b", 1}},
+                Document{{"a", kLongMax}, {"b", 1}},
+                Document{{"a", kLongMax}, {"b", 2LL}},
+                Document{{"a", Decimal128("1.5")}, {"b", 2}},
+                Document{{"a", 0.0}, {"b", -0.0}},
+                Document{{"a", -0.0}, {"b", -0.0}},
+                Document{{"a", kNaN}, {"b", 1}},
+                Document{{"a", BSONNULL}, {"b", 1}},
+                Document{{"b", 1}},
+                Document{}};
+    }
+};
+
+TEST_F(CompiledExpressionTest, DoesNotCompileExpressionsWithoutCompiledOperators) {
+    ASSERT_FALSE(CompiledExpression::compile(getExpCtx(), parse("'$a'")));
+    ASSERT_FALSE(CompiledExpression::compile(getExpCtx(), parse("{$add: [1, 2]}")));
+    ASSERT_FALSE(CompiledExpression::compile(getExpCtx(), parse("{$concat: ['$a', '$b']}")));
+}
+
+TEST_F(CompiledExpressionTest, CompilesOperatorOverUncompiledOperands) {
+    auto compiled =
+        CompiledExpression::compile(getExpCtx(), parse("{$gt: [{$strLenCP: '$s'}, 2]}"));
+    ASSERT(compiled);
+    ASSERT_VALUE_EQ(compiled->evaluate(Document{{"s", "abc"_sd}}), Value(true));
+    ASSERT_VALUE_EQ(compiled->evaluate(Document{{"s", "ab"_sd}}), Value(false));
+}
+
+TEST_F(CompiledExpressionTest, ArithmeticMatchesTree) {
+    const auto documents = numericDocuments();
+    assertSameResults("{$add: ['$a', '$b']}", documents);
+    assertSameResults("{$add: ['$a', '$b', '$a', 1.5]}", documents);
+    assertSameResults("{$add: ['$a', {$literal: NumberLong(1)}]}", documents);
+    assertSameResults("{$subtract: ['$a', '$b']}", documents);
+    assertSameResults("{$subtract: ['$b', '$a']}", documents);
+    assertSameResults("{$multiply: ['$a', '$b']}", documents);
+    assertSameResults("{$multiply: ['$a', '$b', '$a', '$b']}", documents);
+    assertSameResults("{$multiply: [{$subtract: ['$a', '$b']}, {$add: ['$a', '$b']}]}", documents);
+}
+
+TEST_F(CompiledExpressionTest, ComparisonsMatchTree) {
+    const auto documents = numericDocuments();
+    for (auto&& op : {"$eq", "$ne", "$gt", "$gte", "$lt", "$lte", "$cmp"}) {
+        assertSameResults(str::stream() << "{" << op << ": ['$a', '$b']}", documents);
+        assertSameResults(str::stream() << "{" << op << ": ['$a', 5]}", documents);
+    }
+}
+
+TEST_F(CompiledExpressionTest, LogicMatchesTree) {
+    const auto documents = numericDocuments();
+    assertSameResults("{$and: [{$gt: ['$a', 2]}, '$b']}", documents);
+    assertSameResults("{$or: [{$gt: ['$a', 2]}, {$lt: ['$b', 0]}]}", documents);
+    assertSameResults("{$not: ['$a']}", documents);
+    assertSameResults("{$cond: [{$gte: ['$a', '$b']}, '$a', '$b']}", documents);
+}
+
+TEST_F(CompiledExpressionTest, FieldPathsTraverseObjectsAndArrays) {
+    assertSameResults("{$add: ['$a.b.c', 1]}",
+                      {Document{{"a", Document{{"b", Document{{"c", 1}}}}}},
+                       Document{{"a", Document{{"b", 1}}}},
+                       Document{{"a", 1}}});
+    assertSameResults("{$eq: ['$a.b', [1, 2]]}",
+                      {Document{{"a", std::vector<Value>{Value(Document{{"b", 1}}),
+                                                         Value(Document{{"b", 2}})}}},
+                       Document{{"a", std::vector<Value>{Value(1)}}}});
+}
+
+TEST_F(CompiledExpressionTest, ShortCircuitsLikeTree) {
+    const Document document{{"s", "string"_sd}, {"f", false}, {"t", true}};
+    assertSameResults("{$and: ['$f', {$add: ['$s', 1]}]}", {document});
+    assertSameResults("{$or: ['$t', {$add: ['$s', 1]}]}", {document});
+    assertSameResults("{$cond: ['$t', 1, {$add: ['$s', 1]}]}", {document});
+    assertSameResults("{$cond: ['$f', {$add: ['$s', 1]}, 1]}", {document});
+    assertSameResults("{$add: ['$missing', {$add: ['$s', 1]}]}", {document});
+    assertSameResults("{$multiply: ['$missing', {$add: ['$s', 1]}]}", {document});
+}
+
+TEST_F(CompiledExpressionTest, ThrowsLikeTree) {
+    const Document document{{"s", "string"_sd}};
+    assertSameError("{$add: ['$s', 1]}", document, 16554);
+    assertSameError("{$multiply: [2, '$s']}", document, 16555);
+    assertSameError("{$subtract: ['$s', 1]}", document, 16556);
+}
+
+TEST_F(CompiledExpressionTest, ComparesStringsWithCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    getExpCtx()->setCollator(&collator);
+
+    auto compiled = CompiledExpression::compile(getExpCtx(), parse("{$eq: ['$s', 'ABC']}"));
+    ASSERT(compiled);
+    ASSERT_VALUE_EQ(compiled->evaluate(Document{{"s", "abc"_sd}}), Value(true));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -202,6 +202,17 @@ Pipeline::SourceContainer::iterator DocumentSource::optimizeAt(
     return doOptimizeAt(itr, container);
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSource::getNextBatch(vector<Document>* batch,
+                                                                         size_t maxBatchSize) {
+    invariant(maxBatchSize > 0);
+    auto next = getNext();
+    if (!next.isAdvanced()) {
+        return next.getStatus();
+    }
+    batch->push_back(next.releaseDocument());
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 void DocumentSource::serializeToArray(vector<Value>& array,
                                       boost::optional<ExplainOptions::Verbosity> explain) const {
     Value entry = serialize(explain);
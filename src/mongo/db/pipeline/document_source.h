@@ -433,6 +433,21 @@ public:
      */
     virtual GetNextResult getNext() = 0;
 
+    /**
+     * Batched counterpart of getNext(). Appends at most 'maxBatchSize' documents to 'batch' and
+     * returns kAdvanced if more results may follow. Otherwise returns the status which ended the
+     * batch, either kEOF or kPauseExecution; documents may have been appended in either case, and
+     * must be consumed before acting on the status.
+     *
+     * The default implementation produces a single result via getNext(), so that stages which
+     * hold references to their child's documents never see more than one of them at a time.
+     * Stages which can produce many results cheaply, or filter or transform them without
+     * per-document dispatch, should override this. Implementers must call
+     * pExpCtx->checkForInterrupt() at least once per batch.
+     */
+    virtual GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                                     size_t maxBatchSize);
+
     /**
      * Returns a struct containing information about any special constraints imposed on using this
      * stage. Input parameter Pipeline::SplitState is used by stages whose requirements change
@@ -675,6 +690,27 @@ protected:
      */
     virtual void doDispose() {}
 
+    /**
+     * Pulls results from 'pSource' in batches of up to 'maxBatchSize' documents, passing each one
+     * to 'consume' as an rvalue. Returns once the source reports something other than kAdvanced,
+     * with that status; every document produced before it has been consumed by then.
+     */
+    template <typename Consumer>
+    GetNextResult::ReturnStatus consumeSourceInBatches(size_t maxBatchSize, Consumer&& consume) {
+        std::vector<Document> batch;
+        batch.reserve(maxBatchSize);
+        while (true) {
+            batch.clear();
+            auto status = pSource->getNextBatch(&batch, maxBatchSize);
+            for (auto&& doc : batch) {
+                consume(std::move(doc));
+            }
+            if (status != GetNextResult::ReturnStatus::kAdvanced) {
+                return status;
+            }
+        }
+    }
+
     /*
       Most DocumentSources have an underlying source they get their data
       from.  This is a convenience for them.
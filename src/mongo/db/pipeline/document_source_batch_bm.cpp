@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/query_knobs.h"
+
+namespace mongo {
+namespace {
+
+// Number of documents in the scanned collection.
+const int kNumDocs = 10 * 1000 * 1000;
+
+/**
+ * Produces kNumDocs documents on demand, the way a collection scan feeding the pipeline would,
+ * without holding them all in memory. Document 'i' has an integral field 'a' in [0, 100), an
+ * integral field 'b' in [0, 1000) and a double field 'c'.
+ */
+class GeneratedCollection final : public DocumentSourceMock {
+public:
+    explicit GeneratedCollection(const boost::intrusive_ptr<ExpressionContext>& expCtx)
+        : DocumentSourceMock({}, expCtx) {}
+
+    GetNextResult getNext() final {
+        if (_nextId == kNumDocs) {
+            return GetNextResult::makeEOF();
+        }
+        return makeDocument(_nextId++);
+    }
+
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final {
+        if (_nextId == kNumDocs) {
+            return GetNextResult::ReturnStatus::kEOF;
+        }
+        for (size_t i = 0; i < maxBatchSize && _nextId < kNumDocs; i++) {
+            batch->push_back(makeDocument(_nextId++));
+        }
+        return GetNextResult::ReturnStatus::kAdvanced;
+    }
+
+private:
+    static Document makeDocument(int i) {
+        return Document{{"_id", i}, {"a", i % 100}, {"b", (i * 7) % 1000}, {"c", i * 0.5}};
+    }
+
+    int _nextId = 0;
+};
+
+/**
+ * Runs the pipeline given by 'stageSpecs' over the generated collection and consumes the output of
+ * its last stage, pulling the number of documents given by the argument at a time. This is also
+ * the batch size $group and $sort use to consume their input; a batch size of one pulls every
+ * document through getNext().
+ */
+void runPipeline(benchmark::State& state, const std::vector<const char*>& stageSpecs) {
+    const int savedBatchSize = internalDocumentSourceBatchSize.load();
+    internalDocumentSourceBatchSize.store(state.range(0));
+    const size_t batchSize = state.range(0);
+
+    std::vector<BSONObj> rawPipeline;
+    for (auto&& spec : stageSpecs) {
+        rawPipeline.push_back(fromjson(spec));
+    }
+
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    for (auto keepRunning : state) {
+        auto pipeline = uassertStatusOK(Pipeline::parse(rawPipeline, expCtx));
+        pipeline->optimizePipeline();
+        pipeline->addInitialSource(new GeneratedCollection(expCtx));
+
+        auto last = pipeline->getSources().back();
+        if (batchSize == 1) {
+            for (auto next = last->getNext(); next.isAdvanced(); next = last->getNext()) {
+                benchmark::DoNotOptimize(next.getDocument());
+            }
+        } else {
+            std::vector<Document> batch;
+            auto status = DocumentSource::GetNextResult::ReturnStatus::kAdvanced;
+            while (status == DocumentSource::GetNextResult::ReturnStatus::kAdvanced) {
+                batch.clear();
+                status = last->getNextBatch(&batch, batchSize);
+                benchmark::DoNotOptimize(batch.data());
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kNumDocs);
+    internalDocumentSourceBatchSize.store(savedBatchSize);
+}
+
+void BM_Scan(benchmark::State& state) {
+    runPipeline(state, {});
+}
+
+void BM_Match(benchmark::State& state) {
+    runPipeline(state, {"{$match: {a: {$lt: 10}}}"});
+}
+
+void BM_Project(benchmark::State& state) {
+    runPipeline(state, {"{$project: {a: 1, d: {$add: ['$a', '$b']}}}"});
+}
+
+void BM_Group(benchmark::State& state) {
+    runPipeline(state, {"{$group: {_id: '$b', total: {$sum: '$c'}}}"});
+}
+
+void BM_Sort(benchmark::State& state) {
+    runPipeline(state, {"{$sort: {b: 1}}", "{$limit: 100}"});
+}
+
+void BM_MatchProjectGroup(benchmark::State& state) {
+    runPipeline(state,
+              {"{$match: {a: {$lt: 50}}}",
+               "{$project: {b: 1, d: {$multiply: ['$a', '$c']}}}",
+               "{$group: {_id: '$b', total: {$sum: '$d'}}}"});
+}
+
+#define BENCHMARK_BATCHED(name) \
+    BENCHMARK(name)->ArgName("batchSize")->Arg(1)->Arg(128)->Unit(benchmark::kMillisecond)
+
+BENCHMARK_BATCHED(BM_Scan);
+BENCHMARK_BATCHED(BM_Match);
+BENCHMARK_BATCHED(BM_Project);
+BENCHMARK_BATCHED(BM_Group);
+BENCHMARK_BATCHED(BM_Sort);
+BENCHMARK_BATCHED(BM_MatchProjectGroup);
+
+}  // namespace
+}  // namespace mongo
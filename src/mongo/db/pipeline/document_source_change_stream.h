@@ -225,6 +225,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final {
+        // As with getNext(), this stage is never executed directly.
+        MONGO_UNREACHABLE;
+    }
+
     StageConstraints constraints(Pipeline::SplitState pipeState) const final;
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final;
@@ -30,6 +30,9 @@
 
 #include "mongo/db/pipeline/document_source_cursor.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/pipeline/document.h"
@@ -63,6 +66,25 @@ DocumentSource::GetNextResult DocumentSourceCursor::getNext() {
     return std::move(out);
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceCursor::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    if (_currentBatch.empty()) {
+        loadBatch();
+
+        if (_currentBatch.empty())
+            return GetNextResult::ReturnStatus::kEOF;
+    }
+
+    // Hand over what is already buffered rather than loading more, so that the collection lock is
+    // taken at the same points as when documents are pulled one at a time.
+    auto end = _currentBatch.begin() + std::min(maxBatchSize, _currentBatch.size());
+    std::move(_currentBatch.begin(), end, std::back_inserter(*batch));
+    _currentBatch.erase(_currentBatch.begin(), end);
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 void DocumentSourceCursor::loadBatch() {
     if (!_exec || _exec->isDisposed()) {
         // No more documents.
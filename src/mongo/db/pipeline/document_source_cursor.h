@@ -47,6 +47,8 @@ class DocumentSourceCursor final : public DocumentSource {
 public:
     // virtuals from DocumentSource
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final;
     const char* getSourceName() const final;
     BSONObjSet getOutputSorts() final {
         return _outputSorts;
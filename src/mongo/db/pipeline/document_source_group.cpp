@@ -28,6 +28,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
@@ -38,6 +40,7 @@
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/stdx/memory.h"
 
 namespace mongo {
@@ -51,6 +54,74 @@ REGISTER_DOCUMENT_SOURCE(group,
                          LiteParsedDocumentSourceDefault::parse,
                          DocumentSourceGroup::createFromBson);
 
+namespace {
+
+// Past this many levels of partitioning, a partition that does not fit in memory is re-aggregated
+// in memory anyway. Each level spreads its groups over all of the partitions of the next, so only
+// a partition holding very few, very large groups can get this deep.
+const int kMaxSpillPartitionLevel = 8;
+
+/**
+ * Returns the states of 'accumulators' in the form they are spilled to disk: nothing if there are
+ * no accumulators, a single Value if there is one, and an array of Values otherwise.
+ */
+Value getSpilledStates(const DocumentSourceGroup::Accumulators& accumulators) {
+    switch (accumulators.size()) {
+        case 0:  // no values, essentially a distinct
+            return Value();
+        case 1:  // just one value, use optimized serialization as single Value
+            return accumulators[0]->getValue(/*toBeMerged=*/true);
+        default: {  // multiple values, serialize as array-typed Value
+            vector<Value> states;
+            states.reserve(accumulators.size());
+            for (auto&& accumulator : accumulators) {
+                states.push_back(accumulator->getValue(/*toBeMerged=*/true));
+            }
+            return Value(std::move(states));
+        }
+    }
+}
+
+/**
+ * Merges states spilled by getSpilledStates() into 'accumulators'.
+ */
+void mergeSpilledStates(const Value& states,
+                        const DocumentSourceGroup::Accumulators& accumulators) {
+    switch (accumulators.size()) {
+        case 0:  // No accumulators so no Values.
+            break;
+        case 1:  // Single accumulators serialize as a single Value.
+            accumulators[0]->process(states, true);
+            break;
+        default: {  // Multiple accumulators serialize as an array of Values.
+            const vector<Value>& accumulatorStates = states.getArray();
+            for (size_t i = 0; i < accumulators.size(); i++) {
+                accumulators[i]->process(accumulatorStates[i], true);
+            }
+        }
+    }
+}
+
+/**
+ * Returns which of 'numPartitions' partitions a group whose _id hashes to 'idHash' is spilled to
+ * at partitioning level 'level'.
+ */
+size_t getSpillPartition(size_t idHash, int level, size_t numPartitions) {
+    // Mix the level into the hash so that the groups sharing a partition at one level are spread
+    // over all of the partitions at the next, rather than landing in the same one again. This is
+    // the finalizer of MurmurHash3, which also makes the partitions independent of the buckets the
+    // same groups land in when re-aggregated in a hash table.
+    uint64_t hash = idHash + static_cast<uint64_t>(level) * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash % numPartitions;
+}
+
+}  // namespace
+
 const char* DocumentSourceGroup::getSourceName() const {
     return "$group";
 }
@@ -70,7 +141,9 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNext() {
         accum->reset();  // Prep accumulators for a new group.
     }
 
-    if (_spilled) {
+    if (_spilled && _numSpillPartitions) {
+        return getNextFromPartitions();
+    } else if (_spilled) {
         return getNextSpilled();
     } else if (_streaming) {
         return getNextStreaming();
@@ -85,22 +158,10 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
         return GetNextResult::makeEOF();
 
     _currentId = _firstPartOfNextGroup.first;
-    const size_t numAccumulators = _accumulatedFields.size();
     while (pExpCtx->getValueComparator().evaluate(_currentId == _firstPartOfNextGroup.first)) {
         // Inside of this loop, _firstPartOfNextGroup is the current data being processed.
         // At loop exit, it is the first value to be processed in the next group.
-        switch (numAccumulators) {  // mirrors switch in spill()
-            case 1:                 // Single accumulators serialize as a single Value.
-                _currentAccumulators[0]->process(_firstPartOfNextGroup.second, true);
-            case 0:  // No accumulators so no Values.
-                break;
-            default: {  // Multiple accumulators serialize as an array of Values.
-                const vector<Value>& accumulatorStates = _firstPartOfNextGroup.second.getArray();
-                for (size_t i = 0; i < numAccumulators; i++) {
-                    _currentAccumulators[i]->process(accumulatorStates[i], true);
-                }
-            }
-        }
+        mergeSpilledStates(_firstPartOfNextGroup.second, _currentAccumulators);
 
         if (!_sorterIterator->more()) {
             dispose();
@@ -113,6 +174,26 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
     return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
 }
 
+DocumentSource::GetNextResult DocumentSourceGroup::getNextFromPartitions() {
+    // We aren't streaming, and we have spilled to disk by hash partitions. Each partition holds
+    // every state of the groups hashed to it, so a partition re-aggregated in memory holds the
+    // final value of its groups.
+    while (groupsIterator == _groups->end()) {
+        if (_spilledPartitions.empty()) {
+            dispose();
+            return GetNextResult::makeEOF();
+        }
+
+        auto partition = std::move(_spilledPartitions.back());
+        _spilledPartitions.pop_back();
+        reaggregatePartition(std::move(partition));
+    }
+
+    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    ++groupsIterator;
+    return std::move(out);
+}
+
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     // Not spilled, and not streaming.
     if (_groups->empty())
@@ -168,6 +249,8 @@ void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    _partitionWriters.clear();
+    _spilledPartitions.clear();
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -221,10 +304,18 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         insides["$doingMerge"] = Value(true);
     }
 
-    if (explain && findRelevantInputSort()) {
-        return Value(DOC("$streamingGroup" << insides.freeze()));
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats) {
+        insides["spillStats"] = Value(DOC("partitionsSpilled" << _spillStats.partitionsSpilled
+                                                              << "bytesSpilled"
+                                                              << _spillStats.bytesSpilled
+                                                              << "reaggregationPasses"
+                                                              << _spillStats.reaggregationPasses));
     }
-    return Value(DOC(getSourceName() << insides.freeze()));
+
+    MutableDocument out;
+    out[explain && findRelevantInputSort() ? "$streamingGroup" : getSourceName()] =
+        insides.freezeToValue();
+    return out.freezeToValue();
 }
 
 DocumentSource::GetDepsReturn DocumentSourceGroup::getDependencies(DepsTracker* deps) const {
@@ -266,6 +357,7 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
       _initialized(false),
       _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false),
+      _numSpillPartitions(std::max(internalDocumentSourceGroupSpillPartitions.load(), 0)),
       _allowDiskUse(pExpCtx->allowDiskUse && !pExpCtx->inMongos) {}
 
 void DocumentSourceGroup::addAccumulator(AccumulationStatement accumulationStatement) {
@@ -478,21 +570,22 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     }
 
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
-    GetNextResult input = pSource->getNext();
-    for (; input.isAdvanced(); input = pSource->getNext()) {
+    // Barring any pausing, this exhausts 'pSource' and populates '_groups'. The input is pulled in
+    // batches to avoid a virtual call per document through any stages which support them.
+    const size_t batchSize = std::max(1, internalDocumentSourceBatchSize.load());
+    auto status = consumeSourceInBatches(batchSize, [&](Document&& input) {
         if (_memoryUsageBytes > _maxMemoryUsageBytes) {
             uassert(16945,
                     "Exceeded memory limit for $group, but didn't allow external sort."
                     " Pass allowDiskUse:true to opt in.",
                     _allowDiskUse);
-            _sortedFiles.push_back(spill());
-            _memoryUsageBytes = 0;
+            spillGroups();
         }
 
-        // We release the result document here so that it does not outlive the end of this loop
-        // iteration. Not releasing could lead to an array copy when this group follows an unwind.
-        auto rootDocument = input.releaseDocument();
+        // 'input' still refers to the document in the batch. We move it out here so that it does
+        // not outlive this call. Keeping it in the batch could lead to an array copy when this
+        // group follows an unwind.
+        Document rootDocument = std::move(input);
         Value id = computeId(rootDocument);
 
         // Look for the _id value in the map. If it's not there, add a new entry with a blank
@@ -532,23 +625,34 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             if (!inserted &&                 // is a dup
                 !pExpCtx->inMongos &&        // can't spill to disk in mongos
                 !_allowDiskUse &&            // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {  // don't open too many FDs
+                _numSpills < 20) {           // don't open too many FDs
 
-                _sortedFiles.push_back(spill());
+                spillGroups();
             }
         }
-    }
+    });
 
-    switch (input.getStatus()) {
+    switch (status) {
         case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
             MONGO_UNREACHABLE;  // We consumed all advances above.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
-            return input;  // Propagate pause.
+            return GetNextResult::makePauseExecution();  // Propagate pause.
         }
         case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
             // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
+            if (_numSpills > 0 && _numSpillPartitions) {
+                _spilled = true;
+
+                // Every group has to be in its partition, since the partitions are re-aggregated
+                // one at a time.
+                if (!_groups->empty()) {
+                    spillToPartitions(&_partitionWriters, 0);
+                }
+                finishPartitions(&_partitionWriters, 0);
+
+                groupsIterator = _groups->end();
+            } else if (_numSpills > 0) {
                 _spilled = true;
                 if (!_groups->empty()) {
                     _sortedFiles.push_back(spill());
@@ -576,7 +680,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             // This must happen last so that, unless control gets here, we will re-enter
             // initialization after getting a GetNextResult::ResultState::kPauseExecution.
             _initialized = true;
-            return input;
+            return GetNextResult::makeEOF();
         }
     }
     MONGO_UNREACHABLE;
@@ -592,34 +696,107 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
 
     SortedFileWriter<Value, Value> writer(SortOptions().TempDir(pExpCtx->tempDir));
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
-            }
-            break;
+    for (size_t i = 0; i < ptrs.size(); i++) {
+        writer.addAlreadySorted(ptrs[i]->first, getSpilledStates(ptrs[i]->second));
+    }
 
-        case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
-            }
-            break;
+    _groups->clear();
 
-        default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
-                }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
-            }
-            break;
+    shared_ptr<Sorter<Value, Value>::Iterator> iterator(writer.done());
+    _spillStats.bytesSpilled += writer.bytesWritten();
+    return iterator;
+}
+
+void DocumentSourceGroup::spillGroups() {
+    if (_numSpillPartitions) {
+        spillToPartitions(&_partitionWriters, 0);
+    } else {
+        _sortedFiles.push_back(spill());
+    }
+    _memoryUsageBytes = 0;
+    ++_numSpills;
+}
+
+void DocumentSourceGroup::spillToPartitions(SpillPartitionWriters* writers, int level) {
+    writers->resize(_numSpillPartitions);
+
+    const auto& valueComparator = pExpCtx->getValueComparator();
+    for (auto&& group : *_groups) {
+        const size_t partition =
+            getSpillPartition(valueComparator.hash(group.first), level, writers->size());
+        auto& writer = (*writers)[partition];
+        if (!writer) {
+            writer = stdx::make_unique<SortedFileWriter<Value, Value>>(
+                SortOptions().TempDir(pExpCtx->tempDir));
+        }
+        writer->addAlreadySorted(group.first, getSpilledStates(group.second));
     }
 
     _groups->clear();
+    _memoryUsageBytes = 0;
+}
+
+void DocumentSourceGroup::finishPartitions(SpillPartitionWriters* writers, int level) {
+    for (auto&& writer : *writers) {
+        // Partitions no group was hashed to were never created.
+        if (!writer) {
+            continue;
+        }
+
+        _spilledPartitions.push_back({shared_ptr<Sorter<Value, Value>::Iterator>(writer->done()),
+                                      level});
+        ++_spillStats.partitionsSpilled;
+        _spillStats.bytesSpilled += writer->bytesWritten();
+    }
+    writers->clear();
+}
+
+void DocumentSourceGroup::reaggregatePartition(SpilledPartition partition) {
+    ++_spillStats.reaggregationPasses;
+
+    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _memoryUsageBytes = 0;
+
+    // Groups that still do not fit in memory are partitioned again, at the next level.
+    SpillPartitionWriters subPartitionWriters;
+    const bool canPartitionAgain = partition.level + 1 < kMaxSpillPartitionLevel;
+
+    while (partition.data->more()) {
+        // A single group that does not fit in memory has nowhere else to go.
+        if (_memoryUsageBytes > _maxMemoryUsageBytes && canPartitionAgain && _groups->size() > 1) {
+            spillToPartitions(&subPartitionWriters, partition.level + 1);
+        }
+
+        auto spilled = partition.data->next();
+
+        const size_t oldSize = _groups->size();
+        Accumulators& group = (*_groups)[spilled.first];
+        if (_groups->size() != oldSize) {
+            _memoryUsageBytes += spilled.first.getApproximateSize();
+            group.reserve(_accumulatedFields.size());
+            for (auto&& accumulatedField : _accumulatedFields) {
+                group.push_back(accumulatedField.makeAccumulator(pExpCtx));
+            }
+        } else {
+            for (auto&& accumulator : group) {
+                _memoryUsageBytes -= accumulator->memUsageForSorter();
+            }
+        }
+
+        mergeSpilledStates(spilled.second, group);
+        for (auto&& accumulator : group) {
+            _memoryUsageBytes += accumulator->memUsageForSorter();
+        }
+    }
+
+    if (!subPartitionWriters.empty()) {
+        if (!_groups->empty()) {
+            spillToPartitions(&subPartitionWriters, partition.level + 1);
+        }
+        finishPartitions(&subPartitionWriters, partition.level + 1);
+    }
 
-    return shared_ptr<Sorter<Value, Value>::Iterator>(writer.done());
+    groupsIterator = _groups->begin();
 }
 
 boost::optional<BSONObj> DocumentSourceGroup::findRelevantInputSort() const {
@@ -695,7 +872,9 @@ BSONObjSet DocumentSourceGroup::getOutputSorts() {
                        // False negatives are OK.
     }
 
-    if (!(_streaming || _spilled)) {
+    // Groups spilled to hash partitions come out in no particular order, unlike groups spilled
+    // sorted, which come out in _id order.
+    if (!(_streaming || _spilled) || (_spilled && _numSpillPartitions)) {
         return SimpleBSONObjComparator::kInstance.makeBSONObjSet();
     }
 
@@ -45,12 +45,31 @@ public:
 
     static const size_t kDefaultMaxMemoryUsageBytes = 100 * 1024 * 1024;
 
+    /**
+     * Describes what this stage has written to disk when its groups did not fit in memory.
+     */
+    struct SpillStats {
+        // Number of on-disk partitions written, including those written while re-aggregating a
+        // partition that did not fit in memory either.
+        long long partitionsSpilled = 0;
+
+        // Number of bytes written to disk.
+        long long bytesSpilled = 0;
+
+        // Number of partitions read back from disk and re-aggregated.
+        long long reaggregationPasses = 0;
+    };
+
     // Virtuals from DocumentSource.
     boost::intrusive_ptr<DocumentSource> optimize() final;
     GetDepsReturn getDependencies(DepsTracker* deps) const final;
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
     GetNextResult getNext() final;
     const char* getSourceName() const final;
+    /**
+     * Reports the _id order of the output of a $group that has spilled its groups sorted. A $group
+     * that has spilled to hash partitions, or has not spilled, returns its groups in no order.
+     */
     BSONObjSet getOutputSorts() final;
 
     /**
@@ -99,6 +118,10 @@ public:
         return _streaming;
     }
 
+    const SpillStats& getSpillStats() const {
+        return _spillStats;
+    }
+
     // Virtuals for SplittableDocumentSource.
     boost::intrusive_ptr<DocumentSource> getShardSource() final;
     std::list<boost::intrusive_ptr<DocumentSource>> getMergeSources() final;
@@ -144,6 +167,48 @@ private:
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
+    using SpillPartitionWriters = std::vector<std::unique_ptr<SortedFileWriter<Value, Value>>>;
+
+    /**
+     * A partition of the groups written to disk by spillToPartitions(), waiting to be read back
+     * and re-aggregated. 'level' is the number of times its groups have been partitioned.
+     */
+    struct SpilledPartition {
+        std::shared_ptr<Sorter<Value, Value>::Iterator> data;
+        int level;
+    };
+
+    /**
+     * Spills the groups map to disk, either with spill() or with spillToPartitions(), depending on
+     * the spill strategy this stage was created with.
+     */
+    void spillGroups();
+
+    /**
+     * Writes each group in the groups map to the partition in 'writers' chosen by hashing its _id,
+     * then clears the map. 'level' is the level of the partitions being written, so that groups
+     * that shared a partition at one level are spread out at the next.
+     */
+    void spillToPartitions(SpillPartitionWriters* writers, int level);
+
+    /**
+     * Finishes writing the partitions in 'writers', adding the non-empty ones to the partitions
+     * waiting to be re-aggregated.
+     */
+    void finishPartitions(SpillPartitionWriters* writers, int level);
+
+    /**
+     * Reads back 'partition' and re-aggregates it into the groups map. If it does not fit in
+     * memory, its groups are partitioned again and the groups map is left holding the last of
+     * them.
+     */
+    void reaggregatePartition(SpilledPartition partition);
+
+    /**
+     * Returns the groups from the partitions spilled to disk, one partition at a time.
+     */
+    GetNextResult getNextFromPartitions();
+
     Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
 
     /**
@@ -179,8 +244,20 @@ private:
 
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
+    size_t _numSpills = 0;
+
+    // The number of partitions groups are hashed into when spilling, or 0 if groups are instead
+    // spilled sorted and merged back together.
+    const size_t _numSpillPartitions;
+
+    // Only used when spilling to partitions. '_partitionWriters' holds the partitions being
+    // written while loading the input, and '_spilledPartitions' holds the partitions that have
+    // yet to be re-aggregated once the input is exhausted.
+    SpillPartitionWriters _partitionWriters;
+    std::vector<SpilledPartition> _spilledPartitions;
+    SpillStats _spillStats;
 
-    // Only used when '_spilled' is false.
+    // Only used when '_spilled' is false, or when the groups have been spilled to partitions.
     GroupsMap::iterator groupsIterator;
 
     // Only used when '_spilled' is true.
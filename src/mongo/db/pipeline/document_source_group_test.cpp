@@ -47,6 +47,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value_comparator.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/memory.h"
@@ -139,6 +140,165 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     ASSERT_EQ(idSet.count(2), 1UL);
 }
 
+/**
+ * Creates a $group on '$key' which pushes '$val' and counts its input, and which spills to
+ * 'numSpillPartitions' partitions, or sorts its spills if 0, when over 'maxMemoryUsageBytes'.
+ */
+intrusive_ptr<DocumentSourceGroup> createSpillingGroup(
+    const intrusive_ptr<ExpressionContextForTest>& expCtx,
+    int numSpillPartitions,
+    size_t maxMemoryUsageBytes) {
+    VariablesParseState vps = expCtx->variablesParseState;
+    AccumulationStatement pushStatement{"vals",
+                                        ExpressionFieldPath::parse(expCtx, "$val", vps),
+                                        AccumulationStatement::getFactory("$push")};
+    AccumulationStatement countStatement{"count",
+                                         ExpressionConstant::create(expCtx, Value(1)),
+                                         AccumulationStatement::getFactory("$sum")};
+    auto groupByExpression = ExpressionFieldPath::parse(expCtx, "$key", vps);
+
+    // The spill strategy is fixed when the stage is created.
+    const int oldNumSpillPartitions = internalDocumentSourceGroupSpillPartitions.load();
+    internalDocumentSourceGroupSpillPartitions.store(numSpillPartitions);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement, countStatement}, maxMemoryUsageBytes);
+    internalDocumentSourceGroupSpillPartitions.store(oldNumSpillPartitions);
+    return group;
+}
+
+/**
+ * Returns the output of 'group' over 'input', keyed by _id.
+ */
+map<int, Document> runGroup(const intrusive_ptr<DocumentSourceGroup>& group,
+                            const deque<DocumentSource::GetNextResult>& input) {
+    auto mock = DocumentSourceMock::create(input);
+    group->setSource(mock.get());
+
+    map<int, Document> results;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        ASSERT_TRUE(results.emplace(doc["_id"].coerceToInt(), doc).second);
+    }
+    return results;
+}
+
+TEST_F(DocumentSourceGroupTest, SpillingToPartitionsShouldMatchSortedSpilling) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 500; ++i) {
+        input.emplace_back(Document{{"key", i % 50}, {"val", i}});
+    }
+
+    auto sortedResults = runGroup(createSpillingGroup(expCtx, 0, maxMemoryUsageBytes), input);
+    auto group = createSpillingGroup(expCtx, 16, maxMemoryUsageBytes);
+    auto partitionedResults = runGroup(group, input);
+
+    ASSERT_EQ(partitionedResults.size(), 50UL);
+    ASSERT_EQ(partitionedResults.size(), sortedResults.size());
+    for (auto&& result : sortedResults) {
+        // Each $push must also see its values in the same order.
+        ASSERT_DOCUMENT_EQ(partitionedResults[result.first], result.second);
+        ASSERT_VALUE_EQ(partitionedResults[result.first]["count"], Value(10));
+    }
+
+    const auto& spillStats = group->getSpillStats();
+    ASSERT_GT(spillStats.partitionsSpilled, 0LL);
+    ASSERT_LTE(spillStats.partitionsSpilled, 16LL);
+    ASSERT_GT(spillStats.bytesSpilled, 0LL);
+    ASSERT_EQ(spillStats.reaggregationPasses, spillStats.partitionsSpilled);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldPartitionAgainWhenPartitionDoesNotFitInMemory) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    // Each of the 2 partitions holds about 5000 bytes of groups, so has to be partitioned again.
+    string largeStr(100, 'x');
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 100; ++i) {
+        input.emplace_back(Document{{"key", i}, {"val", largeStr}});
+    }
+
+    auto group = createSpillingGroup(expCtx, 2, maxMemoryUsageBytes);
+    auto results = runGroup(group, input);
+
+    ASSERT_EQ(results.size(), 100UL);
+    for (auto&& result : results) {
+        ASSERT_VALUE_EQ(result.second["vals"], Value(vector<Value>{Value(largeStr)}));
+        ASSERT_VALUE_EQ(result.second["count"], Value(1));
+    }
+
+    const auto& spillStats = group->getSpillStats();
+    ASSERT_GT(spillStats.partitionsSpilled, 2LL);
+    ASSERT_EQ(spillStats.reaggregationPasses, spillStats.partitionsSpilled);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReportSpillStatsInExecStatsExplain) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 100; ++i) {
+        input.emplace_back(Document{{"key", i}, {"val", i}});
+    }
+    auto group = createSpillingGroup(expCtx, 16, 1000);
+    runGroup(group, input);
+
+    // The spill statistics are part of the $group's own explain output.
+    const auto& spillStats = group->getSpillStats();
+    auto explained = group->serialize(ExplainOptions::Verbosity::kExecStats).getDocument();
+    ASSERT_EQ(explained.size(), 1UL);
+    auto explainedStats = explained["$group"]["spillStats"];
+    ASSERT_VALUE_EQ(explainedStats["partitionsSpilled"], Value(spillStats.partitionsSpilled));
+    ASSERT_VALUE_EQ(explainedStats["bytesSpilled"], Value(spillStats.bytesSpilled));
+    ASSERT_VALUE_EQ(explainedStats["reaggregationPasses"], Value(spillStats.reaggregationPasses));
+
+    ASSERT_TRUE(group->serialize(ExplainOptions::Verbosity::kQueryPlanner)
+                    .getDocument()["$group"]["spillStats"]
+                    .missing());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldOnlyReportSortedOutputWhenSpillingSorted) {
+    auto expCtx = getExpCtx();
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 100; ++i) {
+        input.emplace_back(Document{{"key", i}, {"val", i}});
+    }
+
+    // Groups spilled sorted are merged back together in _id order.
+    auto sortedGroup = createSpillingGroup(expCtx, 0, 1000);
+    auto mock = DocumentSourceMock::create(input);
+    sortedGroup->setSource(mock.get());
+    for (int i = 0; i < 100; ++i) {
+        auto next = sortedGroup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_VALUE_EQ(next.releaseDocument()["_id"], Value(i));
+    }
+    ASSERT_TRUE(sortedGroup->getNext().isEOF());
+    BSONObjSet sortedOutputSort = sortedGroup->getOutputSorts();
+    ASSERT_EQUALS(sortedOutputSort.size(), 1U);
+    ASSERT_EQUALS(sortedOutputSort.count(BSON("_id" << 1)), 1U);
+
+    // Groups spilled to partitions come out in no particular order.
+    auto partitionedGroup = createSpillingGroup(expCtx, 16, 1000);
+    ASSERT_EQ(runGroup(partitionedGroup, input).size(), 100UL);
+    ASSERT_TRUE(partitionedGroup->getOutputSorts().empty());
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldErrorIfNotAllowedToSpillToDiskAndResultSetIsTooLarge) {
     auto expCtx = getExpCtx();
     const size_t maxMemoryUsageBytes = 1000;
@@ -31,8 +31,12 @@
 #include "mongo/db/pipeline/document_source_lookup.h"
 
 #include "mongo/base/init.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/matcher/path_internal.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
@@ -210,13 +214,19 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
         return unwindResult();
     }
 
+    if (canLookUpInBatches()) {
+        return getNextFromBatch();
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
 
-    auto inputDoc = nextInput.releaseDocument();
+    return lookUpDocument(nextInput.releaseDocument());
+}
 
+Document DocumentSourceLookUp::lookUpDocument(Document inputDoc) {
     // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
@@ -235,12 +245,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
 
     while (auto result = pipeline->getNext()) {
         objsize += result->getApproximateSize();
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline "
-                              << getUserPipelineDefinition()
-                              << " exceeds maximum document size",
-                objsize <= BSONObjMaxInternalSize);
+        assertResultsSizeWithinLimit(objsize);
         results.emplace_back(std::move(*result));
     }
 
@@ -249,6 +254,245 @@ DocumentSource::GetNextResult DocumentSourceLookUp::getNext() {
     return output.freeze();
 }
 
+void DocumentSourceLookUp::assertResultsSizeWithinLimit(int resultsSize) {
+    uassert(4568,
+            str::stream() << "Total size of documents in " << _fromNs.coll()
+                          << " matching pipeline "
+                          << getUserPipelineDefinition()
+                          << " exceeds maximum document size",
+            resultsSize <= BSONObjMaxInternalSize);
+}
+
+bool DocumentSourceLookUp::canLookUpInBatches() const {
+    if (wasConstructedWithPipelineSyntax() || _unwindSrc) {
+        return false;
+    }
+
+    // A view on the foreign namespace puts its pipeline in front of our $match, and the matches
+    // would have to be computed after that pipeline rather than from the stored documents.
+    if (_resolvedPipeline.size() != 1) {
+        return false;
+    }
+
+    // The hash join finds candidate matches by the values at 'foreignField', expanding arrays.
+    // A query on a path with a numeric component can also match array elements by position,
+    // which that would miss.
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (isAllDigits(_foreignField->getFieldName(i))) {
+            return false;
+        }
+    }
+
+    return internalDocumentSourceLookupBatchSize.load() > 1;
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::getNextFromBatch() {
+    if (_lookedUpBatch.empty()) {
+        if (_inputAfterBatch) {
+            auto nextInput = std::move(*_inputAfterBatch);
+            _inputAfterBatch = boost::none;
+            return nextInput;
+        }
+
+        // The batch size is halved each time a batch does not fit in memory, so that a join with
+        // many matches per input document ends up with batches that fit, rather than falling back
+        // to one query per document for the rest of its input.
+        const size_t maxBatchSize = internalDocumentSourceLookupBatchSize.load();
+        if (_batchSize == 0 || _batchSize > maxBatchSize) {
+            _batchSize = maxBatchSize;
+        }
+
+        // The queries of a batch are combined into a single query. Stop adding documents before
+        // that query could approach the BSON size limit, as it would for documents with large or
+        // many-valued local fields; a document whose query alone is that large is looked up on
+        // its own, as it would have been without batching.
+        const int maxQueryBytes = BSONObjMaxUserSize / 2;
+        std::vector<Document> batch;
+        std::vector<BSONObj> queries;
+        int queryBytes = 0;
+        while (batch.size() < _batchSize) {
+            Document inputDoc;
+            if (_inputForNextBatch) {
+                inputDoc = std::move(*_inputForNextBatch);
+                _inputForNextBatch = boost::none;
+            } else {
+                auto nextInput = pSource->getNext();
+                if (!nextInput.isAdvanced()) {
+                    if (batch.empty()) {
+                        return nextInput;
+                    }
+                    _inputAfterBatch = std::move(nextInput);
+                    break;
+                }
+                inputDoc = nextInput.releaseDocument();
+            }
+
+            auto query = makeMatchStageFromInput(
+                             inputDoc, *_localField, _foreignField->fullPath(), BSONObj())
+                             .firstElement()
+                             .Obj()
+                             .getOwned();
+            if (!batch.empty() && queryBytes + query.objsize() > maxQueryBytes) {
+                _inputForNextBatch = std::move(inputDoc);
+                break;
+            }
+            queryBytes += query.objsize();
+            queries.push_back(std::move(query));
+            batch.push_back(std::move(inputDoc));
+        }
+
+        if (batch.size() > 1 && !hashJoinBatch(&batch, queries)) {
+            _batchSize = std::max<size_t>(_batchSize / 2, 1);
+        }
+
+        // If the batch could not be joined as a whole, fall back to one query per document.
+        if (_lookedUpBatch.empty()) {
+            for (auto&& inputDoc : batch) {
+                _lookedUpBatch.push_back(lookUpDocument(std::move(inputDoc)));
+            }
+        }
+    }
+
+    auto output = std::move(_lookedUpBatch.front());
+    _lookedUpBatch.pop_front();
+    return std::move(output);
+}
+
+bool DocumentSourceLookUp::hashJoinBatch(std::vector<Document>* batch,
+                                         const std::vector<BSONObj>& queries) {
+    const auto& foreignFieldName = _foreignField->fullPath();
+
+    // For each input document, parse the query a per-document lookup would run. These queries
+    // decide which of the candidate matches found through the hash table actually match.
+    std::vector<std::unique_ptr<MatchExpression>> matchers;
+    matchers.reserve(batch->size());
+
+    // Maps each local value to the input documents that have it. Null and missing values match
+    // foreign documents where the field is missing, and array values can match a whole array, so
+    // the documents with such values are checked against every foreign document instead.
+    auto inputsByValue =
+        _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    std::vector<size_t> inputsMatchingAnything;
+    std::vector<Value> localValues;
+
+    for (size_t i = 0; i < batch->size(); ++i) {
+        const Document& inputDoc = (*batch)[i];
+        matchers.push_back(
+            uassertStatusOK(MatchExpressionParser::parse(queries[i],
+                                                         _fromExpCtx,
+                                                         ExtensionsCallbackNoop(),
+                                                         Pipeline::kAllowedMatcherFeatures)));
+
+        bool matchesAnything = false;
+        auto addLocalValue = [&](const Value& value) {
+            if (value.nullish() || value.isArray()) {
+                matchesAnything = true;
+            } else {
+                auto& inputs = inputsByValue[value];
+                if (inputs.empty()) {
+                    localValues.push_back(value);
+                }
+                if (inputs.empty() || inputs.back() != i) {
+                    inputs.push_back(i);
+                }
+            }
+        };
+        bool foundLocalValue = false;
+        document_path_support::visitAllValuesAtPath(
+            inputDoc, *_localField, [&](const Value& value) {
+                foundLocalValue = true;
+                addLocalValue(value);
+            });
+        if (!foundLocalValue) {
+            addLocalValue(Value(BSONNULL));
+        }
+        if (matchesAnything) {
+            inputsMatchingAnything.push_back(i);
+        }
+    }
+
+    // Build a single query that matches everything any of the per-document queries would match.
+    // As in makeMatchStageFromInput(), regular expressions are compared with $eq so that they only
+    // match other regular expressions.
+    BSONObjBuilder match;
+    {
+        BSONObjBuilder query(match.subobjStart("$match"));
+        BSONArrayBuilder orPredicates(query.subarrayStart("$or"));
+        auto queriesMatchingAnything = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+        for (size_t i : inputsMatchingAnything) {
+            if (queriesMatchingAnything.insert(queries[i]).second) {
+                orPredicates.append(queries[i]);
+            }
+        }
+        BSONArrayBuilder inValues;
+        for (auto&& value : localValues) {
+            if (value.getType() == BSONType::RegEx) {
+                orPredicates.append(BSON(foreignFieldName << BSON("$eq" << value)));
+            } else {
+                inValues << value;
+            }
+        }
+        orPredicates.append(BSON(foreignFieldName << BSON("$in" << inValues.arr())));
+    }
+    _resolvedPipeline.back() = match.obj();
+
+    auto pipeline = buildPipeline(Document());
+
+    const long long maxMemoryBytes = internalDocumentSourceLookupBatchMaxMemoryBytes.load();
+    long long memoryBytes = 0;
+    std::vector<std::vector<Value>> results(batch->size());
+    std::vector<int> resultSizes(batch->size(), 0);
+
+    // The index of the last foreign document each input document was checked against, so that
+    // an input document with several values is only checked once per foreign document.
+    std::vector<size_t> lastChecked(batch->size(), std::numeric_limits<size_t>::max());
+
+    size_t foreignIdx = 0;
+    while (auto foreignDoc = pipeline->getNext()) {
+        const int foreignDocSize = foreignDoc->getApproximateSize();
+        memoryBytes += foreignDocSize;
+        if (memoryBytes > maxMemoryBytes) {
+            return false;
+        }
+
+        const BSONObj foreignObj = foreignDoc->toBson();
+        auto checkCandidate = [&](size_t i) {
+            if (lastChecked[i] == foreignIdx) {
+                return;
+            }
+            lastChecked[i] = foreignIdx;
+            if (!matchers[i]->matchesBSON(foreignObj)) {
+                return;
+            }
+
+            resultSizes[i] += foreignDocSize;
+            assertResultsSizeWithinLimit(resultSizes[i]);
+            results[i].emplace_back(*foreignDoc);
+        };
+
+        document_path_support::visitAllValuesAtPath(
+            *foreignDoc, *_foreignField, [&](const Value& value) {
+                auto it = inputsByValue.find(value);
+                if (it != inputsByValue.end()) {
+                    for (size_t i : it->second) {
+                        checkCandidate(i);
+                    }
+                }
+            });
+        for (size_t i : inputsMatchingAnything) {
+            checkCandidate(i);
+        }
+        ++foreignIdx;
+    }
+
+    for (size_t i = 0; i < batch->size(); ++i) {
+        MutableDocument output(std::move((*batch)[i]));
+        output.setNestedField(_as, Value(std::move(results[i])));
+        _lookedUpBatch.push_back(output.freeze());
+    }
+    return true;
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -433,6 +677,7 @@ void DocumentSourceLookUp::doDispose() {
         _pipeline->dispose(pExpCtx->opCtx);
         _pipeline.reset();
     }
+    _lookedUpBatch.clear();
 }
 
 BSONObj DocumentSourceLookUp::makeMatchStageFromInput(const Document& input,
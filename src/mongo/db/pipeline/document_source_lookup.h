@@ -29,6 +29,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -244,6 +245,36 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns true if this stage may look up the matches for several input documents with a
+     * single query against the foreign collection. This is only done for the localField/
+     * foreignField syntax against a collection, when no $unwind has been absorbed.
+     */
+    bool canLookUpInBatches() const;
+
+    /**
+     * Returns the next input document with its matches from the foreign collection, looking up
+     * the matches for up to 'internalDocumentSourceLookupBatchSize' input documents at a time.
+     * A batch also ends early once the queries of its documents total half of
+     * BSONObjMaxUserSize, so that their combined query stays within the BSON size limit.
+     */
+    GetNextResult getNextFromBatch();
+
+    /**
+     * Queries the foreign collection once for all of the documents in 'batch', and hash joins the
+     * results with 'batch'. 'queries' holds, for each input document, the query that a
+     * per-document lookup would have run. Each input document is checked against the result using
+     * that query, so the output is the same. Returns false, leaving 'batch' untouched, if the
+     * results would need more than 'internalDocumentSourceLookupBatchMaxMemoryBytes' of memory.
+     */
+    bool hashJoinBatch(std::vector<Document>* batch, const std::vector<BSONObj>& queries);
+
+    /**
+     * Runs the foreign query for the single document 'inputDoc' and returns it with the 'as' field
+     * set to the matches.
+     */
+    Document lookUpDocument(Document inputDoc);
+
     /**
      * Copies 'vars' and 'vps' to the Variables and VariablesParseState objects in 'expCtx'. These
      * copies provide access to 'let' defined variables in sub-pipeline execution.
@@ -275,6 +306,13 @@ private:
      */
     std::string getUserPipelineDefinition();
 
+    /**
+     * Throws if 'resultsSize', the total size of the foreign documents matched by one input
+     * document, is too large for them to be added to it. Used whether or not the input documents
+     * are looked up in batches, so both fail the same way.
+     */
+    void assertResultsSizeWithinLimit(int resultsSize);
+
     /**
      * Reinitialize the cache with a new max size. May only be called if this DSLookup was created
      * with pipeline syntax, the cache has not been frozen or abandoned, and no data has been added
@@ -332,6 +370,16 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // The following members are used to hold onto state across getNext() calls when looking up
+    // input documents in batches. '_lookedUpBatch' holds the joined documents that have not been
+    // returned yet, '_inputAfterBatch' holds the non-advanced result, such as a pause, that ended
+    // the batch, and '_inputForNextBatch' holds the input document that would have made the
+    // batch's query too large.
+    std::deque<Document> _lookedUpBatch;
+    boost::optional<GetNextResult> _inputAfterBatch;
+    boost::optional<Document> _inputForNextBatch;
+    size_t _batchSize = 0;
 };
 
 }  // namespace mongo
@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/pipeline/document_source_lookup.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs.h"
+
+namespace mongo {
+namespace {
+
+// Number of documents in the local and foreign collections.
+const int kNumLocalDocs = 4 * 1024;
+const int kNumForeignDocs = 16 * 1024;
+
+/**
+ * Serves every query against the foreign collection by filtering all of its documents, like a
+ * collection scan for a foreignField without an index.
+ */
+class ForeignCollectionScanInterface final : public StubMongoProcessInterface {
+public:
+    explicit ForeignCollectionScanInterface(std::deque<DocumentSource::GetNextResult> foreignDocs)
+        : _foreignDocs(std::move(foreignDocs)) {}
+
+    bool isSharded(OperationContext* opCtx, const NamespaceString& ns) final {
+        return false;
+    }
+
+    StatusWith<std::unique_ptr<Pipeline, PipelineDeleter>> makePipeline(
+        const std::vector<BSONObj>& rawPipeline,
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const MakePipelineOptions opts) final {
+        auto pipeline = uassertStatusOK(Pipeline::parse(rawPipeline, expCtx));
+        pipeline->optimizePipeline();
+        pipeline->addInitialSource(DocumentSourceMock::create(_foreignDocs));
+        return std::move(pipeline);
+    }
+
+private:
+    const std::deque<DocumentSource::GetNextResult> _foreignDocs;
+};
+
+/**
+ * Joins kNumLocalDocs documents to kNumForeignDocs documents on an integer field, with each local
+ * document matching four foreign documents, looking up the number of local documents given by
+ * the argument at a time. A batch size of one looks up each local document with its own query.
+ */
+void BM_LookUpLocalForeignField(benchmark::State& state) {
+    const int savedBatchSize = internalDocumentSourceLookupBatchSize.load();
+    internalDocumentSourceLookupBatchSize.store(state.range(0));
+
+    std::deque<DocumentSource::GetNextResult> localDocs;
+    for (int i = 0; i < kNumLocalDocs; i++) {
+        localDocs.emplace_back(Document{{"_id", i}, {"a", i}});
+    }
+    std::deque<DocumentSource::GetNextResult> foreignDocs;
+    for (int i = 0; i < kNumForeignDocs; i++) {
+        foreignDocs.emplace_back(Document{{"_id", i}, {"b", i % kNumLocalDocs}});
+    }
+
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+    expCtx->mongoProcessInterface =
+        std::make_shared<ForeignCollectionScanInterface>(std::move(foreignDocs));
+    const BSONObj spec =
+        BSON("$lookup" << BSON("from" << fromNs.coll() << "localField"
+                                      << "a"
+                                      << "foreignField"
+                                      << "b"
+                                      << "as"
+                                      << "matches"));
+
+    for (auto keepRunning : state) {
+        auto lookup = DocumentSourceLookUp::createFromBson(spec.firstElement(), expCtx);
+        auto localSource = DocumentSourceMock::create(localDocs);
+        lookup->setSource(localSource.get());
+        for (auto next = lookup->getNext(); next.isAdvanced(); next = lookup->getNext()) {
+            benchmark::DoNotOptimize(next.getDocument());
+        }
+        lookup->dispose();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kNumLocalDocs);
+    internalDocumentSourceLookupBatchSize.store(savedBatchSize);
+}
+
+BENCHMARK(BM_LookUpLocalForeignField)
+    ->ArgName("batchSize")
+    ->Arg(1)
+    ->Arg(64)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
@@ -502,6 +502,7 @@ public:
         const std::vector<BSONObj>& rawPipeline,
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const MakePipelineOptions opts) final {
+        ++_numPipelinesMade;
         auto pipeline = Pipeline::parse(rawPipeline, expCtx);
         if (!pipeline.isOK()) {
             return pipeline.getStatus();
@@ -532,9 +533,14 @@ public:
         return Status::OK();
     }
 
+    int numPipelinesMade() const {
+        return _numPipelinesMade;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
+    int _numPipelinesMade = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -641,6 +647,215 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     lookup->dispose();
 }
 
+/**
+ * Runs {$lookup: {from: "foreign", localField: "a", foreignField: "b", as: "matches"}} over
+ * 'localDocs' with 'foreignDocs' as the foreign collection. Returns the output, and sets
+ * 'numQueries' to the number of queries run against the foreign collection.
+ */
+vector<Document> runLookUp(const intrusive_ptr<ExpressionContextForTest>& expCtx,
+                           const vector<Document>& localDocs,
+                           const deque<DocumentSource::GetNextResult>& foreignDocs,
+                           int* numQueries) {
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+    auto mongoInterface = std::make_shared<MockMongoInterface>(foreignDocs);
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto lookup = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {from: 'foreign', localField: 'a', foreignField: 'b', as: 'matches'}}")
+            .firstElement(),
+        expCtx);
+    deque<DocumentSource::GetNextResult> localResults;
+    for (auto&& localDoc : localDocs) {
+        localResults.emplace_back(Document(localDoc));
+    }
+    auto mockLocalSource = DocumentSourceMock::create(std::move(localResults));
+    lookup->setSource(mockLocalSource.get());
+
+    vector<Document> output;
+    for (auto next = lookup->getNext(); next.isAdvanced(); next = lookup->getNext()) {
+        output.push_back(next.releaseDocument());
+    }
+    lookup->dispose();
+
+    *numQueries = mongoInterface->numPipelinesMade();
+    return output;
+}
+
+/**
+ * Restores the $lookup batching knobs when a test changing them ends.
+ */
+class LookUpBatchKnobsGuard {
+public:
+    ~LookUpBatchKnobsGuard() {
+        internalDocumentSourceLookupBatchSize.store(_batchSize);
+        internalDocumentSourceLookupBatchMaxMemoryBytes.store(_maxMemoryBytes);
+    }
+
+private:
+    const int _batchSize = internalDocumentSourceLookupBatchSize.load();
+    const int _maxMemoryBytes = internalDocumentSourceLookupBatchMaxMemoryBytes.load();
+};
+
+const vector<Document> kBatchLocalDocs = {
+    Document(fromjson("{_id: 0, a: 1}")),
+    Document(fromjson("{_id: 1, a: 1.0}")),
+    Document(fromjson("{_id: 2, a: [2, 3]}")),
+    Document(fromjson("{_id: 3}")),
+    Document(fromjson("{_id: 4, a: null}")),
+    Document(fromjson("{_id: 5, a: 'x'}")),
+    Document(fromjson("{_id: 6, a: [[2, 3]]}")),
+    Document(fromjson("{_id: 7, a: {c: 1}}")),
+    Document(fromjson("{_id: 8, a: /x/}")),
+    Document(fromjson("{_id: 9, a: [1, 1, 'x']}")),
+    Document(fromjson("{_id: 10, a: [{c: 1}, {c: 2}]}")),
+};
+
+const deque<DocumentSource::GetNextResult> kBatchForeignDocs = {
+    Document(fromjson("{_id: 100, b: 1}")),
+    Document(fromjson("{_id: 101, b: [1, 2]}")),
+    Document(fromjson("{_id: 102}")),
+    Document(fromjson("{_id: 103, b: null}")),
+    Document(fromjson("{_id: 104, b: [2, 3]}")),
+    Document(fromjson("{_id: 105, b: 'x'}")),
+    Document(fromjson("{_id: 106, b: /x/}")),
+    Document(fromjson("{_id: 107, b: {c: 1}}")),
+    Document(fromjson("{_id: 108, b: [{c: 1}, null]}")),
+    Document(fromjson("{_id: 109, b: {$numberLong: '3'}}")),
+    Document(fromjson("{_id: 110, b: [[2, 3], 4]}")),
+    Document(fromjson("{_id: 111, b: [[1]]}")),
+};
+
+TEST_F(DocumentSourceLookUpTest, BatchedLookUpMatchesPerDocumentLookUp) {
+    LookUpBatchKnobsGuard knobsGuard;
+
+    internalDocumentSourceLookupBatchSize.store(1);
+    int numPerDocumentQueries = 0;
+    auto expected =
+        runLookUp(getExpCtx(), kBatchLocalDocs, kBatchForeignDocs, &numPerDocumentQueries);
+    ASSERT_EQ(numPerDocumentQueries, static_cast<int>(kBatchLocalDocs.size()));
+
+    internalDocumentSourceLookupBatchSize.store(1000);
+    int numBatchedQueries = 0;
+    auto actual = runLookUp(getExpCtx(), kBatchLocalDocs, kBatchForeignDocs, &numBatchedQueries);
+    ASSERT_EQ(numBatchedQueries, 1);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST_F(DocumentSourceLookUpTest, BatchedLookUpUsesSmallerBatchesWhenOverMemoryLimit) {
+    LookUpBatchKnobsGuard knobsGuard;
+
+    internalDocumentSourceLookupBatchSize.store(1);
+    int numPerDocumentQueries = 0;
+    auto expected =
+        runLookUp(getExpCtx(), kBatchLocalDocs, kBatchForeignDocs, &numPerDocumentQueries);
+
+    // No batch fits, so each batch is tried as a whole and then looked up one document at a time,
+    // with the batch size halving until it reaches one.
+    internalDocumentSourceLookupBatchSize.store(4);
+    internalDocumentSourceLookupBatchMaxMemoryBytes.store(1);
+    int numQueries = 0;
+    auto actual = runLookUp(getExpCtx(), kBatchLocalDocs, kBatchForeignDocs, &numQueries);
+    ASSERT_EQ(numQueries, static_cast<int>(kBatchLocalDocs.size()) + 2);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST_F(DocumentSourceLookUpTest, BatchedLookUpLimitsQuerySizeWithLargeJoinKeys) {
+    LookUpBatchKnobsGuard knobsGuard;
+
+    // Each local document's query is a little over 3MB, so no more than two fit in the half of
+    // BSONObjMaxUserSize that a batch's query may use.
+    const std::string largeKey(3 * 1024 * 1024, 'x');
+    vector<Document> localDocs;
+    for (int i = 0; i < 6; ++i) {
+        localDocs.push_back(Document{{"_id", i}, {"a", largeKey + std::to_string(i)}});
+    }
+    const deque<DocumentSource::GetNextResult> foreignDocs = {
+        Document{{"_id", 100}, {"b", largeKey + "0"}},
+        Document{{"_id", 101}, {"b", largeKey + "3"}},
+        Document{{"_id", 102}, {"b", "x"_sd}},
+    };
+
+    internalDocumentSourceLookupBatchSize.store(1);
+    int numPerDocumentQueries = 0;
+    auto expected = runLookUp(getExpCtx(), localDocs, foreignDocs, &numPerDocumentQueries);
+    ASSERT_EQ(numPerDocumentQueries, static_cast<int>(localDocs.size()));
+
+    internalDocumentSourceLookupBatchSize.store(1000);
+    int numBatchedQueries = 0;
+    auto actual = runLookUp(getExpCtx(), localDocs, foreignDocs, &numBatchedQueries);
+    ASSERT_EQ(numBatchedQueries, 3);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST_F(DocumentSourceLookUpTest, BatchedLookUpFailsLikePerDocumentLookUpWhenResultsTooLarge) {
+    LookUpBatchKnobsGuard knobsGuard;
+
+    // Five 4MB foreign documents match the first local document, more than fit in one document.
+    const std::string largeValue(4 * 1024 * 1024, 'x');
+    const vector<Document> localDocs = {Document{{"_id", 0}, {"a", 1}},
+                                        Document{{"_id", 1}, {"a", 2}}};
+    deque<DocumentSource::GetNextResult> foreignDocs;
+    for (int i = 0; i < 5; ++i) {
+        foreignDocs.push_back(Document{{"_id", i}, {"b", 1}, {"big", largeValue}});
+    }
+
+    int numQueries = 0;
+    internalDocumentSourceLookupBatchSize.store(1);
+    ASSERT_THROWS_CODE(runLookUp(getExpCtx(), localDocs, foreignDocs, &numQueries),
+                       AssertionException,
+                       4568);
+
+    internalDocumentSourceLookupBatchSize.store(1000);
+    internalDocumentSourceLookupBatchMaxMemoryBytes.store(100 * 1024 * 1024);
+    ASSERT_THROWS_CODE(runLookUp(getExpCtx(), localDocs, foreignDocs, &numQueries),
+                       AssertionException,
+                       4568);
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotLookUpInBatchesOnNumericForeignFieldPath) {
+    LookUpBatchKnobsGuard knobsGuard;
+    internalDocumentSourceLookupBatchSize.store(1000);
+
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespace(fromNs, {fromNs, std::vector<BSONObj>{}});
+    auto mongoInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document(fromjson("{_id: 0, b: [5, 6]}"))});
+    expCtx->mongoProcessInterface = mongoInterface;
+
+    auto lookup = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {from: 'foreign', localField: 'a', foreignField: 'b.1', as: 'm'}}")
+            .firstElement(),
+        expCtx);
+    auto mockLocalSource = DocumentSourceMock::create(
+        {Document(fromjson("{a: 6}")), Document(fromjson("{a: 5}"))});
+    lookup->setSource(mockLocalSource.get());
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       Document(fromjson("{a: 6, m: [{_id: 0, b: [5, 6]}]}")));
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), Document(fromjson("{a: 5, m: []}")));
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_EQ(mongoInterface->numPipelinesMade(), 2);
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -30,6 +30,8 @@
 
 #include "mongo/db/pipeline/document_source_match.h"
 
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_array.h"
@@ -78,6 +80,16 @@ intrusive_ptr<DocumentSource> DocumentSourceMatch::optimize() {
     return this;
 }
 
+bool DocumentSourceMatch::matches(const Document& input) const {
+    // MatchExpression only takes BSON documents, so we have to make one. As an optimization, only
+    // serialize the fields we need to do the match.
+    BSONObj toMatch = _dependencies.needWholeDocument
+        ? input.toBson()
+        : document_path_support::documentToBsonWithPaths(input, _dependencies.fields);
+
+    return _expression->matchesBSON(toMatch);
+}
+
 DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
     pExpCtx->checkForInterrupt();
 
@@ -86,14 +98,7 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
 
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
-        // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
-        // only serialize the fields we need to do the match.
-        BSONObj toMatch = _dependencies.needWholeDocument
-            ? nextInput.getDocument().toBson()
-            : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
-                                                             _dependencies.fields);
-
-        if (_expression->matchesBSON(toMatch)) {
+        if (matches(nextInput.getDocument())) {
             return nextInput;
         }
 
@@ -108,6 +113,30 @@ DocumentSource::GetNextResult DocumentSourceMatch::getNext() {
     return nextInput;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceMatch::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    massert(50807,
+            "Should never call getNextBatch on a $match stage with $text clause",
+            !_isTextQuery);
+
+    // Filter each input batch in place, keeping the documents which were already in 'batch'. Keep
+    // pulling until something matches so that a selective predicate does not hand empty batches
+    // to the stage after us.
+    const auto firstNew = batch->size();
+    while (true) {
+        auto status = pSource->getNextBatch(batch, maxBatchSize);
+        batch->erase(std::remove_if(batch->begin() + firstNew,
+                                    batch->end(),
+                                    [this](const Document& doc) { return !matches(doc); }),
+                     batch->end());
+        if (status != GetNextResult::ReturnStatus::kAdvanced || batch->size() > firstNew) {
+            return status;
+        }
+    }
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceMatch::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -42,6 +42,8 @@ public:
     virtual ~DocumentSourceMatch() = default;
 
     GetNextResult getNext() override;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) override;
     boost::intrusive_ptr<DocumentSource> optimize() final;
     BSONObjSet getOutputSorts() final {
         return pSource ? pSource->getOutputSorts()
@@ -160,6 +162,11 @@ protected:
                         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
 private:
+    /**
+     * Returns whether 'input' satisfies this stage's predicate.
+     */
+    bool matches(const Document& input) const;
+
     std::unique_ptr<MatchExpression> _expression;
 
     BSONObj _predicate;
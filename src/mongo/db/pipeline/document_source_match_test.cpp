@@ -497,6 +497,49 @@ TEST_F(DocumentSourceMatchTest, ShouldPropagatePauses) {
     ASSERT_TRUE(match->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceMatchTest, ShouldFilterBatchesAndPropagatePauses) {
+    auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
+    auto mock = DocumentSourceMock::create({Document{{"a", 1}, {"b", 0}},
+                                            Document{{"a", 2}},
+                                            Document{{"a", 1}, {"b", 1}},
+                                            Document{{"a", 1}, {"b", 2}},
+                                            DocumentSource::GetNextResult::makePauseExecution(),
+                                            Document{{"a", 2}},
+                                            Document{{"a", 2}},
+                                            Document{{"a", 2}},
+                                            Document{{"a", 1}, {"b", 3}}});
+    match->setSource(mock.get());
+
+    std::vector<Document> batch;
+    ASSERT_TRUE(match->getNextBatch(&batch, 3) ==
+                DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 2UL);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 0}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"a", 1}, {"b", 1}}));
+
+    // Documents already in the batch should be kept.
+    ASSERT_TRUE(match->getNextBatch(&batch, 3) ==
+                DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 3UL);
+    ASSERT_DOCUMENT_EQ(batch[2], (Document{{"a", 1}, {"b", 2}}));
+
+    batch.clear();
+    ASSERT_TRUE(match->getNextBatch(&batch, 3) ==
+                DocumentSource::GetNextResult::ReturnStatus::kPauseExecution);
+    ASSERT_TRUE(batch.empty());
+
+    // A batch in which nothing matches should not be returned empty.
+    ASSERT_TRUE(match->getNextBatch(&batch, 2) ==
+                DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 3}}));
+
+    batch.clear();
+    ASSERT_TRUE(match->getNextBatch(&batch, 2) ==
+                DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_TRUE(batch.empty());
+}
+
 TEST_F(DocumentSourceMatchTest, ShouldCorrectlyJoinWithSubsequentMatch) {
     const auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
     const auto secondMatch = DocumentSourceMatch::create(BSON("b" << 1), getExpCtx());
@@ -104,4 +104,23 @@ DocumentSource::GetNextResult DocumentSourceMock::getNext() {
     queue.pop_front();
     return next;
 }
+
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceMock::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    invariant(!isDisposed);
+    invariant(!isDetachedFromOpCtx);
+
+    // Hand out consecutive documents, stopping short of a pause so that it is returned on its own.
+    size_t appended = 0;
+    while (appended < maxBatchSize && !queue.empty() && queue.front().isAdvanced()) {
+        batch->push_back(queue.front().releaseDocument());
+        queue.pop_front();
+        ++appended;
+    }
+
+    if (appended > 0) {
+        return GetNextResult::ReturnStatus::kAdvanced;
+    }
+    return getNext().getStatus();
+}
 }
@@ -0,0 +1,402 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_parallel_cursor.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/client.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_request.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+constexpr StringData DocumentSourceParallelCursor::kStageName;
+
+namespace {
+// How many partial results the threads may buffer before they wait for them to be consumed.
+const size_t kMaxBufferedResults = 1024;
+
+// Guards 'numThreadsReserved', the number of threads reserved by all parallel scans together.
+stdx::mutex threadsReservedMutex;
+size_t numThreadsReserved = 0;
+
+size_t getMaxTotalThreads() {
+    const int maxTotalThreads = internalQueryParallelCollectionScanMaxTotalThreads.load();
+    return maxTotalThreads > 0 ? static_cast<size_t>(maxTotalThreads)
+                               : std::max<size_t>(1, ProcessInfo::getNumAvailableCores());
+}
+}  // namespace
+
+DocumentSourceParallelCursor::ThreadReservation
+DocumentSourceParallelCursor::ThreadReservation::reserve(size_t numThreads) {
+    stdx::lock_guard<stdx::mutex> lk(threadsReservedMutex);
+    const size_t maxTotalThreads = getMaxTotalThreads();
+    // The limit may have been lowered below what is already reserved.
+    const size_t numFree =
+        maxTotalThreads > numThreadsReserved ? maxTotalThreads - numThreadsReserved : 0;
+    const size_t numReserved = std::min(numThreads, numFree);
+    if (numReserved < 2) {
+        return ThreadReservation();
+    }
+    numThreadsReserved += numReserved;
+    return ThreadReservation(numReserved);
+}
+
+DocumentSourceParallelCursor::ThreadReservation::ThreadReservation(ThreadReservation&& other)
+    : _numThreads(other._numThreads) {
+    other._numThreads = 0;
+}
+
+DocumentSourceParallelCursor::ThreadReservation&
+DocumentSourceParallelCursor::ThreadReservation::operator=(ThreadReservation&& other) {
+    if (this != &other) {
+        release();
+        _numThreads = other._numThreads;
+        other._numThreads = 0;
+    }
+    return *this;
+}
+
+DocumentSourceParallelCursor::ThreadReservation::~ThreadReservation() {
+    release();
+}
+
+void DocumentSourceParallelCursor::ThreadReservation::release() {
+    if (!_numThreads) {
+        return;
+    }
+    stdx::lock_guard<stdx::mutex> lk(threadsReservedMutex);
+    invariant(numThreadsReserved >= _numThreads);
+    numThreadsReserved -= _numThreads;
+    _numThreads = 0;
+}
+
+DocumentSourceParallelCursor::DocumentSourceParallelCursor(
+    const Collection* collection,
+    ThreadReservation threads,
+    std::vector<RecordId> splitPoints,
+    BSONObj query,
+    const DepsTracker& deps,
+    std::vector<BSONObj> rangePipeline,
+    const intrusive_ptr<ExpressionContext>& expCtx)
+    : DocumentSource(expCtx),
+      _nss(collection->ns()),
+      _uuid(collection->uuid()),
+      _splitPoints(std::move(splitPoints)),
+      _query(std::move(query)),
+      _projection(deps.toProjection()),
+      _dependencies(deps.toParsedDeps()),
+      _shouldProduceEmptyDocs(deps.hasNoRequirements()),
+      _rangePipeline(std::move(rangePipeline)),
+      _readTimestamp(expCtx->opCtx->recoveryUnit()->getPointInTimeReadTimestamp()),
+      _threads(std::move(threads)) {}
+
+DocumentSourceParallelCursor::~DocumentSourceParallelCursor() {
+    // The threads refer to this stage, so they must be gone before it is.
+    stopWorkers();
+}
+
+intrusive_ptr<DocumentSourceParallelCursor> DocumentSourceParallelCursor::create(
+    const Collection* collection,
+    ThreadReservation threads,
+    std::vector<RecordId> splitPoints,
+    BSONObj query,
+    const DepsTracker& deps,
+    std::vector<BSONObj> rangePipeline,
+    const intrusive_ptr<ExpressionContext>& expCtx) {
+    invariant(collection);
+    invariant(!splitPoints.empty());
+    invariant(splitPoints.size() < threads.numThreads());
+    return new DocumentSourceParallelCursor(collection,
+                                            std::move(threads),
+                                            std::move(splitPoints),
+                                            std::move(query),
+                                            deps,
+                                            std::move(rangePipeline),
+                                            expCtx);
+}
+
+const char* DocumentSourceParallelCursor::getSourceName() const {
+    return kStageName.rawData();
+}
+
+DocumentSource::GetNextResult DocumentSourceParallelCursor::getNext() {
+    pExpCtx->checkForInterrupt();
+
+    if (!_started) {
+        startWorkers();
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    waitForResults(lk);
+    if (_results.empty()) {
+        return GetNextResult::makeEOF();
+    }
+
+    Document next = std::move(_results.front());
+    _results.pop_front();
+    _consumedCV.notify_all();
+    return std::move(next);
+}
+
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceParallelCursor::getNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    if (!_started) {
+        startWorkers();
+    }
+
+    stdx::unique_lock<stdx::mutex> lk(_mutex);
+    waitForResults(lk);
+    if (_results.empty()) {
+        return GetNextResult::ReturnStatus::kEOF;
+    }
+
+    auto end = _results.begin() + std::min(maxBatchSize, _results.size());
+    std::move(_results.begin(), end, std::back_inserter(*batch));
+    _results.erase(_results.begin(), end);
+    _consumedCV.notify_all();
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
+void DocumentSourceParallelCursor::waitForResults(stdx::unique_lock<stdx::mutex>& lk) {
+    pExpCtx->opCtx->waitForConditionOrInterrupt(_producedCV, lk, [&] {
+        return !_results.empty() || _numRangesRunning == 0 || !_status.isOK();
+    });
+    uassertStatusOK(_status);
+}
+
+void DocumentSourceParallelCursor::startWorkers() {
+    invariant(!_started);
+    _started = true;
+    _deadline = pExpCtx->opCtx->getDeadline();
+
+    const size_t numRanges = _splitPoints.size() + 1;
+
+    ThreadPool::Options options;
+    options.poolName = "ParallelCollectionScan";
+    options.threadNamePrefix = "parallelScan-";
+    options.minThreads = 0;
+    options.maxThreads = numRanges;
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName);
+    };
+    _pool = stdx::make_unique<ThreadPool>(options);
+    _pool->startup();
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _numRangesRunning = numRanges;
+    }
+    for (size_t i = 0; i < numRanges; ++i) {
+        Status status = _pool->schedule([this, i] { scanRange(i); });
+        if (!status.isOK()) {
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _numRangesRunning -= numRanges - i;
+            uassertStatusOK(status);
+        }
+    }
+}
+
+void DocumentSourceParallelCursor::stopWorkers() {
+    if (!_pool) {
+        _threads = ThreadReservation();
+        return;
+    }
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_mutex);
+        _stopping = true;
+        for (auto&& opCtx : _workerOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(opCtx);
+        }
+        _consumedCV.notify_all();
+    }
+
+    _pool->shutdown();
+    _pool->join();
+    _pool.reset();
+    _threads = ThreadReservation();
+    _results.clear();
+}
+
+void DocumentSourceParallelCursor::doDispose() {
+    stopWorkers();
+}
+
+void DocumentSourceParallelCursor::scanRange(size_t rangeIndex) {
+    auto opCtx = cc().makeOperationContext();
+
+    Status status = Status::OK();
+    try {
+        {
+            // Register the operation first, so that stopWorkers() can interrupt it.
+            stdx::lock_guard<stdx::mutex> lk(_mutex);
+            _workerOpCtxs.insert(opCtx.get());
+            uassert(ErrorCodes::Interrupted, "parallel collection scan was stopped", !_stopping);
+        }
+        runRangePipeline(opCtx.get(), rangeIndex);
+    } catch (const DBException& ex) {
+        status = ex.toStatus();
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _workerOpCtxs.erase(opCtx.get());
+    // Errors caused by stopping the scan are of no interest to anyone.
+    if (!status.isOK() && _status.isOK() && !_stopping) {
+        _status = status;
+    }
+    --_numRangesRunning;
+    _producedCV.notify_all();
+}
+
+void DocumentSourceParallelCursor::runRangePipeline(OperationContext* opCtx, size_t rangeIndex) {
+    if (_deadline < Date_t::max()) {
+        opCtx->setDeadlineByDate(_deadline);
+    }
+    if (_readTimestamp) {
+        uassertStatusOK(opCtx->recoveryUnit()->setPointInTimeReadTimestamp(*_readTimestamp));
+    }
+
+    // The stages of this range produce partial results, like those of a shard in a cluster.
+    auto expCtx = pExpCtx->copyWith(_nss, _uuid);
+    expCtx->opCtx = opCtx;
+    expCtx->needsMerge = true;
+
+    auto pipeline = uassertStatusOK(Pipeline::parse(_rangePipeline, expCtx));
+    intrusive_ptr<DocumentSourceCursor> cursor;
+    {
+        AutoGetCollectionForRead autoColl(opCtx, _nss);
+        Collection* collection = autoColl.getCollection();
+        uassert(ErrorCodes::QueryPlanKilled,
+                str::stream() << "collection " << _nss.ns()
+                              << " was dropped or renamed during a parallel scan",
+                collection && collection->uuid() == _uuid);
+
+        auto qr = stdx::make_unique<QueryRequest>(_nss);
+        qr->setFilter(_query);
+        qr->setCollation(expCtx->getCollator() ? expCtx->getCollator()->getSpec().toBSON()
+                                               : expCtx->collation);
+        const ExtensionsCallbackReal extensionsCallback(opCtx, &_nss);
+        auto cq = uassertStatusOK(CanonicalQuery::canonicalize(
+            opCtx, std::move(qr), expCtx, extensionsCallback, Pipeline::kAllowedMatcherFeatures));
+
+        CollectionScanParams params;
+        params.collection = collection;
+        params.direction = CollectionScanParams::FORWARD;
+        if (rangeIndex > 0) {
+            params.resumeAfterRecordId = _splitPoints[rangeIndex - 1];
+        }
+        if (rangeIndex < _splitPoints.size()) {
+            params.maxRecord = _splitPoints[rangeIndex];
+        }
+
+        auto ws = stdx::make_unique<WorkingSet>();
+        auto root = stdx::make_unique<CollectionScan>(opCtx, params, ws.get(), cq->root());
+        auto exec = uassertStatusOK(PlanExecutor::make(opCtx,
+                                                       std::move(ws),
+                                                       std::move(root),
+                                                       std::move(cq),
+                                                       collection,
+                                                       PlanExecutor::YIELD_AUTO));
+
+        // DocumentSourceCursor expects a yielding PlanExecutor that has had its state saved.
+        exec->saveState();
+        cursor = DocumentSourceCursor::create(collection, std::move(exec), expCtx);
+    }
+
+    cursor->setQuery(_query);
+    if (_shouldProduceEmptyDocs) {
+        cursor->shouldProduceEmptyDocs();
+    }
+    cursor->setProjection(_projection, _dependencies);
+    pipeline->addInitialSource(cursor);
+
+    while (auto next = pipeline->getNext()) {
+        stdx::unique_lock<stdx::mutex> lk(_mutex);
+        opCtx->waitForConditionOrInterrupt(
+            _consumedCV, lk, [&] { return _results.size() < kMaxBufferedResults || _stopping; });
+        uassert(ErrorCodes::Interrupted, "parallel collection scan was stopped", !_stopping);
+        _results.push_back(std::move(*next));
+        _producedCV.notify_all();
+    }
+
+    const auto& stats = cursor->getPlanSummaryStats();
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _planSummaryStats.nReturned += stats.nReturned;
+    _planSummaryStats.totalKeysExamined += stats.totalKeysExamined;
+    _planSummaryStats.totalDocsExamined += stats.totalDocsExamined;
+    _planSummaryStats.executionTimeMillis =
+        std::max(_planSummaryStats.executionTimeMillis, stats.executionTimeMillis);
+}
+
+std::string DocumentSourceParallelCursor::getPlanSummaryStr() const {
+    return CollectionScan::kStageType;
+}
+
+PlanSummaryStats DocumentSourceParallelCursor::getPlanSummaryStats() const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    return _planSummaryStats;
+}
+
+Value DocumentSourceParallelCursor::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    // We never parse a DocumentSourceParallelCursor, so we only serialize for explain.
+    if (!explain) {
+        return Value();
+    }
+
+    std::vector<Value> rangePipeline(_rangePipeline.begin(), _rangePipeline.end());
+    return Value(DOC(getSourceName() << DOC("query" << _query << "fields" << _projection
+                                                    << "numRanges"
+                                                    << static_cast<long long>(
+                                                           _splitPoints.size() + 1)
+                                                    << "pipeline"
+                                                    << rangePipeline)));
+}
+
+}  // namespace mongo
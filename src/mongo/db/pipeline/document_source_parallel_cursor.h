@@ -0,0 +1,222 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <set>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/dependencies.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/record_id.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class Collection;
+
+/**
+ * Scans a collection on several threads at once and feeds each thread's share of the records
+ * through its own copy of the leading stages of a pipeline, up to and including a $group which
+ * produces partial results. This stage returns the partial results of every thread, in no
+ * particular order, to the stages which merge them.
+ *
+ * The collection is split into ranges of RecordIds, which are scanned by one thread each. The
+ * threads of all parallel scans together are bounded by
+ * 'internalQueryParallelCollectionScanMaxTotalThreads'.
+ */
+class DocumentSourceParallelCursor final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$parallelCursor"_sd;
+
+    /**
+     * A share of the threads which all parallel collection scans may use together. The threads are
+     * given back when the reservation is destroyed.
+     */
+    class ThreadReservation {
+    public:
+        /**
+         * Reserves up to 'numThreads' threads, or none if fewer than two are free, since a scan on
+         * a single thread is better run by the thread running the aggregate.
+         */
+        static ThreadReservation reserve(size_t numThreads);
+
+        ThreadReservation() = default;
+        ThreadReservation(ThreadReservation&& other);
+        ThreadReservation& operator=(ThreadReservation&& other);
+        ~ThreadReservation();
+
+        size_t numThreads() const {
+            return _numThreads;
+        }
+
+    private:
+        explicit ThreadReservation(size_t numThreads) : _numThreads(numThreads) {}
+
+        void release();
+
+        size_t _numThreads = 0;
+    };
+
+    /**
+     * Creates a stage which scans 'collection' in the ranges between 'splitPoints', as described
+     * by RecordStore::getRangeSplitPoints(), on the threads of 'threads'. There may be no more
+     * ranges than reserved threads. The records of each range which match 'query' are passed
+     * through the stages described by 'rangePipeline', which only needs the fields in 'deps'.
+     * 'rangePipeline' must end with a $group, whose partial results this stage returns.
+     *
+     * Must be called while holding the collection lock.
+     */
+    static boost::intrusive_ptr<DocumentSourceParallelCursor> create(
+        const Collection* collection,
+        ThreadReservation threads,
+        std::vector<RecordId> splitPoints,
+        BSONObj query,
+        const DepsTracker& deps,
+        std::vector<BSONObj> rangePipeline,
+        const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    // virtuals from DocumentSource
+    GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final;
+    const char* getSourceName() const final;
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kStreaming,
+                                     PositionRequirement::kFirst,
+                                     HostTypeRequirement::kAnyShard,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kNotAllowed);
+
+        constraints.requiresInputDocSource = false;
+        return constraints;
+    }
+
+    std::string getPlanSummaryStr() const;
+
+    /**
+     * Returns the sum of the plan summary statistics of the ranges scanned so far.
+     */
+    PlanSummaryStats getPlanSummaryStats() const;
+
+protected:
+    /**
+     * Interrupts the threads scanning the collection and waits for them to finish.
+     */
+    void doDispose() final;
+
+private:
+    DocumentSourceParallelCursor(const Collection* collection,
+                                 ThreadReservation threads,
+                                 std::vector<RecordId> splitPoints,
+                                 BSONObj query,
+                                 const DepsTracker& deps,
+                                 std::vector<BSONObj> rangePipeline,
+                                 const boost::intrusive_ptr<ExpressionContext>& expCtx);
+    ~DocumentSourceParallelCursor();
+
+    /**
+     * Starts one thread per range. Called by the first call to getNext().
+     */
+    void startWorkers();
+
+    /**
+     * Interrupts the threads which are still scanning, joins them and gives back their
+     * reservation.
+     */
+    void stopWorkers();
+
+    /**
+     * Waits until a thread has produced a result, or until all of them have finished. Throws the
+     * error of any thread which failed.
+     */
+    void waitForResults(stdx::unique_lock<stdx::mutex>& lk);
+
+    /**
+     * Runs on a thread of '_pool'. Scans the range at 'rangeIndex' with a new OperationContext,
+     * and records any error it fails with in '_status'.
+     */
+    void scanRange(size_t rangeIndex);
+
+    /**
+     * Scans the range at 'rangeIndex' on behalf of 'opCtx', through a copy of '_rangePipeline'.
+     */
+    void runRangePipeline(OperationContext* opCtx, size_t rangeIndex);
+
+    const NamespaceString _nss;
+    const boost::optional<UUID> _uuid;
+    const std::vector<RecordId> _splitPoints;
+
+    // BSONObj members must outlive _dependencies.
+    const BSONObj _query;
+    const BSONObj _projection;
+    const boost::optional<ParsedDeps> _dependencies;
+    const bool _shouldProduceEmptyDocs;
+    const std::vector<BSONObj> _rangePipeline;
+
+    // The snapshot the caller reads from, if it reads at a timestamp. Every range is then scanned
+    // at this timestamp as well.
+    const boost::optional<Timestamp> _readTimestamp;
+
+    // The caller's deadline, which every thread inherits.
+    Date_t _deadline = Date_t::max();
+
+    bool _started = false;
+    ThreadReservation _threads;
+    std::unique_ptr<ThreadPool> _pool;
+
+    // Guards the members below, which are shared with the threads scanning the collection.
+    mutable stdx::mutex _mutex;
+
+    // Signaled when a thread produces a result or finishes.
+    stdx::condition_variable _producedCV;
+
+    // Signaled when results are consumed, or when the threads must stop.
+    stdx::condition_variable _consumedCV;
+
+    std::deque<Document> _results;
+    size_t _numRangesRunning = 0;
+    Status _status = Status::OK();
+    bool _stopping = false;
+    std::set<OperationContext*> _workerOpCtxs;
+    PlanSummaryStats _planSummaryStats;
+};
+
+}  // namespace mongo
@@ -160,6 +160,35 @@ TEST_F(ProjectStageTest, ShouldPropagatePauses) {
     ASSERT(project->getNext().isEOF());
 }
 
+TEST_F(ProjectStageTest, ShouldTransformOnlyNewDocumentsInBatch) {
+    auto project = DocumentSourceProject::create(BSON("a" << true << "_id" << false), getExpCtx());
+    auto source = DocumentSourceMock::create({Document{{"a", 1}, {"b", 1}},
+                                              Document{{"a", 2}, {"b", 2}},
+                                              DocumentSource::GetNextResult::makePauseExecution(),
+                                              Document{{"a", 3}, {"b", 3}}});
+    project->setSource(source.get());
+
+    vector<Document> batch{Document{{"b", 0}}};
+    ASSERT_TRUE(project->getNextBatch(&batch, 10) ==
+                DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 3UL);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"b", 0}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"a", 1}}));
+    ASSERT_DOCUMENT_EQ(batch[2], (Document{{"a", 2}}));
+
+    batch.clear();
+    ASSERT_TRUE(project->getNextBatch(&batch, 10) ==
+                DocumentSource::GetNextResult::ReturnStatus::kPauseExecution);
+    ASSERT_TRUE(batch.empty());
+    ASSERT_TRUE(project->getNextBatch(&batch, 10) ==
+                DocumentSource::GetNextResult::ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 3}}));
+    ASSERT_TRUE(project->getNextBatch(&batch, 10) ==
+                DocumentSource::GetNextResult::ReturnStatus::kEOF);
+    ASSERT_EQ(batch.size(), 1UL);
+}
+
 TEST_F(ProjectStageTest, InclusionShouldAddDependenciesOfIncludedAndComputedFields) {
     auto project = DocumentSourceProject::create(
         fromjson("{a: true, x: '$b', y: {$and: ['$c','$d']}, z: {$meta: 'textScore'}}"),
@@ -69,6 +69,20 @@ DocumentSource::GetNextResult DocumentSourceSingleDocumentTransformation::getNex
     return _parsedTransform->applyTransformation(input.releaseDocument());
 }
 
+DocumentSource::GetNextResult::ReturnStatus
+DocumentSourceSingleDocumentTransformation::getNextBatch(std::vector<Document>* batch,
+                                                         size_t maxBatchSize) {
+    pExpCtx->checkForInterrupt();
+
+    // Transform the documents our child appends in place, leaving any earlier ones untouched.
+    const auto firstNew = batch->size();
+    auto status = pSource->getNextBatch(batch, maxBatchSize);
+    for (auto it = batch->begin() + firstNew; it != batch->end(); ++it) {
+        *it = _parsedTransform->applyTransformation(*it);
+    }
+    return status;
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceSingleDocumentTransformation::optimize() {
     _parsedTransform->optimize();
     return this;
@@ -99,6 +99,8 @@ public:
     // virtuals from DocumentSource
     const char* getSourceName() const final;
     GetNextResult getNext() final;
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch,
+                                             size_t maxBatchSize) final;
     boost::intrusive_ptr<DocumentSource> optimize() final;
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
     DocumentSource::GetDepsReturn getDependencies(DepsTracker* deps) const final;
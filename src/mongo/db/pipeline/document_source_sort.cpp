@@ -30,6 +30,8 @@
 
 #include "mongo/db/pipeline/document_source_sort.h"
 
+#include <algorithm>
+
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/document.h"
 #include "mongo/db/pipeline/document_path_support.h"
@@ -40,6 +42,7 @@
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/value.h"
 #include "mongo/db/query/collation/collation_index_key.h"
+#include "mongo/db/query/query_knobs.h"
 
 namespace mongo {
 
@@ -327,19 +330,20 @@ SortOptions DocumentSourceSort::makeSortOptions() const {
         opts.extSortAllowed = true;
         opts.tempDir = pExpCtx->tempDir;
     }
+    opts.numSortThreads = std::max(1, internalDocumentSourceSortNumThreads.load());
 
     return opts;
 }
 
 DocumentSource::GetNextResult DocumentSourceSort::populate() {
-    auto nextInput = pSource->getNext();
-    for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
-        loadDocument(nextInput.releaseDocument());
-    }
-    if (nextInput.isEOF()) {
-        loadingDone();
+    const size_t batchSize = std::max(1, internalDocumentSourceBatchSize.load());
+    auto status =
+        consumeSourceInBatches(batchSize, [this](Document&& doc) { loadDocument(std::move(doc)); });
+    if (status == GetNextResult::ReturnStatus::kPauseExecution) {
+        return GetNextResult::makePauseExecution();
     }
-    return nextInput;
+    loadingDone();
+    return GetNextResult::makeEOF();
 }
 
 void DocumentSourceSort::loadDocument(Document&& doc) {
@@ -264,75 +264,95 @@ const char* ExpressionAbs::getOpName() const {
 /* ------------------------- ExpressionAdd ----------------------------- */
 
 Value ExpressionAdd::evaluate(const Document& root) const {
-    // We'll try to return the narrowest possible result value while avoiding overflow, loss
-    // of precision due to intermediate rounding or implicit use of decimal types. To do that,
-    // compute a compensated sum for non-decimal values and a separate decimal sum for decimal
-    // values, and track the current narrowest type.
-    DoubleDoubleSummation nonDecimalTotal;
-    Decimal128 decimalTotal;
-    BSONType totalType = NumberInt;
-    bool haveDate = false;
-
-    const size_t n = vpOperand.size();
-    for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
+    Sum sum;
+    for (auto&& operand : vpOperand) {
+        if (!sum.add(operand->evaluate(root))) {
+            return Value(BSONNULL);
+        }
+    }
+    return sum.getValue();
+}
 
-        switch (val.getType()) {
-            case NumberDecimal:
-                decimalTotal = decimalTotal.add(val.getDecimal());
-                totalType = NumberDecimal;
-                break;
-            case NumberDouble:
-                nonDecimalTotal.addDouble(val.getDouble());
-                if (totalType != NumberDecimal)
-                    totalType = NumberDouble;
-                break;
-            case NumberLong:
-                nonDecimalTotal.addLong(val.getLong());
-                if (totalType == NumberInt)
-                    totalType = NumberLong;
-                break;
-            case NumberInt:
-                nonDecimalTotal.addDouble(val.getInt());
-                break;
-            case Date:
-                uassert(16612, "only one date allowed in an $add expression", !haveDate);
-                haveDate = true;
-                nonDecimalTotal.addLong(val.getDate().toMillisSinceEpoch());
-                break;
-            default:
-                uassert(16554,
-                        str::stream() << "$add only supports numeric or date types, not "
-                                      << typeName(val.getType()),
-                        val.nullish());
-                return Value(BSONNULL);
+bool ExpressionAdd::Sum::add(const Value& val) {
+    const BSONType type = val.getType();
+    if (_integral) {
+        long long newTotal;
+        if ((type == NumberInt || type == NumberLong) &&
+            !mongoSignedAddOverflow64(_integralTotal, val.coerceToLong(), &newTotal)) {
+            _integralTotal = newTotal;
+            if (type == NumberLong)
+                _totalType = NumberLong;
+            return true;
         }
+
+        // Carry on from the exact total of the operands so far with the compensated sum.
+        _nonDecimalTotal.addLong(_integralTotal);
+        _integral = false;
     }
 
-    if (haveDate) {
+    switch (type) {
+        case NumberDecimal:
+            _decimalTotal = _decimalTotal.add(val.getDecimal());
+            _totalType = NumberDecimal;
+            break;
+        case NumberDouble:
+            _nonDecimalTotal.addDouble(val.getDouble());
+            if (_totalType != NumberDecimal)
+                _totalType = NumberDouble;
+            break;
+        case NumberLong:
+            _nonDecimalTotal.addLong(val.getLong());
+            if (_totalType == NumberInt)
+                _totalType = NumberLong;
+            break;
+        case NumberInt:
+            _nonDecimalTotal.addDouble(val.getInt());
+            break;
+        case Date:
+            uassert(16612, "only one date allowed in an $add expression", !_haveDate);
+            _haveDate = true;
+            _nonDecimalTotal.addLong(val.getDate().toMillisSinceEpoch());
+            break;
+        default:
+            uassert(16554,
+                    str::stream() << "$add only supports numeric or date types, not "
+                                  << typeName(type),
+                    val.nullish());
+            return false;
+    }
+    return true;
+}
+
+Value ExpressionAdd::Sum::getValue() const {
+    if (_integral) {
+        return _totalType == NumberLong ? Value(_integralTotal)
+                                        : Value::createIntOrLong(_integralTotal);
+    }
+
+    if (_haveDate) {
         int64_t longTotal;
-        if (totalType == NumberDecimal) {
-            longTotal = decimalTotal.add(nonDecimalTotal.getDecimal()).toLong();
+        if (_totalType == NumberDecimal) {
+            longTotal = _decimalTotal.add(_nonDecimalTotal.getDecimal()).toLong();
         } else {
-            uassert(ErrorCodes::Overflow, "date overflow in $add", nonDecimalTotal.fitsLong());
-            longTotal = nonDecimalTotal.getLong();
+            uassert(ErrorCodes::Overflow, "date overflow in $add", _nonDecimalTotal.fitsLong());
+            longTotal = _nonDecimalTotal.getLong();
         }
         return Value(Date_t::fromMillisSinceEpoch(longTotal));
     }
-    switch (totalType) {
+    switch (_totalType) {
         case NumberDecimal:
-            return Value(decimalTotal.add(nonDecimalTotal.getDecimal()));
+            return Value(_decimalTotal.add(_nonDecimalTotal.getDecimal()));
         case NumberLong:
-            dassert(nonDecimalTotal.isInteger());
-            if (nonDecimalTotal.fitsLong())
-                return Value(nonDecimalTotal.getLong());
+            dassert(_nonDecimalTotal.isInteger());
+            if (_nonDecimalTotal.fitsLong())
+                return Value(_nonDecimalTotal.getLong());
         // Fallthrough.
         case NumberInt:
-            if (nonDecimalTotal.fitsLong())
-                return Value::createIntOrLong(nonDecimalTotal.getLong());
+            if (_nonDecimalTotal.fitsLong())
+                return Value::createIntOrLong(_nonDecimalTotal.getLong());
         // Fallthrough.
         case NumberDouble:
-            return Value(nonDecimalTotal.getDouble());
+            return Value(_nonDecimalTotal.getDouble());
         default:
             massert(16417, "$add resulted in a non-numeric type", false);
     }
@@ -796,8 +816,11 @@ Value ExpressionCompare::evaluate(const Document& root) const {
     Value pLeft(vpOperand[0]->evaluate(root));
     Value pRight(vpOperand[1]->evaluate(root));
 
-    int cmp = getExpressionContext()->getValueComparator().compare(pLeft, pRight);
+    return evaluateComparison(cmpOp,
+                              getExpressionContext()->getValueComparator().compare(pLeft, pRight));
+}
 
+Value ExpressionCompare::evaluateComparison(CmpOp cmpOp, int cmp) {
     // Make cmp one of 1, 0, or -1.
     if (cmp == 0) {
         // leave as 0
@@ -2581,57 +2604,53 @@ const char* ExpressionMod::getOpName() const {
 /* ------------------------- ExpressionMultiply ----------------------------- */
 
 Value ExpressionMultiply::evaluate(const Document& root) const {
-    /*
-      We'll try to return the narrowest possible result value.  To do that
-      without creating intermediate Values, do the arithmetic for double
-      and integral types in parallel, tracking the current narrowest
-      type.
-     */
-    double doubleProduct = 1;
-    long long longProduct = 1;
-    Decimal128 decimalProduct;  // This will be initialized on encountering the first decimal.
-
-    BSONType productType = NumberInt;
-
-    const size_t n = vpOperand.size();
-    for (size_t i = 0; i < n; ++i) {
-        Value val = vpOperand[i]->evaluate(root);
+    Product product;
+    for (auto&& operand : vpOperand) {
+        if (!product.multiply(operand->evaluate(root))) {
+            return Value(BSONNULL);
+        }
+    }
+    return product.getValue();
+}
 
-        if (val.numeric()) {
-            BSONType oldProductType = productType;
-            productType = Value::getWidestNumeric(productType, val.getType());
-            if (productType == NumberDecimal) {
-                // On finding the first decimal, convert the partial product to decimal.
-                if (oldProductType != NumberDecimal) {
-                    decimalProduct = oldProductType == NumberDouble
-                        ? Decimal128(doubleProduct, Decimal128::kRoundTo15Digits)
-                        : Decimal128(static_cast<int64_t>(longProduct));
-                }
-                decimalProduct = decimalProduct.multiply(val.coerceToDecimal());
-            } else {
-                doubleProduct *= val.coerceToDouble();
-                if (mongoSignedMultiplyOverflow64(longProduct, val.coerceToLong(), &longProduct)) {
-                    // The 'longProduct' would have overflowed, so we're abandoning it.
-                    productType = NumberDouble;
-                }
+bool ExpressionMultiply::Product::multiply(const Value& val) {
+    if (val.numeric()) {
+        BSONType oldProductType = _productType;
+        _productType = Value::getWidestNumeric(_productType, val.getType());
+        if (_productType == NumberDecimal) {
+            // On finding the first decimal, convert the partial product to decimal.
+            if (oldProductType != NumberDecimal) {
+                _decimalProduct = oldProductType == NumberDouble
+                    ? Decimal128(_doubleProduct, Decimal128::kRoundTo15Digits)
+                    : Decimal128(static_cast<int64_t>(_longProduct));
             }
-        } else if (val.nullish()) {
-            return Value(BSONNULL);
+            _decimalProduct = _decimalProduct.multiply(val.coerceToDecimal());
         } else {
-            uasserted(16555,
-                      str::stream() << "$multiply only supports numeric types, not "
-                                    << typeName(val.getType()));
+            _doubleProduct *= val.coerceToDouble();
+            if (mongoSignedMultiplyOverflow64(_longProduct, val.coerceToLong(), &_longProduct)) {
+                // The '_longProduct' would have overflowed, so we're abandoning it.
+                _productType = NumberDouble;
+            }
         }
+    } else if (val.nullish()) {
+        return false;
+    } else {
+        uasserted(16555,
+                  str::stream() << "$multiply only supports numeric types, not "
+                                << typeName(val.getType()));
     }
+    return true;
+}
 
-    if (productType == NumberDouble)
-        return Value(doubleProduct);
-    else if (productType == NumberLong)
-        return Value(longProduct);
-    else if (productType == NumberInt)
-        return Value::createIntOrLong(longProduct);
-    else if (productType == NumberDecimal)
-        return Value(decimalProduct);
+Value ExpressionMultiply::Product::getValue() const {
+    if (_productType == NumberDouble)
+        return Value(_doubleProduct);
+    else if (_productType == NumberLong)
+        return Value(_longProduct);
+    else if (_productType == NumberInt)
+        return Value::createIntOrLong(_longProduct);
+    else if (_productType == NumberDecimal)
+        return Value(_decimalProduct);
     else
         massert(16418, "$multiply resulted in a non-numeric type", false);
 }
@@ -4217,7 +4236,10 @@ const char* ExpressionStrLenCP::getOpName() const {
 Value ExpressionSubtract::evaluate(const Document& root) const {
     Value lhs = vpOperand[0]->evaluate(root);
     Value rhs = vpOperand[1]->evaluate(root);
+    return apply(lhs, rhs);
+}
 
+Value ExpressionSubtract::apply(const Value& lhs, const Value& rhs) {
     BSONType diffType = Value::getWidestNumeric(rhs.getType(), lhs.getType());
 
     if (diffType == NumberDecimal) {
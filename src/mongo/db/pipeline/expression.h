@@ -48,6 +48,7 @@
 #include "mongo/stdx/functional.h"
 #include "mongo/util/intrusive_counter.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/summation.h"
 
 namespace mongo {
 
@@ -666,6 +667,37 @@ public:
 
 class ExpressionAdd final : public ExpressionVariadic<ExpressionAdd> {
 public:
+    /**
+     * The running total of a $add, which is given the values of its operands one at a time.
+     */
+    class Sum {
+    public:
+        /**
+         * Adds 'val' to the total. Returns false if 'val' is null or missing, in which case the
+         * result of the $add is null and no more operands should be added. Throws if 'val' is of a
+         * type that cannot be added.
+         */
+        bool add(const Value& val);
+
+        Value getValue() const;
+
+    private:
+        // While every operand so far has been a NumberInt or NumberLong and their total fits in a
+        // long long, the total is kept exactly in '_integralTotal' and the summations below are
+        // unused.
+        bool _integral = true;
+        long long _integralTotal = 0;
+
+        // We'll try to return the narrowest possible result value while avoiding overflow, loss
+        // of precision due to intermediate rounding or implicit use of decimal types. To do that,
+        // compute a compensated sum for non-decimal values and a separate decimal sum for decimal
+        // values, and track the current narrowest type.
+        DoubleDoubleSummation _nonDecimalTotal;
+        Decimal128 _decimalTotal;
+        BSONType _totalType = NumberInt;
+        bool _haveDate = false;
+    };
+
     explicit ExpressionAdd(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : ExpressionVariadic<ExpressionAdd>(expCtx) {}
 
@@ -779,6 +811,10 @@ public:
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const boost::intrusive_ptr<Expression>& pExpression);
 
+    const boost::intrusive_ptr<Expression>& getExpression() const {
+        return pExpression;
+    }
+
 protected:
     void _doAddDependencies(DepsTracker* deps) const final;
 
@@ -809,6 +845,13 @@ public:
     ExpressionCompare(const boost::intrusive_ptr<ExpressionContext>& expCtx, CmpOp cmpOp)
         : ExpressionFixedArity<ExpressionCompare, 2>(expCtx), cmpOp(cmpOp) {}
 
+    /**
+     * Returns the result of 'cmpOp' given 'cmp', the result of comparing its two operands: less
+     * than zero if the first operand is smaller, zero if they are equal and greater than zero
+     * otherwise.
+     */
+    static Value evaluateComparison(CmpOp cmpOp, int cmp);
+
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
 
@@ -1401,6 +1444,30 @@ public:
 
 class ExpressionMultiply final : public ExpressionVariadic<ExpressionMultiply> {
 public:
+    /**
+     * The running product of a $multiply, which is given the values of its operands one at a time.
+     */
+    class Product {
+    public:
+        /**
+         * Multiplies the product by 'val'. Returns false if 'val' is null or missing, in which case
+         * the result of the $multiply is null and no more operands should be multiplied. Throws if
+         * 'val' is not numeric.
+         */
+        bool multiply(const Value& val);
+
+        Value getValue() const;
+
+    private:
+        // We'll try to return the narrowest possible result value. To do that without creating
+        // intermediate Values, do the arithmetic for double and integral types in parallel,
+        // tracking the current narrowest type.
+        double _doubleProduct = 1;
+        long long _longProduct = 1;
+        Decimal128 _decimalProduct;  // This will be initialized on encountering the first decimal.
+        BSONType _productType = NumberInt;
+    };
+
     explicit ExpressionMultiply(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : ExpressionVariadic<ExpressionMultiply>(expCtx) {}
 
@@ -1755,6 +1822,11 @@ public:
     explicit ExpressionSubtract(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : ExpressionFixedArity<ExpressionSubtract, 2>(expCtx) {}
 
+    /**
+     * Returns the result of subtracting 'rhs' from 'lhs'.
+     */
+    static Value apply(const Value& lhs, const Value& rhs);
+
     Value evaluate(const Document& root) const final;
     const char* getOpName() const final;
 };
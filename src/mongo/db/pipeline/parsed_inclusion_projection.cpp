@@ -32,6 +32,8 @@
 
 #include <algorithm>
 
+#include "mongo/db/query/query_knobs.h"
+
 namespace mongo {
 
 namespace parsed_aggregation_projection {
@@ -45,12 +47,23 @@ using std::unique_ptr;
 
 InclusionNode::InclusionNode(std::string pathToNode) : _pathToNode(std::move(pathToNode)) {}
 
-void InclusionNode::optimize() {
+void InclusionNode::optimize(const boost::intrusive_ptr<ExpressionContext>& expCtx) {
     for (auto&& expressionIt : _expressions) {
         _expressions[expressionIt.first] = expressionIt.second->optimize();
     }
+
+    _compiledExpressions.clear();
+    if (internalQueryEnableCompiledExpressions.load()) {
+        for (auto&& expressionIt : _expressions) {
+            auto compiled = CompiledExpression::compile(expCtx, expressionIt.second);
+            if (compiled) {
+                _compiledExpressions[expressionIt.first] = std::move(compiled);
+            }
+        }
+    }
+
     for (auto&& childPair : _children) {
-        childPair.second->optimize();
+        childPair.second->optimize(expCtx);
     }
 }
 
@@ -147,6 +160,12 @@ void InclusionNode::addComputedFields(MutableDocument* outputDoc, const Document
         if (childIt != _children.end()) {
             outputDoc->setField(field,
                                 childIt->second->addComputedFields(outputDoc->peek()[field], root));
+            continue;
+        }
+
+        auto compiledIt = _compiledExpressions.find(field);
+        if (compiledIt != _compiledExpressions.end()) {
+            outputDoc->setField(field, compiledIt->second->evaluate(root));
         } else {
             auto expressionIt = _expressions.find(field);
             invariant(expressionIt != _expressions.end());
@@ -30,6 +30,7 @@
 
 #include <memory>
 
+#include "mongo/db/pipeline/compiled_expression.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/parsed_aggregation_projection.h"
@@ -55,9 +56,10 @@ public:
     InclusionNode(std::string pathToNode = "");
 
     /**
-     * Optimize any computed expressions.
+     * Optimize any computed expressions, and compile them if internalQueryEnableCompiledExpressions
+     * is set.
      */
-    void optimize();
+    void optimize(const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     /**
      * Serialize this projection.
@@ -169,6 +171,10 @@ private:
     std::vector<std::string> _orderToProcessAdditionsAndChildren;
 
     StringMap<boost::intrusive_ptr<Expression>> _expressions;
+
+    // The compiled form of those of '_expressions' which could be compiled, which is evaluated in
+    // their place. StringMap cannot hold a std::unique_ptr, as with '_children' below.
+    stdx::unordered_map<std::string, std::unique_ptr<CompiledExpression>> _compiledExpressions;
     stdx::unordered_set<std::string> _inclusions;
 
     // TODO use StringMap once SERVER-23700 is resolved.
@@ -212,7 +218,7 @@ public:
      * Optimize any computed expressions.
      */
     void optimize() final {
-        _root->optimize();
+        _root->optimize(_expCtx);
     }
 
     DocumentSource::GetDepsReturn addDependencies(DepsTracker* deps) const final {
@@ -40,7 +40,9 @@
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/value.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace parsed_aggregation_projection {
@@ -321,6 +323,29 @@ TEST(InclusionProjectionExecutionTest, ShouldApplyComputedFieldsInOrderSpecified
     ASSERT_DOCUMENT_EQ(result, expectedResult);
 }
 
+TEST(InclusionProjectionExecutionTest, ShouldApplyCompiledComputedFields) {
+    const bool enableCompiledExpressions = internalQueryEnableCompiledExpressions.load();
+    internalQueryEnableCompiledExpressions.store(true);
+    ON_BLOCK_EXIT([&] { internalQueryEnableCompiledExpressions.store(enableCompiledExpressions); });
+
+    const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    ParsedInclusionProjection inclusion(expCtx);
+    inclusion.parse(BSON("sum" << BSON("$add" << BSON_ARRAY("$a"
+                                                            << "$b"))
+                               << "sub.gt"
+                               << BSON("$gt" << BSON_ARRAY("$a" << 1))
+                               << "a"
+                               << true));
+    inclusion.optimize();
+    auto result = inclusion.applyProjection(Document{{"a", 1}, {"b", 2.5}});
+    auto expectedResult = Document{{"a", 1}, {"sum", 3.5}, {"sub", Document{{"gt", false}}}};
+    ASSERT_DOCUMENT_EQ(result, expectedResult);
+
+    result = inclusion.applyProjection(Document{{"a", 2}, {"b", BSONNULL}});
+    expectedResult = Document{{"a", 2}, {"sum", BSONNULL}, {"sub", Document{{"gt", true}}}};
+    ASSERT_DOCUMENT_EQ(result, expectedResult);
+}
+
 TEST(InclusionProjectionExecutionTest, ShouldImplicitlyIncludeId) {
     const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     ParsedInclusionProjection inclusion(expCtx);
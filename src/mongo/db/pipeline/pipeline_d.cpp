@@ -58,17 +58,22 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_merge_cursors.h"
+#include "mongo/db/pipeline/document_source_parallel_cursor.h"
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/s/collection_metadata.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/metadata_manager.h"
@@ -227,6 +232,71 @@ BSONObj removeSortKeyMetaProjection(BSONObj projectionObj) {
     }
     return projectionObj.removeField(Document::metaFieldSortKey);
 }
+
+/**
+ * Returns true if 'source' transforms each document independently of all others, so that any
+ * share of the input can be passed through it on its own.
+ */
+bool isStreamingStageForParallelScan(const intrusive_ptr<DocumentSource>& source) {
+    if (auto match = dynamic_cast<DocumentSourceMatch*>(source.get())) {
+        return !match->isTextQuery() && !dynamic_cast<DocumentSourceOplogMatch*>(match);
+    }
+    return dynamic_cast<DocumentSourceSingleDocumentTransformation*>(source.get()) ||
+        dynamic_cast<DocumentSourceUnwind*>(source.get());
+}
+
+/**
+ * Returns true if the collection scan 'exec' which feeds 'sources' may be replaced by several
+ * threads each scanning a range of 'collection', as described on
+ * DocumentSourceParallelCursor. This requires that the aggregate asks for it, that the remaining
+ * stages are streaming stages followed by a $group which can merge partial results, and that
+ * each thread can read the same data as the calling thread would.
+ */
+bool canScanInParallel(Collection* collection,
+                       const AggregationRequest* aggRequest,
+                       const intrusive_ptr<ExpressionContext>& expCtx,
+                       const Pipeline::SourceContainer& sources,
+                       PlanExecutor* exec,
+                       const BSONObj& queryObj,
+                       bool oplogReplay) {
+    if (!aggRequest || !aggRequest->shouldAllowParallelScan() ||
+        internalQueryParallelCollectionScanThreads.load() < 2) {
+        return false;
+    }
+
+    auto opCtx = expCtx->opCtx;
+    if (!collection || collection->isCapped() || collection->ns().isOplog() || expCtx->explain ||
+        expCtx->tailableMode != TailableModeEnum::kNormal || oplogReplay ||
+        DocumentSourceMatch::isTextQuery(queryObj)) {
+        return false;
+    }
+
+    // Each thread would have to filter out the orphaned documents on its own.
+    if (ShardingState::get(opCtx)->needCollectionMetadata(opCtx, collection->ns().ns())) {
+        return false;
+    }
+
+    // A snapshot read belongs to a transaction, which other threads cannot join.
+    if (repl::ReadConcernArgs::get(opCtx).getLevel() ==
+        repl::ReadConcernLevel::kSnapshotReadConcern) {
+        return false;
+    }
+
+    // Only replace a plan which scans the whole collection anyway.
+    if (exec->getRootStage()->stageType() != STAGE_COLLSCAN) {
+        return false;
+    }
+
+    for (auto&& source : sources) {
+        if (dynamic_cast<DocumentSourceGroup*>(source.get())) {
+            return true;
+        }
+        if (!isStreamingStageForParallelScan(source)) {
+            return false;
+        }
+    }
+    return false;
+}
 }  // namespace
 
 void PipelineD::prepareCursorSource(Collection* collection,
@@ -325,6 +395,26 @@ void PipelineD::prepareCursorSource(Collection* collection,
                                                 &sortObj,
                                                 &projForQuery));
 
+    if (canScanInParallel(
+            collection, aggRequest, expCtx, sources, exec.get(), queryObj, oplogReplay)) {
+        // Scan on this thread if the other parallel scans have taken all of the threads.
+        auto threads = DocumentSourceParallelCursor::ThreadReservation::reserve(
+            internalQueryParallelCollectionScanThreads.load());
+        if (threads.numThreads()) {
+            auto splitPoints = collection->getRecordStore()->getRangeSplitPoints(
+                expCtx->opCtx, threads.numThreads());
+            if (!splitPoints.empty()) {
+                addParallelCursorSource(collection,
+                                        pipeline,
+                                        expCtx,
+                                        std::move(threads),
+                                        std::move(splitPoints),
+                                        deps,
+                                        queryObj);
+                return;
+            }
+        }
+    }
 
     if (!projForQuery.isEmpty() && !sources.empty()) {
         // Check for redundant $project in query with the same specification as the inclusion
@@ -541,6 +631,46 @@ void PipelineD::addCursorSource(Collection* collection,
     pipeline->addInitialSource(pSource);
 }
 
+void PipelineD::addParallelCursorSource(
+    Collection* collection,
+    Pipeline* pipeline,
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    DocumentSourceParallelCursor::ThreadReservation threads,
+    std::vector<RecordId> splitPoints,
+    const DepsTracker& deps,
+    const BSONObj& queryObj) {
+    Pipeline::SourceContainer& sources = pipeline->_sources;
+
+    // Split the pipeline at its first $group, the way it would be split between the shards and
+    // the merging node of a cluster. Every range runs the stages up to and including a partial
+    // $group, and the merging half of the $group combines what they produce.
+    auto groupIt = std::find_if(sources.begin(), sources.end(), [](const auto& source) {
+        return dynamic_cast<DocumentSourceGroup*>(source.get()) != nullptr;
+    });
+    invariant(groupIt != sources.end());
+    auto mergeSources = static_cast<DocumentSourceGroup*>(groupIt->get())->getMergeSources();
+
+    std::vector<BSONObj> rangePipeline;
+    for (auto it = sources.begin(); it != std::next(groupIt); ++it) {
+        std::vector<Value> serializedStages;
+        (*it)->serializeToArray(serializedStages);
+        for (auto&& stage : serializedStages) {
+            rangePipeline.push_back(stage.getDocument().toBson());
+        }
+    }
+    sources.erase(sources.begin(), std::next(groupIt));
+    sources.splice(sources.begin(), mergeSources);
+
+    pipeline->addInitialSource(DocumentSourceParallelCursor::create(collection,
+                                                                    std::move(threads),
+                                                                    std::move(splitPoints),
+                                                                    queryObj,
+                                                                    deps,
+                                                                    std::move(rangePipeline),
+                                                                    expCtx));
+    pipeline->stitch();
+}
+
 Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
     if (auto docSourceCursor =
             dynamic_cast<DocumentSourceCursor*>(pipeline->_sources.front().get())) {
@@ -554,6 +684,10 @@ std::string PipelineD::getPlanSummaryStr(const Pipeline* pPipeline) {
             dynamic_cast<DocumentSourceCursor*>(pPipeline->_sources.front().get())) {
         return docSourceCursor->getPlanSummaryStr();
     }
+    if (auto parallelCursor =
+            dynamic_cast<DocumentSourceParallelCursor*>(pPipeline->_sources.front().get())) {
+        return parallelCursor->getPlanSummaryStr();
+    }
 
     return "";
 }
@@ -564,6 +698,9 @@ void PipelineD::getPlanSummaryStats(const Pipeline* pPipeline, PlanSummaryStats*
     if (auto docSourceCursor =
             dynamic_cast<DocumentSourceCursor*>(pPipeline->_sources.front().get())) {
         *statsOut = docSourceCursor->getPlanSummaryStats();
+    } else if (auto parallelCursor = dynamic_cast<DocumentSourceParallelCursor*>(
+                   pPipeline->_sources.front().get())) {
+        *statsOut = parallelCursor->getPlanSummaryStats();
     }
 
     bool hasSortStage{false};
@@ -35,8 +35,10 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/aggregation_request.h"
+#include "mongo/db/pipeline/document_source_parallel_cursor.h"
 #include "mongo/db/pipeline/mongo_process_common.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/record_id.h"
 
 namespace mongo {
 class Collection;
@@ -190,6 +192,21 @@ private:
         BSONObj* sortObj,
         BSONObj* projectionObj);
 
+    /**
+     * Replaces the stages of 'pipeline' up to and including its first $group with a
+     * DocumentSourceParallelCursor which runs them on each of the ranges of 'collection' between
+     * 'splitPoints', on the threads of 'threads', followed by the stages which merge their
+     * partial results.
+     */
+    static void addParallelCursorSource(
+        Collection* collection,
+        Pipeline* pipeline,
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        DocumentSourceParallelCursor::ThreadReservation threads,
+        std::vector<RecordId> splitPoints,
+        const DepsTracker& deps,
+        const BSONObj& queryObj);
+
     /**
      * Creates a DocumentSourceCursor from the given PlanExecutor and adds it to the front of the
      * Pipeline.
@@ -45,6 +45,7 @@
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_solution.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/log.h"
 #include "mongo/util/mongoutils/str.h"
@@ -554,9 +555,43 @@ std::string SolutionCacheData::toString() const {
 // PlanCache
 //
 
-PlanCache::PlanCache() : _cache(internalQueryCacheSize.load()) {}
+namespace {
+
+// A partition is never given fewer entries than this, so that a small cache is not cut into
+// pieces too small for per-partition LRU to approximate LRU over the whole cache.
+const size_t kMinEntriesPerPartition = 64;
+
+/**
+ * Returns the largest power of two no greater than the configured number of partitions that
+ * still leaves every partition with at least kMinEntriesPerPartition entries.
+ */
+size_t computeNumPartitions(size_t cacheSize) {
+    const size_t requested = std::max(1, internalQueryCacheNumPartitions.load());
+    const size_t limit =
+        std::min(requested, std::max<size_t>(1, cacheSize / kMinEntriesPerPartition));
+
+    size_t numPartitions = 1;
+    while (numPartitions * 2 <= limit) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
+
+}  // namespace
+
+PlanCache::PlanCache() : PlanCache(std::string()) {}
+
+PlanCache::PlanCache(const std::string& ns) : _ns(ns) {
+    const size_t cacheSize = internalQueryCacheSize.load();
+    const size_t numPartitions = computeNumPartitions(cacheSize);
+    const size_t partitionSize =
+        cacheSize / numPartitions + (cacheSize % numPartitions == 0 ? 0 : 1);
 
-PlanCache::PlanCache(const std::string& ns) : _cache(internalQueryCacheSize.load()), _ns(ns) {}
+    _partitions.reserve(numPartitions);
+    for (size_t i = 0; i < numPartitions; ++i) {
+        _partitions.push_back(stdx::make_unique<Partition>(partitionSize));
+    }
+}
 
 PlanCache::~PlanCache() {}
 
@@ -736,8 +771,11 @@ Status PlanCache::add(const CanonicalQuery& query,
     }
     entry->projection = projBuilder.obj();
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(computeKey(query), entry);
+    HashedKey hashedKey = computeHashedKey(query);
+
+    Partition& partition = getPartition(hashedKey);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    std::unique_ptr<PlanCacheEntry> evictedEntry = partition.cache.add(hashedKey, entry);
 
     if (NULL != evictedEntry.get()) {
         LOG(1) << _ns << ": plan cache maximum size exceeded - "
@@ -748,18 +786,19 @@ Status PlanCache::add(const CanonicalQuery& query,
 }
 
 Status PlanCache::get(const CanonicalQuery& query, CachedSolution** crOut) const {
-    PlanCacheKey key = computeKey(query);
+    HashedKey hashedKey = computeHashedKey(query);
     verify(crOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = getPartition(hashedKey);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(hashedKey, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
     invariant(entry);
 
-    *crOut = new CachedSolution(key, *entry);
+    *crOut = new CachedSolution(hashedKey.key, *entry);
 
     return Status::OK();
 }
@@ -769,11 +808,12 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
         return Status(ErrorCodes::BadValue, "feedback is NULL");
     }
     std::unique_ptr<PlanCacheEntryFeedback> autoFeedback(feedback);
-    PlanCacheKey ck = computeKey(cq);
+    HashedKey hashedKey = computeHashedKey(cq);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = getPartition(hashedKey);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(ck, &entry);
+    Status cacheStatus = partition.cache.get(hashedKey, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -788,13 +828,18 @@ Status PlanCache::feedback(const CanonicalQuery& cq, PlanCacheEntryFeedback* fee
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    HashedKey hashedKey = computeHashedKey(canonicalQuery);
+
+    Partition& partition = getPartition(hashedKey);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.remove(hashedKey);
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    _cache.clear();
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        partition->cache.clear();
+    }
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -805,13 +850,26 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
     return keyBuilder.str();
 }
 
+PlanCache::HashedKey PlanCache::computeHashedKey(const CanonicalQuery& cq) const {
+    HashedKey hashedKey;
+    hashedKey.key = computeKey(cq);
+    hashedKey.hash = std::hash<PlanCacheKey>()(hashedKey.key);
+    return hashedKey;
+}
+
+PlanCache::Partition& PlanCache::getPartition(const HashedKey& hashedKey) const {
+    // The number of partitions is a power of two.
+    return *_partitions[hashedKey.hash & (_partitions.size() - 1)];
+}
+
 Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOut) const {
-    PlanCacheKey key = computeKey(query);
+    HashedKey hashedKey = computeHashedKey(query);
     verify(entryOut);
 
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
+    Partition& partition = getPartition(hashedKey);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
     PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
+    Status cacheStatus = partition.cache.get(hashedKey, &entry);
     if (!cacheStatus.isOK()) {
         return cacheStatus;
     }
@@ -823,25 +881,32 @@ Status PlanCache::getEntry(const CanonicalQuery& query, PlanCacheEntry** entryOu
 }
 
 std::vector<PlanCacheEntry*> PlanCache::getAllEntries() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
     std::vector<PlanCacheEntry*> entries;
-    typedef std::list<std::pair<PlanCacheKey, PlanCacheEntry*>>::const_iterator ConstIterator;
-    for (ConstIterator i = _cache.begin(); i != _cache.end(); i++) {
-        PlanCacheEntry* entry = i->second;
-        entries.push_back(entry->clone());
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        for (auto&& keyAndEntry : partition->cache) {
+            entries.push_back(keyAndEntry.second->clone());
+        }
     }
 
     return entries;
 }
 
 bool PlanCache::contains(const CanonicalQuery& cq) const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.hasKey(computeKey(cq));
+    HashedKey hashedKey = computeHashedKey(cq);
+
+    Partition& partition = getPartition(hashedKey);
+    stdx::lock_guard<stdx::mutex> cacheLock(partition.mutex);
+    return partition.cache.hasKey(hashedKey);
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<stdx::mutex> cacheLock(_cacheMutex);
-    return _cache.size();
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<stdx::mutex> cacheLock(partition->mutex);
+        size += partition->cache.size();
+    }
+    return size;
 }
 
 void PlanCache::notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries) {
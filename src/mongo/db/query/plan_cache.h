@@ -29,7 +29,9 @@
 #pragma once
 
 #include <boost/optional/optional.hpp>
+#include <memory>
 #include <set>
+#include <vector>
 
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/query/canonical_query.h"
@@ -287,6 +289,9 @@ public:
  * mapping, the cache contains information on why that mapping was made and statistics on the
  * cache entry's actual performance on subsequent runs.
  *
+ * The cache is split into partitions by the hash of the query's cache key, each with its own
+ * mutex and LRU list, so that concurrent operations on different query shapes do not serialize
+ * on a single lock.
  */
 class PlanCache {
 private:
@@ -396,7 +401,7 @@ public:
 
     /**
      * Returns true if there is an entry in the cache for the 'query'.
-     * Internally calls hasKey() on the LRU cache.
+     * Internally calls hasKey() on the LRU cache of the partition owning the query's key.
      */
     bool contains(const CanonicalQuery& cq) const;
 
@@ -414,15 +419,62 @@ public:
      */
     void notifyOfIndexEntries(const std::vector<IndexEntry>& indexEntries);
 
+    /**
+     * Returns the number of independently locked partitions the cache is split into.
+     */
+    size_t numPartitions() const {
+        return _partitions.size();
+    }
+
 private:
+    /**
+     * A PlanCacheKey together with its hash. The hash is computed once per operation and then
+     * used both to pick a partition and to probe that partition's map, so the encoded key string
+     * is hashed exactly once. Equality still compares the full string.
+     *
+     * The encoded string is still built for every lookup. Keying entries by the hash alone would
+     * let two query shapes whose hashes collide share a cached plan, and applying one shape's
+     * index tags to another shape's match expression is not safe. The string is also the shape
+     * identity used by index filters and the plan cache commands.
+     */
+    struct HashedKey {
+        struct Hasher {
+            std::size_t operator()(const HashedKey& hashedKey) const {
+                return hashedKey.hash;
+            }
+        };
+
+        bool operator==(const HashedKey& other) const {
+            return hash == other.hash && key == other.key;
+        }
+
+        PlanCacheKey key;
+        std::size_t hash;
+    };
+
+    /**
+     * One shard of the cache: an LRU store over the query shapes whose key hash maps to it. Each
+     * partition evicts independently, so recency is tracked per partition rather than globally.
+     */
+    struct Partition {
+        explicit Partition(size_t maxSize) : cache(maxSize) {}
+
+        // Protects 'cache'.
+        stdx::mutex mutex;
+        LRUKeyValue<HashedKey, PlanCacheEntry, HashedKey::Hasher> cache;
+    };
+
     void encodeKeyForMatch(const MatchExpression* tree, StringBuilder* keyBuilder) const;
     void encodeKeyForSort(const BSONObj& sortObj, StringBuilder* keyBuilder) const;
     void encodeKeyForProj(const BSONObj& projObj, StringBuilder* keyBuilder) const;
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry> _cache;
+    HashedKey computeHashedKey(const CanonicalQuery& cq) const;
+
+    Partition& getPartition(const HashedKey& hashedKey) const;
 
-    // Protects _cache.
-    mutable stdx::mutex _cacheMutex;
+    // Fixed at construction; the number of partitions is a power of two. The partitions are
+    // allocated individually since they can be neither copied nor moved.
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Full namespace of collection.
     std::string _ns;
@@ -0,0 +1,199 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/exec/plan_stats.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/query_knobs.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/stdx/memory.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 16;  // max number of threads looking up plans concurrently
+
+// Passed as the benchmark argument to use the default number of plan cache partitions.
+const int kDefaultPartitions = 0;
+
+// Number of distinct query shapes held in the cache.
+const int kNumShapes = 1000;
+
+const NamespaceString kNss("test.plan_cache_bm");
+
+std::unique_ptr<CanonicalQuery> makeQuery(OperationContext* opCtx, int shape) {
+    auto qr = stdx::make_unique<QueryRequest>(kNss);
+    qr->setFilter(BSON("a" + std::to_string(shape) << 1 << "b" << BSON("$gt" << 5)));
+    qr->setSort(BSON("c" << 1));
+    qr->setProj(BSON("_id" << 0 << "c" << 1));
+    return uassertStatusOK(
+        CanonicalQuery::canonicalize(opCtx,
+                                     std::move(qr),
+                                     nullptr,
+                                     ExtensionsCallbackNoop(),
+                                     MatchExpressionParser::kAllowAllSpecialFeatures));
+}
+
+PlanRankingDecision* makeDecision() {
+    auto why = stdx::make_unique<PlanRankingDecision>();
+    CommonStats common("COLLSCAN");
+    auto stats = stdx::make_unique<PlanStageStats>(common, STAGE_COLLSCAN);
+    stats->specific = stdx::make_unique<CollectionScanStats>();
+    why->stats.push_back(std::move(stats));
+    why->scores.push_back(0U);
+    why->candidateOrder.push_back(0U);
+    return why.release();
+}
+
+/**
+ * Fills a plan cache with kNumShapes query shapes, partitioned as requested by the benchmark
+ * argument. Set up and torn down by thread 0 only; the other threads wait at the start barrier
+ * of the timing loop.
+ */
+class PlanCacheTest : public benchmark::Fixture {
+protected:
+    void setUpCache(benchmark::State& state) {
+        _opCtx = _serviceContext.makeOperationContext();
+
+        const int oldNumPartitions = internalQueryCacheNumPartitions.load();
+        if (state.range(0) != kDefaultPartitions) {
+            internalQueryCacheNumPartitions.store(state.range(0));
+        }
+        planCache = stdx::make_unique<PlanCache>(kNss.ns());
+        internalQueryCacheNumPartitions.store(oldNumPartitions);
+
+        for (int shape = 0; shape < kNumShapes; ++shape) {
+            queries.push_back(makeQuery(_opCtx.get(), shape));
+
+            QuerySolution soln;
+            soln.cacheData = stdx::make_unique<SolutionCacheData>();
+            soln.cacheData->solnType = SolutionCacheData::COLLSCAN_SOLN;
+            std::vector<QuerySolution*> solns{&soln};
+            invariantOK(planCache->add(*queries.back(), solns, makeDecision(), Date_t()));
+        }
+    }
+
+    void tearDownCache() {
+        planCache.reset();
+        queries.clear();
+        _opCtx.reset();
+    }
+
+    /**
+     * Returns the query shape a thread should use on its 'iteration'-th lookup. Threads start at
+     * different shapes and step through all of them.
+     */
+    const CanonicalQuery& queryFor(const benchmark::State& state, size_t iteration) const {
+        const size_t start = state.thread_index * (kNumShapes / kMaxPerfThreads);
+        return *queries[(start + iteration * 7) % kNumShapes];
+    }
+
+    std::unique_ptr<PlanCache> planCache;
+    std::vector<std::unique_ptr<CanonicalQuery>> queries;
+
+private:
+    QueryTestServiceContext _serviceContext;
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+BENCHMARK_DEFINE_F(PlanCacheTest, BM_PlanCacheGet)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpCache(state);
+    }
+
+    size_t iteration = 0;
+    for (auto keepRunning : state) {
+        CachedSolution* rawCachedSolution;
+        invariantOK(planCache->get(queryFor(state, iteration++), &rawCachedSolution));
+        std::unique_ptr<CachedSolution> cachedSolution(rawCachedSolution);
+        benchmark::DoNotOptimize(cachedSolution.get());
+    }
+
+    if (state.thread_index == 0) {
+        tearDownCache();
+    }
+}
+
+// Mirrors what a query answered from the cache does: look up the plan, then report back how it
+// performed.
+BENCHMARK_DEFINE_F(PlanCacheTest, BM_PlanCacheGetAndFeedback)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpCache(state);
+    }
+
+    size_t iteration = 0;
+    for (auto keepRunning : state) {
+        const CanonicalQuery& cq = queryFor(state, iteration++);
+
+        CachedSolution* rawCachedSolution;
+        invariantOK(planCache->get(cq, &rawCachedSolution));
+        std::unique_ptr<CachedSolution> cachedSolution(rawCachedSolution);
+
+        auto feedback = stdx::make_unique<PlanCacheEntryFeedback>();
+        feedback->score = 1.0;
+        planCache->feedback(cq, feedback.release()).ignore();
+    }
+
+    if (state.thread_index == 0) {
+        tearDownCache();
+    }
+}
+
+BENCHMARK_DEFINE_F(PlanCacheTest, BM_PlanCacheComputeKey)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpCache(state);
+    }
+
+    size_t iteration = 0;
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(planCache->computeKey(queryFor(state, iteration++)));
+    }
+
+    if (state.thread_index == 0) {
+        tearDownCache();
+    }
+}
+
+BENCHMARK_REGISTER_F(PlanCacheTest, BM_PlanCacheGet)
+    ->Arg(1)
+    ->Arg(kDefaultPartitions)
+    ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(PlanCacheTest, BM_PlanCacheGetAndFeedback)
+    ->Arg(1)
+    ->Arg(kDefaultPartitions)
+    ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(PlanCacheTest, BM_PlanCacheComputeKey)->Arg(kDefaultPartitions);
+
+}  // namespace
+}  // namespace mongo
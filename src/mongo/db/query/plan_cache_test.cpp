@@ -446,6 +446,85 @@ TEST(PlanCacheTest, AddValidSolution) {
     ASSERT_EQUALS(planCache.size(), 1U);
 }
 
+/**
+ * Adds an entry for 'cq' with a single collection scan solution.
+ */
+void addCollScanEntry(PlanCache* planCache, const CanonicalQuery& cq) {
+    QuerySolution qs;
+    qs.cacheData.reset(new SolutionCacheData());
+    qs.cacheData->tree.reset(new PlanCacheIndexTree());
+    std::vector<QuerySolution*> solns;
+    solns.push_back(&qs);
+    ASSERT_OK(planCache->add(cq, solns, createDecision(1U), Date_t{}));
+}
+
+TEST(PlanCacheTest, EntriesAreSpreadAcrossPartitions) {
+    const int oldNumPartitions = internalQueryCacheNumPartitions.load();
+    ON_BLOCK_EXIT(
+        [oldNumPartitions] { internalQueryCacheNumPartitions.store(oldNumPartitions); });
+    internalQueryCacheNumPartitions.store(8);
+
+    PlanCache planCache;
+    ASSERT_EQUALS(planCache.numPartitions(), 8U);
+
+    const int kNumShapes = 100;
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (int i = 0; i < kNumShapes; ++i) {
+        queries.push_back(canonicalize(BSON("a" + std::to_string(i) << 1)));
+        addCollScanEntry(&planCache, *queries.back());
+    }
+
+    ASSERT_EQUALS(planCache.size(), static_cast<size_t>(kNumShapes));
+    for (auto&& cq : queries) {
+        CachedSolution* rawCachedSolution;
+        ASSERT_OK(planCache.get(*cq, &rawCachedSolution));
+        unique_ptr<CachedSolution> cachedSolution(rawCachedSolution);
+        ASSERT_EQUALS(cachedSolution->key, planCache.computeKey(*cq));
+    }
+
+    std::vector<PlanCacheEntry*> entries = planCache.getAllEntries();
+    ON_BLOCK_EXIT([&entries] {
+        for (auto entry : entries) {
+            delete entry;
+        }
+    });
+    ASSERT_EQUALS(entries.size(), static_cast<size_t>(kNumShapes));
+
+    ASSERT_OK(planCache.remove(*queries.front()));
+    ASSERT_FALSE(planCache.contains(*queries.front()));
+    ASSERT_EQUALS(planCache.size(), static_cast<size_t>(kNumShapes - 1));
+
+    planCache.clear();
+    ASSERT_EQUALS(planCache.size(), 0U);
+}
+
+// A cache too small to split keeps exact LRU eviction over all of its entries.
+TEST(PlanCacheTest, SmallCacheUsesSinglePartition) {
+    const int oldCacheSize = internalQueryCacheSize.load();
+    ON_BLOCK_EXIT([oldCacheSize] { internalQueryCacheSize.store(oldCacheSize); });
+    internalQueryCacheSize.store(2);
+
+    PlanCache planCache;
+    ASSERT_EQUALS(planCache.numPartitions(), 1U);
+
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    unique_ptr<CanonicalQuery> cqC(canonicalize("{c: 1}"));
+    addCollScanEntry(&planCache, *cqA);
+    addCollScanEntry(&planCache, *cqB);
+
+    // Touch 'a' so that 'b' becomes the least recently used entry.
+    CachedSolution* rawCachedSolution;
+    ASSERT_OK(planCache.get(*cqA, &rawCachedSolution));
+    delete rawCachedSolution;
+
+    addCollScanEntry(&planCache, *cqC);
+    ASSERT_EQUALS(planCache.size(), 2U);
+    ASSERT_TRUE(planCache.contains(*cqA));
+    ASSERT_FALSE(planCache.contains(*cqB));
+    ASSERT_TRUE(planCache.contains(*cqC));
+}
+
 /**
  * Each test in the CachePlanSelectionTest suite goes through
  * the following flow:
@@ -40,6 +40,8 @@ MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlanEvaluationMaxResults, int, 101);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheSize, int, 5000);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheNumPartitions, int, 16);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheFeedbacksStored, int, 20);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryCacheEvictionRatio, double, 10.0);
@@ -76,6 +78,24 @@ MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceCursorBatchSizeBytes, int, 4
 
 MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupCacheSizeBytes, int, 100 * 1024 * 1024);
 
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupBatchSize, int, 1000);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceLookupBatchMaxMemoryBytes,
+                              int,
+                              100 * 1024 * 1024);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceSortNumThreads, int, 1);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceGroupSpillPartitions, int, 16);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryEnableCompiledExpressions, bool, false);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalDocumentSourceBatchSize, int, 128);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryParallelCollectionScanThreads, int, 1);
+
+MONGO_EXPORT_SERVER_PARAMETER(internalQueryParallelCollectionScanMaxTotalThreads, int, 0);
+
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryPlannerGenerateCoveredWholeIndexScans, bool, false);
 
 MONGO_EXPORT_SERVER_PARAMETER(internalQueryIgnoreUnknownJSONSchemaKeywords, bool, false);
@@ -64,6 +64,11 @@ extern AtomicBool internalQueryPlannerEnableHashIntersection;
 // How many entries in the cache?
 extern AtomicInt32 internalQueryCacheSize;
 
+// Into how many independently locked partitions is each collection's cache split? The number
+// actually used is rounded down to a power of two and reduced for small caches so that every
+// partition can hold a reasonable number of entries.
+extern AtomicInt32 internalQueryCacheNumPartitions;
+
 // How many feedback entries do we collect before possibly evicting from the cache based on bad
 // performance?
 extern AtomicInt32 internalQueryCacheFeedbacksStored;
@@ -122,5 +127,37 @@ extern AtomicInt32 internalDocumentSourceCursorBatchSizeBytes;
 
 extern AtomicInt32 internalDocumentSourceLookupCacheSizeBytes;
 
+// How many input documents may a $lookup with localField/foreignField look up with a single query?
+extern AtomicInt32 internalDocumentSourceLookupBatchSize;
+
+// How much memory may the foreign documents matching one such batch use?
+extern AtomicInt32 internalDocumentSourceLookupBatchMaxMemoryBytes;
+
+// How many threads may a $sort stage without a limit use to sort, spill and merge its input?
+extern AtomicInt32 internalDocumentSourceSortNumThreads;
+
+// How many partitions does a $group hash its groups into when they do not fit in memory? 0 spills
+// them sorted instead, to be merged back together. A $group that spills sorted returns its groups in
+// _id order, whereas one that spills to partitions returns them in no particular order, as a $group
+// that does not spill always has.
+extern AtomicInt32 internalDocumentSourceGroupSpillPartitions;
+
+// Should the expressions computed by $project and $addFields be compiled into a flat program
+// rather than evaluated by walking the expression tree?
+extern AtomicBool internalQueryEnableCompiledExpressions;
+
+// How many documents may $group and $sort pull from the stage before them at a time? 1 pulls them
+// one by one.
+extern AtomicInt32 internalDocumentSourceBatchSize;
+
+// How many threads may scan a collection for an aggregate which sets 'allowParallelScan'? 1 always
+// scans on the thread running the aggregate.
+extern AtomicInt32 internalQueryParallelCollectionScanThreads;
+
+// How many threads may all parallel collection scans use together? An aggregate which finds fewer
+// than two of them free scans on its own thread instead. Values below 1 mean one thread per
+// available core.
+extern AtomicInt32 internalQueryParallelCollectionScanMaxTotalThreads;
+
 extern AtomicBool internalQueryProhibitBlockingMergeOnMongoS;
 }  // namespace mongo
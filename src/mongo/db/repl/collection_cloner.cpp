@@ -32,6 +32,7 @@
 
 #include "mongo/db/repl/collection_cloner.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "mongo/base/string_data.h"
@@ -39,6 +40,7 @@
 #include "mongo/client/remote_command_retry_scheduler.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/query/killcursors_request.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_parameters.h"
@@ -68,6 +70,47 @@ MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionCountAttempts, int, 3);
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListIndexesAttempts, int, 3);
 // The number of attempts for the find command, which gets the data.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionFindAttempts, int, 3);
+
+// The number of '_id' ranges to split a collection into when cloning it. Each range is read over
+// its own cursor, and the cursors are fetched from concurrently. A value of 1 clones every
+// collection over the cursor(s) described by 'maxNumInitialSyncCollectionClonerCursors'.
+MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncCollectionClonerPartitions, int, 1);
+
+// Collections with fewer documents than this per partition are not partitioned.
+MONGO_EXPORT_SERVER_PARAMETER(initialSyncCollectionClonerMinDocumentsPerPartition, int, 100000);
+
+// The number of '_id' values sampled from the sync source per partition to choose the partition
+// boundaries.
+const int kSplitPointSamplesPerPartition = 32;
+
+/**
+ * Returns the partitions bounded by the '_id' values in 'samples', each of the form {_id: <value>},
+ * so that each partition holds about the same number of samples. The first partition starts at
+ * MinKey and the last ends at MaxKey. Returns fewer than 'numPartitions' partitions if there are
+ * too few distinct samples.
+ */
+std::vector<CollectionCloner::PartitionStats> makePartitions(std::vector<BSONObj> samples,
+                                                             int numPartitions) {
+    auto idLessThan = [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs.firstElement().woCompare(rhs.firstElement(), false) < 0;
+    };
+    std::sort(samples.begin(), samples.end(), idLessThan);
+
+    std::vector<CollectionCloner::PartitionStats> partitions(1);
+    partitions.front().min = BSON("_id" << MINKEY);
+    for (int i = 1; i < numPartitions && !samples.empty(); ++i) {
+        const auto& splitPoint = samples[i * samples.size() / numPartitions];
+        if (!idLessThan(partitions.back().min, splitPoint)) {
+            continue;
+        }
+        partitions.back().max = splitPoint;
+        partitions.emplace_back();
+        partitions.back().min = splitPoint;
+    }
+    partitions.back().max = BSON("_id" << MAXKEY);
+    return partitions;
+}
+
 }  // namespace
 
 // Failpoint which causes initial sync to hang before establishing its cursor to clone the
@@ -259,6 +302,12 @@ void CollectionCloner::_cancelRemainingWork_inlock() {
     if (_verifyCollectionDroppedScheduler) {
         _verifyCollectionDroppedScheduler->shutdown();
     }
+    if (_sampleSplitPointsScheduler) {
+        _sampleSplitPointsScheduler->shutdown();
+    }
+    for (auto&& scheduler : _establishPartitionCursorsSchedulers) {
+        scheduler->shutdown();
+    }
     _dbWorkTaskRunner.cancel();
 }
 
@@ -468,6 +517,35 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
 
     _collLoader = std::move(collectionBulkLoader.getValue());
 
+    Client::initThreadIfNotAlready();
+    auto opCtx = cc().getOperationContext();
+
+    MONGO_FAIL_POINT_BLOCK(initialSyncHangBeforeCollectionClone, options) {
+        const BSONObj& data = options.getData();
+        if (data["namespace"].String() == _destNss.ns()) {
+            log() << "initial sync - initialSyncHangBeforeCollectionClone fail point "
+                     "enabled. Blocking until fail point is disabled.";
+            while (MONGO_FAIL_POINT(initialSyncHangBeforeCollectionClone) && !_isShuttingDown()) {
+                mongo::sleepsecs(1);
+            }
+        }
+    }
+
+    bool partitionCollection;
+    {
+        LockGuard lk(_mutex);
+        partitionCollection = _shouldPartitionCollection();
+    }
+    auto scheduleStatus = partitionCollection
+        ? _scheduleSampleSplitPoints(numInitialSyncCollectionClonerPartitions.load())
+        : _scheduleEstablishCollectionCursors(opCtx);
+    if (!scheduleStatus.isOK()) {
+        _finishCallback(scheduleStatus);
+        return;
+    }
+}
+
+Status CollectionCloner::_scheduleEstablishCollectionCursors(OperationContext* opCtx) {
     BSONObjBuilder cmdObj;
     EstablishCursorsCommand cursorCommand;
     // The 'find' command is used when the number of cloning cursors is 1 to ensure
@@ -488,20 +566,6 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
         cursorCommand = ParallelCollScan;
     }
 
-    Client::initThreadIfNotAlready();
-    auto opCtx = cc().getOperationContext();
-
-    MONGO_FAIL_POINT_BLOCK(initialSyncHangBeforeCollectionClone, options) {
-        const BSONObj& data = options.getData();
-        if (data["namespace"].String() == _destNss.ns()) {
-            log() << "initial sync - initialSyncHangBeforeCollectionClone fail point "
-                     "enabled. Blocking until fail point is disabled.";
-            while (MONGO_FAIL_POINT(initialSyncHangBeforeCollectionClone) && !_isShuttingDown()) {
-                mongo::sleepsecs(1);
-            }
-        }
-    }
-
     _establishCollectionCursorsScheduler = stdx::make_unique<RemoteCommandRetryScheduler>(
         _executor,
         RemoteCommandRequest(_source,
@@ -522,9 +586,9 @@ void CollectionCloner::_beginCollectionCallback(const executor::TaskExecutor::Ca
 
     if (!scheduleStatus.isOK()) {
         _establishCollectionCursorsScheduler.reset();
-        _finishCallback(scheduleStatus);
-        return;
+        return scheduleStatus;
     }
+    return Status::OK();
 }
 
 Status CollectionCloner::_parseCursorResponse(BSONObj response,
@@ -611,6 +675,250 @@ void CollectionCloner::_establishCollectionCursorsCallback(const RemoteCommandCa
     LOG(1) << "Collection cloner running with " << cursorResponses.size()
            << " cursors established.";
 
+    _startCloningFromCursors(std::move(cursorResponses));
+}
+
+bool CollectionCloner::_shouldPartitionCollection() const {
+    const auto numPartitions = numInitialSyncCollectionClonerPartitions.load();
+    if (numPartitions <= 1) {
+        return false;
+    }
+    // Ranges are defined over the '_id' index, which capped collections may lack. A collection
+    // with a default collation would also need the ranges bounded in that collation.
+    if (_idIndexSpec.isEmpty() || _options.capped || !_options.collation.isEmpty()) {
+        return false;
+    }
+    const auto minDocumentsPerPartition =
+        std::max(1, initialSyncCollectionClonerMinDocumentsPerPartition.load());
+    return _stats.documentToCopy >=
+        static_cast<size_t>(numPartitions) * static_cast<size_t>(minDocumentsPerPartition);
+}
+
+Status CollectionCloner::_scheduleSampleSplitPoints(int numPartitions) {
+    const int sampleSize = numPartitions * kSplitPointSamplesPerPartition;
+    // 'aggregate' does not accept a collection UUID, so the sample is taken by name. A rename
+    // during the sample only affects where the partition boundaries fall.
+    auto cmdObj = BSON("aggregate" << _sourceNss.coll() << "pipeline"
+                                   << BSON_ARRAY(BSON("$sample" << BSON("size" << sampleSize))
+                                                 << BSON("$project" << BSON("_id" << 1)))
+                                   << "cursor"
+                                   << BSON("batchSize" << sampleSize));
+
+    LockGuard lk(_mutex);
+    _sampleSplitPointsScheduler = stdx::make_unique<RemoteCommandRetryScheduler>(
+        _executor,
+        RemoteCommandRequest(_source,
+                             _sourceNss.db().toString(),
+                             cmdObj,
+                             ReadPreferenceSetting::secondaryPreferredMetadata(),
+                             nullptr),
+        [=](const RemoteCommandCallbackArgs& rcbd) {
+            _sampleSplitPointsCallback(rcbd, numPartitions);
+        },
+        RemoteCommandRetryScheduler::makeRetryPolicy(
+            numInitialSyncCollectionFindAttempts.load(),
+            executor::RemoteCommandRequest::kNoTimeout,
+            RemoteCommandRetryScheduler::kAllRetriableErrors));
+    auto scheduleStatus = _sampleSplitPointsScheduler->startup();
+    if (!scheduleStatus.isOK()) {
+        _sampleSplitPointsScheduler.reset();
+        return scheduleStatus;
+    }
+    return Status::OK();
+}
+
+void CollectionCloner::_sampleSplitPointsCallback(const RemoteCommandCallbackArgs& rcbd,
+                                                  int numPartitions) {
+    if (_isShuttingDown()) {
+        _finishCallback({ErrorCodes::CallbackCanceled, "Cloner shutting down."});
+        return;
+    }
+    const auto& response = rcbd.response;
+    if (!response.isOK()) {
+        _finishCallback(response.status);
+        return;
+    }
+
+    auto fallBackToSingleCursor = [&](const Status& reason) {
+        log() << "Not partitioning collection " << _sourceNss.ns() << " for cloning: "
+              << redact(reason);
+        Client::initThreadIfNotAlready();
+        auto scheduleStatus = _scheduleEstablishCollectionCursors(cc().getOperationContext());
+        if (!scheduleStatus.isOK()) {
+            _finishCallback(scheduleStatus);
+        }
+    };
+
+    auto commandStatus = getStatusFromCommandResult(response.data);
+    if (!commandStatus.isOK()) {
+        fallBackToSingleCursor(commandStatus);
+        return;
+    }
+    auto cursorResponse = CursorResponse::parseFromBSON(response.data);
+    if (!cursorResponse.isOK()) {
+        fallBackToSingleCursor(cursorResponse.getStatus());
+        return;
+    }
+
+    std::vector<BSONObj> samples;
+    for (auto&& doc : cursorResponse.getValue().getBatch()) {
+        if (doc.hasField("_id")) {
+            samples.push_back(doc.getOwned());
+        }
+    }
+    auto partitions = makePartitions(std::move(samples), numPartitions);
+
+    UniqueLock lk(_mutex);
+    if (cursorResponse.getValue().getCursorId() != 0) {
+        _executor
+            ->scheduleRemoteCommand(
+                RemoteCommandRequest(_source,
+                                     _sourceNss.db().toString(),
+                                     KillCursorsRequest(cursorResponse.getValue().getNSS(),
+                                                        {cursorResponse.getValue().getCursorId()})
+                                         .toBSON(),
+                                     nullptr),
+                [](const executor::TaskExecutor::RemoteCommandCallbackArgs&) {})
+            .getStatus()
+            .ignore();
+    }
+    if (partitions.size() < 2) {
+        lk.unlock();
+        fallBackToSingleCursor({ErrorCodes::InvalidLength, "too few distinct '_id' values"});
+        return;
+    }
+
+    log() << "Cloning collection " << _sourceNss.ns() << " as " << partitions.size()
+          << " '_id' ranges";
+    _stats.partitions = std::move(partitions);
+    auto scheduleStatus = _scheduleEstablishPartitionCursor_inlock(0);
+    if (!scheduleStatus.isOK()) {
+        lk.unlock();
+        _finishCallback(scheduleStatus);
+    }
+}
+
+Status CollectionCloner::_scheduleEstablishPartitionCursor_inlock(size_t partition) {
+    invariant(partition < _stats.partitions.size());
+    const auto& bounds = _stats.partitions[partition];
+
+    BSONObjBuilder cmdObj;
+    cmdObj.appendElements(makeCommandWithUUIDorCollectionName("find", _options.uuid, _sourceNss));
+    cmdObj.append("noCursorTimeout", true);
+    cmdObj.append("batchSize", 0);
+    cmdObj.append("hint", _idIndexSpec["key"].Obj());
+    // The first and last partitions are unbounded below and above respectively, so that documents
+    // with '_id' values of any type are cloned.
+    if (partition > 0) {
+        cmdObj.append("min", bounds.min);
+    }
+    if (partition + 1 < _stats.partitions.size()) {
+        cmdObj.append("max", bounds.max);
+    }
+
+    _establishPartitionCursorsSchedulers.push_back(stdx::make_unique<RemoteCommandRetryScheduler>(
+        _executor,
+        RemoteCommandRequest(_source,
+                             _sourceNss.db().toString(),
+                             cmdObj.obj(),
+                             ReadPreferenceSetting::secondaryPreferredMetadata(),
+                             nullptr,
+                             RemoteCommandRequest::kNoTimeout),
+        [this](const RemoteCommandCallbackArgs& rcbd) { _establishPartitionCursorCallback(rcbd); },
+        RemoteCommandRetryScheduler::makeRetryPolicy(
+            numInitialSyncCollectionFindAttempts.load(),
+            executor::RemoteCommandRequest::kNoTimeout,
+            RemoteCommandRetryScheduler::kAllRetriableErrors)));
+    return _establishPartitionCursorsSchedulers.back()->startup();
+}
+
+void CollectionCloner::_establishPartitionCursorCallback(const RemoteCommandCallbackArgs& rcbd) {
+    auto finishWithStatus = [this](const Status& status) {
+        {
+            LockGuard lk(_mutex);
+            _killPartitionCursors_inlock();
+        }
+        _finishCallback(status);
+    };
+
+    if (_isShuttingDown()) {
+        finishWithStatus({ErrorCodes::CallbackCanceled, "Cloner shutting down."});
+        return;
+    }
+    const auto& response = rcbd.response;
+    if (!response.isOK()) {
+        finishWithStatus(response.status);
+        return;
+    }
+    auto commandStatus = getStatusFromCommandResult(response.data);
+    if (commandStatus == ErrorCodes::NamespaceNotFound) {
+        finishWithStatus(Status::OK());
+        return;
+    }
+    if (!commandStatus.isOK()) {
+        finishWithStatus(commandStatus.withContext(
+            str::stream() << "Error querying collection '" << _sourceNss.ns() << "'"));
+        return;
+    }
+    auto cursorResponse = CursorResponse::parseFromBSON(response.data);
+    if (!cursorResponse.isOK()) {
+        finishWithStatus(cursorResponse.getStatus());
+        return;
+    }
+
+    UniqueLock lk(_mutex);
+    _partitionCursors.push_back(std::move(cursorResponse.getValue()));
+    if (_partitionCursors.size() < _stats.partitions.size()) {
+        auto scheduleStatus = _scheduleEstablishPartitionCursor_inlock(_partitionCursors.size());
+        if (!scheduleStatus.isOK()) {
+            lk.unlock();
+            finishWithStatus(scheduleStatus);
+        }
+        return;
+    }
+
+    // The 'AsyncResultsMerger' takes over the cursors and kills them if cloning fails.
+    auto cursorResponses = std::move(_partitionCursors);
+    _partitionCursors.clear();
+    lk.unlock();
+    _startCloningFromCursors(std::move(cursorResponses));
+}
+
+void CollectionCloner::_killPartitionCursors_inlock() {
+    std::vector<CursorId> cursorIds;
+    for (auto&& cursor : _partitionCursors) {
+        if (cursor.getCursorId() != 0) {
+            cursorIds.push_back(cursor.getCursorId());
+        }
+    }
+    _partitionCursors.clear();
+    if (cursorIds.empty()) {
+        return;
+    }
+    _executor
+        ->scheduleRemoteCommand(
+            RemoteCommandRequest(_source,
+                                 _sourceNss.db().toString(),
+                                 KillCursorsRequest(_sourceNss, cursorIds).toBSON(),
+                                 nullptr),
+            [](const executor::TaskExecutor::RemoteCommandCallbackArgs&) {})
+        .getStatus()
+        .ignore();
+}
+
+size_t CollectionCloner::_findPartition_inlock(const BSONObj& doc) const {
+    invariant(!_stats.partitions.empty());
+    auto id = doc["_id"];
+    auto it = std::upper_bound(_stats.partitions.begin(),
+                               _stats.partitions.end(),
+                               id,
+                               [](const BSONElement& value, const PartitionStats& partition) {
+                                   return value.woCompare(partition.min.firstElement(), false) < 0;
+                               });
+    return it == _stats.partitions.begin() ? 0 : (it - _stats.partitions.begin()) - 1;
+}
+
+void CollectionCloner::_startCloningFromCursors(std::vector<CursorResponse> cursorResponses) {
     // Initialize the 'AsyncResultsMerger'(ARM).
     std::vector<RemoteCursor> remoteCursors;
     for (auto&& cursorResponse : cursorResponses) {
@@ -867,6 +1175,11 @@ void CollectionCloner::_insertDocumentsCallback(
     }
     _documentsToInsert.swap(docs);
     _stats.documentsCopied += docs.size();
+    if (!_stats.partitions.empty()) {
+        for (auto&& doc : docs) {
+            ++_stats.partitions[_findPartition_inlock(doc)].documentsCopied;
+        }
+    }
     ++_stats.fetchBatches;
     _progressMeter.hit(int(docs.size()));
     invariant(_collLoader);
@@ -945,6 +1258,14 @@ void CollectionCloner::_finishCallback(const Status& status) {
 constexpr StringData CollectionCloner::Stats::kDocumentsToCopyFieldName;
 constexpr StringData CollectionCloner::Stats::kDocumentsCopiedFieldName;
 
+BSONObj CollectionCloner::PartitionStats::toBSON() const {
+    BSONObjBuilder bob;
+    bob.append("min", min);
+    bob.append("max", max);
+    bob.appendNumber("documentsCopied", documentsCopied);
+    return bob.obj();
+}
+
 std::string CollectionCloner::Stats::toString() const {
     return toBSON().toString();
 }
@@ -961,6 +1282,12 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
     builder->appendNumber(kDocumentsCopiedFieldName, documentsCopied);
     builder->appendNumber("indexes", indexes);
     builder->appendNumber("fetchedBatches", fetchBatches);
+    if (!partitions.empty()) {
+        BSONArrayBuilder partitionsBuilder(builder->subarrayStart("partitions"));
+        for (auto&& partition : partitions) {
+            partitionsBuilder.append(partition.toBSON());
+        }
+    }
     if (start != Date_t()) {
         builder->appendDate("start", start);
         if (end != Date_t()) {
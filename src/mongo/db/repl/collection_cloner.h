@@ -41,6 +41,7 @@
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/cursor_response.h"
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/callback_completion_guard.h"
 #include "mongo/db/repl/storage_interface.h"
@@ -69,6 +70,17 @@ public:
     using RemoteCommandCallbackArgs = executor::TaskExecutor::RemoteCommandCallbackArgs;
     using OnCompletionGuard = CallbackCompletionGuard<Status>;
 
+    /**
+     * Progress of one '_id' range of a collection that is cloned over several cursors.
+     */
+    struct PartitionStats {
+        BSONObj min;  // Inclusive, of the form {_id: <value>}.
+        BSONObj max;  // Exclusive, except for the last partition, whose max is {_id: MaxKey}.
+        size_t documentsCopied{0};
+
+        BSONObj toBSON() const;
+    };
+
     struct Stats {
         static constexpr StringData kDocumentsToCopyFieldName = "documentsToCopy"_sd;
         static constexpr StringData kDocumentsCopiedFieldName = "documentsCopied"_sd;
@@ -80,6 +92,8 @@ public:
         size_t documentsCopied{0};
         size_t indexes{0};
         size_t fetchBatches{0};
+        // Empty unless the collection is cloned as several '_id' ranges.
+        std::vector<PartitionStats> partitions;
 
         std::string toString() const;
         BSONObj toBSON() const;
@@ -196,6 +210,12 @@ private:
      */
     enum EstablishCursorsCommand { Find, ParallelCollScan };
 
+    /**
+     * Schedules the 'find' or 'parallelCollectionScan' command that establishes the cursors used
+     * to clone the whole collection.
+     */
+    Status _scheduleEstablishCollectionCursors(OperationContext* opCtx);
+
     /**
      * Parses the cursor responses from the 'find' or 'parallelCollectionScan' command
      * and passes them into the 'AsyncResultsMerger'.
@@ -203,6 +223,53 @@ private:
     void _establishCollectionCursorsCallback(const RemoteCommandCallbackArgs& rcbd,
                                              EstablishCursorsCommand cursorCommand);
 
+    /**
+     * Returns true if the collection should be cloned as several '_id' ranges, each read over its
+     * own cursor, rather than over a single cursor.
+     */
+    bool _shouldPartitionCollection() const;
+
+    /**
+     * Schedules an aggregation that samples '_id' values from the sync source. The samples are
+     * used to choose the boundaries of 'numPartitions' '_id' ranges of roughly equal size.
+     */
+    Status _scheduleSampleSplitPoints(int numPartitions);
+
+    /**
+     * Computes the partitions from the sampled '_id' values and establishes the cursor of the
+     * first one. Falls back to cloning over a single cursor if the sample is unusable.
+     */
+    void _sampleSplitPointsCallback(const RemoteCommandCallbackArgs& rcbd, int numPartitions);
+
+    /**
+     * Schedules a 'find' command with 'min' and 'max' bounds on the '_id' index to establish the
+     * cursor for the partition at index 'partition' in '_stats.partitions'.
+     */
+    Status _scheduleEstablishPartitionCursor_inlock(size_t partition);
+
+    /**
+     * Stores the cursor of one partition. Once every partition has a cursor, passes them all into
+     * the 'AsyncResultsMerger', which then fetches from the partitions concurrently.
+     */
+    void _establishPartitionCursorCallback(const RemoteCommandCallbackArgs& rcbd);
+
+    /**
+     * Kills the cursors in '_partitionCursors' on the sync source. Used when cloning stops before
+     * every partition has a cursor, since the 'AsyncResultsMerger' does not own them yet.
+     */
+    void _killPartitionCursors_inlock();
+
+    /**
+     * Returns the index in '_stats.partitions' of the partition that contains 'doc'.
+     */
+    size_t _findPartition_inlock(const BSONObj& doc) const;
+
+    /**
+     * Creates the 'AsyncResultsMerger' over 'cursorResponses' and schedules the handling of its
+     * first results.
+     */
+    void _startCloningFromCursors(std::vector<CursorResponse> cursorResponses);
+
     /**
      * Parses the response from a 'parallelCollectionScan' command into a vector of cursor
      * elements.
@@ -311,6 +378,17 @@ private:
     // (M) Scheduler used to determine if a cursor was closed because the collection was dropped.
     std::unique_ptr<RemoteCommandRetryScheduler> _verifyCollectionDroppedScheduler;
 
+    // (M) Scheduler used to sample '_id' values when choosing partition boundaries.
+    std::unique_ptr<RemoteCommandRetryScheduler> _sampleSplitPointsScheduler;
+
+    // (M) Schedulers used to establish the cursor of each partition, in partition order. They are
+    // kept until the cloner is destroyed because each one is started from its predecessor's
+    // callback.
+    std::vector<std::unique_ptr<RemoteCommandRetryScheduler>> _establishPartitionCursorsSchedulers;
+
+    // (M) Cursors established so far for the partitions in '_stats.partitions'.
+    std::vector<CursorResponse> _partitionCursors;
+
     // State transitions:
     // PreStart --> Running --> ShuttingDown --> Complete
     // It is possible to skip intermediate states. For example,
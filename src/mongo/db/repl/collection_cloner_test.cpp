@@ -37,10 +37,12 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/unittest/task_executor_proxy.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/mongoutils/str.h"
+#include "mongo/util/scopeguard.h"
 
 namespace {
 
@@ -1070,6 +1072,85 @@ TEST_F(CollectionClonerTest, InsertDocumentsMultipleBatches) {
     ASSERT_FALSE(collectionCloner->isActive());
 }
 
+TEST_F(CollectionClonerTest, PartitionedCloneEstablishesCursorPerIdRange) {
+    auto& params = ServerParameterSet::getGlobal()->getMap();
+    auto numPartitions = params.find("numInitialSyncCollectionClonerPartitions");
+    auto minDocsPerPartition = params.find("initialSyncCollectionClonerMinDocumentsPerPartition");
+    ASSERT(numPartitions != params.end());
+    ASSERT(minDocsPerPartition != params.end());
+    ASSERT_OK(numPartitions->second->setFromString("2"));
+    ON_BLOCK_EXIT([&] { invariantOK(numPartitions->second->setFromString("1")); });
+    ASSERT_OK(minDocsPerPartition->second->setFromString("1"));
+    ON_BLOCK_EXIT([&] { invariantOK(minDocsPerPartition->second->setFromString("100000")); });
+
+    ASSERT_OK(collectionCloner->startup());
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(getNet());
+        processNetworkResponse(createCountResponse(4));
+        processNetworkResponse(createListIndexesResponse(0, BSON_ARRAY(idIndexSpec)));
+    }
+    collectionCloner->waitForDbWorker();
+    ASSERT_TRUE(collectionStats.initCalled);
+
+    auto net = getNet();
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+
+        auto noi = net->getNextReadyRequest();
+        ASSERT_EQUALS("aggregate", std::string(noi->getRequest().cmdObj.firstElementFieldName()));
+        const BSONArray samples = BSON_ARRAY(BSON("_id" << 4) << BSON("_id" << 1)
+                                                              << BSON("_id" << 3)
+                                                              << BSON("_id" << 2));
+        scheduleNetworkResponse(noi, createCursorResponse(0, samples));
+        finishProcessingNetworkResponse();
+
+        // The sampled '_id' values split the collection into [MinKey, 3) and [3, MaxKey].
+        noi = net->getNextReadyRequest();
+        auto findCmd = noi->getRequest().cmdObj;
+        ASSERT_EQUALS("find", std::string(findCmd.firstElementFieldName()));
+        ASSERT_FALSE(findCmd.hasField("min"));
+        ASSERT_BSONOBJ_EQ(BSON("_id" << 3), findCmd["max"].Obj());
+        scheduleNetworkResponse(noi, createCursorResponse(1, BSONArray()));
+        finishProcessingNetworkResponse();
+
+        noi = net->getNextReadyRequest();
+        findCmd = noi->getRequest().cmdObj;
+        ASSERT_EQUALS("find", std::string(findCmd.firstElementFieldName()));
+        ASSERT_BSONOBJ_EQ(BSON("_id" << 3), findCmd["min"].Obj());
+        ASSERT_FALSE(findCmd.hasField("max"));
+        scheduleNetworkResponse(noi, createCursorResponse(2, BSONArray()));
+        finishProcessingNetworkResponse();
+    }
+    collectionCloner->waitForDbWorker();
+
+    // Both partitions are fetched from concurrently.
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+        ASSERT_TRUE(net->hasReadyRequests());
+        auto first = net->getNextReadyRequest();
+        ASSERT_TRUE(net->hasReadyRequests());
+        auto second = net->getNextReadyRequest();
+        for (auto&& noi : {first, second}) {
+            auto docs = noi->getRequest().cmdObj["getMore"].numberLong() == 1
+                ? BSON_ARRAY(BSON("_id" << 1) << BSON("_id" << 2))
+                : BSON_ARRAY(BSON("_id" << 3));
+            scheduleNetworkResponse(noi, createFinalCursorResponse(docs));
+        }
+        finishProcessingNetworkResponse();
+    }
+
+    collectionCloner->join();
+    ASSERT_OK(getStatus());
+    ASSERT_EQUALS(3, collectionStats.insertCount);
+    ASSERT_TRUE(collectionStats.commitCalled);
+
+    auto stats = collectionCloner->getStats();
+    ASSERT_EQUALS(3U, stats.documentsCopied);
+    ASSERT_EQUALS(2U, stats.partitions.size());
+    ASSERT_EQUALS(2U, stats.partitions[0].documentsCopied);
+    ASSERT_EQUALS(1U, stats.partitions[1].documentsCopied);
+}
+
 TEST_F(CollectionClonerTest, LastBatchContainsNoDocuments) {
     ASSERT_OK(collectionCloner->startup());
     ASSERT_TRUE(collectionCloner->isActive());
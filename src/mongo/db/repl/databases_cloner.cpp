@@ -61,6 +61,10 @@ using UniqueLock = stdx::unique_lock<stdx::mutex>;
 // The number of attempts for the listDatabases commands.
 MONGO_EXPORT_SERVER_PARAMETER(numInitialSyncListDatabasesAttempts, int, 3);
 
+// The number of databases cloned at the same time. Each database cloner clones one collection at a
+// time, so this also bounds the number of collections being cloned at once.
+MONGO_EXPORT_SERVER_PARAMETER(maxNumInitialSyncConcurrentDatabaseCloners, int, 1);
+
 }  // namespace
 
 
@@ -342,8 +346,9 @@ void DatabasesCloner::_onListDatabaseFinish(
                           << status.toString();
             }
         };
-        const auto onDbFinish = [this, dbName](const Status& status) {
-            _onEachDBCloneFinish(status, dbName);
+        const auto dbIndex = _databaseCloners.size();
+        const auto onDbFinish = [this, dbName, dbIndex](const Status& status) {
+            _onEachDBCloneFinish(status, dbName, dbIndex);
         };
         Status startStatus = Status::OK();
         try {
@@ -360,10 +365,6 @@ void DatabasesCloner::_onListDatabaseFinish(
             if (_scheduleDbWorkFn) {
                 dbCloner->setScheduleDbWorkFn_forTest(_scheduleDbWorkFn);
             }
-            // Start first database cloner.
-            if (_databaseCloners.empty()) {
-                startStatus = dbCloner->startup();
-            }
         } catch (...) {
             startStatus = exceptionToStatus();
         }
@@ -385,7 +386,38 @@ void DatabasesCloner::_onListDatabaseFinish(
         } else {
             _fail_inlock(&lk, _status);
         }
+        return;
+    }
+
+    auto startStatus = _startDatabaseCloners_inlock();
+    if (!startStatus.isOK()) {
+        _fail_inlock(&lk, startStatus);
+        return;
+    }
+}
+
+Status DatabasesCloner::_startDatabaseCloners_inlock() {
+    const size_t maxRunning =
+        static_cast<size_t>(std::max(1, maxNumInitialSyncConcurrentDatabaseCloners.load()));
+    while (_nextDatabaseClonerIndex < _databaseCloners.size() &&
+           _nextDatabaseClonerIndex - _stats.databasesCloned < maxRunning) {
+        // The 'admin' database is validated once it has been cloned, and users may authenticate
+        // against it while the rest of the initial sync runs, so it is not cloned alongside others.
+        if (_nextDatabaseClonerIndex > 0 && _stats.databasesCloned == 0 &&
+            StringData(_databaseCloners.front()->getDBName()).equalCaseInsensitive("admin")) {
+            break;
+        }
+        auto&& dbCloner = _databaseCloners[_nextDatabaseClonerIndex];
+        auto startStatus = dbCloner->startup();
+        if (!startStatus.isOK()) {
+            warning() << "failed to schedule database '" << dbCloner->getDBName() << "' ("
+                      << (_nextDatabaseClonerIndex + 1) << " of " << _databaseCloners.size()
+                      << ") due to " << startStatus.toString();
+            return startStatus;
+        }
+        ++_nextDatabaseClonerIndex;
     }
+    return Status::OK();
 }
 
 std::vector<std::shared_ptr<DatabaseCloner>> DatabasesCloner::_getDatabaseCloners() const {
@@ -398,10 +430,17 @@ RemoteCommandRetryScheduler* DatabasesCloner::_getListDatabasesScheduler() const
     return _listDBsScheduler.get();
 }
 
-void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::string& name) {
+void DatabasesCloner::_onEachDBCloneFinish(const Status& status,
+                                           const std::string& name,
+                                           size_t index) {
     UniqueLock lk(_mutex);
+    if (!_isActive_inlock() || !_finishFn) {
+        // Another database cloner has already failed the initial sync.
+        return;
+    }
+
     if (!status.isOK()) {
-        warning() << "database '" << name << "' (" << (_stats.databasesCloned + 1) << " of "
+        warning() << "database '" << name << "' (" << (index + 1) << " of "
                   << _databaseCloners.size() << ") clone failed due to " << status.toString();
         _fail_inlock(&lk, status);
         return;
@@ -435,13 +474,8 @@ void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::stri
         return;
     }
 
-    // Start next database cloner.
-    auto&& dbCloner = _databaseCloners[_stats.databasesCloned];
-    auto startStatus = dbCloner->startup();
+    auto startStatus = _startDatabaseCloners_inlock();
     if (!startStatus.isOK()) {
-        warning() << "failed to schedule database '" << name << "' ("
-                  << (_stats.databasesCloned + 1) << " of " << _databaseCloners.size()
-                  << ") due to " << startStatus.toString();
         _fail_inlock(&lk, startStatus);
         return;
     }
@@ -449,17 +483,21 @@ void DatabasesCloner::_onEachDBCloneFinish(const Status& status, const std::stri
 
 void DatabasesCloner::_fail_inlock(UniqueLock* lk, Status status) {
     LOG(3) << "DatabasesCloner::_fail_inlock called";
-    if (!_isActive_inlock()) {
+    if (!_isActive_inlock() || !_finishFn) {
         return;
     }
 
     _setStatus_inlock(status);
-    // TODO: shutdown outstanding work, like any cloners active
-    invariant(_finishFn);
     auto finish = _finishFn;
     _finishFn = {};
+    auto databaseCloners = _databaseCloners;
     lk->unlock();
 
+    // Stop the database cloners still running alongside the one that failed.
+    for (auto&& cloner : databaseCloners) {
+        cloner->shutdown();
+    }
+
     LOG(3) << "DatabasesCloner - calling _finishFn with status: " << _status;
     finish(status);
 
@@ -132,8 +132,17 @@ private:
     /** Will call the completion function, and become inactive. */
     void _succeed_inlock(stdx::unique_lock<stdx::mutex>* lk);
 
-    /** Called each time a database clone is finished */
-    void _onEachDBCloneFinish(const Status& status, const std::string& name);
+    /**
+     * Called each time a database clone is finished. 'index' is the position of the database's
+     * cloner in '_databaseCloners'.
+     */
+    void _onEachDBCloneFinish(const Status& status, const std::string& name, size_t index);
+
+    /**
+     * Starts database cloners, in order, until 'maxNumInitialSyncConcurrentDatabaseCloners' are
+     * running. The 'admin' database is always cloned on its own, before any other database.
+     */
+    Status _startDatabaseCloners_inlock();
 
     //  Callbacks
 
@@ -177,6 +186,7 @@ private:
 
     std::unique_ptr<RemoteCommandRetryScheduler> _listDBsScheduler;  // (M) scheduler for listDBs.
     std::vector<std::shared_ptr<DatabaseCloner>> _databaseCloners;   // (M) database cloners by name
+    size_t _nextDatabaseClonerIndex = 0;  // (M) index in '_databaseCloners' of the next to start.
     Stats _stats;                                                    // (M)
 
     // State transitions:
@@ -38,6 +38,7 @@
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/executor/network_interface_mock.h"
 #include "mongo/executor/thread_pool_task_executor_test_fixture.h"
 #include "mongo/stdx/mutex.h"
@@ -321,6 +322,37 @@ protected:
                                                   [](const Status&) {});
     }
 
+    /**
+     * Takes the ready listCollections requests off the network, keyed by the database each one
+     * is sent to.
+     */
+    std::map<std::string, NetworkInterfaceMock::NetworkOperationIterator>
+    getReadyListCollectionsRequests() {
+        NetworkInterfaceMock* net = getNet();
+        std::map<std::string, NetworkInterfaceMock::NetworkOperationIterator> requests;
+        while (net->hasReadyRequests()) {
+            auto noi = net->getNextReadyRequest();
+            ASSERT_EQUALS("listCollections"_sd,
+                          noi->getRequest().cmdObj.firstElement().fieldNameStringData());
+            requests.emplace(noi->getRequest().dbname, noi);
+        }
+        return requests;
+    }
+
+    /**
+     * Responds to a listCollections request with no collections, which finishes its database.
+     */
+    void processEmptyListCollectionsResponse(NetworkInterfaceMock::NetworkOperationIterator noi) {
+        const auto dbName = noi->getRequest().dbname;
+        scheduleNetworkResponse(noi,
+                                BSON("ok" << 1 << "cursor"
+                                          << BSON("id" << 0LL << "ns"
+                                                       << dbName + ".$cmd.listCollections"
+                                                       << "firstBatch"
+                                                       << BSONArray())));
+        getNet()->runReadyNetworkOperations();
+    }
+
 private:
     executor::ThreadPoolMock::Options makeThreadPoolMockOptions() const override;
 
@@ -896,6 +928,178 @@ TEST_F(DBsClonerTest, AdminDbValidationErrorShouldAbortTheCloner) {
     ASSERT_TRUE(isAdminDbValidFnCalled);
 }
 
+/**
+ * Sets 'maxNumInitialSyncConcurrentDatabaseCloners' for the duration of a test.
+ */
+class ConcurrentDBsClonerTest : public DBsClonerTest {
+protected:
+    void setMaxConcurrentDatabaseCloners(int maxCloners) {
+        auto& params = ServerParameterSet::getGlobal()->getMap();
+        auto param = params.find("maxNumInitialSyncConcurrentDatabaseCloners");
+        ASSERT(param != params.end());
+        _param = param->second;
+        ASSERT_OK(_param->setFromString(std::to_string(maxCloners)));
+    }
+
+    void tearDown() override {
+        if (_param) {
+            invariantOK(_param->setFromString("1"));
+        }
+        DBsClonerTest::tearDown();
+    }
+
+private:
+    ServerParameter* _param = nullptr;
+};
+
+TEST_F(ConcurrentDBsClonerTest, StartsUpToTheMaximumNumberOfDatabaseClonersAtOnce) {
+    setMaxConcurrentDatabaseCloners(2);
+
+    Status result = getDetectableErrorStatus();
+    DatabasesCloner cloner{&getStorage(),
+                           &getExecutor(),
+                           &getDbWorkThreadPool(),
+                           HostAndPort{"local:1234"},
+                           [](const BSONObj&) { return true; },
+                           [&result](const Status& status) {
+                               log() << "setting result to " << status;
+                               result = status;
+                           }};
+
+    ASSERT_OK(cloner.startup());
+    ASSERT_TRUE(cloner.isActive());
+
+    auto net = getNet();
+    executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+    scheduleNetworkResponse("listDatabases",
+                            fromjson("{ok:1, databases:[{name:'a'}, {name:'b'}, {name:'c'}]}"));
+    net->runReadyNetworkOperations();
+    ASSERT_TRUE(cloner.isActive());
+
+    // Cloning starts with the first two databases.
+    auto requests = getReadyListCollectionsRequests();
+    ASSERT_EQUALS(2U, requests.size());
+    ASSERT_EQUALS(1U, requests.count("a"));
+    ASSERT_EQUALS(1U, requests.count("b"));
+
+    // Once 'a' is cloned, 'c' starts while 'b' is still being cloned.
+    processEmptyListCollectionsResponse(requests["a"]);
+    ASSERT_TRUE(cloner.isActive());
+    auto nextRequests = getReadyListCollectionsRequests();
+    ASSERT_EQUALS(1U, nextRequests.size());
+    ASSERT_EQUALS(1U, nextRequests.count("c"));
+
+    processEmptyListCollectionsResponse(nextRequests["c"]);
+    ASSERT_TRUE(cloner.isActive());
+    processEmptyListCollectionsResponse(requests["b"]);
+
+    cloner.join();
+    ASSERT_FALSE(cloner.isActive());
+    ASSERT_OK(result);
+    ASSERT_EQUALS(3U, cloner.getStats().databasesCloned);
+}
+
+TEST_F(ConcurrentDBsClonerTest, AdminDatabaseIsClonedOnItsOwnBeforeOtherDatabases) {
+    setMaxConcurrentDatabaseCloners(3);
+
+    bool isAdminDbValidFnCalled = false;
+    _storageInterface.isAdminDbValidFn = [&isAdminDbValidFnCalled](OperationContext* opCtx) {
+        isAdminDbValidFnCalled = true;
+        return Status::OK();
+    };
+
+    Status result = getDetectableErrorStatus();
+    DatabasesCloner cloner{&getStorage(),
+                           &getExecutor(),
+                           &getDbWorkThreadPool(),
+                           HostAndPort{"local:1234"},
+                           [](const BSONObj&) { return true; },
+                           [&result](const Status& status) {
+                               log() << "setting result to " << status;
+                               result = status;
+                           }};
+
+    ASSERT_OK(cloner.startup());
+    ASSERT_TRUE(cloner.isActive());
+
+    auto net = getNet();
+    executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+    scheduleNetworkResponse("listDatabases",
+                            fromjson("{ok:1, databases:[{name:'a'}, {name:'admin'}, {name:'b'}]}"));
+    net->runReadyNetworkOperations();
+    ASSERT_TRUE(cloner.isActive());
+
+    // Only 'admin' is cloned until it has been validated.
+    auto requests = getReadyListCollectionsRequests();
+    ASSERT_EQUALS(1U, requests.size());
+    ASSERT_EQUALS(1U, requests.count("admin"));
+    ASSERT_FALSE(isAdminDbValidFnCalled);
+
+    processEmptyListCollectionsResponse(requests["admin"]);
+    ASSERT_TRUE(isAdminDbValidFnCalled);
+    ASSERT_TRUE(cloner.isActive());
+
+    // The remaining databases are then cloned together.
+    auto nextRequests = getReadyListCollectionsRequests();
+    ASSERT_EQUALS(2U, nextRequests.size());
+    ASSERT_EQUALS(1U, nextRequests.count("a"));
+    ASSERT_EQUALS(1U, nextRequests.count("b"));
+    processEmptyListCollectionsResponse(nextRequests["a"]);
+    processEmptyListCollectionsResponse(nextRequests["b"]);
+
+    cloner.join();
+    ASSERT_FALSE(cloner.isActive());
+    ASSERT_OK(result);
+}
+
+TEST_F(ConcurrentDBsClonerTest, FailingDatabaseClonerShutsDownTheClonersRunningAlongsideIt) {
+    setMaxConcurrentDatabaseCloners(3);
+
+    int finishCalls = 0;
+    Status result = getDetectableErrorStatus();
+    Status expectedStatus{ErrorCodes::NoSuchKey, "fake"};
+    DatabasesCloner cloner{&getStorage(),
+                           &getExecutor(),
+                           &getDbWorkThreadPool(),
+                           HostAndPort{"local:1234"},
+                           [](const BSONObj&) { return true; },
+                           [&result, &finishCalls](const Status& status) {
+                               log() << "setting result to " << status;
+                               result = status;
+                               ++finishCalls;
+                           }};
+
+    ASSERT_OK(cloner.startup());
+    ASSERT_TRUE(cloner.isActive());
+
+    auto net = getNet();
+    executor::NetworkInterfaceMock::InNetworkGuard guard(net);
+    scheduleNetworkResponse("listDatabases",
+                            fromjson("{ok:1, databases:[{name:'a'}, {name:'b'}, {name:'c'}]}"));
+    net->runReadyNetworkOperations();
+    ASSERT_TRUE(cloner.isActive());
+
+    auto requests = getReadyListCollectionsRequests();
+    ASSERT_EQUALS(3U, requests.size());
+
+    // 'b' fails while 'a' and 'c' are still being cloned.
+    net->scheduleResponse(requests["b"], net->now(), expectedStatus);
+    net->runReadyNetworkOperations();
+    ASSERT_FALSE(cloner.isActive());
+    ASSERT_EQUALS(expectedStatus, result);
+
+    // The other cloners were shut down, which canceled their listCollections requests.
+    net->runReadyNetworkOperations();
+    ASSERT_FALSE(net->hasReadyRequests());
+
+    cloner.join();
+    ASSERT_EQUALS(expectedStatus, result);
+    ASSERT_EQUALS(1, finishCalls);
+    for (auto&& dbStats : cloner.getStats().databaseStats) {
+        ASSERT_NOT_EQUALS(Date_t(), dbStats.end) << dbStats.dbname;
+    }
+}
+
 TEST_F(DBsClonerTest, SingleDatabaseCopiesCompletely) {
     const Responses resps = {
         // Clone Start
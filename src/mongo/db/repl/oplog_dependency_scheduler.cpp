@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_dependency_scheduler.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+
+constexpr size_t OplogDependencyScheduler::kMinOpsPerUnit;
+constexpr size_t OplogDependencyScheduler::kUnitsPerWriter;
+
+OplogDependencyScheduler::OplogDependencyScheduler(size_t numWriters, Mode mode)
+    : _numWriters(numWriters), _mode(mode) {
+    invariant(_numWriters > 0);
+    if (_mode == Mode::kStatic) {
+        _units.resize(_numWriters);
+    }
+}
+
+void OplogDependencyScheduler::addOp(const OplogEntry* op, uint32_t conflictKey) {
+    invariant(!_scheduled);
+    ++_numOps;
+
+    if (_mode == Mode::kStatic) {
+        auto& unit = _units[conflictKey % _numWriters];
+        if (unit.empty()) {
+            unit.reserve(8);  // Skip a few growth rounds
+        }
+        unit.push_back(op);
+        return;
+    }
+
+    auto result = _chainIndex.emplace(conflictKey, _chains.size());
+    if (result.second) {
+        _chains.emplace_back();
+    }
+    _chains[result.first->second].push_back(op);
+}
+
+void OplogDependencyScheduler::scheduleUnits() {
+    invariant(!_scheduled);
+    _scheduled = true;
+
+    if (_mode == Mode::kDynamic) {
+        _packChainsIntoUnits();
+    }
+
+    _units.erase(std::remove_if(_units.begin(),
+                                _units.end(),
+                                [](const OperationPtrs& unit) { return unit.empty(); }),
+                 _units.end());
+}
+
+void OplogDependencyScheduler::_packChainsIntoUnits() {
+    const size_t targetUnitSize =
+        std::max(kMinOpsPerUnit, _numOps / (_numWriters * kUnitsPerWriter));
+
+    // Chains are packed in the order their first operation appeared in the batch. Neighbouring
+    // chains are likely to be on the same namespace, which keeps bulk inserts grouped together. A
+    // chain is never split across units.
+    for (auto&& chain : _chains) {
+        if (chain.size() >= targetUnitSize) {
+            _units.emplace_back(std::move(chain));
+            continue;
+        }
+        if (_units.empty() || _units.back().size() + chain.size() > targetUnitSize) {
+            _units.emplace_back();
+            _units.back().reserve(targetUnitSize);
+        }
+        auto& unit = _units.back();
+        unit.insert(unit.end(), chain.begin(), chain.end());
+    }
+
+    _chains.clear();
+    _chainIndex.clear();
+
+    // Hand out the longest units first. A long chain started late would otherwise extend the batch
+    // while every other writer sits idle.
+    std::stable_sort(_units.begin(), _units.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.size() > rhs.size();
+    });
+}
+
+OplogDependencyScheduler::OperationPtrs* OplogDependencyScheduler::next() {
+    invariant(_scheduled);
+    const size_t index = _nextUnit.fetchAndAdd(1);
+    if (index >= _units.size()) {
+        return nullptr;
+    }
+    return &_units[index];
+}
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,149 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/base/disallow_copying.h"
+#include "mongo/db/repl/multiapplier.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * Decides which operations in an oplog application batch may be applied concurrently and hands
+ * them out to the writer threads.
+ *
+ * Every operation is tagged with a conflict key by the caller: operations that touch the same
+ * document share a key, and so do all operations on a collection that must be applied in
+ * collection order (capped collections, or storage engines without document-level locking).
+ * Operations with the same key form a chain that must be applied in batch order by a single
+ * writer. Chains with different keys have no ordering constraints between them, so the dependency
+ * graph of a batch is a set of independent chains.
+ *
+ * In kStatic mode each chain is assigned to writer 'key % numWriters', which is how batches have
+ * always been partitioned. A handful of hot documents can leave most writers idle in this mode.
+ *
+ * In kDynamic mode the chains are packed into work units of roughly equal size, and the units are
+ * handed out longest first to whichever writer asks for one next. A writer that finishes early
+ * keeps taking units that would otherwise have been queued behind an overloaded writer, so the
+ * time to apply a batch is bounded by its longest chain rather than its unluckiest hash bucket.
+ *
+ * Usage: call addOp() for every operation in the batch from a single thread, then call
+ * scheduleUnits() once. After that, next() may be called concurrently from any number of writer
+ * threads until it returns nullptr.
+ */
+class OplogDependencyScheduler {
+    MONGO_DISALLOW_COPYING(OplogDependencyScheduler);
+
+public:
+    using OperationPtrs = MultiApplier::OperationPtrs;
+
+    enum class Mode { kStatic, kDynamic };
+
+    // The smallest work unit that kDynamic mode builds out of independent chains. Small units
+    // would defeat the grouping of inserts that the writers perform within a unit.
+    static constexpr size_t kMinOpsPerUnit = 16;
+
+    // kDynamic mode aims for this many work units per writer so that an idle writer has something
+    // left to take when another writer is stuck on a long chain.
+    static constexpr size_t kUnitsPerWriter = 4;
+
+    OplogDependencyScheduler(size_t numWriters, Mode mode);
+
+    /**
+     * Adds 'op' to the end of the chain for 'conflictKey'. Must not be called after
+     * scheduleUnits().
+     */
+    void addOp(const OplogEntry* op, uint32_t conflictKey);
+
+    /**
+     * Packs the chains built by addOp() into work units. Must be called exactly once, before the
+     * first call to next().
+     */
+    void scheduleUnits();
+
+    /**
+     * Returns the next work unit to apply, or nullptr if every unit has been handed out. Each unit
+     * is returned exactly once. The caller may reorder the operations of the returned unit as
+     * long as operations on the same namespace keep their relative order.
+     *
+     * Safe to call concurrently.
+     */
+    OperationPtrs* next();
+
+    /**
+     * Returns the number of non-empty work units. Only valid after scheduleUnits().
+     */
+    size_t getNumUnits() const {
+        return _units.size();
+    }
+
+    /**
+     * Returns the work units in the order next() hands them out. Only valid after
+     * scheduleUnits(). Intended for testing.
+     */
+    const std::vector<OperationPtrs>& getUnits() const {
+        return _units;
+    }
+
+    size_t getNumOps() const {
+        return _numOps;
+    }
+
+    Mode getMode() const {
+        return _mode;
+    }
+
+private:
+    void _packChainsIntoUnits();
+
+    const size_t _numWriters;
+    const Mode _mode;
+
+    size_t _numOps = 0;
+    bool _scheduled = false;
+
+    // kDynamic mode only. Chains in the order their first operation was added, and the position of
+    // each conflict key's chain in '_chains'.
+    std::vector<OperationPtrs> _chains;
+    stdx::unordered_map<uint32_t, size_t> _chainIndex;
+
+    // Work units in the order they are handed out. In kStatic mode these are filled directly by
+    // addOp(), one per writer.
+    std::vector<OperationPtrs> _units;
+
+    AtomicWord<size_t> _nextUnit{0};
+};
+
+}  // namespace repl
+}  // namespace mongo
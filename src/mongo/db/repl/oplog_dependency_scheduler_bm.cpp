@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_dependency_scheduler.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/string_map.h"
+#include "third_party/murmurhash3/MurmurHash3.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+using Mode = OplogDependencyScheduler::Mode;
+
+const size_t kBatchSize = 10 * 1000;
+const size_t kNumWriters = 16;
+
+/**
+ * A batch of updates in which 'hotPercent' percent of the operations go to one of 'numHotDocs'
+ * documents and every other operation goes to a document of its own.
+ */
+struct SkewedBatch {
+    SkewedBatch(int numHotDocs, int hotPercent) {
+        PseudoRandom rand(12345);
+        const StringData ns = "test.hot";
+        ops.reserve(kBatchSize);
+        conflictKeys.reserve(kBatchSize);
+        for (size_t i = 0; i < kBatchSize; ++i) {
+            const bool hot = numHotDocs > 0 && rand.nextInt32(100) < hotPercent;
+            const int id = hot ? rand.nextInt32(numHotDocs) : numHotDocs + i;
+            ops.emplace_back(BSON("ts" << Timestamp(Seconds(1), i + 1) << "t" << 1LL << "h" << 1LL
+                                       << "v"
+                                       << 2
+                                       << "op"
+                                       << "u"
+                                       << "ns"
+                                       << ns
+                                       << "o"
+                                       << BSON("$set" << BSON("counter" << int(i)))
+                                       << "o2"
+                                       << BSON("_id" << id)));
+
+            // Same conflict key as fillWriterVectors() computes for a non-capped collection.
+            uint32_t hash = StringMapTraits::HashedKey(ns).hash();
+            const size_t idHash =
+                SimpleBSONElementComparator::kInstance.hash(ops.back().getIdElement());
+            MurmurHash3_x86_32(&idHash, sizeof(idHash), hash, &hash);
+            conflictKeys.push_back(hash);
+        }
+    }
+
+    std::vector<OplogEntry> ops;
+    std::vector<uint32_t> conflictKeys;
+};
+
+/**
+ * Stands in for applying an operation: walks the operation's BSON a fixed number of times.
+ */
+void simulateApply(const OplogDependencyScheduler::OperationPtrs& unit) {
+    for (auto&& op : unit) {
+        for (int i = 0; i < 50; ++i) {
+            benchmark::DoNotOptimize(SimpleBSONObjComparator::kInstance.hash(op->raw));
+        }
+    }
+}
+
+std::unique_ptr<ThreadPool> makeWriterPool() {
+    ThreadPool::Options options;
+    options.poolName = "oplog dependency scheduler benchmark";
+    options.maxThreads = options.minThreads = kNumWriters;
+    auto pool = stdx::make_unique<ThreadPool>(options);
+    pool->startup();
+    return pool;
+}
+
+void BM_ApplySkewedBatch(benchmark::State& state, Mode mode) {
+    const SkewedBatch batch(state.range(0), state.range(1));
+    auto writerPool = makeWriterPool();
+
+    for (auto keepRunning : state) {
+        OplogDependencyScheduler scheduler(kNumWriters, mode);
+        for (size_t i = 0; i < batch.ops.size(); ++i) {
+            scheduler.addOp(&batch.ops[i], batch.conflictKeys[i]);
+        }
+        scheduler.scheduleUnits();
+
+        const size_t numWriters = std::min(kNumWriters, scheduler.getNumUnits());
+        for (size_t i = 0; i < numWriters; ++i) {
+            invariantOK(writerPool->schedule([&scheduler] {
+                while (auto unit = scheduler.next()) {
+                    simulateApply(*unit);
+                }
+            }));
+        }
+        writerPool->waitForIdle();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch.ops.size());
+
+    writerPool->shutdown();
+    writerPool->join();
+}
+
+// Arguments are the number of hot documents and the percentage of operations that touch them.
+void skewedBatchArgs(benchmark::internal::Benchmark* b) {
+    b->Args({0, 0})->Args({4, 25})->Args({4, 50})->Args({32, 90})->UseRealTime();
+}
+
+BENCHMARK_CAPTURE(BM_ApplySkewedBatch, StaticHashing, Mode::kStatic)->Apply(skewedBatchArgs);
+BENCHMARK_CAPTURE(BM_ApplySkewedBatch, DynamicScheduling, Mode::kDynamic)->Apply(skewedBatchArgs);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
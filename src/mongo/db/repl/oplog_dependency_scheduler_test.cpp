@@ -0,0 +1,206 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_dependency_scheduler.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+using Mode = OplogDependencyScheduler::Mode;
+using OperationPtrs = OplogDependencyScheduler::OperationPtrs;
+
+std::vector<OplogEntry> makeInsertOps(int count) {
+    std::vector<OplogEntry> ops;
+    ops.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        ops.emplace_back(BSON("ts" << Timestamp(Seconds(1), i + 1) << "t" << 1LL << "h" << 1LL
+                                   << "v"
+                                   << 2
+                                   << "op"
+                                   << "i"
+                                   << "ns"
+                                   << "test.t"
+                                   << "o"
+                                   << BSON("_id" << i)));
+    }
+    return ops;
+}
+
+/**
+ * Returns the operations handed out by next(), in the order they were handed out.
+ */
+std::vector<OperationPtrs> drain(OplogDependencyScheduler* scheduler) {
+    std::vector<OperationPtrs> units;
+    while (auto unit = scheduler->next()) {
+        units.push_back(*unit);
+    }
+    ASSERT_FALSE(scheduler->next());
+    return units;
+}
+
+TEST(OplogDependencySchedulerTest, StaticModeAssignsOperationsByKeyModuloWriters) {
+    auto ops = makeInsertOps(6);
+    OplogDependencyScheduler scheduler(4, Mode::kStatic);
+    for (size_t i = 0; i < ops.size(); ++i) {
+        scheduler.addOp(&ops[i], i);
+    }
+    scheduler.scheduleUnits();
+
+    // Keys 0..5 over 4 writers: writers 0 and 1 receive two operations each, the rest one.
+    auto units = drain(&scheduler);
+    ASSERT_EQUALS(4U, units.size());
+    ASSERT(units[0] == OperationPtrs({&ops[0], &ops[4]}));
+    ASSERT(units[1] == OperationPtrs({&ops[1], &ops[5]}));
+    ASSERT(units[2] == OperationPtrs({&ops[2]}));
+    ASSERT(units[3] == OperationPtrs({&ops[3]}));
+}
+
+TEST(OplogDependencySchedulerTest, StaticModeSkipsIdleWriters) {
+    auto ops = makeInsertOps(3);
+    OplogDependencyScheduler scheduler(16, Mode::kStatic);
+    for (auto&& op : ops) {
+        scheduler.addOp(&op, 7);
+    }
+    scheduler.scheduleUnits();
+
+    ASSERT_EQUALS(1U, scheduler.getNumUnits());
+    auto units = drain(&scheduler);
+    ASSERT(units[0] == OperationPtrs({&ops[0], &ops[1], &ops[2]}));
+}
+
+TEST(OplogDependencySchedulerTest, DynamicModeKeepsChainsTogetherAndInOrder) {
+    auto ops = makeInsertOps(1000);
+    OplogDependencyScheduler scheduler(4, Mode::kDynamic);
+    for (size_t i = 0; i < ops.size(); ++i) {
+        scheduler.addOp(&ops[i], i % 37);
+    }
+    scheduler.scheduleUnits();
+
+    // Every chain must be wholly contained in one unit, and appear there in batch order.
+    std::vector<int> unitForKey(37, -1);
+    std::vector<const OplogEntry*> lastForKey(37, nullptr);
+    size_t numOps = 0;
+    auto units = drain(&scheduler);
+    for (size_t u = 0; u < units.size(); ++u) {
+        for (auto op : units[u]) {
+            const size_t key = (op - &ops[0]) % 37;
+            if (unitForKey[key] == -1) {
+                unitForKey[key] = u;
+            }
+            ASSERT_EQUALS(unitForKey[key], static_cast<int>(u));
+            ASSERT(lastForKey[key] < op);
+            lastForKey[key] = op;
+            ++numOps;
+        }
+    }
+    ASSERT_EQUALS(ops.size(), numOps);
+    ASSERT_EQUALS(ops.size(), scheduler.getNumOps());
+}
+
+TEST(OplogDependencySchedulerTest, DynamicModeHandsOutHotChainFirst) {
+    auto ops = makeInsertOps(400);
+    OplogDependencyScheduler scheduler(4, Mode::kDynamic);
+
+    // The first 200 operations are on distinct documents. The rest all update the same document.
+    for (size_t i = 0; i < ops.size(); ++i) {
+        scheduler.addOp(&ops[i], i < 200 ? i : 12345);
+    }
+    scheduler.scheduleUnits();
+
+    auto units = drain(&scheduler);
+    ASSERT_GREATER_THAN(units.size(), 1U);
+    ASSERT_EQUALS(200U, units[0].size());
+    ASSERT(units[0].front() == &ops[200]);
+    ASSERT(units[0].back() == &ops[399]);
+
+    // The independent operations are spread over units no larger than the target unit size.
+    const size_t targetUnitSize =
+        std::max(OplogDependencyScheduler::kMinOpsPerUnit,
+                 ops.size() / (4 * OplogDependencyScheduler::kUnitsPerWriter));
+    for (size_t u = 1; u < units.size(); ++u) {
+        ASSERT_LESS_THAN_OR_EQUALS(units[u].size(), targetUnitSize);
+        ASSERT_LESS_THAN_OR_EQUALS(units[u].size(), units[u - 1].size());
+    }
+}
+
+TEST(OplogDependencySchedulerTest, DynamicModeKeepsSmallBatchesInOneUnit) {
+    auto ops = makeInsertOps(5);
+    OplogDependencyScheduler scheduler(16, Mode::kDynamic);
+    for (size_t i = 0; i < ops.size(); ++i) {
+        scheduler.addOp(&ops[i], i);
+    }
+    scheduler.scheduleUnits();
+
+    auto units = drain(&scheduler);
+    ASSERT_EQUALS(1U, units.size());
+    ASSERT(units[0] == OperationPtrs({&ops[0], &ops[1], &ops[2], &ops[3], &ops[4]}));
+}
+
+TEST(OplogDependencySchedulerTest, ConcurrentWritersReceiveEveryUnitExactlyOnce) {
+    auto ops = makeInsertOps(5000);
+    OplogDependencyScheduler scheduler(8, Mode::kDynamic);
+    for (size_t i = 0; i < ops.size(); ++i) {
+        scheduler.addOp(&ops[i], i % 1000);
+    }
+    scheduler.scheduleUnits();
+
+    std::vector<std::vector<const OplogEntry*>> applied(8);
+    std::vector<stdx::thread> writers;
+    for (size_t i = 0; i < applied.size(); ++i) {
+        writers.emplace_back([&scheduler, &writerOps = applied[i]] {
+            while (auto unit = scheduler.next()) {
+                writerOps.insert(writerOps.end(), unit->begin(), unit->end());
+            }
+        });
+    }
+    for (auto&& writer : writers) {
+        writer.join();
+    }
+
+    std::vector<const OplogEntry*> all;
+    for (auto&& writerOps : applied) {
+        all.insert(all.end(), writerOps.begin(), writerOps.end());
+    }
+    std::sort(all.begin(), all.end());
+    ASSERT_EQUALS(ops.size(), all.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        ASSERT(all[i] == &ops[i]);
+    }
+}
+
+}  // namespace
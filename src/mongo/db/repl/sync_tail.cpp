@@ -63,6 +63,7 @@
 #include "mongo/db/repl/bgsync.h"
 #include "mongo/db/repl/initial_syncer.h"
 #include "mongo/db/repl/multiapplier.h"
+#include "mongo/db/repl/oplog_dependency_scheduler.h"
 #include "mongo/db/repl/oplogreader.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/repl_set_config.h"
@@ -134,6 +135,19 @@ public:
     }
 } exportedBatchLimitOperationsParam;
 
+/**
+ * When set, writer threads take work units from a shared queue built by OplogDependencyScheduler
+ * instead of each applying a fixed 'hash % replWriterThreadCount' share of the batch.
+ */
+MONGO_EXPORT_SERVER_PARAMETER(replWriterDynamicScheduling, bool, false);
+
+/**
+ * When set, the next batch is written to the oplog and partitioned among the writer threads while
+ * the current batch is being applied. Only used with storage engines that support document-level
+ * locking.
+ */
+MONGO_EXPORT_SERVER_PARAMETER(replPipelinedBatchApplication, bool, false);
+
 // The oplog entries applied
 Counter64 opsAppliedStats;
 ServerStatusMetricField<Counter64> displayOpsApplied("repl.apply.ops", &opsAppliedStats);
@@ -147,6 +161,11 @@ ServerStatusMetricField<Counter64> displayAttemptsToBecomeSecondary(
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// Number of batches that were written to the oplog while the previous batch was being applied.
+Counter64 pipelinedBatchesStats;
+ServerStatusMetricField<Counter64> displayPipelinedBatches("repl.apply.pipelinedBatches",
+                                                           &pipelinedBatchesStats);
+
 class ApplyBatchFinalizer {
 public:
     ApplyBatchFinalizer(ReplicationCoordinator* replCoord) : _replCoord(replCoord) {}
@@ -428,28 +447,37 @@ void prefetchOps(const MultiApplier::Operations& ops, ThreadPool* prefetcherPool
     prefetcherPool->waitForIdle();
 }
 
-// Doles out all the work to the writer pool threads.
-// Does not modify writerVectors, but passes non-const pointers to inner vectors into func.
-void applyOps(std::vector<MultiApplier::OperationPtrs>& writerVectors,
+// Doles out all the work to the writer pool threads. Each writer keeps taking work units from
+// 'scheduler' until there are none left or applying one fails.
+// Passes non-const pointers to the scheduler's work units into func.
+void applyOps(OplogDependencyScheduler* scheduler,
               ThreadPool* writerPool,
               const SyncTail::MultiSyncApplyFunc& func,
               SyncTail* st,
               std::vector<Status>* statusVector,
               std::vector<WorkerMultikeyPathInfo>* workerMultikeyPathInfo) {
-    invariant(writerVectors.size() == statusVector->size());
-    for (size_t i = 0; i < writerVectors.size(); i++) {
-        if (!writerVectors[i].empty()) {
-            invariantOK(writerPool->schedule([
-                &func,
-                st,
-                &writer = writerVectors.at(i),
-                &status = statusVector->at(i),
-                &workerMultikeyPathInfo = workerMultikeyPathInfo->at(i)
-            ] {
-                auto opCtx = cc().makeOperationContext();
-                status = func(opCtx.get(), &writer, st, &workerMultikeyPathInfo);
-            }));
-        }
+    invariant(workerMultikeyPathInfo->size() == statusVector->size());
+    const size_t numWriters = std::min(statusVector->size(), scheduler->getNumUnits());
+    for (size_t i = 0; i < numWriters; i++) {
+        invariantOK(writerPool->schedule([
+            &func,
+            st,
+            scheduler,
+            &status = statusVector->at(i),
+            &workerMultikeyPathInfo = workerMultikeyPathInfo->at(i)
+        ] {
+            auto opCtx = cc().makeOperationContext();
+            while (auto unit = scheduler->next()) {
+                WorkerMultikeyPathInfo unitMultikeyPathInfo;
+                status = func(opCtx.get(), unit, st, &unitMultikeyPathInfo);
+                if (!status.isOK()) {
+                    return;
+                }
+                workerMultikeyPathInfo.insert(workerMultikeyPathInfo.end(),
+                                              unitMultikeyPathInfo.begin(),
+                                              unitMultikeyPathInfo.end());
+            }
+        }));
     }
 }
 
@@ -561,18 +589,18 @@ private:
 /**
  * ops - This only modifies the isForCappedCollection field on each op. It does not alter the ops
  *      vector in any other way.
- * writerVectors - Set of operations for each worker thread to apply.
+ * scheduler - Receives each operation along with the hash that determines which other operations
+ *      it must be applied in order with.
  * applyOpsOperations - If provided, stores extracted applyOps operations.
  */
 void fillWriterVectors(OperationContext* opCtx,
                        MultiApplier::Operations* ops,
-                       std::vector<MultiApplier::OperationPtrs>* writerVectors,
+                       OplogDependencyScheduler* scheduler,
                        std::vector<MultiApplier::Operations>* applyOpsOperations) {
     const auto serviceContext = opCtx->getServiceContext();
     const auto storageEngine = serviceContext->getGlobalStorageEngine();
 
     const bool supportsDocLocking = storageEngine->supportsDocLocking();
-    const uint32_t numWriters = writerVectors->size();
 
     CachedCollectionProperties collPropertiesCache;
 
@@ -609,7 +637,7 @@ void fillWriterVectors(OperationContext* opCtx,
             try {
                 applyOpsOperations->emplace_back(ApplyOps::extractOperations(op));
                 fillWriterVectors(
-                    opCtx, &applyOpsOperations->back(), writerVectors, applyOpsOperations);
+                    opCtx, &applyOpsOperations->back(), scheduler, applyOpsOperations);
             } catch (...) {
                 fassertFailedWithStatusNoTrace(
                     50711,
@@ -620,16 +648,55 @@ void fillWriterVectors(OperationContext* opCtx,
             continue;
         }
 
-        auto& writer = (*writerVectors)[hash % numWriters];
-        if (writer.empty()) {
-            writer.reserve(8);  // Skip a few growth rounds
-        }
-        writer.push_back(&op);
+        scheduler->addOp(&op, hash);
     }
 }
 
+/**
+ * Returns true if 'ops' may be applied while the batch after it is being prepared, or prepared
+ * while the batch before it is being applied. Commands can change the collection properties that
+ * partitioning depends on, so batches containing them are never overlapped with another batch.
+ */
+bool canPipelineBatch(const MultiApplier::Operations& ops) {
+    return !ops.empty() && std::none_of(ops.cbegin(), ops.cend(), [](const OplogEntry& op) {
+        return op.isCommand();
+    });
+}
+
 }  // namespace
 
+/**
+ * A batch of operations along with the state that SyncTail builds for it before the writer threads
+ * can apply it. In pipelined mode this state is built for the next batch while the current batch is
+ * being applied.
+ */
+class SyncTail::PreparedBatch {
+    MONGO_DISALLOW_COPYING(PreparedBatch);
+
+public:
+    PreparedBatch(MultiApplier::Operations batchOps,
+                  size_t numWriters,
+                  OplogDependencyScheduler::Mode mode)
+        : ops(std::move(batchOps)), scheduler(numWriters, mode) {}
+
+    const MultiApplier::Operations ops;
+
+    // Set once every entry in 'ops' has been scheduled to be written to the oplog.
+    bool writtenToOplog = false;
+
+    // Set once every operation has been handed to 'scheduler'.
+    bool partitioned = false;
+
+    // Holds extracted applyOps operations. Must stay in scope until all operations in
+    // 'opsWithTxnUpdates' and 'applyOpsOperations' have been applied.
+    std::vector<MultiApplier::Operations> applyOpsOperations;
+
+    // A copy of 'ops' with reconstructed writes to config.transactions added.
+    MultiApplier::Operations opsWithTxnUpdates;
+
+    OplogDependencyScheduler scheduler;
+};
+
 namespace {
 void tryToGoLiveAsASecondary(OperationContext* opCtx,
                              ReplicationCoordinator* replCoord,
@@ -811,6 +878,27 @@ void SyncTail::oplogApplication(OplogBuffer* oplogBuffer, ReplicationCoordinator
     ReplicationConsistencyMarkers* consistencyMarkers = replProcess->getConsistencyMarkers();
     OpTime minValid;
 
+    // In pipelined mode, the batch that was written to the oplog and partitioned while the previous
+    // batch was being applied.
+    std::unique_ptr<PreparedBatch> nextBatch;
+
+    // In pipelined mode, a batch that was taken from the batcher while the previous batch was being
+    // applied but could not be prepared early. It is applied next, the usual way.
+    boost::optional<OpQueue> pendingOps;
+
+    auto getNextBatchToPrepare = [&]() -> std::unique_ptr<PreparedBatch> {
+        invariant(!pendingOps);
+        OpQueue ops = batcher.getNextBatch(Seconds(0));
+        if (ops.empty() && !ops.mustShutdown()) {
+            return nullptr;
+        }
+        if (!canPipelineBatch(ops.getBatch())) {
+            pendingOps = std::move(ops);
+            return nullptr;
+        }
+        return _makePreparedBatch(ops.releaseBatch());
+    };
+
     while (true) {  // Exits on message from OpQueueBatcher.
         // Use a new operation context each iteration, as otherwise we may appear to use a single
         // collection name to refer to collections with different UUIDs.
@@ -839,25 +927,30 @@ void SyncTail::oplogApplication(OplogBuffer* oplogBuffer, ReplicationCoordinator
         tryToGoLiveAsASecondary(&opCtx, replCoord, minValid);
 
         long long termWhenBufferIsEmpty = replCoord->getTerm();
-        // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
-        // ready in time, we'll loop again so we can do the above checks periodically.
-        OpQueue ops = batcher.getNextBatch(Seconds(1));
-        if (ops.empty()) {
-            if (ops.mustShutdown()) {
-                // Shut down and exit oplog application loop.
-                return;
-            }
-            if (MONGO_FAIL_POINT(rsSyncApplyStop)) {
-                continue;
+        std::unique_ptr<PreparedBatch> batch = std::move(nextBatch);
+        if (!batch) {
+            // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
+            // ready in time, we'll loop again so we can do the above checks periodically.
+            OpQueue ops = pendingOps ? std::move(*pendingOps) : batcher.getNextBatch(Seconds(1));
+            pendingOps = boost::none;
+            if (ops.empty()) {
+                if (ops.mustShutdown()) {
+                    // Shut down and exit oplog application loop.
+                    return;
+                }
+                if (MONGO_FAIL_POINT(rsSyncApplyStop)) {
+                    continue;
+                }
+                // Signal drain complete if we're in Draining state and the buffer is empty.
+                replCoord->signalDrainComplete(&opCtx, termWhenBufferIsEmpty);
+                continue;  // Try again.
             }
-            // Signal drain complete if we're in Draining state and the buffer is empty.
-            replCoord->signalDrainComplete(&opCtx, termWhenBufferIsEmpty);
-            continue;  // Try again.
+            batch = _makePreparedBatch(ops.releaseBatch());
         }
 
-        // Extract some info from ops that we'll need after releasing the batch below.
-        const auto firstOpTimeInBatch = ops.front().getOpTime();
-        const auto lastOpTimeInBatch = ops.back().getOpTime();
+        // Extract some info from the batch that we'll need after applying it below.
+        const auto firstOpTimeInBatch = batch->ops.front().getOpTime();
+        const auto lastOpTimeInBatch = batch->ops.back().getOpTime();
         const auto lastAppliedOpTimeAtStartOfBatch = replCoord->getMyLastAppliedOpTime();
 
         // Make sure the oplog doesn't go back in time or repeat an entry.
@@ -874,10 +967,17 @@ void SyncTail::oplogApplication(OplogBuffer* oplogBuffer, ReplicationCoordinator
         // Don't allow the fsync+lock thread to see intermediate states of batch application.
         stdx::lock_guard<SimpleMutex> fsynclk(filesLockedFsync);
 
-        // Apply the operations in this batch. 'multiApply' returns the optime of the last op that
-        // was applied, which should be the last optime in the batch.
-        auto lastOpTimeAppliedInBatch =
-            fassertNoTrace(34437, multiApply(&opCtx, ops.releaseBatch()));
+        // Apply the operations in this batch. '_multiApply' returns the optime of the last op that
+        // was applied, which should be the last optime in the batch. In pipelined mode it also
+        // writes the following batch to the oplog, if one is ready, and returns it in 'nextBatch'.
+        const bool pipelined = replPipelinedBatchApplication.load() &&
+            opCtx.getServiceContext()->getGlobalStorageEngine()->supportsDocLocking();
+        auto lastOpTimeAppliedInBatch = fassertNoTrace(
+            34437,
+            _multiApply(&opCtx,
+                        batch.get(),
+                        pipelined ? getNextBatchToPrepare : GetNextBatchFn(),
+                        &nextBatch));
         invariant(lastOpTimeAppliedInBatch == lastOpTimeInBatch);
 
         // In order to provide resilience in the event of a crash in the middle of batch
@@ -1239,7 +1339,7 @@ Status multiSyncApply(OperationContext* opCtx,
 
     invariant(!MultikeyPathTracker::get(opCtx).isTrackingMultikeyPathInfo());
     invariant(workerMultikeyPathInfo->empty());
-    auto newPaths = MultikeyPathTracker::get(opCtx).getMultikeyPathInfo();
+    auto newPaths = MultikeyPathTracker::get(opCtx).releaseMultikeyPathInfo();
     if (!newPaths.empty()) {
         workerMultikeyPathInfo->swap(newPaths);
     }
@@ -1294,7 +1394,7 @@ Status multiInitialSyncApply(OperationContext* opCtx,
 
     invariant(!MultikeyPathTracker::get(opCtx).isTrackingMultikeyPathInfo());
     invariant(workerMultikeyPathInfo->empty());
-    auto newPaths = MultikeyPathTracker::get(opCtx).getMultikeyPathInfo();
+    auto newPaths = MultikeyPathTracker::get(opCtx).releaseMultikeyPathInfo();
     if (!newPaths.empty()) {
         workerMultikeyPathInfo->swap(newPaths);
     }
@@ -1302,8 +1402,51 @@ Status multiInitialSyncApply(OperationContext* opCtx,
     return Status::OK();
 }
 
+std::unique_ptr<SyncTail::PreparedBatch> SyncTail::_makePreparedBatch(
+    MultiApplier::Operations ops) {
+    return stdx::make_unique<PreparedBatch>(std::move(ops),
+                                            _writerPool->getStats().numThreads,
+                                            replWriterDynamicScheduling.load()
+                                                ? OplogDependencyScheduler::Mode::kDynamic
+                                                : OplogDependencyScheduler::Mode::kStatic);
+}
+
+void SyncTail::_writeBatchToOplog(OperationContext* opCtx, PreparedBatch* batch) {
+    invariant(!batch->writtenToOplog);
+    auto consistencyMarkers = ReplicationProcess::get(opCtx)->getConsistencyMarkers();
+    consistencyMarkers->setOplogTruncateAfterPoint(opCtx, batch->ops.front().getTimestamp());
+    scheduleWritesToOplog(opCtx, _writerPool, batch->ops);
+    batch->writtenToOplog = true;
+}
+
+void SyncTail::_partitionBatch(OperationContext* opCtx, PreparedBatch* batch) {
+    invariant(!batch->partitioned);
+
+    // Normal writes to config.transactions in the primary don't create an oplog entry.
+    // Reconstruct these ops so config.transactions will be replicated correctly.
+    // Need to create a new copy of ops vector because the workerPool is also concurrently
+    // reading it and we don't want the new oplog entries to get written to the actual
+    // oplog.rs collection.
+    batch->opsWithTxnUpdates = Session::addOpsForReplicatingTxnTable(batch->ops);
+
+    fillWriterVectors(
+        opCtx, &batch->opsWithTxnUpdates, &batch->scheduler, &batch->applyOpsOperations);
+    batch->scheduler.scheduleUnits();
+    batch->partitioned = true;
+}
+
 StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::Operations ops) {
     invariant(!ops.empty());
+    auto batch = _makePreparedBatch(std::move(ops));
+    return _multiApply(opCtx, batch.get(), GetNextBatchFn(), nullptr);
+}
+
+StatusWith<OpTime> SyncTail::_multiApply(OperationContext* opCtx,
+                                         PreparedBatch* batch,
+                                         const GetNextBatchFn& getNextBatch,
+                                         std::unique_ptr<PreparedBatch>* nextBatch) {
+    const auto& ops = batch->ops;
+    invariant(!ops.empty());
 
     if (isMMAPV1()) {
         // Use a ThreadPool to prefetch all the operations in a batch.
@@ -1333,23 +1476,15 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
         // because the spawned threads refer to objects on the stack
         ON_BLOCK_EXIT([&] { _writerPool->waitForIdle(); });
 
-        // Write batch of ops into oplog.
-        consistencyMarkers->setOplogTruncateAfterPoint(opCtx, ops.front().getTimestamp());
-        scheduleWritesToOplog(opCtx, _writerPool, ops);
-
-        // Holds extracted applyOps operations. Keep in scope until all operations in 'ops' and
-        // 'applyOpsOperations' have been applied.
-        std::vector<MultiApplier::Operations> applyOpsOperations;
-
-        // Normal writes to config.transactions in the primary don't create an oplog entry.
-        // Reconstruct these ops so config.transactions will be replicated correctly.
-        // Need to create a new copy of ops vector because the workerPool is also concurrently
-        // reading it and we don't want the new oplog entries to get written to the actual
-        // oplog.rs collection.
-        auto opsWithTxnUpdates = Session::addOpsForReplicatingTxnTable(ops);
+        // Write batch of ops into oplog, unless that was done while the previous batch was being
+        // applied.
+        if (!batch->writtenToOplog) {
+            _writeBatchToOplog(opCtx, batch);
+        }
 
-        std::vector<MultiApplier::OperationPtrs> writerVectors(_writerPool->getStats().numThreads);
-        fillWriterVectors(opCtx, &opsWithTxnUpdates, &writerVectors, &applyOpsOperations);
+        if (!batch->partitioned) {
+            _partitionBatch(opCtx, batch);
+        }
 
         // Wait for writes to finish before applying ops.
         _writerPool->waitForIdle();
@@ -1360,7 +1495,24 @@ StatusWith<OpTime> SyncTail::multiApply(OperationContext* opCtx, MultiApplier::O
 
         {
             std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
-            applyOps(writerVectors, _writerPool, _applyFunc, this, &statusVector, &multikeyVector);
+            applyOps(
+                &batch->scheduler, _writerPool, _applyFunc, this, &statusVector, &multikeyVector);
+
+            // While the writer threads apply this batch, write the next batch to the oplog and
+            // partition it. The oplog writes queue behind this batch's work units, so they are
+            // picked up by whichever writers run out of work first. The oplog truncate after point
+            // now covers the next batch only: if we crash before it is applied, startup recovery
+            // truncates the next batch and reapplies this one from 'appliedThrough'.
+            if (getNextBatch && canPipelineBatch(ops)) {
+                invariant(nextBatch && !*nextBatch);
+                *nextBatch = getNextBatch();
+                if (*nextBatch) {
+                    _writeBatchToOplog(opCtx, nextBatch->get());
+                    _partitionBatch(opCtx, nextBatch->get());
+                    pipelinedBatchesStats.increment();
+                }
+            }
+
             _writerPool->waitForIdle();
 
             // If any of the statuses is not ok, return error.
@@ -244,6 +244,41 @@ private:
     void _consume(OperationContext* opCtx, OplogBuffer* oplogBuffer);
 
     class OpQueueBatcher;
+    class PreparedBatch;
+
+    /**
+     * Returns the batch that follows the one currently being applied, if one is ready and may be
+     * prepared ahead of its turn. Otherwise returns nullptr.
+     */
+    using GetNextBatchFn = stdx::function<std::unique_ptr<PreparedBatch>()>;
+
+    std::unique_ptr<PreparedBatch> _makePreparedBatch(MultiApplier::Operations ops);
+
+    /**
+     * Sets the oplog truncate after point to the start of 'batch' and schedules the writes of its
+     * entries to the oplog on the writer pool. The caller must wait for the writer pool to become
+     * idle before relying on the writes.
+     */
+    void _writeBatchToOplog(OperationContext* opCtx, PreparedBatch* batch);
+
+    /**
+     * Adds the reconstructed config.transactions writes to 'batch' and hands all of its operations
+     * to its scheduler.
+     */
+    void _partitionBatch(OperationContext* opCtx, PreparedBatch* batch);
+
+    /**
+     * Applies 'batch' as described for multiApply(), skipping the stages that were already done
+     * for it while the previous batch was being applied.
+     *
+     * If 'getNextBatch' is provided and returns a batch, that batch is written to the oplog and
+     * partitioned while 'batch' is being applied, and is returned through 'nextBatch'. The oplog
+     * truncate after point is left covering the next batch until it is applied.
+     */
+    StatusWith<OpTime> _multiApply(OperationContext* opCtx,
+                                   PreparedBatch* batch,
+                                   const GetNextBatchFn& getNextBatch,
+                                   std::unique_ptr<PreparedBatch>* nextBatch);
 
     std::string _hostname;
 
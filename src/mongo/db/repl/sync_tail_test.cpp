@@ -58,6 +58,7 @@
 #include "mongo/db/repl/replication_process.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/sync_tail.h"
+#include "mongo/db/server_parameters.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/db/session_catalog.h"
@@ -492,6 +493,71 @@ TEST_F(SyncTailTest, MultiApplyAssignsOperationsToWriterThreadsBasedOnNamespaceH
     ASSERT_EQUALS(op2, lastEntry);
 }
 
+TEST_F(SyncTailTest, MultiApplyWithDynamicSchedulingAppliesEachOperationOnceInDocumentOrder) {
+    auto param = ServerParameterSet::getGlobal()->getMap().find("replWriterDynamicScheduling");
+    ASSERT(param != ServerParameterSet::getGlobal()->getMap().end());
+    ASSERT_OK(param->second->setFromString("true"));
+    ON_BLOCK_EXIT([&] { invariantOK(param->second->setFromString("false")); });
+
+    NamespaceString nss1("test.t0");
+    NamespaceString nss2("test.t1");
+    auto writerPool = SyncTail::makeWriterPool(4);
+
+    stdx::mutex mutex;
+    std::vector<MultiApplier::Operations> operationsApplied;
+    auto applyOperationFn =
+        [&mutex, &operationsApplied](OperationContext* opCtx,
+                                     MultiApplier::OperationPtrs* operationsForWriterThreadToApply,
+                                     SyncTail* st,
+                                     WorkerMultikeyPathInfo*) -> Status {
+        stdx::lock_guard<stdx::mutex> lock(mutex);
+        operationsApplied.emplace_back();
+        for (auto&& opPtr : *operationsForWriterThreadToApply) {
+            operationsApplied.back().push_back(*opPtr);
+        }
+        return Status::OK();
+    };
+
+    // Inserts of distinct documents into 'nss1' interleaved with updates to a single hot document
+    // in 'nss2'.
+    MultiApplier::Operations ops;
+    for (int i = 0; i < 200; ++i) {
+        OpTime opTime(Timestamp(Seconds(1), i + 1), 1LL);
+        if (i % 2 == 0) {
+            ops.push_back(makeInsertDocumentOplogEntry(opTime, nss1, BSON("_id" << i)));
+        } else {
+            ops.push_back(makeUpdateDocumentOplogEntry(
+                opTime, nss2, BSON("_id" << 0), BSON("$set" << BSON("x" << i))));
+        }
+    }
+
+    SyncTail syncTail(nullptr, applyOperationFn, writerPool.get());
+    auto lastOpTime = unittest::assertGet(syncTail.multiApply(_opCtx.get(), ops));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+    stdx::lock_guard<stdx::mutex> lock(mutex);
+    std::vector<OpTime> seen;
+    for (auto&& operationsAppliedByCall : operationsApplied) {
+        // All updates to the hot document must be applied by one call, in oplog order.
+        std::vector<OpTime> hotDocumentUpdates;
+        for (auto&& oplogEntry : operationsAppliedByCall) {
+            seen.push_back(oplogEntry.getOpTime());
+            if (oplogEntry.getNamespace() == nss2) {
+                hotDocumentUpdates.push_back(oplogEntry.getOpTime());
+            }
+        }
+        if (!hotDocumentUpdates.empty()) {
+            ASSERT_EQUALS(100U, hotDocumentUpdates.size());
+            ASSERT_TRUE(std::is_sorted(hotDocumentUpdates.begin(), hotDocumentUpdates.end()));
+        }
+    }
+    std::sort(seen.begin(), seen.end());
+    ASSERT_EQUALS(ops.size(), seen.size());
+    for (size_t i = 0; i < ops.size(); ++i) {
+        ASSERT_EQUALS(ops[i].getOpTime(), seen[i]);
+    }
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyUsesSyncApplyToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
     auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
@@ -568,6 +634,47 @@ TEST_F(SyncTailTest, MultiSyncApplyAddsMultipleWorkerMultikeyPathInfo) {
     }
 }
 
+TEST_F(SyncTailTest, MultiSyncApplyReportsOnlyItsOwnWorkerMultikeyPathInfo) {
+    NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
+
+    {
+        auto op = makeCreateCollectionOplogEntry({Timestamp(Seconds(1), 0), 1LL}, nss);
+        testWorkerMultikeyPaths(_opCtx.get(), op, 0UL);
+    }
+
+    {
+        auto keyPattern = BSON("a" << 1);
+        auto op =
+            makeCreateIndexOplogEntry({Timestamp(Seconds(2), 0), 1LL}, nss, "a_1", keyPattern);
+        testWorkerMultikeyPaths(_opCtx.get(), op, 0UL);
+    }
+
+    {
+        auto keyPattern = BSON("b" << 1);
+        auto op =
+            makeCreateIndexOplogEntry({Timestamp(Seconds(3), 0), 1LL}, nss, "b_1", keyPattern);
+        testWorkerMultikeyPaths(_opCtx.get(), op, 0UL);
+    }
+
+    // With dynamic scheduling a writer applies several work units with the same OperationContext,
+    // so the multikey paths found by one call must not be reported again by the next.
+    {
+        auto doc = BSON("_id" << 1 << "a" << BSON_ARRAY(4 << 5));
+        auto op = makeInsertDocumentOplogEntry({Timestamp(Seconds(4), 0), 1LL}, nss, doc);
+        testWorkerMultikeyPaths(_opCtx.get(), op, 1UL);
+    }
+
+    {
+        auto doc = BSON("_id" << 2 << "b" << BSON_ARRAY(6 << 7));
+        auto op = makeInsertDocumentOplogEntry({Timestamp(Seconds(5), 0), 1LL}, nss, doc);
+        WorkerMultikeyPathInfo pathInfo;
+        MultiApplier::OperationPtrs ops = {&op};
+        ASSERT_OK(multiSyncApply(_opCtx.get(), &ops, nullptr, &pathInfo));
+        ASSERT_EQ(pathInfo.size(), 1UL);
+        ASSERT_EQ(pathInfo[0].indexName, "b_1");
+    }
+}
+
 TEST_F(SyncTailTest, MultiSyncApplyDoesNotAddWorkerMultikeyPathInfoOnCreateIndex) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
 
@@ -48,20 +48,24 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
-#include <snappy.h>
+#include <cstring>
 #include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/sorter/sorter_thread_pool.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/bufreader.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/future.h"
 #include "mongo/util/mongoutils/str.h"
 #include "mongo/util/unowned_ptr.h"
 
@@ -102,6 +106,43 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+/**
+ * Spilled data is written as a series of blocks, each an int32 size followed by that many
+ * bytes, encrypted if the EncryptionHooks are enabled. Once decrypted, a block holds this
+ * header followed by the (possibly compressed) key/value pairs.
+ */
+struct SpillBlockHeader {
+    enum Flags : uint8_t {
+        kPrefixCompressedKeys = 1 << 0,  // Keys are stored as <shared, suffixSize, suffix>.
+    };
+
+    static const size_t kSize = 2 * sizeof(uint8_t) + sizeof(int32_t);
+
+    SorterSpillCompressor compressor;
+    uint8_t flags;
+    int32_t uncompressedSize;
+};
+
+/** Appends 'value' to 'buf' in 7-bit groups, least significant first. */
+inline void appendVarUInt(BufBuilder& buf, uint32_t value) {
+    while (value >= 0x80) {
+        buf.appendChar(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    buf.appendChar(static_cast<char>(value));
+}
+
+inline uint32_t readVarUInt(BufReader& reader) {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        const uint8_t byte = reader.read<uint8_t>();
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+    msgasserted(50802, "corrupt variable-length integer in sorter spill file");
+}
+
 /** Ensures a named file is deleted when this object goes out of scope */
 class FileDeleter {
 public:
@@ -181,12 +222,35 @@ public:
         fillIfNeeded();
 
         // Note: key must be read before value so can't pass directly to Data constructor
-        auto first = Key::deserializeForSorter(*_reader, _settings.first);
+        auto first = _prefixCompressedKeys ? readPrefixCompressedKey()
+                                           : Key::deserializeForSorter(*_reader, _settings.first);
         auto second = Value::deserializeForSorter(*_reader, _settings.second);
         return Data(std::move(first), std::move(second));
     }
 
 private:
+    /**
+     * Rebuilds the next key from the bytes it shares with the previous one. The key may point
+     * into the rebuilt bytes, so the previous key's buffer is only reused on the call after.
+     */
+    Key readPrefixCompressedKey() {
+        const uint32_t sharedSize = readVarUInt(*_reader);
+        const uint32_t suffixSize = readVarUInt(*_reader);
+
+        const std::vector<char>& previous = _keyBuffers[_currentKeyBuffer];
+        massert(50803, "corrupt key prefix in sorter spill file", sharedSize <= previous.size());
+
+        _currentKeyBuffer ^= 1;
+        std::vector<char>& key = _keyBuffers[_currentKeyBuffer];
+        key.resize(sharedSize + suffixSize);
+        std::copy(previous.begin(), previous.begin() + sharedSize, key.begin());
+        if (suffixSize)
+            memcpy(key.data() + sharedSize, _reader->skip(suffixSize), suffixSize);
+
+        BufReader keyReader(key.data(), key.size());
+        return Key::deserializeForSorter(keyReader, _settings.first);
+    }
+
     void fillIfNeeded() {
         verify(!_done);
 
@@ -195,14 +259,12 @@ private:
     }
 
     void fill() {
-        int32_t rawSize;
-        read(&rawSize, sizeof(rawSize));
+        int32_t blockSize;
+        read(&blockSize, sizeof(blockSize));
         if (_done)
             return;
 
-        // negative size means compressed
-        const bool compressed = rawSize < 0;
-        int32_t blockSize = std::abs(rawSize);
+        massert(50806, "corrupt sorter spill block size", blockSize >= 0);
 
         _buffer.reset(new char[blockSize]);
         read(_buffer.get(), blockSize);
@@ -225,26 +287,34 @@ private:
             _buffer.swap(out);
         }
 
-        if (!compressed) {
-            _reader.reset(new BufReader(_buffer.get(), blockSize));
+        massert(50804,
+                "sorter spill block too short",
+                blockSize >= static_cast<int32_t>(SpillBlockHeader::kSize));
+        BufReader headerReader(_buffer.get(), SpillBlockHeader::kSize);
+        SpillBlockHeader header;
+        header.compressor = static_cast<SorterSpillCompressor>(headerReader.read<uint8_t>());
+        header.flags = headerReader.read<uint8_t>();
+        header.uncompressedSize = headerReader.read<LittleEndian<int32_t>>();
+        _prefixCompressedKeys = header.flags & SpillBlockHeader::kPrefixCompressedKeys;
+
+        const char* body = _buffer.get() + SpillBlockHeader::kSize;
+        const size_t bodySize = blockSize - SpillBlockHeader::kSize;
+        if (header.compressor == SorterSpillCompressor::kNone) {
+            _reader.reset(new BufReader(body, bodySize));
             return;
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
-
-        size_t uncompressedSize;
-        massert(17061,
-                "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
-
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
-        massert(17062,
-                "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+        massert(50805, "corrupt sorter spill block size", header.uncompressedSize >= 0);
+        std::unique_ptr<char[]> decompressionBuffer(new char[header.uncompressedSize]);
+        uncompressSpillBlock(header.compressor,
+                             body,
+                             bodySize,
+                             decompressionBuffer.get(),
+                             header.uncompressedSize);
 
         // hold on to decompressed data and throw out compressed data at block exit
         _buffer.swap(decompressionBuffer);
-        _reader.reset(new BufReader(_buffer.get(), uncompressedSize));
+        _reader.reset(new BufReader(_buffer.get(), header.uncompressedSize));
     }
 
     // sets _done to true on EOF - asserts on any other error
@@ -267,6 +337,9 @@ private:
     bool _done;
     std::unique_ptr<char[]> _buffer;
     std::unique_ptr<BufReader> _reader;
+    bool _prefixCompressedKeys = false;  // Set per block by fill().
+    std::vector<char> _keyBuffers[2];    // Rebuilt keys, alternating between calls to next().
+    size_t _currentKeyBuffer = 0;
     std::string _fileName;
     std::shared_ptr<FileDeleter> _fileDeleter;  // Must outlive _file
     std::ifstream _file;
@@ -396,6 +469,98 @@ private:
     STLComparator _greater;                      // named so calls make sense
 };
 
+/** Runs 'func' on 'pool' and returns a Future for its result, or for the exception it threw. */
+template <typename Result, typename Func>
+Future<Result> runOnPool(ThreadPool* pool, Func func) {
+    Promise<Result> promise;
+    auto future = promise.getFuture();
+    uassertStatusOK(pool->schedule([ sharedPromise = promise.share(), func ]() mutable {
+        sharedPromise.setWith([&] {
+            // Futures only carry DBExceptions, but file operations can throw others.
+            try {
+                return func();
+            } catch (const DBException&) {
+                throw;
+            } catch (...) {
+                uassertStatusOK(exceptionToStatus());
+                MONGO_UNREACHABLE;
+            }
+        });
+    }));
+    return future;
+}
+
+/**
+ * Calls 'func(i)' for each i in [0, numTasks), all but the last on 'pool' and the last on the
+ * calling thread. Returns once every call has finished, rethrowing the first error any of them
+ * raised.
+ */
+template <typename Func>
+void runInParallel(ThreadPool* pool, size_t numTasks, const Func& func) {
+    if (numTasks == 0)
+        return;
+
+    std::vector<Future<void>> futures;
+    for (size_t i = 0; i + 1 < numTasks; i++) {
+        futures.push_back(runOnPool<void>(pool, [&func, i] { func(i); }));
+    }
+
+    // The tasks on the pool refer to this frame, so they must all finish before we can throw.
+    Status status = Status::OK();
+    try {
+        func(numTasks - 1);
+    } catch (...) {
+        status = exceptionToStatus();
+    }
+    for (auto&& future : futures) {
+        Status taskStatus = std::move(future).getNoThrow();
+        if (status.isOK())
+            status = taskStatus;
+    }
+    uassertStatusOK(status);
+}
+
+/**
+ * Sorts [begin, end) like std::stable_sort, using up to 'numThreads' threads: the range is cut
+ * into chunks that are sorted in parallel and then merged pairwise, each round of merges also in
+ * parallel. Merging only adjacent chunks keeps the sort stable.
+ */
+template <typename RandomIt, typename Less>
+void parallelStableSort(
+    ThreadPool* pool, size_t numThreads, RandomIt begin, RandomIt end, const Less& less) {
+    // Below this many elements per chunk, handing work to other threads costs more than it saves.
+    const size_t kMinChunkSize = 16 * 1024;
+
+    const size_t size = std::distance(begin, end);
+    const size_t numChunks = std::min(numThreads, size / kMinChunkSize);
+    if (numChunks <= 1) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    std::vector<RandomIt> bounds;
+    for (size_t i = 0; i <= numChunks; i++) {
+        bounds.push_back(begin + size * i / numChunks);
+    }
+
+    runInParallel(pool, numChunks, [&](size_t chunk) {
+        std::stable_sort(bounds[chunk], bounds[chunk + 1], less);
+    });
+
+    for (size_t width = 1; width < numChunks; width *= 2) {
+        const size_t numMerges = (numChunks + 2 * width - 1) / (2 * width);
+        runInParallel(pool, numMerges, [&](size_t merge) {
+            const size_t first = merge * 2 * width;
+            const size_t middle = first + width;
+            if (middle >= numChunks)
+                return;  // Nothing to merge with in this round.
+
+            const size_t last = std::min(first + 2 * width, numChunks);
+            std::inplace_merge(bounds[first], bounds[middle], bounds[last], less);
+        });
+    }
+}
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -408,8 +573,25 @@ public:
     NoLimitSorter(const SortOptions& opts,
                   const Comparator& comp,
                   const Settings& settings = Settings())
-        : _comp(comp), _settings(settings), _opts(opts), _memUsed(0) {
+        : _comp(comp),
+          _settings(settings),
+          _opts(opts),
+          _memUsed(0),
+          _runSizeBytes(_opts.numSortThreads > 1 && _opts.extSortAllowed
+                            ? _opts.maxMemoryUsageBytes / _opts.numSortThreads
+                            : _opts.maxMemoryUsageBytes) {
         verify(_opts.limit == 0);
+
+        if (_opts.numSortThreads > 1)
+            _pool = getSortThreadPool();
+    }
+
+    ~NoLimitSorter() {
+        // Background spills refer to this sorter, so let them finish before tearing it down. The
+        // pool is shared with other sorters, so only this sorter's own work is waited for.
+        for (auto&& pendingSpill : _pendingSpills) {
+            std::move(pendingSpill).getNoThrow().getStatus().ignore();
+        }
     }
 
     void add(const Key& key, const Value& val) {
@@ -418,23 +600,35 @@ public:
         _memUsed += key.memUsageForSorter();
         _memUsed += val.memUsageForSorter();
 
-        if (_memUsed > _opts.maxMemoryUsageBytes)
+        if (_memUsed > _runSizeBytes)
             spill();
     }
 
     Iterator* done() {
-        if (_iters.empty()) {
-            sort();
+        if (_iters.empty() && _pendingSpills.empty()) {
+            if (_pool) {
+                parallelStableSort(_pool,
+                                   _opts.numSortThreads,
+                                   _data.begin(),
+                                   _data.end(),
+                                   STLComparator(_comp));
+            } else {
+                sort(&_data);
+            }
             return new InMemIterator<Key, Value>(_data);
         }
 
         spill();
+        if (_pool) {
+            waitForSpills(0);
+            mergeRunsInParallel();
+        }
         return Iterator::merge(_iters, _opts, _comp);
     }
 
     // TEMP these are here for compatibility. Will be replaced with a general stats API
     int numFiles() const {
-        return _iters.size();
+        return _iters.size() + _pendingSpills.size();
     }
     size_t memUsed() const {
         return _memUsed;
@@ -453,13 +647,89 @@ private:
         const Comparator& _comp;
     };
 
-    void sort() {
+    void sort(std::deque<Data>* data) const {
         STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        std::stable_sort(data->begin(), data->end(), less);
 
         // Does 2x more compares than stable_sort
         // TODO test on windows
-        // std::sort(_data.begin(), _data.end(), comp);
+        // std::sort(data->begin(), data->end(), comp);
+    }
+
+    /** Sorts 'data' and writes it out to a new file, returning an iterator over that file. */
+    std::shared_ptr<Iterator> writeRun(std::deque<Data>* data) const {
+        sort(data);
+
+        SortedFileWriter<Key, Value> writer(_opts, _settings);
+        for (; !data->empty(); data->pop_front()) {
+            writer.addAlreadySorted(data->front().first, data->front().second);
+        }
+
+        return std::shared_ptr<Iterator>(writer.done());
+    }
+
+    /** Merges 'runs' into a single new file, returning an iterator over that file. */
+    std::shared_ptr<Iterator> mergeRuns(const std::vector<std::shared_ptr<Iterator>>& runs) const {
+        std::unique_ptr<Iterator> merged(Iterator::merge(runs, _opts, _comp));
+
+        SortedFileWriter<Key, Value> writer(_opts, _settings);
+        while (merged->more()) {
+            Data next = merged->next();
+            writer.addAlreadySorted(next.first, next.second);
+        }
+
+        return std::shared_ptr<Iterator>(writer.done());
+    }
+
+    /**
+     * Moves background spills into _iters, oldest first, until at most 'maxPending' remain. Runs
+     * are appended in the order they were spilled, which MergeIterator relies on for stability.
+     */
+    void waitForSpills(size_t maxPending) {
+        while (_pendingSpills.size() > maxPending) {
+            _iters.push_back(std::move(_pendingSpills.front()).get());
+            _pendingSpills.pop_front();
+        }
+    }
+
+    /**
+     * Hands the current data to the thread pool to be sorted and written out while the caller
+     * keeps adding. At most numSortThreads - 1 runs are in flight, so together with the run being
+     * filled, memory stays within maxMemoryUsageBytes.
+     */
+    void spillInBackground() {
+        waitForSpills(_opts.numSortThreads - 2);
+
+        auto run = std::make_shared<std::deque<Data>>();
+        run->swap(_data);
+        _memUsed = 0;
+
+        _pendingSpills.push_back(runOnPool<std::shared_ptr<Iterator>>(
+            _pool, [this, run] { return writeRun(run.get()); }));
+    }
+
+    /**
+     * Reduces the number of runs to at most kMaxMergeWidth before the final merge, which runs on
+     * the caller's thread, by merging groups of adjacent runs into new files in parallel. This
+     * trades another pass over the data for fewer comparisons per document in the final merge
+     * and fewer files open at once.
+     */
+    void mergeRunsInParallel() {
+        const size_t kMaxMergeWidth = 16;
+
+        while (_iters.size() > kMaxMergeWidth) {
+            const size_t numGroups = (_iters.size() + kMaxMergeWidth - 1) / kMaxMergeWidth;
+            std::vector<std::shared_ptr<Iterator>> merged(numGroups);
+            runInParallel(_pool, numGroups, [&](size_t group) {
+                const auto first = _iters.begin() + group * kMaxMergeWidth;
+                const auto last =
+                    _iters.begin() + std::min((group + 1) * kMaxMergeWidth, _iters.size());
+                merged[group] = last - first == 1
+                    ? *first
+                    : mergeRuns(std::vector<std::shared_ptr<Iterator>>(first, last));
+            });
+            _iters.swap(merged);
+        }
     }
 
     void spill() {
@@ -479,14 +749,12 @@ private:
                           << " Pass allowDiskUse:true to opt in.");
         }
 
-        sort();
-
-        SortedFileWriter<Key, Value> writer(_opts, _settings);
-        for (; !_data.empty(); _data.pop_front()) {
-            writer.addAlreadySorted(_data.front().first, _data.front().second);
+        if (_pool) {
+            spillInBackground();
+            return;
         }
 
-        _iters.push_back(std::shared_ptr<Iterator>(writer.done()));
+        _iters.push_back(writeRun(&_data));
 
         _memUsed = 0;
     }
@@ -495,8 +763,14 @@ private:
     const Settings _settings;
     SortOptions _opts;
     size_t _memUsed;
+    const size_t _runSizeBytes;                     // spill once _memUsed exceeds this
     std::deque<Data> _data;                         // the "current" data
     std::vector<std::shared_ptr<Iterator>> _iters;  // data that has already been spilled
+
+    // Only set when numSortThreads > 1. The process-wide sort pool, which sorts and writes runs in
+    // the background and merges them. It bounds the threads all sorters use together.
+    ThreadPool* _pool = nullptr;
+    std::deque<Future<std::shared_ptr<Iterator>>> _pendingSpills;  // runs still being written
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -806,7 +1080,9 @@ inline unsigned nextFileNumber() {
 
 template <typename Key, typename Value>
 SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts, const Settings& settings)
-    : _settings(settings) {
+    : _settings(settings),
+      _compressor(opts.spillCompressor),
+      _prefixCompressKeys(opts.prefixCompressKeys) {
     namespace str = mongoutils::str;
 
     // This should be checked by consumers, but if we get here don't allow writes.
@@ -839,8 +1115,34 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts, const Se
 
 template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::addAlreadySorted(const Key& key, const Value& val) {
-    key.serializeForSorter(_buffer);
+    const int sizeBefore = _buffer.len();
+    if (_prefixCompressKeys) {
+        _keyBuffer.reset();
+        key.serializeForSorter(_keyBuffer);
+        const char* keyData = _keyBuffer.buf();
+        const size_t keySize = _keyBuffer.len();
+
+        // The first key in each block is stored whole so blocks can be read independently.
+        size_t sharedSize = 0;
+        if (_buffer.len() != 0) {
+            const size_t maxShared = std::min(keySize, _lastKey.size());
+            while (sharedSize < maxShared && keyData[sharedSize] == _lastKey[sharedSize])
+                sharedSize++;
+        }
+
+        sorter::appendVarUInt(_buffer, sharedSize);
+        sorter::appendVarUInt(_buffer, keySize - sharedSize);
+        _buffer.appendBuf(keyData + sharedSize, keySize - sharedSize);
+        _lastKey.assign(keyData, keySize);
+        _bufferBytesBeforeCompression += keySize;
+    } else {
+        key.serializeForSorter(_buffer);
+        _bufferBytesBeforeCompression += _buffer.len() - sizeBefore;
+    }
+
+    const int valueStart = _buffer.len();
     val.serializeForSorter(_buffer);
+    _bufferBytesBeforeCompression += _buffer.len() - valueStart;
 
     if (_buffer.len() > 64 * 1024)
         spill();
@@ -850,22 +1152,35 @@ template <typename Key, typename Value>
 void SortedFileWriter<Key, Value>::spill() {
     namespace str = mongoutils::str;
 
-    int32_t size = _buffer.len();
-    char* outBuffer = _buffer.buf();
-
-    if (size == 0)
+    if (_buffer.len() == 0)
         return;
 
     std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
+    sorter::SpillBlockHeader header;
+    header.compressor = _compressor;
+    header.flags = _prefixCompressKeys ? sorter::SpillBlockHeader::kPrefixCompressedKeys : 0;
+    header.uncompressedSize = _buffer.len();
+    if (!sorter::compressSpillBlock(_compressor, _buffer.buf(), _buffer.len(), &compressed)) {
+        header.compressor = SorterSpillCompressor::kNone;
+    }
     verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
-    if (shouldCompress) {
-        size = compressed.size();
-        outBuffer = const_cast<char*>(compressed.data());
+    const char* body = _buffer.buf();
+    size_t bodySize = _buffer.len();
+    if (header.compressor != SorterSpillCompressor::kNone) {
+        body = compressed.data();
+        bodySize = compressed.size();
     }
 
+    BufBuilder block(sorter::SpillBlockHeader::kSize + bodySize);
+    block.appendChar(static_cast<char>(header.compressor));
+    block.appendChar(static_cast<char>(header.flags));
+    block.appendNum(header.uncompressedSize);
+    block.appendBuf(body, bodySize);
+
+    int32_t size = block.len();
+    const char* outBuffer = block.buf();
+
     std::unique_ptr<char[]> out;
     auto encryptionHooks = EncryptionHooks::get(getGlobalServiceContext());
     if (encryptionHooks->enabled()) {
@@ -884,11 +1199,9 @@ void SortedFileWriter<Key, Value>::spill() {
         size = resultLen;
     }
 
-    // negative size means compressed
-    size = shouldCompress ? -size : size;
     try {
         _file.write(reinterpret_cast<const char*>(&size), sizeof(size));
-        _file.write(outBuffer, std::abs(size));
+        _file.write(outBuffer, size);
 
     } catch (const std::exception&) {
         msgasserted(16821,
@@ -896,7 +1209,11 @@ void SortedFileWriter<Key, Value>::spill() {
                                   << sorter::myErrnoWithDescription());
     }
 
+    sorter::recordSpilledBlock(_bufferBytesBeforeCompression, sizeof(size) + size);
+    _bytesWritten += sizeof(size) + size;
+
     _buffer.reset();
+    _bufferBytesBeforeCompression = 0;
 }
 
 template <typename Key, typename Value>
@@ -37,6 +37,7 @@
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/bson/util/builder.h"
+#include "mongo/db/sorter/sorter_spill.h"
 
 /**
  * This is the public API for the Sorter (both in-memory and external)
@@ -98,8 +99,24 @@ struct SortOptions {
     bool extSortAllowed;         /// If false, uassert if more mem needed than allowed.
     std::string tempDir;         /// Directory to directly place files in.
                                  /// Must be explicitly set if extSortAllowed is true.
+    size_t numSortThreads;       /// Threads used to sort, spill and merge when limit is 0.
+                                 /// With 1, all work happens on the thread calling the Sorter.
+                                 /// Extra threads come from a pool shared by all Sorters.
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    /// Block compressor for data spilled to tempDir.
+    SorterSpillCompressor spillCompressor;
+
+    /// Store each spilled key as the bytes it doesn't share with the key before it.
+    /// Only pays off for keys that serialize with long common prefixes.
+    bool prefixCompressKeys;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          numSortThreads(1),
+          spillCompressor(getDefaultSorterSpillCompressor()),
+          prefixCompressKeys(getDefaultSorterSpillPrefixCompression()) {}
 
     /// Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -122,6 +139,21 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& NumSortThreads(size_t newNumSortThreads) {
+        numSortThreads = newNumSortThreads;
+        return *this;
+    }
+
+    SortOptions& SpillCompressor(SorterSpillCompressor newSpillCompressor) {
+        spillCompressor = newSpillCompressor;
+        return *this;
+    }
+
+    SortOptions& PrefixCompressKeys(bool newPrefixCompressKeys = true) {
+        prefixCompressKeys = newPrefixCompressKeys;
+        return *this;
+    }
 };
 
 /// This is the output from the sorting framework
@@ -196,14 +228,25 @@ public:
     void addAlreadySorted(const Key&, const Value&);
     Iterator* done();  /// Can't add more data after calling done()
 
+    /// Bytes written to the file so far, including everything written by done().
+    size_t bytesWritten() const {
+        return _bytesWritten;
+    }
+
 private:
     void spill();
 
     const Settings _settings;
+    const SorterSpillCompressor _compressor;
+    const bool _prefixCompressKeys;
     std::string _fileName;
     std::shared_ptr<sorter::FileDeleter> _fileDeleter;  // Must outlive _file
     std::ofstream _file;
     BufBuilder _buffer;
+    size_t _bufferBytesBeforeCompression = 0;  // What _buffer would hold without prefixes.
+    BufBuilder _keyBuffer;                     // Scratch space for serializing a single key.
+    std::string _lastKey;                      // Previous key in _buffer, if prefix compressing.
+    size_t _bytesWritten = 0;
 };
 }
 
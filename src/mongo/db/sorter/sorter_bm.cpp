@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxSortThreads = 16;  // max number of threads the sorter may use
+
+// Number of index keys sorted per iteration.
+const int kNumKeys = 1024 * 1024;
+
+/**
+ * Orders (key, RecordId) pairs the way an index build does.
+ */
+class IndexKeyComparator {
+public:
+    using Data = std::pair<BSONObj, RecordId>;
+
+    int operator()(const Data& lhs, const Data& rhs) const {
+        int cmp = lhs.first.woCompare(rhs.first, _ordering, /*considerFieldName*/ false);
+        if (cmp) {
+            return cmp;
+        }
+        return lhs.second.compare(rhs.second);
+    }
+
+private:
+    const Ordering _ordering = Ordering::make(BSON("a" << 1 << "b" << 1));
+};
+
+using IndexKeySorter = Sorter<BSONObj, RecordId>;
+
+/**
+ * Returns keys shaped like those of a compound index on a number and a short string, in random
+ * order. Generated once and shared by every run.
+ */
+const std::vector<BSONObj>& getIndexKeys() {
+    static const std::vector<BSONObj> keys = [] {
+        PseudoRandom random(1);
+        std::vector<BSONObj> keys;
+        keys.reserve(kNumKeys);
+        for (int i = 0; i < kNumKeys; i++) {
+            keys.push_back(
+                BSON("" << random.nextInt64() << ""
+                        << ("key" + std::to_string(random.nextInt32(1000 * 1000)))));
+        }
+        return keys;
+    }();
+    return keys;
+}
+
+/**
+ * Sorts kNumKeys index keys with the number of threads given by the first argument and the memory
+ * limit in megabytes given by the second, then reads the sorted output back. Reports the amount
+ * of key data sorted per second of wall-clock time, since most of the work may happen on the
+ * sorter's own threads.
+ */
+void BM_SortIndexKeys(benchmark::State& state) {
+    const auto& keys = getIndexKeys();
+    unittest::TempDir tempDir("sorter_bm");
+    const SortOptions opts = SortOptions()
+                                 .TempDir(tempDir.path())
+                                 .ExtSortAllowed()
+                                 .MaxMemoryUsageBytes(state.range(1) * 1024 * 1024)
+                                 .NumSortThreads(state.range(0));
+
+    int64_t bytesPerIteration = 0;
+    for (const auto& key : keys) {
+        bytesPerIteration += key.objsize() + sizeof(RecordId);
+    }
+
+    int numFiles = 0;
+    for (auto keepRunning : state) {
+        std::unique_ptr<IndexKeySorter> sorter(
+            IndexKeySorter::make(opts, IndexKeyComparator()));
+        for (int i = 0; i < kNumKeys; i++) {
+            sorter->add(keys[i], RecordId(i + 1));
+        }
+        numFiles = sorter->numFiles();
+
+        std::unique_ptr<IndexKeySorter::Iterator> sorted(sorter->done());
+        while (sorted->more()) {
+            benchmark::DoNotOptimize(sorted->next());
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytesPerIteration);
+    state.counters["spillFiles"] = numFiles;
+}
+
+void sortArgs(benchmark::internal::Benchmark* bm) {
+    for (int memoryMB : {1024, 16}) {
+        for (int threads = 1; threads <= kMaxSortThreads; threads *= 2) {
+            bm->Args({threads, memoryMB});
+        }
+    }
+}
+
+BENCHMARK(BM_SortIndexKeys)
+    ->ArgNames({"threads", "memoryMB"})
+    ->Apply(sortArgs)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+MONGO_CREATE_SORTER(mongo::BSONObj, mongo::RecordId, mongo::IndexKeyComparator);
@@ -0,0 +1,202 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/sorter/sorter_spill.h"
+
+#include <snappy.h>
+#include <zlib.h>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+AtomicWord<int> defaultSpillCompressor(static_cast<int>(SorterSpillCompressor::kSnappy));
+
+class SorterSpillCompressorParameter : public ServerParameter {
+public:
+    SorterSpillCompressorParameter()
+        : ServerParameter(ServerParameterSet::getGlobal(), "sorterSpillCompressor") {}
+
+    void append(OperationContext* opCtx, BSONObjBuilder& b, const std::string& name) override {
+        b.append(name, toString(getDefaultSorterSpillCompressor()));
+    }
+
+    Status set(const BSONElement& newValueElement) override {
+        if (newValueElement.type() != String) {
+            return Status(ErrorCodes::BadValue, "sorterSpillCompressor must be a string");
+        }
+        return setFromString(newValueElement.str());
+    }
+
+    Status setFromString(const std::string& str) override {
+        auto swCompressor = parseSorterSpillCompressor(str);
+        if (!swCompressor.isOK()) {
+            return swCompressor.getStatus();
+        }
+        defaultSpillCompressor.store(static_cast<int>(swCompressor.getValue()));
+        return Status::OK();
+    }
+} sorterSpillCompressorParameter;
+
+MONGO_EXPORT_SERVER_PARAMETER(sorterSpillPrefixCompression, bool, false);
+
+Counter64 spilledBlocks;
+Counter64 spilledBytesBeforeCompression;
+Counter64 spilledBytesAfterCompression;
+
+ServerStatusMetricField<Counter64> displaySpilledBlocks("sorter.spill.blocks", &spilledBlocks);
+ServerStatusMetricField<Counter64> displaySpilledBytesBeforeCompression(
+    "sorter.spill.bytesBeforeCompression", &spilledBytesBeforeCompression);
+ServerStatusMetricField<Counter64> displaySpilledBytesAfterCompression(
+    "sorter.spill.bytesAfterCompression", &spilledBytesAfterCompression);
+
+}  // namespace
+
+StringData toString(SorterSpillCompressor compressor) {
+    switch (compressor) {
+        case SorterSpillCompressor::kNone:
+            return "none"_sd;
+        case SorterSpillCompressor::kSnappy:
+            return "snappy"_sd;
+        case SorterSpillCompressor::kZlib:
+            return "zlib"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+StatusWith<SorterSpillCompressor> parseSorterSpillCompressor(StringData name) {
+    for (auto compressor : {SorterSpillCompressor::kNone,
+                            SorterSpillCompressor::kSnappy,
+                            SorterSpillCompressor::kZlib}) {
+        if (name == toString(compressor)) {
+            return compressor;
+        }
+    }
+    return Status(ErrorCodes::BadValue,
+                  str::stream() << "unknown sorter spill compressor '" << name
+                                << "', expected one of: none, snappy, zlib");
+}
+
+SorterSpillCompressor getDefaultSorterSpillCompressor() {
+    return static_cast<SorterSpillCompressor>(defaultSpillCompressor.load());
+}
+
+bool getDefaultSorterSpillPrefixCompression() {
+    return sorterSpillPrefixCompression.load();
+}
+
+SorterSpillStats getSorterSpillStats() {
+    SorterSpillStats stats;
+    stats.blocks = spilledBlocks.get();
+    stats.bytesBeforeCompression = spilledBytesBeforeCompression.get();
+    stats.bytesAfterCompression = spilledBytesAfterCompression.get();
+    return stats;
+}
+
+namespace sorter {
+
+bool compressSpillBlock(SorterSpillCompressor compressor,
+                        const char* data,
+                        size_t size,
+                        std::string* out) {
+    switch (compressor) {
+        case SorterSpillCompressor::kNone:
+            return false;
+        case SorterSpillCompressor::kSnappy:
+            snappy::Compress(data, size, out);
+            break;
+        case SorterSpillCompressor::kZlib: {
+            out->resize(::compressBound(size));
+            uLongf outLength = out->size();
+            const int ret = ::compress2(reinterpret_cast<Bytef*>(&(*out)[0]),
+                                        &outLength,
+                                        reinterpret_cast<const Bytef*>(data),
+                                        size,
+                                        Z_DEFAULT_COMPRESSION);
+            massert(50797, str::stream() << "zlib compression failed: " << ret, ret == Z_OK);
+            out->resize(outLength);
+            break;
+        }
+    }
+
+    return out->size() < size / 10 * 9;
+}
+
+void uncompressSpillBlock(SorterSpillCompressor compressor,
+                          const char* data,
+                          size_t size,
+                          char* out,
+                          size_t uncompressedSize) {
+    switch (compressor) {
+        case SorterSpillCompressor::kNone:
+            massert(50798, "spilled block has the wrong size", size == uncompressedSize);
+            memcpy(out, data, size);
+            return;
+        case SorterSpillCompressor::kSnappy: {
+            size_t snappySize;
+            massert(17061,
+                    "couldn't get uncompressed length",
+                    snappy::GetUncompressedLength(data, size, &snappySize));
+            massert(50799, "spilled block has the wrong size", snappySize == uncompressedSize);
+            massert(17062, "decompression failed", snappy::RawUncompress(data, size, out));
+            return;
+        }
+        case SorterSpillCompressor::kZlib: {
+            uLongf outLength = uncompressedSize;
+            const int ret = ::uncompress(reinterpret_cast<Bytef*>(out),
+                                         &outLength,
+                                         reinterpret_cast<const Bytef*>(data),
+                                         size);
+            massert(50800,
+                    str::stream() << "zlib decompression failed: " << ret,
+                    ret == Z_OK && outLength == uncompressedSize);
+            return;
+        }
+    }
+
+    msgasserted(50801,
+                str::stream() << "unknown sorter spill compressor: "
+                              << static_cast<int>(compressor));
+}
+
+void recordSpilledBlock(size_t bytesBeforeCompression, size_t bytesAfterCompression) {
+    spilledBlocks.increment();
+    spilledBytesBeforeCompression.increment(bytesBeforeCompression);
+    spilledBytesAfterCompression.increment(bytesAfterCompression);
+}
+
+}  // namespace sorter
+}  // namespace mongo
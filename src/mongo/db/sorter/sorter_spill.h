@@ -0,0 +1,98 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * Block compressors the Sorter can apply to the data it spills to disk.
+ *
+ * The numeric values are written to each spilled block, so they must not be reused.
+ */
+enum class SorterSpillCompressor : std::uint8_t {
+    kNone = 0,
+    kSnappy = 1,
+    kZlib = 2,
+};
+
+StringData toString(SorterSpillCompressor compressor);
+StatusWith<SorterSpillCompressor> parseSorterSpillCompressor(StringData name);
+
+/**
+ * Defaults for SortOptions, controlled by the "sorterSpillCompressor" and
+ * "sorterSpillPrefixCompression" server parameters.
+ */
+SorterSpillCompressor getDefaultSorterSpillCompressor();
+bool getDefaultSorterSpillPrefixCompression();
+
+/**
+ * Process-wide totals for the blocks every Sorter has spilled, also reported by serverStatus
+ * under metrics.sorter.spill.
+ */
+struct SorterSpillStats {
+    long long blocks = 0;
+    long long bytesBeforeCompression = 0;  // Serialized keys and values.
+    long long bytesAfterCompression = 0;   // Bytes written to the spill files.
+};
+
+SorterSpillStats getSorterSpillStats();
+
+namespace sorter {
+// Everything in this namespace is internal to the sorter
+
+/**
+ * Compresses 'size' bytes at 'data' into 'out'. Returns false if that doesn't save at least 10%,
+ * in which case the block should be written uncompressed.
+ */
+bool compressSpillBlock(SorterSpillCompressor compressor,
+                        const char* data,
+                        size_t size,
+                        std::string* out);
+
+/**
+ * Uncompresses a block written by compressSpillBlock() into the 'uncompressedSize' bytes at
+ * 'out'. Asserts if the block is corrupt.
+ */
+void uncompressSpillBlock(SorterSpillCompressor compressor,
+                          const char* data,
+                          size_t size,
+                          char* out,
+                          size_t uncompressedSize);
+
+void recordSpilledBlock(size_t bytesBeforeCompression, size_t bytesAfterCompression);
+
+}  // namespace sorter
+}  // namespace mongo
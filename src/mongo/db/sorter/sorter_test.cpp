@@ -278,6 +278,57 @@ public:
 };
 
 
+// Every spill format must read back what was written, and be counted in the spill stats.
+class SpillCompressionTests {
+public:
+    void run() {
+        unittest::TempDir tempDir("sortedFileWriterTests");
+        for (auto compressor : {SorterSpillCompressor::kNone,
+                                SorterSpillCompressor::kSnappy,
+                                SorterSpillCompressor::kZlib}) {
+            for (bool prefixCompressKeys : {false, true}) {
+                const SortOptions opts = SortOptions()
+                                             .TempDir(tempDir.path())
+                                             .SpillCompressor(compressor)
+                                             .PrefixCompressKeys(prefixCompressKeys);
+                const SorterSpillStats statsBefore = getSorterSpillStats();
+
+                // Runs of equal keys give prefix compression whole keys to share.
+                SortedFileWriter<IntWrapper, IntWrapper> sorter(opts);
+                for (int i = 0; i < NUM_ITEMS; i++)
+                    sorter.addAlreadySorted(i / 3, -i);
+
+                std::unique_ptr<IWIterator> iter(sorter.done());
+                for (int i = 0; i < NUM_ITEMS; i++) {
+                    ASSERT(iter->more());
+                    IWPair next = iter->next();
+                    ASSERT_EQUALS(static_cast<int>(next.first), i / 3);
+                    ASSERT_EQUALS(static_cast<int>(next.second), -i);
+                }
+                ASSERT_FALSE(iter->more());
+
+                const SorterSpillStats statsAfter = getSorterSpillStats();
+                const long long bytesBeforeCompression =
+                    statsAfter.bytesBeforeCompression - statsBefore.bytesBeforeCompression;
+                const long long bytesAfterCompression =
+                    statsAfter.bytesAfterCompression - statsBefore.bytesAfterCompression;
+                ASSERT_GREATER_THAN(statsAfter.blocks - statsBefore.blocks, 1);
+                ASSERT_EQUALS(bytesBeforeCompression,
+                              static_cast<long long>(NUM_ITEMS * sizeof(IWPair)));
+                if (compressor != SorterSpillCompressor::kNone || prefixCompressKeys) {
+                    ASSERT_LESS_THAN(bytesAfterCompression, bytesBeforeCompression);
+                }
+            }
+        }
+
+        ASSERT(boost::filesystem::is_empty(tempDir.path()));
+    }
+
+    enum Constants {
+        NUM_ITEMS = 100 * 1000,
+    };
+};
+
 class MergeIteratorTests {
 public:
     void run() {
@@ -542,6 +593,71 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+// Spills from a thread pool and merges the many small runs that produces in parallel.
+template <bool Random = true>
+class LotsOfDataLittleMemoryParallel : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts).NumSortThreads(4);
+    }
+};
+
+// Fits in memory, so done() sorts the data on several threads without spilling.
+class LotsOfDataParallelInMemory : public LotsOfDataLittleMemory</*random=*/true> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return opts.NumSortThreads(4);
+    }
+};
+
+// Spills many small zlib compressed runs with prefix compressed keys.
+template <bool Random = true>
+class LotsOfDataLittleMemoryCompressed : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts)
+            .SpillCompressor(SorterSpillCompressor::kZlib)
+            .PrefixCompressKeys();
+    }
+};
+
+// Equal keys must come back in the order they were added, whether or not the sort spills.
+class ParallelSortIsStable {
+public:
+    void run() {
+        unittest::TempDir tempDir("sorterTests");
+
+        for (bool extSortAllowed : {false, true}) {
+            const SortOptions opts =
+                SortOptions()
+                    .TempDir(tempDir.path())
+                    .MaxMemoryUsageBytes(extSortAllowed ? 16 * 1024 : 64 * 1024 * 1024)
+                    .ExtSortAllowed(extSortAllowed)
+                    .NumSortThreads(4);
+
+            std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+            for (int i = 0; i < NUM_ITEMS; i++) {
+                sorter->add(i % NUM_KEYS, i);
+            }
+
+            std::unique_ptr<IWIterator> iter(sorter->done());
+            for (int key = 0; key < NUM_KEYS; key++) {
+                for (int i = key; i < NUM_ITEMS; i += NUM_KEYS) {
+                    ASSERT(iter->more());
+                    IWPair next = iter->next();
+                    ASSERT_EQUALS(static_cast<int>(next.first), key);
+                    ASSERT_EQUALS(static_cast<int>(next.second), i);
+                }
+            }
+            ASSERT_FALSE(iter->more());
+        }
+
+        ASSERT(boost::filesystem::is_empty(tempDir.path()));
+    }
+
+    enum Constants {
+        NUM_ITEMS = 200 * 1000,
+        NUM_KEYS = 100,
+    };
+};
 }
 
 class SorterSuite : public mongo::unittest::Suite {
@@ -551,6 +667,7 @@ public:
     void setupTests() {
         add<InMemIterTests>();
         add<SortedFileWriterAndFileIteratorTests>();
+        add<SpillCompressionTests>();
         add<MergeIteratorTests>();
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
@@ -563,6 +680,12 @@ public:
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::LotsOfDataLittleMemoryParallel</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryParallel</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelInMemory>();
+        add<SorterTests::LotsOfDataLittleMemoryCompressed</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryCompressed</*random=*/true>>();
+        add<SorterTests::ParallelSortIsStable>();
     }
 };
 
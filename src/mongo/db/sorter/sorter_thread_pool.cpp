@@ -0,0 +1,69 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/sorter/sorter_thread_pool.h"
+
+#include <algorithm>
+
+#include "mongo/db/server_parameters.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace {
+
+// Upper bound on the threads all Sorters use together. Values below 1 mean one thread per
+// available core.
+MONGO_EXPORT_STARTUP_SERVER_PARAMETER(sorterMaxThreads, int, 0);
+
+}  // namespace
+
+namespace sorter {
+
+ThreadPool* getSortThreadPool() {
+    // Never destroyed: sorters may still be running when static destructors run at exit.
+    static ThreadPool* const pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "sorter";
+        options.threadNamePrefix = "sorter-";
+        options.minThreads = 0;
+        options.maxThreads = sorterMaxThreads > 0
+            ? static_cast<size_t>(sorterMaxThreads)
+            : std::max<size_t>(1, ProcessInfo::getNumAvailableCores());
+
+        auto newPool = new ThreadPool(options);
+        newPool->startup();
+        return newPool;
+    }();
+    return pool;
+}
+
+}  // namespace sorter
+}  // namespace mongo
@@ -0,0 +1,49 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+namespace mongo {
+
+class ThreadPool;
+
+namespace sorter {
+// Everything in this namespace is internal to the sorter
+
+/**
+ * Returns the thread pool shared by every Sorter that uses more than one thread. It holds at most
+ * "sorterMaxThreads" threads, so concurrent sorts, such as those of an index build creating
+ * several indexes, queue for threads rather than each starting its own. The pool is created on
+ * first use and lives until the process exits.
+ *
+ * Tasks on the pool must not wait for other tasks on the pool.
+ */
+ThreadPool* getSortThreadPool();
+
+}  // namespace sorter
+}  // namespace mongo
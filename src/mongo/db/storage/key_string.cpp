@@ -40,6 +40,7 @@
 #include "mongo/base/data_view.h"
 #include "mongo/platform/bits.h"
 #include "mongo/platform/strnlen.h"
+#include "mongo/stdx/memory.h"
 #include "mongo/util/hex.h"
 #include "mongo/util/log.h"
 
@@ -229,10 +230,24 @@ const uint8_t kGreater = 254;
 
 // some utility functions
 namespace {
+/**
+ * Copies 'bytes' bytes from 'src' to 'dst', flipping every bit. 'dst' may be equal to 'src'.
+ *
+ * Works a word at a time, which compilers unroll for the fixed-size numeric fields and vectorize
+ * for long strings, since inverting descending fields is on the hot path of encoding them.
+ */
 void memcpy_flipBits(void* dst, const void* src, size_t bytes) {
     const char* input = static_cast<const char*>(src);
     char* output = static_cast<char*>(dst);
     const char* const end = input + bytes;
+    while (static_cast<size_t>(end - input) >= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, input, sizeof(word));
+        word = ~word;
+        memcpy(output, &word, sizeof(word));
+        input += sizeof(word);
+        output += sizeof(word);
+    }
     while (input != end) {
         *output++ = ~(*input++);
     }
@@ -284,10 +299,8 @@ string readInvertedCString(BufReader* reader) {
     const char* end = static_cast<const char*>(memchr(start, 0xFF, reader->remaining()));
     invariant(end);
     size_t actualBytes = end - start;
-    string s(start, actualBytes);
-    for (size_t i = 0; i < s.size(); i++) {
-        s[i] = ~s[i];
-    }
+    string s(actualBytes, '\0');
+    memcpy_flipBits(&s[0], start, actualBytes);
     reader->skip(1 + actualBytes);
     return s;
 }
@@ -314,10 +327,7 @@ string readInvertedCStringWithNuls(BufReader* reader) {
         reader->skip(1 + actualBytes);
     } while (reader->peek<unsigned char>() == 0x00);
 
-    for (size_t i = 0; i < out.size(); i++) {
-        out[i] = ~out[i];
-    }
-
+    memcpy_flipBits(&out[0], out.data(), out.size());
     return out;
 }
 }  // namespace
@@ -382,6 +392,128 @@ void KeyString::_appendAllElementsForIndexing(const BSONObj& obj,
     _append(kEnd, false);
 }
 
+void KeyString::BatchEncoder::encode(const std::vector<BSONObj>& objs,
+                                     const std::vector<RecordId>& recordIds) {
+    invariant(objs.size() == recordIds.size());
+    _size = objs.size();
+    while (_keys.size() < _size) {
+        _keys.push_back(stdx::make_unique<KeyString>(_version));
+    }
+
+    _matching.clear();
+    _fields.clear();
+    const size_t nFields = _size ? objs[0].nFields() : 0;
+    for (size_t i = 0; i < _size; ++i) {
+        // If the first key doesn't have the numeric pattern, none of them can match it.
+        if (!_matching.empty() || i == 0) {
+            if (_appendFieldsIfMatching(objs[i], nFields)) {
+                _keys[i]->resetToEmpty();
+                _matching.push_back(i);
+                continue;
+            }
+        }
+        _keys[i]->resetToKey(objs[i], _ord, recordIds[i]);
+    }
+
+    if (_matching.empty())
+        return;
+
+    for (size_t j = 0; j < nFields; ++j) {
+        _appendField(j, nFields);
+    }
+    for (size_t i : _matching) {
+        _keys[i]->_append(kEnd, false);
+        _keys[i]->appendRecordId(recordIds[i]);
+    }
+}
+
+bool KeyString::BatchEncoder::_appendFieldsIfMatching(const BSONObj& obj, size_t nFields) {
+    const size_t firstField = _fields.size();
+    BSONObjIterator it(obj);
+    for (size_t j = 0; j < nFields && it.more(); ++j) {
+        const BSONElement elem = it.next();
+        const BSONType type = firstField == 0 ? elem.type() : _fields[j].type();
+        // A field name is a discriminator, which only resetToKey() handles.
+        if ((type != NumberDouble && type != NumberLong) || elem.type() != type ||
+            *elem.fieldName()) {
+            break;
+        }
+        _fields.push_back(elem);
+    }
+
+    if (_fields.size() - firstField != nFields || it.more()) {
+        _fields.resize(firstField);
+        return false;
+    }
+    return true;
+}
+
+void KeyString::BatchEncoder::_appendField(size_t fieldIndex, size_t nFields) {
+    const bool invert = (_ord.get(fieldIndex) == -1);
+    const BSONType type = _fields[fieldIndex].type();
+
+    // Append the type bits of every key, and the whole field of the keys whose value isn't
+    // encoded as an integer.
+    _integers.clear();
+    for (size_t m = 0; m < _matching.size(); ++m) {
+        const BSONElement& elem = _fields[m * nFields + fieldIndex];
+        KeyString& ks = *_keys[_matching[m]];
+        IntegerEncoding integer;
+        integer.keyIndex = _matching[m];
+
+        if (type == NumberLong) {
+            const long long num = elem._numberLong();
+            if (num == std::numeric_limits<long long>::min()) {
+                ks._appendNumberLong(num, invert);
+                continue;
+            }
+            ks._typeBits.appendNumberLong();
+            integer.isNegative = num < 0;
+            integer.magnitude = integer.isNegative ? -num : num;
+        } else {
+            const double num = elem._numberDouble();
+            integer.isNegative = num < 0.0;
+            const double magnitude = integer.isNegative ? -num : num;
+
+            // Only doubles with an integral value below 2**63 are encoded as integers. -0.0 also
+            // needs its own type bits.
+            if (!(magnitude < kMinLargeDouble) ||
+                static_cast<double>(static_cast<uint64_t>(magnitude)) != magnitude ||
+                (num == 0.0 && std::signbit(num))) {
+                ks._appendNumberDouble(num, invert);
+                continue;
+            }
+            ks._typeBits.appendNumberDouble();
+            integer.magnitude = static_cast<uint64_t>(magnitude);
+        }
+        _integers.push_back(integer);
+    }
+
+    // Encode the integers as _appendPreshiftedIntegerPortion() does, zero taking no bytes. The
+    // bytes an integer uses are moved to the front of its big-endian encoding, so each one is
+    // written with fixed-size stores.
+    const uint64_t invertMask = invert ? ~0ULL : 0;
+    for (auto& integer : _integers) {
+        const uint64_t preshifted = integer.magnitude << 1;
+        const int leadingZeros = countLeadingZeros64(preshifted);
+        const uint8_t size = (64 - leadingZeros + 7) / 8;
+        const uint8_t ctype = integer.isNegative ? CType::kNumericNegative1ByteInt - (size - 1)
+                                                 : CType::kNumericPositive1ByteInt + (size - 1);
+        integer.size = size;
+        integer.ctype = (size == 0 ? CType::kNumericZero : ctype) ^ uint8_t(invertMask);
+        integer.bigEndian = endian::nativeToBig(preshifted << (leadingZeros & 56)) ^
+            (integer.isNegative ? ~invertMask : invertMask);
+    }
+
+    for (const auto& integer : _integers) {
+        StackBufBuilder& buffer = _keys[integer.keyIndex]->_buffer;
+        char* const dst = buffer.skip(1 + sizeof(integer.bigEndian));
+        dst[0] = integer.ctype;
+        memcpy(dst + 1, &integer.bigEndian, sizeof(integer.bigEndian));
+        buffer.setlen(buffer.len() - (sizeof(integer.bigEndian) - integer.size));
+    }
+}
+
 void KeyString::appendRecordId(RecordId loc) {
     // The RecordId encoding must be able to determine the full length starting from the last
     // byte, without knowing where the first byte is since it is stored at the end of a
@@ -2022,6 +2154,66 @@ BSONObj KeyString::toBson(StringData data, Ordering ord, const TypeBits& typeBit
     return toBson(data.rawData(), data.size(), ord, typeBits);
 }
 
+void KeyString::Decoder::reset(const char* buffer, size_t len, const TypeBits& typeBits) {
+    _reader.emplace(buffer, len);
+    _typeBitsReader.emplace(typeBits);
+    _version = typeBits.version;
+    _nextField = 0;
+    _scratch.resetToEmpty();
+}
+
+bool KeyString::Decoder::_appendNext() {
+    invariant(_reader);
+    if (!_reader->remaining())
+        return false;
+
+    const bool invert = (_ord.get(_nextField) == -1);
+    uint8_t ctype = readType<uint8_t>(_reader.get_ptr(), invert);
+    if (ctype == kLess || ctype == kGreater) {
+        // A discriminator is logically part of the previous field, as in toBson().
+        ctype = readType<uint8_t>(_reader.get_ptr(), invert);
+    }
+
+    if (ctype == kEnd) {
+        // Anything after kEnd is the RecordId, which isn't a field.
+        _reader->skip(_reader->remaining());
+        return false;
+    }
+
+    toBsonValue(ctype,
+                _reader.get_ptr(),
+                _typeBitsReader.get_ptr(),
+                invert,
+                _version,
+                &(_scratch << ""));
+    _nextField++;
+    return true;
+}
+
+BSONElement KeyString::Decoder::next() {
+    _scratch.resetToEmpty();
+    const int offset = _scratch.len();
+    if (!_appendNext())
+        return BSONElement();
+    return BSONElement(_scratch.bb().buf() + offset);
+}
+
+BSONElement KeyString::Decoder::field(size_t fieldIndex) {
+    invariant(fieldIndex >= _nextField);
+    BSONElement elem;
+    do {
+        elem = next();
+    } while (!elem.eoo() && _nextField <= fieldIndex);
+    return elem;
+}
+
+BSONObj KeyString::Decoder::toBson() {
+    _scratch.resetToEmpty();
+    while (_appendNext()) {
+    }
+    return _scratch.asTempObj();
+}
+
 RecordId KeyString::decodeRecordIdAtEnd(const void* bufferRaw, size_t bufSize) {
     invariant(bufSize >= 2);  // smallest possible encoding of a RecordId.
     const unsigned char* buffer = static_cast<const unsigned char*>(bufferRaw);
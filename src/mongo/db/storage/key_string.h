@@ -30,8 +30,12 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <limits>
+#include <memory>
+#include <vector>
 
+#include "mongo/base/disallow_copying.h"
 #include "mongo/base/static_assert.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobj.h"
@@ -41,6 +45,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/platform/decimal128.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/bufreader.h"
 
 namespace mongo {
 
@@ -307,6 +312,125 @@ public:
     static BSONObj toBson(StringData data, Ordering ord, const TypeBits& types);
     static BSONObj toBson(const char* buffer, size_t len, Ordering ord, const TypeBits& types);
 
+    /**
+     * Decodes keys without allocating a BSONObj per key. Every decoded key or field is written to
+     * a buffer owned by the Decoder that is reused from key to key, so a Decoder kept around for
+     * an operation (e.g. by an index cursor) stops allocating once that buffer has grown to fit
+     * the largest key. Callers that keep a decoded key past the next call must copy it.
+     */
+    class Decoder {
+        MONGO_DISALLOW_COPYING(Decoder);
+
+    public:
+        explicit Decoder(Ordering ord) : _ord(ord) {}
+
+        /**
+         * Starts decoding a new key. 'buffer' and 'typeBits' must outlive the decoding of this
+         * key. Invalidates all elements returned for the previous key.
+         */
+        void reset(const char* buffer, size_t len, const TypeBits& typeBits);
+
+        /**
+         * Returns the next field of the key, named "", or EOO once all fields have been
+         * decoded. The element is valid until the next call to any method.
+         */
+        BSONElement next();
+
+        /**
+         * Returns the field at 'fieldIndex', which must not be before the next field to be
+         * decoded, or EOO if the key doesn't have that many fields. Fields in between still
+         * have to be decoded, but after it nothing is read. The element is valid until the next
+         * call to any method.
+         */
+        BSONElement field(size_t fieldIndex);
+
+        /**
+         * Decodes the remaining fields of the key into an unowned object, as the static
+         * KeyString::toBson() does. The object is valid until the next call to any method.
+         */
+        BSONObj toBson();
+
+    private:
+        /**
+         * Appends the next field of the key to '_scratch'. Returns false once all fields have
+         * been decoded.
+         */
+        bool _appendNext();
+
+        const Ordering _ord;
+        boost::optional<BufReader> _reader;
+        boost::optional<TypeBits::Reader> _typeBitsReader;
+        Version _version = kLatestVersion;
+        size_t _nextField = 0;
+        BSONObjBuilder _scratch;
+    };
+
+    /**
+     * Encodes batches of keys that share a key pattern, such as the keys of a bulk index build,
+     * into the same KeyStrings resetToKey() produces. When every field of the pattern is a double
+     * or a 64-bit integer, the batch is encoded a field at a time across all of its keys, so the
+     * type and ordering of each field are looked up once per batch and the integer encodings are
+     * computed in one tight loop and written with fixed-size stores. Keys that don't match the
+     * pattern of the first key in the batch are encoded one at a time with resetToKey().
+     */
+    class BatchEncoder {
+        MONGO_DISALLOW_COPYING(BatchEncoder);
+
+    public:
+        BatchEncoder(Version version, Ordering ord) : _version(version), _ord(ord) {}
+
+        /**
+         * Encodes 'objs[i]' followed by 'recordIds[i]' into key(i), for every 'i'. Invalidates
+         * the keys of the previous batch.
+         */
+        void encode(const std::vector<BSONObj>& objs, const std::vector<RecordId>& recordIds);
+
+        size_t size() const {
+            return _size;
+        }
+
+        const KeyString& key(size_t i) const {
+            invariant(i < _size);
+            return *_keys[i];
+        }
+
+    private:
+        /**
+         * A field of key 'keyIndex' that is a double or 64-bit integer with an integral value.
+         * Once encoded, as _appendInteger() would, the field is 'ctype' followed by the first
+         * 'size' bytes of 'bigEndian', both already inverted where the ordering requires it.
+         */
+        struct IntegerEncoding {
+            uint64_t magnitude;
+            bool isNegative;
+            size_t keyIndex;
+            uint64_t bigEndian;
+            uint8_t ctype;
+            uint8_t size;
+        };
+
+        /**
+         * Appends the fields of 'obj' to '_fields' if it has 'nFields' fields with the types of
+         * the first key of the batch, which must all be doubles or 64-bit integers.
+         */
+        bool _appendFieldsIfMatching(const BSONObj& obj, size_t nFields);
+
+        /**
+         * Appends field 'fieldIndex' of every key matching the pattern.
+         */
+        void _appendField(size_t fieldIndex, size_t nFields);
+
+        const Version _version;
+        const Ordering _ord;
+        size_t _size = 0;
+
+        // The keys and the buffers below grow to fit the largest batch and are reused.
+        std::vector<std::unique_ptr<KeyString>> _keys;
+        std::vector<size_t> _matching;  // Indexes of the keys that match the pattern.
+        std::vector<BSONElement> _fields;  // Field j of _matching[i] is at i * nFields + j.
+        std::vector<IntegerEncoding> _integers;
+    };
+
     /**
      * Decodes a RecordId from the end of a buffer.
      */
@@ -0,0 +1,193 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+namespace {
+
+const KeyString::Version kVersion = KeyString::Version::V1;
+const Ordering kOrdering = Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1));
+const RecordId kRecordId(1234567);
+
+enum KeyShape { kInt, kString, kCompound };
+
+/**
+ * Returns a key with as many fields as kOrdering, whose values are mostly of the given shape.
+ */
+BSONObj makeKey(KeyShape shape) {
+    switch (shape) {
+        case kInt:
+            return BSON("" << 42 << "" << (1LL << 32) << "" << -7);
+        case kString:
+            return BSON("" << "some string value"
+                           << ""
+                           << "another one"
+                           << ""
+                           << "x");
+        case kCompound:
+            return BSON("" << 42 << ""
+                           << "some string value"
+                           << ""
+                           << BSON("sub" << 3.5));
+    }
+    MONGO_UNREACHABLE;
+}
+
+void BM_Encode(benchmark::State& state) {
+    const BSONObj key = makeKey(static_cast<KeyShape>(state.range(0)));
+    KeyString ks(kVersion);
+    for (auto keepRunning : state) {
+        ks.resetToKey(key, kOrdering, kRecordId);
+        benchmark::DoNotOptimize(ks.getBuffer());
+    }
+    state.SetBytesProcessed(state.iterations() * ks.getSize());
+}
+
+void BM_EncodeDescending(benchmark::State& state) {
+    const BSONObj key = makeKey(static_cast<KeyShape>(state.range(0)));
+    const Ordering allDescending = Ordering::make(BSON("a" << -1 << "b" << -1 << "c" << -1));
+    KeyString ks(kVersion);
+    for (auto keepRunning : state) {
+        ks.resetToKey(key, allDescending, kRecordId);
+        benchmark::DoNotOptimize(ks.getBuffer());
+    }
+    state.SetBytesProcessed(state.iterations() * ks.getSize());
+}
+
+/**
+ * Encodes a batch of numeric keys of the same pattern, one at a time or with a BatchEncoder.
+ */
+void BM_EncodeNumericBatch(benchmark::State& state) {
+    const bool batched = state.range(0);
+    const size_t batchSize = 64;
+    std::vector<BSONObj> keys;
+    std::vector<RecordId> recordIds;
+    for (size_t i = 0; i < batchSize; ++i) {
+        keys.push_back(BSON("" << 1.5 * i << "" << (1LL << 40) + static_cast<long long>(i) << ""
+                          << -2.0 * i - 1));
+        recordIds.emplace_back(i + 1);
+    }
+
+    KeyString ks(kVersion);
+    KeyString::BatchEncoder encoder(kVersion, kOrdering);
+    for (auto keepRunning : state) {
+        if (batched) {
+            encoder.encode(keys, recordIds);
+            benchmark::DoNotOptimize(encoder.key(batchSize - 1).getBuffer());
+        } else {
+            for (size_t i = 0; i < batchSize; ++i) {
+                ks.resetToKey(keys[i], kOrdering, recordIds[i]);
+                benchmark::DoNotOptimize(ks.getBuffer());
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+void BM_ToBson(benchmark::State& state) {
+    const KeyString ks(kVersion, makeKey(static_cast<KeyShape>(state.range(0))), kOrdering);
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(
+            KeyString::toBson(ks.getBuffer(), ks.getSize(), kOrdering, ks.getTypeBits()));
+    }
+    state.SetBytesProcessed(state.iterations() * ks.getSize());
+}
+
+void BM_DecoderNext(benchmark::State& state) {
+    const KeyString ks(kVersion, makeKey(static_cast<KeyShape>(state.range(0))), kOrdering);
+    KeyString::Decoder decoder(kOrdering);
+    for (auto keepRunning : state) {
+        decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+        while (!decoder.next().eoo()) {
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * ks.getSize());
+}
+
+/**
+ * Decodes each key into the decoder's reused buffer, as the WiredTiger index cursor does.
+ */
+void BM_DecoderToBson(benchmark::State& state) {
+    const KeyString ks(kVersion, makeKey(static_cast<KeyShape>(state.range(0))), kOrdering);
+    KeyString::Decoder decoder(kOrdering);
+    for (auto keepRunning : state) {
+        decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+        benchmark::DoNotOptimize(decoder.toBson());
+    }
+    state.SetBytesProcessed(state.iterations() * ks.getSize());
+}
+
+/**
+ * Decodes only the first field of each key, which is what a covered query on a prefix of a
+ * compound index needs.
+ */
+void BM_DecoderFirstField(benchmark::State& state) {
+    const KeyString ks(kVersion, makeKey(static_cast<KeyShape>(state.range(0))), kOrdering);
+    KeyString::Decoder decoder(kOrdering);
+    for (auto keepRunning : state) {
+        decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+        benchmark::DoNotOptimize(decoder.field(0));
+    }
+}
+
+void BM_GetKeySize(benchmark::State& state) {
+    const KeyString ks(
+        kVersion, makeKey(static_cast<KeyShape>(state.range(0))), kOrdering, kRecordId);
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(
+            KeyString::getKeySize(ks.getBuffer(), ks.getSize(), kOrdering, ks.getTypeBits()));
+    }
+}
+
+void BM_DecodeRecordIdAtEnd(benchmark::State& state) {
+    const KeyString ks(
+        kVersion, makeKey(static_cast<KeyShape>(state.range(0))), kOrdering, kRecordId);
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(KeyString::decodeRecordIdAtEnd(ks.getBuffer(), ks.getSize()));
+    }
+}
+
+BENCHMARK(BM_Encode)->ArgName("shape")->DenseRange(kInt, kCompound);
+BENCHMARK(BM_EncodeDescending)->ArgName("shape")->DenseRange(kInt, kCompound);
+BENCHMARK(BM_EncodeNumericBatch)->ArgName("batched")->DenseRange(0, 1);
+BENCHMARK(BM_ToBson)->ArgName("shape")->DenseRange(kInt, kCompound);
+BENCHMARK(BM_DecoderNext)->ArgName("shape")->DenseRange(kInt, kCompound);
+BENCHMARK(BM_DecoderToBson)->ArgName("shape")->DenseRange(kInt, kCompound);
+BENCHMARK(BM_DecoderFirstField)->ArgName("shape")->DenseRange(kInt, kCompound);
+BENCHMARK(BM_GetKeySize)->ArgName("shape")->DenseRange(kInt, kCompound);
+BENCHMARK(BM_DecodeRecordIdAtEnd)->ArgName("shape")->DenseRange(kInt, kCompound);
+
+}  // namespace
+}  // namespace mongo
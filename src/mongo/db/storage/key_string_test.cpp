@@ -1161,6 +1161,253 @@ TEST_F(KeyStringTest, RecordIds) {
     }
 }
 
+TEST_F(KeyStringTest, DecoderMatchesToBson) {
+    std::vector<BSONObj> keys = {
+        BSON("" << 5 << "" << 5.5 << "" << 5LL << "" << -7),
+        BSON("" << "abc" << "" << BSONSymbol("abc") << "" << BSON("x" << 1) << ""
+                << BSON_ARRAY(1 << "a")),
+        BSON("" << 0 << "" << -0.0 << "" << BSONNULL << "" << MINKEY),
+        BSON("" << OID("abcdefabcdefabcdefabcdef") << "" << true << "" << MAXKEY << "" << false),
+        BSON("" << Date_t::fromMillisSinceEpoch(123) << "" << Timestamp(1, 2) << ""
+                << BSONBinData("abc", 3, bdtCustom) << "" << BSONRegEx("a.*", "i")),
+    };
+    if (version == KeyString::Version::V1) {
+        keys.push_back(BSON("" << Decimal128("5.50") << "" << Decimal128("-0") << "" << 1 << ""
+                               << Decimal128("1E-6000")));
+    }
+
+    // Alternate directions so fields are decoded both with and without inverted bytes.
+    const Ordering ord = Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1 << "d" << -1));
+
+    // One decoder reused for every key, as an index cursor would.
+    KeyString::Decoder decoder(ord);
+    for (const auto& key : keys) {
+        const KeyString ks(version, key, ord, RecordId(42));
+
+        decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+        BSONObjIterator expected(key);
+        for (BSONElement elem = decoder.next(); !elem.eoo(); elem = decoder.next()) {
+            ASSERT(expected.more());
+            const BSONElement expectedElem = expected.next();
+            ASSERT_EQ(elem.type(), expectedElem.type());
+            ASSERT_EQ(elem.woCompare(expectedElem, false), 0);
+        }
+        ASSERT_FALSE(expected.more());
+        ASSERT(decoder.next().eoo());
+        ASSERT_EQ(KeyString::decodeRecordIdAtEnd(ks.getBuffer(), ks.getSize()), RecordId(42));
+
+        std::vector<BSONElement> expectedFields;
+        key.elems(expectedFields);
+        for (size_t i = 0; i <= expectedFields.size(); i++) {
+            decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+            const BSONElement elem = decoder.field(i);
+            if (i == expectedFields.size()) {
+                ASSERT(elem.eoo());
+                continue;
+            }
+
+            ASSERT_EQ(elem.type(), expectedFields[i].type());
+            ASSERT_EQ(elem.woCompare(expectedFields[i], false), 0);
+        }
+    }
+}
+
+TEST_F(KeyStringTest, DecoderToBsonReusesItsBuffer) {
+    const Ordering ord = Ordering::make(BSON("a" << 1 << "b" << -1));
+    const std::vector<BSONObj> keys = {BSON("" << 1 << "" << "abc"),
+                                       BSON("" << 2.5 << "" << BSON("x" << 1)),
+                                       BSON("" << MINKEY << "" << BSONNULL)};
+
+    KeyString::Decoder decoder(ord);
+    const char* buffer = nullptr;
+    for (const auto& key : keys) {
+        const KeyString ks(version, key, ord, RecordId(7));
+        decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+        const BSONObj decoded = decoder.toBson();
+        ASSERT_FALSE(decoded.isOwned());
+        ASSERT_BSONOBJ_EQ(
+            decoded, KeyString::toBson(ks.getBuffer(), ks.getSize(), ord, ks.getTypeBits()));
+
+        // Small keys all fit in the buffer the first key grew.
+        if (buffer)
+            ASSERT_EQ(static_cast<const void*>(decoded.objdata()), buffer);
+        buffer = decoded.objdata();
+    }
+
+    // Fields already returned by next() aren't part of the object.
+    const KeyString ks(version, keys[0], ord, RecordId(7));
+    decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+    ASSERT_EQ(decoder.next().numberInt(), 1);
+    ASSERT_BSONOBJ_EQ(decoder.toBson(), BSON("" << "abc"));
+    ASSERT(decoder.toBson().isEmpty());
+}
+
+TEST_F(KeyStringTest, DecoderStopsAtDiscriminator) {
+    const BSONObj key = BSON("" << 1 << "" << "a");
+    const KeyString ks(version, key, ALL_ASCENDING, KeyString::kExclusiveAfter);
+
+    KeyString::Decoder decoder(ALL_ASCENDING);
+    decoder.reset(ks.getBuffer(), ks.getSize(), ks.getTypeBits());
+    ASSERT_EQ(decoder.next().numberInt(), 1);
+    ASSERT_EQ(decoder.next().valueStringData(), "a"_sd);
+    ASSERT(decoder.next().eoo());
+}
+
+TEST_F(KeyStringTest, DescendingMatchesInvertedAscending) {
+    // Apart from the trailing kEnd byte, a single-field descending key must be the bitwise
+    // inverse of the ascending one. Checked over strings of every length around the word size
+    // used to invert bytes in bulk, with and without NULs, and over random numbers.
+    std::mt19937_64 gen(newSeed());
+    std::vector<BSONObj> values;
+    for (size_t len = 0; len <= 40; len++) {
+        std::string str;
+        for (size_t i = 0; i < len; i++) {
+            str += static_cast<char>('a' + gen() % 26);
+        }
+        values.push_back(BSON("" << str));
+        if (len > 0) {
+            str[gen() % len] = '\0';
+            values.push_back(BSON("" << str));
+        }
+    }
+    for (int i = 0; i < 1000; i++) {
+        const uint64_t bits = gen();
+        values.push_back(BSON("" << static_cast<int>(bits)));
+        values.push_back(BSON("" << static_cast<long long>(bits)));
+        values.push_back(BSON("" << static_cast<double>(static_cast<long long>(bits)) / 1024));
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        values.push_back(BSON("" << d));
+    }
+
+    for (const auto& value : values) {
+        const KeyString ascending(version, value, ONE_ASCENDING);
+        const KeyString descending(version, value, ONE_DESCENDING);
+        ASSERT_EQ(ascending.getSize(), descending.getSize()) << value;
+        ASSERT_EQ(ascending.getTypeBits().getSize(), descending.getTypeBits().getSize());
+        ASSERT_EQ(memcmp(ascending.getTypeBits().getBuffer(),
+                         descending.getTypeBits().getBuffer(),
+                         ascending.getTypeBits().getSize()),
+                  0);
+
+        const size_t lastByte = ascending.getSize() - 1;
+        for (size_t i = 0; i < lastByte; i++) {
+            ASSERT_EQ(static_cast<uint8_t>(~ascending.getBuffer()[i]),
+                      static_cast<uint8_t>(descending.getBuffer()[i]))
+                << value << " byte " << i;
+        }
+        ASSERT_EQ(ascending.getBuffer()[lastByte], descending.getBuffer()[lastByte]);
+
+        const BSONObj decoded = toBson(descending, ONE_DESCENDING);
+        ASSERT_BSONOBJ_EQ(decoded, value);
+        ASSERT_EQ(decoded.firstElement().type(), value.firstElement().type());
+    }
+}
+
+TEST_F(KeyStringTest, BatchEncoderMatchesResetToKey) {
+    // Every key the batch encoder produces must be byte for byte, type bits included, the key
+    // resetToKey() produces. The values cover the boundaries between the integer, fractional,
+    // small and large encodings of doubles, and keys that don't match the pattern of the batch.
+    const std::vector<double> doubles = {0.0,
+                                         -0.0,
+                                         1.0,
+                                         -1.0,
+                                         0.5,
+                                         -0.25,
+                                         127.0,
+                                         128.0,
+                                         -255.5,
+                                         std::numeric_limits<double>::denorm_min(),
+                                         std::numeric_limits<double>::min(),
+                                         std::ldexp(1.0, 53),
+                                         std::ldexp(1.0, 53) + 2,
+                                         std::ldexp(1.0, 63) - 1024,
+                                         std::ldexp(1.0, 63),
+                                         -std::ldexp(1.0, 63),
+                                         std::ldexp(1.0, 64),
+                                         std::numeric_limits<double>::max(),
+                                         std::numeric_limits<double>::infinity(),
+                                         -std::numeric_limits<double>::infinity(),
+                                         std::numeric_limits<double>::quiet_NaN()};
+    const std::vector<long long> longs = {0,
+                                          1,
+                                          -1,
+                                          63,
+                                          64,
+                                          -64,
+                                          -65,
+                                          1LL << 31,
+                                          -(1LL << 40),
+                                          std::numeric_limits<long long>::max(),
+                                          std::numeric_limits<long long>::min(),
+                                          std::numeric_limits<long long>::min() + 1};
+
+    std::mt19937_64 gen(newSeed());
+    const auto randomDouble = [&gen]() -> double {
+        switch (gen() % 3) {
+            case 0:  // An integral value of any magnitude.
+                return static_cast<double>(static_cast<long long>(gen()) >> (gen() % 64));
+            case 1:  // A fraction.
+                return static_cast<double>(static_cast<int>(gen())) / (1 << (gen() % 20));
+            default: {  // Any bit pattern.
+                const uint64_t bits = gen();
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+                return d;
+            }
+        }
+    };
+
+    std::vector<BSONObj> objs;
+    std::vector<RecordId> recordIds;
+    for (size_t i = 0; i < 1000; i++) {
+        const double d = i < doubles.size() ? doubles[i] : randomDouble();
+        const long long l = i < longs.size() ? longs[i]
+                                             : static_cast<long long>(gen()) >> (gen() % 64);
+        objs.push_back(BSON("" << d << "" << l << "" << randomDouble()));
+        recordIds.emplace_back(i + 1);
+    }
+    objs[14] = BSON("" << 1 << "" << 2LL << "" << 3.0);
+    objs[20] = BSON("" << 1.0 << "" << "a" << "" << 3.0);
+    objs[30] = BSON("" << 1.0 << "" << 2LL);
+    objs[40] = BSON("" << 1.0 << "" << 2LL << "" << 3.0 << "" << 4.0);
+    objs[50] = BSON("" << 1.0 << "" << 2.0 << "" << 3.0);
+    objs[63] = BSON("" << 1.0 << "" << 2LL << "g" << 3.0);
+
+    for (const Ordering& ord : {Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1)),
+                                Ordering::make(BSON("a" << -1 << "b" << -1 << "c" << -1))}) {
+        // One encoder reused for batches of every size, some starting with a key that doesn't
+        // match the numeric pattern.
+        KeyString::BatchEncoder encoder(version, ord);
+        for (size_t batchSize : {1, 7, 64, 1000}) {
+            for (size_t start = 0; start < objs.size(); start += batchSize) {
+                const size_t end = std::min(objs.size(), start + batchSize);
+                const std::vector<BSONObj> batchObjs(objs.begin() + start, objs.begin() + end);
+                const std::vector<RecordId> batchRecordIds(recordIds.begin() + start,
+                                                           recordIds.begin() + end);
+                encoder.encode(batchObjs, batchRecordIds);
+                ASSERT_EQ(encoder.size(), batchObjs.size());
+
+                for (size_t i = 0; i < batchObjs.size(); i++) {
+                    const KeyString expected(version, batchObjs[i], ord, batchRecordIds[i]);
+                    const KeyString& actual = encoder.key(i);
+                    ASSERT_EQ(toHex(actual.getBuffer(), actual.getSize()),
+                              toHex(expected.getBuffer(), expected.getSize()))
+                        << batchObjs[i];
+                    const KeyString::TypeBits& actualBits = actual.getTypeBits();
+                    const KeyString::TypeBits& expectedBits = expected.getTypeBits();
+                    ASSERT_EQ(toHex(actualBits.getBuffer(), actualBits.getSize()),
+                              toHex(expectedBits.getBuffer(), expectedBits.getSize()))
+                        << batchObjs[i];
+                }
+            }
+        }
+
+        encoder.encode({}, {});
+        ASSERT_EQ(encoder.size(), 0U);
+    }
+}
+
 TEST_F(KeyStringTest, KeyWithTooManyTypeBitsCausesUassert) {
     BSONObj obj;
     {
@@ -248,6 +248,18 @@ public:
      */
     virtual boost::optional<Record> seekExact(const RecordId& id) = 0;
 
+    /**
+     * Positions the cursor so that the next call to next() returns the first Record after 'id' in
+     * the direction of the cursor, whether or not a Record with that id exists. A null 'id'
+     * positions the cursor before the first Record. The position survives save() and restore().
+     *
+     * Only the cursors of record stores which return split points from
+     * RecordStore::getRangeSplitPoints() must support this.
+     */
+    virtual void positionAfter(const RecordId& id) {
+        MONGO_UNREACHABLE;
+    }
+
     /**
      * Prepares for state changes in underlying data without necessarily saving the current
      * state.
@@ -501,6 +513,22 @@ public:
         return {};
     }
 
+    /**
+     * Returns up to 'numRanges' - 1 distinct RecordIds, in increasing order, which split this
+     * record store into ranges holding roughly equal numbers of records. The first range holds the
+     * records up to and including the first split point, and each following range holds the
+     * records after one split point up to and including the next. The ranges can then be scanned
+     * independently by forward cursors positioned with SeekableRecordCursor::positionAfter().
+     *
+     * The split points are only an estimate and may be stale as soon as they are returned. Record
+     * stores which cannot be split, including those whose cursors do not support positionAfter(),
+     * return an empty vector.
+     */
+    virtual std::vector<RecordId> getRangeSplitPoints(OperationContext* opCtx,
+                                                      size_t numRanges) const {
+        return {};
+    }
+
     /**
      * Returns many RecordCursors that partition the RecordStore into many disjoint sets.
      * Iterating all returned RecordCursors is equivalent to iterating the full store.
@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/record_store_test_harness.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using std::unique_ptr;
+using std::string;
+
+// An empty record store has nothing to split.
+TEST(RecordStoreTestHarness, GetRangeSplitPointsEmpty) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    ASSERT(rs->getRangeSplitPoints(opCtx.get(), 4).empty());
+}
+
+// Scanning every range between the split points returns each record exactly once.
+TEST(RecordStoreTestHarness, GetRangeSplitPointsCoverAllRecords) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const unsigned nToInsert = 5000;
+    std::vector<RecordId> locs;
+    for (unsigned i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        string data = "record " + std::to_string(i);
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp(), false);
+        ASSERT_OK(res.getStatus());
+        locs.push_back(res.getValue());
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    const size_t numRanges = 4;
+    auto splitPoints = rs->getRangeSplitPoints(opCtx.get(), numRanges);
+    // Returns no split points if splitting is not supported.
+    if (splitPoints.empty()) {
+        return;
+    }
+    ASSERT_LT(splitPoints.size(), numRanges);
+    for (size_t i = 1; i < splitPoints.size(); i++) {
+        ASSERT_LT(splitPoints[i - 1], splitPoints[i]);
+    }
+
+    std::vector<RecordId> scanned;
+    for (size_t i = 0; i <= splitPoints.size(); i++) {
+        auto cursor = rs->getCursor(opCtx.get());
+        cursor->positionAfter(i == 0 ? RecordId() : splitPoints[i - 1]);
+
+        // The position must survive a yield before the first record is read.
+        cursor->save();
+        ASSERT(cursor->restore());
+
+        while (auto record = cursor->next()) {
+            if (i < splitPoints.size() && record->id > splitPoints[i]) {
+                break;
+            }
+            scanned.push_back(record->id);
+        }
+    }
+
+    std::sort(locs.begin(), locs.end());
+    ASSERT(scanned == locs);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,249 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor_cache.h"
+
+#include <algorithm>
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+// Finalizer of splitmix64, used to spread table ids over the sketch rows.
+uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+void appendCounters(BSONObjBuilder* builder, const WiredTigerCursorCacheStats::Counters& c) {
+    builder->append("hits", c.hits);
+    builder->append("misses", c.misses);
+    builder->append("evictions", c.evictions);
+}
+
+}  // namespace
+
+void WiredTigerCursorCache::FrequencySketch::ensureCapacity(size_t capacity) {
+    size_t width = 16;
+    while (width < capacity * 4)
+        width *= 2;
+    if (width <= _width)
+        return;
+
+    _width = width;
+    _counters.assign(kDepth * _width, 0);
+    _increments = 0;
+}
+
+size_t WiredTigerCursorCache::FrequencySketch::_slot(uint64_t id, size_t row) const {
+    return row * _width + (mix(id + row * 0x9e3779b97f4a7c15ULL) & (_width - 1));
+}
+
+void WiredTigerCursorCache::FrequencySketch::increment(uint64_t id) {
+    if (_width == 0)
+        return;
+
+    for (size_t row = 0; row < kDepth; row++) {
+        uint8_t& counter = _counters[_slot(id, row)];
+        if (counter < kMaxCount)
+            counter++;
+    }
+
+    if (++_increments >= _width * 10) {
+        for (auto& counter : _counters)
+            counter >>= 1;
+        _increments /= 2;
+    }
+}
+
+unsigned WiredTigerCursorCache::FrequencySketch::estimate(uint64_t id) const {
+    if (_width == 0)
+        return 0;
+
+    unsigned result = kMaxCount;
+    for (size_t row = 0; row < kDepth; row++)
+        result = std::min<unsigned>(result, _counters[_slot(id, row)]);
+    return result;
+}
+
+WT_CURSOR* WiredTigerCursorCache::take(uint64_t id) {
+    _sketch.increment(id);
+
+    auto found = _index.find(id);
+    if (found == _index.end()) {
+        auto ghost = _ghosts.find(id);
+        if (ghost != _ghosts.end()) {
+            _ghostOrder.erase(ghost->second);
+            _ghosts.erase(ghost);
+
+            // A cache with more room would have had this cursor; grow by an eighth.
+            _capacity = std::min(_maxCapacity, _capacity + std::max<size_t>(1, _capacity / 8));
+            _putsSinceGhostHit = 0;
+        }
+        return nullptr;
+    }
+
+    // Hand out the most recently released cursor for the table.
+    auto it = found->second.back();
+    found->second.pop_back();
+    if (found->second.empty())
+        _index.erase(found);
+
+    WT_CURSOR* cursor = it->_cursor;
+    _lru.erase(it);
+    return cursor;
+}
+
+void WiredTigerCursorCache::put(uint64_t id,
+                                WT_CURSOR* cursor,
+                                size_t minCapacity,
+                                size_t maxCapacity,
+                                CursorVector* evicted) {
+    invariant(minCapacity > 0);
+
+    _lru.emplace_front(id, _gen++, cursor);
+    _index[id].push_back(_lru.begin());
+
+    if (maxCapacity <= minCapacity) {
+        // Fixed size: close the cursors released more than 'minCapacity' releases ago.
+        _capacity = _maxCapacity = minCapacity;
+        _trimGhosts(0);
+        while (!_lru.empty() && _gen - _lru.back()._gen > minCapacity)
+            _evict(std::prev(_lru.end()), evicted);
+        return;
+    }
+
+    _maxCapacity = maxCapacity;
+    _capacity = std::min(std::max(_capacity, minCapacity), _maxCapacity);
+    _sketch.ensureCapacity(_maxCapacity);
+
+    // Give back a slot after a long run without a miss that more room would have avoided.
+    if (++_putsSinceGhostHit > 8 * _capacity && _capacity > minCapacity) {
+        _capacity--;
+        _putsSinceGhostHit = 0;
+    }
+
+    // The cursor just released only displaces the least recently used one if its table has been
+    // looked up more often. Later evictions, which only happen if the capacity shrank, are LRU.
+    bool admitted = false;
+    while (_lru.size() > _capacity) {
+        auto victim = std::prev(_lru.end());
+        if (!admitted) {
+            admitted = true;
+            auto candidate = _lru.begin();
+            if (_sketch.estimate(candidate->_id) < _sketch.estimate(victim->_id))
+                victim = candidate;
+        }
+        _evict(victim, evicted);
+    }
+
+    _trimGhosts(_maxCapacity - _capacity);
+}
+
+void WiredTigerCursorCache::_trimGhosts(size_t maxGhosts) {
+    while (_ghostOrder.size() > maxGhosts) {
+        _ghosts.erase(_ghostOrder.front());
+        _ghostOrder.pop_front();
+    }
+}
+
+void WiredTigerCursorCache::_unindex(CursorList::iterator it) {
+    auto found = _index.find(it->_id);
+    invariant(found != _index.end());
+
+    auto& entries = found->second;
+    entries.erase(std::find(entries.begin(), entries.end(), it));
+    if (entries.empty())
+        _index.erase(found);
+}
+
+void WiredTigerCursorCache::_evict(CursorList::iterator it, CursorVector* evicted) {
+    if (_capacity < _maxCapacity && _ghosts.find(it->_id) == _ghosts.end()) {
+        _ghostOrder.push_back(it->_id);
+        _ghosts.emplace(it->_id, std::prev(_ghostOrder.end()));
+    }
+
+    evicted->push_back(*it);
+    _unindex(it);
+    _lru.erase(it);
+}
+
+void WiredTigerCursorCacheStats::add(uint64_t id,
+                                     const std::string& uri,
+                                     const Counters& counters) {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    _total.hits += counters.hits;
+    _total.misses += counters.misses;
+    _total.evictions += counters.evictions;
+
+    auto it = _byTable.find(id);
+    if (it == _byTable.end()) {
+        if (_byTable.size() >= kMaxTrackedTables)
+            return;
+        it = _byTable.emplace(id, TableCounters()).first;
+    }
+    if (it->second.uri.empty())
+        it->second.uri = uri;
+    it->second.counters.hits += counters.hits;
+    it->second.counters.misses += counters.misses;
+    it->second.counters.evictions += counters.evictions;
+}
+
+void WiredTigerCursorCacheStats::append(BSONObjBuilder* builder, bool includeURIs) const {
+    stdx::lock_guard<stdx::mutex> lk(_mutex);
+    appendCounters(builder, _total);
+
+    if (!includeURIs)
+        return;
+
+    // A URI can have had several table ids, if it was dropped and created again.
+    std::map<std::string, Counters> byURI;
+    for (auto&& entry : _byTable) {
+        if (entry.second.uri.empty())
+            continue;
+        auto& counters = byURI[entry.second.uri];
+        counters.hits += entry.second.counters.hits;
+        counters.misses += entry.second.counters.misses;
+        counters.evictions += entry.second.counters.evictions;
+    }
+
+    BSONObjBuilder urisBuilder(builder->subobjStart("uris"));
+    for (auto&& entry : byURI) {
+        BSONObjBuilder uriBuilder(urisBuilder.subobjStart(entry.first));
+        appendCounters(&uriBuilder, entry.second);
+    }
+}
+
+}  // namespace mongo
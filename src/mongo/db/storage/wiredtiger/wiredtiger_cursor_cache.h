@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <wiredtiger.h>
+
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+class WiredTigerCachedCursor {
+public:
+    WiredTigerCachedCursor(uint64_t id, uint64_t gen, WT_CURSOR* cursor)
+        : _id(id), _gen(gen), _cursor(cursor) {}
+
+    uint64_t _id;   // Source ID, assigned to each URI
+    uint64_t _gen;  // Generation, used to age out old cursors
+    WT_CURSOR* _cursor;
+};
+
+/**
+ * Caches idle cursors of a single WiredTiger session, keyed by table id.
+ *
+ * Cursors are kept in LRU order and stamped with a release generation. How they are given up
+ * depends on the bounds passed to put():
+ *
+ * - When the maximum capacity does not exceed the minimum, the cache has a fixed size and ages
+ *   cursors out by generation: a cursor is closed once 'minCapacity' other releases have happened
+ *   since its own. This is the policy the session used before the cache was indexed.
+ *
+ * - Otherwise the cache is adaptive. When it is over capacity, a TinyLFU-style frequency sketch
+ *   of recent lookups decides whether the least recently used cursor or the one just released is
+ *   given up, so that touching many rarely used tables does not flush the cursors of frequently
+ *   used ones. This means the cursor just released may be the one closed. The capacity adapts
+ *   between the bounds: a miss on a table whose cursor was recently given up grows it, and a long
+ *   run of releases without such misses shrinks it again.
+ *
+ * The cache never closes cursors itself. Cursors it gives up are handed back to the caller.
+ *
+ * NOT THREADSAFE
+ */
+class WiredTigerCursorCache {
+public:
+    typedef std::vector<WiredTigerCachedCursor> CursorVector;
+
+    /**
+     * Returns a cached cursor for table 'id' and removes it from the cache, or nullptr if there is
+     * none. Either way the lookup counts towards the frequency of 'id'.
+     */
+    WT_CURSOR* take(uint64_t id);
+
+    /**
+     * Caches 'cursor' for table 'id'. The capacity is first clamped to [minCapacity, maxCapacity],
+     * then cursors are evicted until it is respected and appended to 'evicted'. 'minCapacity' must
+     * be greater than zero. A 'maxCapacity' not greater than 'minCapacity' selects the fixed size,
+     * generation aged policy.
+     */
+    void put(uint64_t id,
+             WT_CURSOR* cursor,
+             size_t minCapacity,
+             size_t maxCapacity,
+             CursorVector* evicted);
+
+    /**
+     * Removes every cached cursor for which 'pred' returns true and appends it to 'removed'.
+     * Removal does not count as eviction, so it never grows the capacity.
+     */
+    template <typename Predicate>
+    void removeIf(Predicate pred, CursorVector* removed) {
+        for (auto it = _lru.begin(); it != _lru.end();) {
+            if (pred(*it)) {
+                removed->push_back(*it);
+                _unindex(it);
+                it = _lru.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    size_t size() const {
+        return _lru.size();
+    }
+
+    bool empty() const {
+        return _lru.empty();
+    }
+
+    size_t capacity() const {
+        return _capacity;
+    }
+
+private:
+    typedef std::list<WiredTigerCachedCursor> CursorList;
+
+    /**
+     * Count-min sketch with four rows of counters saturating at 15. All counters are halved once
+     * the number of increments reaches ten times the width, so that the estimate follows the
+     * recent access pattern rather than all-time popularity.
+     */
+    class FrequencySketch {
+    public:
+        /**
+         * Makes the sketch wide enough to tell apart the tables of a cache holding up to
+         * 'capacity' cursors. Growing the sketch discards the counts gathered so far.
+         */
+        void ensureCapacity(size_t capacity);
+
+        void increment(uint64_t id);
+
+        unsigned estimate(uint64_t id) const;
+
+    private:
+        static const size_t kDepth = 4;
+        static const uint8_t kMaxCount = 15;
+
+        size_t _slot(uint64_t id, size_t row) const;
+
+        std::vector<uint8_t> _counters;  // kDepth rows of _width counters each
+        size_t _width = 0;
+        size_t _increments = 0;
+    };
+
+    void _unindex(CursorList::iterator it);
+
+    void _evict(CursorList::iterator it, CursorVector* evicted);
+
+    void _trimGhosts(size_t maxGhosts);
+
+    CursorList _lru;  // Most recently released cursor first
+    stdx::unordered_map<uint64_t, std::vector<CursorList::iterator>> _index;
+    uint64_t _gen = 0;  // Release generation of the next cursor put in the cache
+
+    size_t _capacity = 0;
+    size_t _maxCapacity = 0;
+
+    // Tables whose cursors were evicted recently, oldest first, each indexed by its position so
+    // that a table appears at most once. A miss on one of these means a larger cache would have
+    // hit. Bounded by the room the capacity still has to grow.
+    typedef std::list<uint64_t> GhostList;
+    GhostList _ghostOrder;
+    stdx::unordered_map<uint64_t, GhostList::iterator> _ghosts;
+    size_t _putsSinceGhostHit = 0;
+
+    FrequencySketch _sketch;
+};
+
+/**
+ * Hit, miss and eviction counts of the session cursor caches, in total and per table. Sessions
+ * accumulate their counts locally by table id and add them here in batches. Tables are reported
+ * by URI.
+ *
+ * THREADSAFE
+ */
+class WiredTigerCursorCacheStats {
+public:
+    struct Counters {
+        long long hits = 0;
+        long long misses = 0;
+        long long evictions = 0;
+
+        long long events() const {
+            return hits + misses + evictions;
+        }
+    };
+
+    /**
+     * Past this many distinct tables, counts are only added to the totals.
+     */
+    static const size_t kMaxTrackedTables = 10000;
+
+    /**
+     * Adds 'counters' to the counts of table 'id'. The URI of a table only needs to be passed the
+     * first time its counts are added; an empty 'uri' leaves the recorded one in place.
+     */
+    void add(uint64_t id, const std::string& uri, const Counters& counters);
+
+    /**
+     * Appends the totals to 'builder', followed by a "uris" subdocument with the counts of each
+     * tracked URI when 'includeURIs' is true.
+     */
+    void append(BSONObjBuilder* builder, bool includeURIs) const;
+
+private:
+    struct TableCounters {
+        std::string uri;
+        Counters counters;
+    };
+
+    mutable stdx::mutex _mutex;
+    Counters _total;
+    stdx::unordered_map<uint64_t, TableCounters> _byTable;
+};
+
+}  // namespace mongo
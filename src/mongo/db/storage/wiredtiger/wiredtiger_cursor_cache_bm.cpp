@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/server_parameters.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const int kCursorCacheSize = 100;
+
+void setIntParameter(StringData name, int value) {
+    auto param = ServerParameterSet::getGlobal()->getMap().find(name.toString());
+    invariant(param != ServerParameterSet::getGlobal()->getMap().end());
+    invariantOK(param->second->setFromString(std::to_string(value)));
+}
+
+/**
+ * Opens cursors on 'state.range(0)' tables of a fresh WiredTiger connection. Tables are picked
+ * following a Zipf distribution, so a few are hot and most are touched rarely, as with a
+ * deployment holding thousands of collections. 'state.range(1)' is the upper bound for the
+ * adaptive cursor cache; the lower bound is kCursorCacheSize.
+ *
+ * The "openCursorPerOp" counter is the fraction of lookups that missed the cursor cache and had
+ * to call WT_SESSION::open_cursor.
+ */
+void BM_OpenCursorsAcrossTables(benchmark::State& state) {
+    const int numTables = state.range(0);
+    setIntParameter("wiredTigerCursorCacheSize", kCursorCacheSize);
+    setIntParameter("wiredTigerCursorCacheMaxSize", state.range(1));
+
+    unittest::TempDir dbpath("wt_cursor_cache_bm");
+    WT_CONNECTION* conn;
+    invariantWTOK(wiredtiger_open(dbpath.path().c_str(), nullptr, "create", &conn));
+
+    std::vector<std::pair<std::string, uint64_t>> tables;
+    {
+        WiredTigerSessionCache sessionCache(conn);
+        auto session = sessionCache.getSession();
+        WT_SESSION* s = session->getSession();
+        for (int i = 0; i < numTables; i++) {
+            std::string uri = str::stream() << "table:cursor_cache_bm_" << i;
+            invariantWTOK(s->create(s, uri.c_str(), "key_format=q,value_format=u"));
+            tables.emplace_back(uri, WiredTigerSession::genTableId());
+        }
+    }
+
+    std::vector<double> weights;
+    for (int i = 0; i < numTables; i++) {
+        weights.push_back(1.0 / (i + 1));
+    }
+    std::discrete_distribution<int> pickTable(weights.begin(), weights.end());
+    std::mt19937 gen(1);
+
+    {
+        WiredTigerSessionCache sessionCache(conn);
+        auto session = sessionCache.getSession();
+
+        for (auto keepRunning : state) {
+            const auto& table = tables[pickTable(gen)];
+            WT_CURSOR* cursor = session->getCursor(table.first, table.second, false);
+            session->releaseCursor(table.second, cursor);
+        }
+
+        // Destroying the session adds its cursor cache counts to the session cache.
+        session.reset();
+        sessionCache.closeAll();
+
+        BSONObjBuilder stats;
+        sessionCache.getCursorCacheStats().append(&stats, false);
+        state.counters["openCursorPerOp"] = stats.obj()["misses"].numberLong() /
+            static_cast<double>(std::max<size_t>(state.iterations(), 1));
+    }
+
+    invariantWTOK(conn->close(conn, nullptr));
+    setIntParameter("wiredTigerCursorCacheSize", -kCursorCacheSize);
+    setIntParameter("wiredTigerCursorCacheMaxSize", 0);
+}
+
+BENCHMARK(BM_OpenCursorsAcrossTables)
+    ->ArgNames({"tables", "maxCacheSize"})
+    ->Args({10, 0})
+    ->Args({1000, 0})
+    ->Args({1000, 1000})
+    ->Args({5000, 0})
+    ->Args({5000, 1000});
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,268 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <array>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor_cache.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+// The cache never dereferences the cursors it holds, so these only serve as distinct addresses.
+std::array<WT_CURSOR, 64> cursors;
+
+WT_CURSOR* cursorFor(uint64_t id) {
+    return &cursors[id];
+}
+
+TEST(WiredTigerCursorCacheTest, TakeReturnsCachedCursorOnce) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    ASSERT_FALSE(cache.take(1));
+    cache.put(1, cursorFor(1), 4, 4, &evicted);
+    ASSERT_EQ(1U, cache.size());
+
+    ASSERT_EQ(cursorFor(1), cache.take(1));
+    ASSERT_FALSE(cache.take(1));
+    ASSERT_TRUE(cache.empty());
+    ASSERT_TRUE(evicted.empty());
+}
+
+TEST(WiredTigerCursorCacheTest, HoldsSeveralCursorsForTheSameTable) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    cache.put(1, cursorFor(1), 4, 4, &evicted);
+    cache.put(1, cursorFor(2), 4, 4, &evicted);
+
+    // The most recently released cursor comes back first.
+    ASSERT_EQ(cursorFor(2), cache.take(1));
+    ASSERT_EQ(cursorFor(1), cache.take(1));
+    ASSERT_FALSE(cache.take(1));
+}
+
+TEST(WiredTigerCursorCacheTest, EvictsLeastRecentlyUsedWhenFrequenciesTie) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    for (uint64_t id = 1; id <= 3; id++)
+        cache.put(id, cursorFor(id), 2, 2, &evicted);
+
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_EQ(1U, evicted.size());
+    ASSERT_EQ(1U, evicted[0]._id);
+    ASSERT_FALSE(cache.take(1));
+}
+
+TEST(WiredTigerCursorCacheTest, FixedSizeAgesOutByGeneration) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    // Table 1 is looked up many times before a scan touches tables that are used only once.
+    cache.put(1, cursorFor(1), 2, 0, &evicted);
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(cursorFor(1), cache.take(1));
+        cache.put(1, cursorFor(1), 2, 0, &evicted);
+    }
+
+    for (uint64_t id = 10; id < 20; id++) {
+        ASSERT_FALSE(cache.take(id));
+        cache.put(id, cursorFor(id), 2, 0, &evicted);
+    }
+
+    // Only the cursors of the last two releases are kept, however often table 1 was used.
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_FALSE(cache.take(1));
+    ASSERT_EQ(cursorFor(19), cache.take(19));
+    ASSERT_EQ(cursorFor(18), cache.take(18));
+}
+
+TEST(WiredTigerCursorCacheTest, FrequentlyUsedCursorSurvivesScan) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    // Table 1 is looked up many times before a scan touches tables that are used only once.
+    cache.put(1, cursorFor(1), 2, 4, &evicted);
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(cursorFor(1), cache.take(1));
+        cache.put(1, cursorFor(1), 2, 4, &evicted);
+    }
+
+    for (uint64_t id = 10; id < 20; id++) {
+        ASSERT_FALSE(cache.take(id));
+        cache.put(id, cursorFor(id), 2, 4, &evicted);
+    }
+
+    ASSERT_EQ(cursorFor(1), cache.take(1));
+}
+
+TEST(WiredTigerCursorCacheTest, CapacityGrowsOnMissesForRecentlyEvictedTables) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    // Cycle over more tables than the minimum capacity allows.
+    for (int round = 0; round < 20; round++) {
+        for (uint64_t id = 1; id <= 8; id++) {
+            if (WT_CURSOR* cursor = cache.take(id))
+                ASSERT_EQ(cursorFor(id), cursor);
+            cache.put(id, cursorFor(id), 2, 16, &evicted);
+        }
+    }
+
+    ASSERT_GTE(cache.capacity(), 7U);
+    ASSERT_LTE(cache.capacity(), 16U);
+
+    // Once the working set fits, lookups hit. The capacity periodically probes one slot lower, so
+    // allow for a single miss.
+    int misses = 0;
+    for (uint64_t id = 1; id <= 8; id++) {
+        if (!cache.take(id))
+            misses++;
+        cache.put(id, cursorFor(id), 2, 16, &evicted);
+    }
+    ASSERT_LTE(misses, 1);
+}
+
+TEST(WiredTigerCursorCacheTest, CapacityShrinksBackWithoutGhostHits) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    for (int round = 0; round < 20; round++) {
+        for (uint64_t id = 1; id <= 8; id++) {
+            cache.take(id);
+            cache.put(id, cursorFor(id), 2, 16, &evicted);
+        }
+    }
+    ASSERT_GT(cache.capacity(), 2U);
+
+    // A single hot table never misses, so the extra room is given back.
+    for (int i = 0; i < 1000; i++) {
+        cache.take(1);
+        cache.put(1, cursorFor(1), 2, 16, &evicted);
+    }
+    ASSERT_EQ(2U, cache.capacity());
+    ASSERT_LTE(cache.size(), 2U);
+}
+
+TEST(WiredTigerCursorCacheTest, FixedSizeWhenMaxDoesNotExceedMin) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    for (int round = 0; round < 20; round++) {
+        for (uint64_t id = 1; id <= 8; id++) {
+            cache.take(id);
+            cache.put(id, cursorFor(id), 4, 0, &evicted);
+        }
+    }
+    ASSERT_EQ(4U, cache.capacity());
+    ASSERT_EQ(4U, cache.size());
+}
+
+TEST(WiredTigerCursorCacheTest, TableEvictedAgainAfterGhostHitStaysAGhost) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    // Table 1 is evicted for table 2, and the miss on it grows the capacity to 2.
+    cache.take(1);
+    cache.put(1, cursorFor(1), 1, 3, &evicted);
+    cache.take(2);
+    cache.put(2, cursorFor(2), 1, 3, &evicted);
+    ASSERT_FALSE(cache.take(1));
+    ASSERT_EQ(2U, cache.capacity());
+    cache.put(1, cursorFor(1), 1, 3, &evicted);
+
+    // Table 2 and then table 3 become more popular than table 1, which is evicted again.
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(cursorFor(2), cache.take(2));
+        cache.put(2, cursorFor(2), 1, 3, &evicted);
+    }
+    for (int i = 0; i < 3; i++) {
+        ASSERT_FALSE(cache.take(3));
+    }
+    evicted.clear();
+    cache.put(3, cursorFor(3), 1, 3, &evicted);
+    ASSERT_EQ(1U, evicted.size());
+    ASSERT_EQ(1U, evicted[0]._id);
+
+    // Its earlier ghost hit must not have left a stale entry behind that drops the new ghost.
+    ASSERT_FALSE(cache.take(1));
+    ASSERT_EQ(3U, cache.capacity());
+}
+
+TEST(WiredTigerCursorCacheTest, RemoveIfDoesNotCountAsEviction) {
+    WiredTigerCursorCache cache;
+    WiredTigerCursorCache::CursorVector evicted;
+
+    for (uint64_t id = 1; id <= 4; id++)
+        cache.put(id, cursorFor(id), 4, 8, &evicted);
+
+    WiredTigerCursorCache::CursorVector removed;
+    cache.removeIf([](const WiredTigerCachedCursor& entry) { return entry._id % 2 == 0; },
+                   &removed);
+
+    ASSERT_EQ(2U, removed.size());
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_FALSE(cache.take(2));
+    ASSERT_EQ(4U, cache.capacity());
+    ASSERT_EQ(cursorFor(3), cache.take(3));
+}
+
+TEST(WiredTigerCursorCacheStatsTest, ReportsTotalsAndURIsOnRequest) {
+    WiredTigerCursorCacheStats stats;
+    WiredTigerCursorCacheStats::Counters counters;
+    counters.hits = 3;
+    counters.misses = 2;
+    stats.add(1, "table:a", counters);
+    counters.evictions = 1;
+    stats.add(2, "table:b", counters);
+
+    // Later batches need not repeat the URI.
+    counters.evictions = 0;
+    stats.add(1, "", counters);
+
+    BSONObjBuilder totalsOnly;
+    stats.append(&totalsOnly, false);
+    ASSERT_BSONOBJ_EQ(BSON("hits" << 9LL << "misses" << 6LL << "evictions" << 1LL),
+                      totalsOnly.obj());
+
+    BSONObjBuilder withURIs;
+    stats.append(&withURIs, true);
+    BSONObj withURIsObj = withURIs.obj();
+    ASSERT_BSONOBJ_EQ(BSON("hits" << 6LL << "misses" << 4LL << "evictions" << 0LL),
+                      withURIsObj["uris"]["table:a"].Obj());
+    ASSERT_BSONOBJ_EQ(BSON("hits" << 3LL << "misses" << 2LL << "evictions" << 1LL),
+                      withURIsObj["uris"]["table:b"].Obj());
+}
+
+}  // namespace
+}  // namespace mongo
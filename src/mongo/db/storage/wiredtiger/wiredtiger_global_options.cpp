@@ -31,6 +31,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/status.h"
+#include "mongo/config.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/util/log.h"
@@ -38,6 +39,22 @@
 
 namespace mongo {
 
+namespace {
+
+// The compressors WiredTiger is built with. zstd is only available when building against a system
+// zstd library.
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+const char kCompressorFormat[] = "(:?none)|(:?snappy)|(:?zlib)|(:?zstd)";
+const char kCompressorDisplayFormat[] = "(none/snappy/zlib/zstd)";
+const char kCompressorHelpList[] = "[none|snappy|zlib|zstd]";
+#else
+const char kCompressorFormat[] = "(:?none)|(:?snappy)|(:?zlib)";
+const char kCompressorDisplayFormat[] = "(none/snappy/zlib)";
+const char kCompressorHelpList[] = "[none|snappy|zlib]";
+#endif
+
+}  // namespace
+
 WiredTigerGlobalOptions wiredTigerGlobalOptions;
 
 Status WiredTigerGlobalOptions::add(moe::OptionSection* options) {
@@ -63,8 +80,9 @@ Status WiredTigerGlobalOptions::add(moe::OptionSection* options) {
         .addOptionChaining("storage.wiredTiger.engineConfig.journalCompressor",
                            "wiredTigerJournalCompressor",
                            moe::String,
-                           "use a compressor for log records [none|snappy|zlib]")
-        .format("(:?none)|(:?snappy)|(:?zlib)", "(none/snappy/zlib)")
+                           std::string("use a compressor for log records ") +
+                               kCompressorHelpList)
+        .format(kCompressorFormat, kCompressorDisplayFormat)
         .setDefault(moe::Value(std::string("snappy")));
     wiredTigerOptions.addOptionChaining("storage.wiredTiger.engineConfig.directoryForIndexes",
                                         "wiredTigerDirectoryForIndexes",
@@ -83,9 +101,9 @@ Status WiredTigerGlobalOptions::add(moe::OptionSection* options) {
         .addOptionChaining("storage.wiredTiger.collectionConfig.blockCompressor",
                            "wiredTigerCollectionBlockCompressor",
                            moe::String,
-                           "block compression algorithm for collection data "
-                           "[none|snappy|zlib]")
-        .format("(:?none)|(:?snappy)|(:?zlib)", "(none/snappy/zlib)")
+                           std::string("block compression algorithm for collection data ") +
+                               kCompressorHelpList)
+        .format(kCompressorFormat, kCompressorDisplayFormat)
         .setDefault(moe::Value(std::string("snappy")));
     wiredTigerOptions
         .addOptionChaining("storage.wiredTiger.collectionConfig.configString",
@@ -852,7 +852,8 @@ public:
           _key(idx.keyStringVersion()),
           _typeBits(idx.keyStringVersion()),
           _query(idx.keyStringVersion()),
-          _prefix(prefix) {
+          _prefix(prefix),
+          _decoder(idx.ordering()) {
         _cursor.emplace(_idx.uri(), _idx.tableId(), false, _opCtx);
     }
 
@@ -1001,7 +1002,10 @@ protected:
 
         BSONObj bson;
         if (TRACING_ENABLED || (parts & kWantKey)) {
-            bson = KeyString::toBson(_key.getBuffer(), _key.getSize(), _idx.ordering(), _typeBits);
+            // The key is decoded into a buffer reused for every key, callers copy the keys they
+            // keep. Keys a scan skips or filters out then cost no allocation.
+            _decoder.reset(_key.getBuffer(), _key.getSize(), _typeBits);
+            bson = _decoder.toBson();
 
             TRACE_CURSOR << " returning " << bson << ' ' << _id;
         }
@@ -1160,11 +1164,21 @@ protected:
 
     std::unique_ptr<KeyString> _endPosition;
 
+    // Decodes the keys returned by curr(), which is const.
+    mutable KeyString::Decoder _decoder;
+
 private:
     // Called after _key has been filled in. Must not throw WriteConflictException.
     void _updateIdAndTypeBits() {
         TRACE_INDEX << "KeyString: [" << _key.toString() << "]";
 
+        // Standard indexes always append the RecordId to the key, so there is no need to walk the
+        // whole key to find out where it ends.
+        if (!_idx.unique()) {
+            _updateIdFromKeyAndTypeBitsFromValue();
+            return;
+        }
+
         auto keySize = KeyString::getKeySize(
             _key.getBuffer(), _key.getSize(), _idx.ordering(), _key.getTypeBits());
 
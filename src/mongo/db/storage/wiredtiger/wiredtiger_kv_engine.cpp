@@ -880,24 +880,22 @@ Status WiredTigerKVEngine::dropIdent(OperationContext* opCtx, StringData ident)
     return Status::OK();
 }
 
-std::list<WiredTigerCachedCursor> WiredTigerKVEngine::filterCursorsWithQueuedDrops(
-    std::list<WiredTigerCachedCursor>* cache) {
-    std::list<WiredTigerCachedCursor> toDrop;
+WiredTigerCursorCache::CursorVector WiredTigerKVEngine::filterCursorsWithQueuedDrops(
+    WiredTigerCursorCache* cache) {
+    WiredTigerCursorCache::CursorVector toDrop;
 
     stdx::lock_guard<stdx::mutex> lk(_identToDropMutex);
     if (_identToDrop.empty())
         return toDrop;
 
-    for (auto i = cache->begin(); i != cache->end();) {
-        if (!i->_cursor ||
-            std::find(_identToDrop.begin(), _identToDrop.end(), std::string(i->_cursor->uri)) ==
-                _identToDrop.end()) {
-            ++i;
-            continue;
-        }
-        toDrop.push_back(*i);
-        i = cache->erase(i);
-    }
+    cache->removeIf(
+        [&](const WiredTigerCachedCursor& entry) {
+            return entry._cursor &&
+                std::find(_identToDrop.begin(),
+                          _identToDrop.end(),
+                          std::string(entry._cursor->uri)) != _identToDrop.end();
+        },
+        &toDrop);
 
     return toDrop;
 }
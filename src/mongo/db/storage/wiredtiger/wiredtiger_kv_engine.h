@@ -200,8 +200,7 @@ public:
         return _conn;
     }
     void dropSomeQueuedIdents();
-    std::list<WiredTigerCachedCursor> filterCursorsWithQueuedDrops(
-        std::list<WiredTigerCachedCursor>* cache);
+    WiredTigerCursorCache::CursorVector filterCursorsWithQueuedDrops(WiredTigerCursorCache* cache);
     bool haveDropsQueued() const;
 
     void syncSizeInfo(bool sync) const;
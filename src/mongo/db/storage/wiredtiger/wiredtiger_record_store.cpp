@@ -37,6 +37,8 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
+#include <algorithm>
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/static_assert.h"
 #include "mongo/bson/util/builder.h"
@@ -1382,6 +1384,47 @@ std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursor(
     return getRandomCursorWithOptions(opCtx, extraConfig);
 }
 
+std::vector<RecordId> WiredTigerRecordStore::getRangeSplitPoints(OperationContext* opCtx,
+                                                                 size_t numRanges) const {
+    // Capped collections must be read in insertion order, and the oplog must respect its
+    // visibility rules, so neither is split.
+    if (_isCapped || _isOplog || numRanges < 2) {
+        return {};
+    }
+
+    auto cursor = getRandomCursor(opCtx);
+    if (!cursor) {
+        return {};
+    }
+
+    // Take several samples per range so that the chosen split points are close to the quantiles
+    // of the RecordIds actually in use.
+    const size_t kSamplesPerRange = 16;
+    std::vector<RecordId> samples;
+    samples.reserve(numRanges * kSamplesPerRange);
+    while (samples.size() < numRanges * kSamplesPerRange) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        samples.push_back(record->id);
+    }
+
+    // A random cursor may return the same record more than once, which is also how a small table
+    // shows itself.
+    std::sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+    if (samples.size() < numRanges) {
+        return {};
+    }
+
+    std::vector<RecordId> splitPoints;
+    for (size_t i = 1; i < numRanges; ++i) {
+        splitPoints.push_back(samples[i * samples.size() / numRanges]);
+    }
+    return splitPoints;
+}
+
 std::vector<std::unique_ptr<RecordCursor>> WiredTigerRecordStore::getManyCursors(
     OperationContext* opCtx) const {
     std::vector<std::unique_ptr<RecordCursor>> cursors(1);
@@ -1859,6 +1902,16 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+void WiredTigerRecordStoreCursorBase::positionAfter(const RecordId& id) {
+    invariant(!_rs._isCapped);
+
+    // Let restore() find the first record after 'id', exactly as it does when resuming after a
+    // yield.
+    save();
+    _lastReturnedId = id;
+    _eof = false;
+    restore();
+}
 
 void WiredTigerRecordStoreCursorBase::save() {
     try {
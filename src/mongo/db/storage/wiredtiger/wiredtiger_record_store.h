@@ -176,6 +176,9 @@ public:
     virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
         OperationContext* opCtx, StringData extraConfig) const = 0;
 
+    std::vector<RecordId> getRangeSplitPoints(OperationContext* opCtx,
+                                              size_t numRanges) const final;
+
     std::vector<std::unique_ptr<RecordCursor>> getManyCursors(OperationContext* opCtx) const final;
 
     virtual Status truncate(OperationContext* opCtx);
@@ -412,6 +415,8 @@ public:
 
     boost::optional<Record> seekExact(const RecordId& id);
 
+    void positionAfter(const RecordId& id);
+
     void save();
 
     void saveUnpositioned();
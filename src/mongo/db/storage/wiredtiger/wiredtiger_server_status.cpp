@@ -69,8 +69,35 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
     invariant(s);
     const string uri = "statistics:";
 
+    BSONObjBuilder wtStats;
+    Status status = WiredTigerUtil::exportTableToBSON(s, uri, "statistics=(fast)", &wtStats);
+
+    // The cursor cache sits above WiredTiger, so its statistics are merged into the "session"
+    // section reported by WiredTiger. Verbosity 2 or higher adds a breakdown by URI.
+    const bool includeURIs = configElement.numberInt() >= 2;
+    const auto& cursorCacheStats =
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getCursorCacheStats();
     BSONObjBuilder bob;
-    Status status = WiredTigerUtil::exportTableToBSON(s, uri, "statistics=(fast)", &bob);
+    auto appendSessionSection = [&](const BSONObj& wtSessionStats) {
+        BSONObjBuilder sessionBob(bob.subobjStart("session"));
+        sessionBob.appendElements(wtSessionStats);
+        BSONObjBuilder cursorCacheBob(sessionBob.subobjStart("cursor cache"));
+        cursorCacheStats.append(&cursorCacheBob, includeURIs);
+    };
+
+    bool appendedSession = false;
+    for (auto&& elem : wtStats.done()) {
+        if (elem.fieldNameStringData() == "session" && elem.type() == Object) {
+            appendSessionSection(elem.Obj());
+            appendedSession = true;
+        } else {
+            bob.append(elem);
+        }
+    }
+    if (!appendedSession) {
+        appendSessionSection(BSONObj());
+    }
+
     if (!status.isOK()) {
         bob.append("error", "unable to retrieve statistics");
         bob.append("code", static_cast<int>(status.code()));
@@ -35,6 +35,10 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -45,6 +49,7 @@
 #include "mongo/stdx/memory.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/log.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -81,8 +86,21 @@ ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>
                                      "wiredTigerCursorCacheSize",
                                      &kWiredTigerCursorCacheSize);
 
+// The "wiredTigerCursorCacheMaxSize" parameter bounds how far a session's cursor cache may grow
+// beyond the absolute value of "wiredTigerCursorCacheSize" when the session keeps missing on
+// tables whose cursors it recently evicted. The cache shrinks back towards
+// "wiredTigerCursorCacheSize" once those misses stop. Values not larger than the absolute value of
+// "wiredTigerCursorCacheSize", including the default, keep the cache at a fixed size, with cursors
+// aged out by release generation as before.
+AtomicInt32 kWiredTigerCursorCacheMaxSize(0);
+
+ExportedServerParameter<std::int32_t, ServerParameterType::kStartupAndRuntime>
+    WiredTigerCursorCacheMaxSizeSetting(ServerParameterSet::getGlobal(),
+                                        "wiredTigerCursorCacheMaxSize",
+                                        &kWiredTigerCursorCacheMaxSize);
+
 WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64_t cursorEpoch)
-    : _epoch(epoch), _cursorEpoch(cursorEpoch), _session(NULL), _cursorGen(0), _cursorsOut(0) {
+    : _epoch(epoch), _cursorEpoch(cursorEpoch), _session(NULL), _cursorsOut(0) {
     invariantWTOK(conn->open_session(conn, NULL, "isolation=snapshot", &_session));
 }
 
@@ -94,26 +112,32 @@ WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn,
       _cursorEpoch(cursorEpoch),
       _cache(cache),
       _session(NULL),
-      _cursorGen(0),
       _cursorsOut(0) {
     invariantWTOK(conn->open_session(conn, NULL, "isolation=snapshot", &_session));
 }
 
 WiredTigerSession::~WiredTigerSession() {
+    _flushCursorCacheStats();
+
     if (_session) {
         invariantWTOK(_session->close(_session, NULL));
     }
 }
 
 WT_CURSOR* WiredTigerSession::getCursor(const std::string& uri, uint64_t id, bool forRecordStore) {
-    // Find the most recently used cursor
-    for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        if (i->_id == id) {
-            WT_CURSOR* c = i->_cursor;
-            _cursors.erase(i);
-            _cursorsOut++;
-            return c;
-        }
+    if (WT_CURSOR* c = _cursors.take(id)) {
+        _countCursorCacheEvent(id, &WiredTigerCursorCacheStats::Counters::hits);
+        _cursorsOut++;
+        return c;
+    }
+
+    // A session always misses before it hits or evicts a table's cursor, so the miss is where the
+    // URI is recorded for the statistics. It is only copied once per batch, and a miss costs an
+    // open_cursor call anyway.
+    if (auto pending =
+            _countCursorCacheEvent(id, &WiredTigerCursorCacheStats::Counters::misses)) {
+        if (pending->uri.empty())
+            pending->uri = uri;
     }
 
     WT_CURSOR* c = NULL;
@@ -133,16 +157,20 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor) {
 
     invariantWTOK(cursor->reset(cursor));
 
-    // Cursors are pushed to the front of the list and removed from the back
-    _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor));
-
     // A negative value for wiredTigercursorCacheSize means to use hybrid caching.
     std::uint32_t cacheSize = abs(kWiredTigerCursorCacheSize.load());
-
-    while (!_cursors.empty() && _cursorGen - _cursors.back()._gen > cacheSize) {
-        cursor = _cursors.back()._cursor;
-        _cursors.pop_back();
+    if (cacheSize == 0) {
         invariantWTOK(cursor->close(cursor));
+        return;
+    }
+
+    std::uint32_t maxCacheSize = std::max(kWiredTigerCursorCacheMaxSize.load(), 0);
+    WiredTigerCursorCache::CursorVector evicted;
+    _cursors.put(id, cursor, cacheSize, maxCacheSize, &evicted);
+
+    for (auto&& entry : evicted) {
+        _countCursorCacheEvent(entry._id, &WiredTigerCursorCacheStats::Counters::evictions);
+        invariantWTOK(entry._cursor->close(entry._cursor));
     }
 }
 
@@ -150,13 +178,15 @@ void WiredTigerSession::closeAllCursors(const std::string& uri) {
     invariant(_session);
 
     bool all = (uri == "");
-    for (auto i = _cursors.begin(); i != _cursors.end();) {
-        WT_CURSOR* cursor = i->_cursor;
-        if (cursor && (all || uri == cursor->uri)) {
-            invariantWTOK(cursor->close(cursor));
-            i = _cursors.erase(i);
-        } else
-            ++i;
+    WiredTigerCursorCache::CursorVector toClose;
+    _cursors.removeIf(
+        [&](const WiredTigerCachedCursor& entry) {
+            return entry._cursor && (all || uri == entry._cursor->uri);
+        },
+        &toClose);
+
+    for (auto&& entry : toClose) {
+        invariantWTOK(entry._cursor->close(entry._cursor));
     }
 }
 
@@ -174,6 +204,29 @@ void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
     }
 }
 
+WiredTigerSession::PendingCursorCacheStats* WiredTigerSession::_countCursorCacheEvent(
+    uint64_t id, long long WiredTigerCursorCacheStats::Counters::*counter) {
+    if (!_cache)
+        return nullptr;
+
+    auto& pending = _pendingCursorCacheStats[id];
+    pending.counters.*counter += 1;
+    _pendingCursorCacheEvents++;
+    return &pending;
+}
+
+void WiredTigerSession::_flushCursorCacheStats() {
+    if (!_cache || _pendingCursorCacheEvents == 0)
+        return;
+
+    auto& stats = _cache->getCursorCacheStats();
+    for (auto&& entry : _pendingCursorCacheStats) {
+        stats.add(entry.first, entry.second.uri, entry.second.counters);
+    }
+    _pendingCursorCacheStats.clear();
+    _pendingCursorCacheEvents = 0;
+}
+
 namespace {
 AtomicUInt64 nextTableId(1);
 }
@@ -184,11 +237,32 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+
+size_t defaultNumIdlePartitions() {
+    return std::max(ProcessInfo::getNumAvailableCores(), 1UL);
+}
+
+// Threads which cannot ask the OS which CPU they are running on are spread over the idle session
+// partitions round-robin, in the order in which they first touch the session cache.
+AtomicWord<unsigned> nextThreadPartitionSeed;
+thread_local unsigned threadPartitionSeed = nextThreadPartitionSeed.fetchAndAdd(1);
+
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
-    : _engine(engine), _conn(engine->getConnection()), _shuttingDown(0) {}
+    : _engine(engine),
+      _conn(engine->getConnection()),
+      _shuttingDown(0),
+      _idlePartitions(defaultNumIdlePartitions()) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn)
-    : _engine(NULL), _conn(conn), _shuttingDown(0) {}
+    : WiredTigerSessionCache(conn, defaultNumIdlePartitions()) {}
+
+WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, size_t numIdlePartitions)
+    : _engine(NULL), _conn(conn), _shuttingDown(0), _idlePartitions(numIdlePartitions) {
+    invariant(numIdlePartitions > 0);
+}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -308,9 +382,12 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto& partition : _idlePartitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (SessionCache::iterator i = partition.sessions.begin(); i != partition.sessions.end();
+             i++) {
+            (*i)->closeAllCursors(uri);
+        }
     }
 }
 
@@ -318,25 +395,52 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto& partition : _idlePartitions) {
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        for (SessionCache::iterator i = partition.sessions.begin(); i != partition.sessions.end();
+             i++) {
+            (*i)->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
+    // Increment the epoch as we are now closing all sessions with this epoch. This must happen
+    // before any partition is emptied: releaseSession rechecks the epoch under the partition lock,
+    // so once a partition has been swapped out below, no session from an older epoch can be
+    // returned to it.
+    _epoch.fetchAndAdd(1);
+
     SessionCache swap;
+    for (auto& partition : _idlePartitions) {
+        {
+            stdx::lock_guard<stdx::mutex> lock(partition.lock);
+            partition.sessions.swap(swap);
+            partition.numSessions.store(0);
+        }
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+        for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
+            delete (*i);
+        }
+        swap.clear();
     }
+}
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+size_t WiredTigerSessionCache::getNumIdleSessions() const {
+    size_t numSessions = 0;
+    for (auto& partition : _idlePartitions) {
+        numSessions += partition.numSessions.load();
     }
+    return numSessions;
+}
+
+size_t WiredTigerSessionCache::_homePartition() const {
+#ifdef __linux__
+    const int cpu = sched_getcpu();
+    if (cpu >= 0)
+        return static_cast<size_t>(cpu) % _idlePartitions.size();
+#endif
+    return threadPartitionSeed % _idlePartitions.size();
 }
 
 bool WiredTigerSessionCache::isEphemeral() {
@@ -348,13 +452,22 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Look in this CPU's partition first, then try to steal from the others. Partitions which
+    // appear empty are skipped without taking their lock.
+    const size_t numPartitions = _idlePartitions.size();
+    const size_t home = _homePartition();
+    for (size_t i = 0; i < numPartitions; i++) {
+        auto& partition = _idlePartitions[(home + i) % numPartitions];
+        if (i != 0 && partition.numSessions.loadRelaxed() == 0)
+            continue;
+
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
+            partition.numSessions.store(partition.sessions.size());
             return UniqueWiredTigerSession(cachedSession);
         }
     }
@@ -404,6 +517,9 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     if (session->_getCursorEpoch() != cursorEpoch)
         session->closeCursorsForQueuedDrops(_engine);
 
+    if (session->_pendingCursorCacheEvents >= WiredTigerSession::kCursorCacheStatsFlushInterval)
+        session->_flushCursorCacheStats();
+
     bool returnedToCache = false;
     uint64_t currentEpoch = _epoch.load();
     bool dropQueuedIdentsAtSessionEnd = session->isDropQueuedIdentsAtSessionEndAllowed();
@@ -413,10 +529,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->dropQueuedIdentsAtSessionEndAllowed(true);
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<stdx::mutex> lock(_cacheLock);
+        auto& partition = _idlePartitions[_homePartition()];
+        stdx::lock_guard<stdx::mutex> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
+            partition.numSessions.store(partition.sessions.size());
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
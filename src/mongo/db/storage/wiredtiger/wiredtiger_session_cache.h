@@ -31,34 +31,28 @@
 
 #pragma once
 
+#include <boost/align/aligned_allocator.hpp>
 #include <list>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
 #include "mongo/db/storage/journal_listener.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
-class WiredTigerCachedCursor {
-public:
-    WiredTigerCachedCursor(uint64_t id, uint64_t gen, WT_CURSOR* cursor)
-        : _id(id), _gen(gen), _cursor(cursor) {}
-
-    uint64_t _id;   // Source ID, assigned to each URI
-    uint64_t _gen;  // Generation, used to age out old cursors
-    WT_CURSOR* _cursor;
-};
-
 /**
- * This is a structure that caches 1 cursor for each uri.
+ * This is a structure that caches idle cursors by table id, see WiredTigerCursorCache.
  * The idea is that there is a pool of these somewhere.
  * NOT THREADSAFE
  */
@@ -126,8 +120,16 @@ public:
 private:
     friend class WiredTigerSessionCache;
 
-    // The cursor cache is a list of pairs that contain an ID and cursor
-    typedef std::list<WiredTigerCachedCursor> CursorCache;
+    // Cursor cache counts gathered since the last flush, for one table. The URI is only filled in
+    // by a miss.
+    struct PendingCursorCacheStats {
+        std::string uri;
+        WiredTigerCursorCacheStats::Counters counters;
+    };
+
+    // Number of cursor cache events after which releasing the session adds its counts to the
+    // session cache's statistics.
+    static const long long kCursorCacheStatsFlushInterval = 256;
 
     // Used internally by WiredTigerSessionCache
     uint64_t _getEpoch() const {
@@ -139,24 +141,40 @@ private:
         return _cursorEpoch;
     }
 
+    /**
+     * Counts a cursor cache event for table 'id'. Returns the table's pending counts, or nullptr
+     * if this session does not report statistics.
+     */
+    PendingCursorCacheStats* _countCursorCacheEvent(
+        uint64_t id, long long WiredTigerCursorCacheStats::Counters::*counter);
+
+    void _flushCursorCacheStats();
+
     const uint64_t _epoch;
     uint64_t _cursorEpoch;
-    WiredTigerSessionCache* _cache;  // not owned
-    WT_SESSION* _session;            // owned
-    CursorCache _cursors;            // owned
-    uint64_t _cursorGen;
+    WiredTigerSessionCache* _cache = nullptr;  // not owned
+    WT_SESSION* _session;                      // owned
+    WiredTigerCursorCache _cursors;            // owned
     int _cursorsOut;
+    stdx::unordered_map<uint64_t, PendingCursorCacheStats> _pendingCursorCacheStats;
+    long long _pendingCursorCacheEvents = 0;
     bool _dropQueuedIdentsAtSessionEnd = true;
 };
 
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  Idle sessions are kept in a number of independently locked partitions, by default one per
+ *  available core. A thread checks sessions in and out of the partition for the CPU it is running
+ *  on and only steals from the other partitions when its own is empty, so that short operations
+ *  on different cores do not all serialize on a single mutex.
  */
 class WiredTigerSessionCache {
 public:
     WiredTigerSessionCache(WiredTigerKVEngine* engine);
     WiredTigerSessionCache(WT_CONNECTION* conn);
+    WiredTigerSessionCache(WT_CONNECTION* conn, size_t numIdlePartitions);
     ~WiredTigerSessionCache();
 
     /**
@@ -252,7 +270,41 @@ public:
         return _engine;
     }
 
+    WiredTigerCursorCacheStats& getCursorCacheStats() {
+        return _cursorCacheStats;
+    }
+
+    size_t getNumIdlePartitions() const {
+        return _idlePartitions.size();
+    }
+
+    /**
+     * Returns the number of sessions currently cached across all partitions. Only meant for
+     * diagnostics and testing, since the value may be stale by the time it is returned.
+     */
+    size_t getNumIdleSessions() const;
+
 private:
+    typedef std::vector<WiredTigerSession*> SessionCache;
+
+    /**
+     * One partition of the idle session pool, padded to its own cache line.
+     */
+    struct IdleSessionPartition {
+        stdx::mutex lock;
+        SessionCache sessions;
+
+        // Mirrors sessions.size(). Only modified while holding 'lock', but may be read without
+        // it so that threads looking for a session to steal can skip empty partitions cheaply.
+        AtomicWord<size_t> numSessions{0};
+    };
+    using AlignedIdlePartition = CacheAligned<IdleSessionPartition>;
+
+    /**
+     * Returns the partition that the calling thread should check sessions in and out of.
+     */
+    size_t _homePartition() const;
+
     WiredTigerKVEngine* _engine;  // not owned, might be NULL
     WT_CONNECTION* _conn;         // not owned
     WiredTigerSnapshotManager _snapshotManager;
@@ -263,9 +315,8 @@ private:
     AtomicUInt32 _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    stdx::mutex _cacheLock;
-    typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+    std::vector<AlignedIdlePartition, boost::alignment::aligned_allocator<AlignedIdlePartition>>
+        _idlePartitions;
 
     // Bumped when all open sessions need to be closed
     AtomicUInt64 _epoch;  // atomic so we can check it outside of the lock
@@ -282,6 +333,8 @@ private:
     stdx::condition_variable _prepareCommittedOrAbortedCond;
     std::uint64_t _lastCommitOrAbortCounter;
 
+    WiredTigerCursorCacheStats _cursorCacheStats;
+
     // Protects _journalListener.
     stdx::mutex _journalListenerMutex;
     // Notified when we commit to the journal.
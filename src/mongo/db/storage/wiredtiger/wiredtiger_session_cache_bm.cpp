@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxPerfThreads = 16;  // max number of threads to check sessions in and out
+
+// Passed as the benchmark argument to use the default number of idle session partitions.
+const int kDefaultPartitions = 0;
+
+const char* const kUri = "table:session_cache_bm";
+
+/**
+ * Opens a WiredTiger connection on a temporary directory and builds a session cache on top of it,
+ * partitioned as requested by the benchmark argument. Set up and torn down by thread 0 only; the
+ * other threads wait at the start barrier of the timing loop.
+ */
+class WiredTigerSessionCacheTest : public benchmark::Fixture {
+protected:
+    void setUpCache(benchmark::State& state) {
+        _dbpath = stdx::make_unique<unittest::TempDir>("wt_session_cache_bm");
+        invariantWTOK(wiredtiger_open(_dbpath->path().c_str(), nullptr, "create", &_conn));
+
+        const auto numPartitions = static_cast<size_t>(state.range(0));
+        sessionCache = numPartitions == kDefaultPartitions
+            ? stdx::make_unique<WiredTigerSessionCache>(_conn)
+            : stdx::make_unique<WiredTigerSessionCache>(_conn, numPartitions);
+
+        // Create the table used by the cursor benchmark.
+        auto session = sessionCache->getSession();
+        invariantWTOK(session->getSession()->create(
+            session->getSession(), kUri, "key_format=q,value_format=u"));
+    }
+
+    void tearDownCache() {
+        sessionCache.reset();
+        invariantWTOK(_conn->close(_conn, nullptr));
+        _conn = nullptr;
+        _dbpath.reset();
+    }
+
+    std::unique_ptr<WiredTigerSessionCache> sessionCache;
+    uint64_t tableId = WiredTigerSession::genTableId();
+
+private:
+    std::unique_ptr<unittest::TempDir> _dbpath;
+    WT_CONNECTION* _conn = nullptr;
+};
+
+BENCHMARK_DEFINE_F(WiredTigerSessionCacheTest, BM_GetReleaseSession)(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpCache(state);
+    }
+
+    for (auto keepRunning : state) {
+        auto session = sessionCache->getSession();
+        benchmark::DoNotOptimize(session->getSession());
+    }
+
+    if (state.thread_index == 0) {
+        tearDownCache();
+    }
+}
+
+BENCHMARK_DEFINE_F(WiredTigerSessionCacheTest, BM_GetReleaseSessionWithCursor)
+(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        setUpCache(state);
+    }
+
+    for (auto keepRunning : state) {
+        auto session = sessionCache->getSession();
+        WT_CURSOR* cursor = session->getCursor(kUri, tableId, false);
+        session->releaseCursor(tableId, cursor);
+    }
+
+    if (state.thread_index == 0) {
+        tearDownCache();
+    }
+}
+
+BENCHMARK_REGISTER_F(WiredTigerSessionCacheTest, BM_GetReleaseSession)
+    ->Arg(1)
+    ->Arg(kDefaultPartitions)
+    ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(WiredTigerSessionCacheTest, BM_GetReleaseSessionWithCursor)
+    ->Arg(1)
+    ->Arg(kDefaultPartitions)
+    ->ThreadRange(1, kMaxPerfThreads);
+
+}  // namespace
+}  // namespace mongo
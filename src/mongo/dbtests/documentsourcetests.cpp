@@ -40,12 +40,15 @@
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_parallel_cursor.h"
 #include "mongo/db/pipeline/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/mock_yield_policies.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/query_knobs.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/stage_builder.h"
 #include "mongo/dbtests/dbtests.h"
@@ -508,5 +511,93 @@ TEST_F(DocumentSourceCursorTest, NormalCursorShouldErrorAfterBeingKilled) {
     ASSERT_THROWS_CODE(cursor->getNext().isEOF(), AssertionException, ErrorCodes::QueryPlanKilled);
 }
 
+TEST_F(DocumentSourceCursorTest, ParallelScanShouldMergePartialGroups) {
+    const int kNumDocs = 10000;
+    for (int i = 0; i < kNumDocs; ++i) {
+        client.insert(nss.ns(), BSON("a" << i % 10 << "b" << i));
+    }
+
+    const int originalNumThreads = internalQueryParallelCollectionScanThreads.load();
+    internalQueryParallelCollectionScanThreads.store(4);
+    ON_BLOCK_EXIT([originalNumThreads] {
+        internalQueryParallelCollectionScanThreads.store(originalNumThreads);
+    });
+
+    AggregationRequest request(nss, {});
+    request.setAllowParallelScan(true);
+    auto pipeline = uassertStatusOK(Pipeline::parse(
+        {fromjson("{$match: {b: {$gte: 100}}}"),
+         fromjson("{$group: {_id: '$a', count: {$sum: 1}, avg: {$avg: '$b'}}}"),
+         fromjson("{$sort: {_id: 1}}")},
+        ctx()));
+    pipeline->optimizePipeline();
+    {
+        AutoGetCollectionForRead readLock(opCtx(), nss);
+        PipelineD::prepareCursorSource(readLock.getCollection(), nss, &request, pipeline.get());
+    }
+
+    // Storage engines which cannot split a collection fall back to a single collection scan.
+    if (dynamic_cast<DocumentSourceParallelCursor*>(pipeline->getSources().front().get())) {
+        ASSERT_EQ(PipelineD::getPlanSummaryStr(pipeline.get()), "COLLSCAN");
+    }
+
+    for (int a = 0; a < 10; ++a) {
+        auto next = pipeline->getNext();
+        ASSERT(next);
+        // The values of 'b' in the group of 'a' are a, a + 10, ..., from 100 on.
+        ASSERT_DOCUMENT_EQ(*next,
+                           (Document{{"_id", a},
+                                     {"count", (kNumDocs - 100) / 10},
+                                     {"avg", (100 + a + kNumDocs - 10 + a) / 2.0}}));
+    }
+    ASSERT(!pipeline->getNext());
+
+    PlanSummaryStats stats;
+    PipelineD::getPlanSummaryStats(pipeline.get(), &stats);
+    ASSERT_EQ(stats.totalDocsExamined, static_cast<size_t>(kNumDocs));
+}
+
+TEST_F(DocumentSourceCursorTest, ParallelScanShouldFallBackToSerialScanWhenThreadsAreTaken) {
+    for (int i = 0; i < 1000; ++i) {
+        client.insert(nss.ns(), BSON("a" << i % 10));
+    }
+
+    const int originalNumThreads = internalQueryParallelCollectionScanThreads.load();
+    const int originalMaxTotalThreads = internalQueryParallelCollectionScanMaxTotalThreads.load();
+    internalQueryParallelCollectionScanThreads.store(4);
+    internalQueryParallelCollectionScanMaxTotalThreads.store(4);
+    ON_BLOCK_EXIT([originalNumThreads, originalMaxTotalThreads] {
+        internalQueryParallelCollectionScanThreads.store(originalNumThreads);
+        internalQueryParallelCollectionScanMaxTotalThreads.store(originalMaxTotalThreads);
+    });
+
+    // Another scan holds all but one of the threads, which is not enough to scan in parallel.
+    auto otherScanThreads = DocumentSourceParallelCursor::ThreadReservation::reserve(3);
+    ASSERT_EQ(otherScanThreads.numThreads(), 3U);
+    ASSERT_EQ(DocumentSourceParallelCursor::ThreadReservation::reserve(4).numThreads(), 0U);
+
+    AggregationRequest request(nss, {});
+    request.setAllowParallelScan(true);
+    auto pipeline = uassertStatusOK(
+        Pipeline::parse({fromjson("{$group: {_id: '$a', count: {$sum: 1}}}")}, ctx()));
+    pipeline->optimizePipeline();
+    {
+        AutoGetCollectionForRead readLock(opCtx(), nss);
+        PipelineD::prepareCursorSource(readLock.getCollection(), nss, &request, pipeline.get());
+    }
+    ASSERT(dynamic_cast<DocumentSourceCursor*>(pipeline->getSources().front().get()));
+
+    int numGroups = 0;
+    while (auto next = pipeline->getNext()) {
+        ASSERT_VALUE_EQ((*next)["count"], Value(100));
+        ++numGroups;
+    }
+    ASSERT_EQ(numGroups, 10);
+
+    // Once the other scan gives its threads back, they can be reserved again.
+    otherScanThreads = DocumentSourceParallelCursor::ThreadReservation();
+    ASSERT_EQ(DocumentSourceParallelCursor::ThreadReservation::reserve(4).numThreads(), 4U);
+}
+
 }  // namespace
 }  // namespace mongo
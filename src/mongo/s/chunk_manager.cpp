@@ -42,6 +42,8 @@
 #include "mongo/db/storage/key_string.h"
 #include "mongo/util/log.h"
 
+#include <algorithm>
+
 namespace mongo {
 namespace {
 
@@ -68,6 +70,143 @@ std::string extractKeyStringInternal(const BSONObj& shardKeyValue, Ordering orde
 
 }  // namespace
 
+constexpr size_t ChunkMap::kMaxBlockSize;
+
+ChunkMap::const_iterator ChunkMap::upperBound(const std::string& keyString) const {
+    const auto blockIt = std::upper_bound(_blockMaxKeys.begin(), _blockMaxKeys.end(), keyString);
+    if (blockIt == _blockMaxKeys.end()) {
+        return end();
+    }
+
+    const size_t blockIndex = blockIt - _blockMaxKeys.begin();
+    const auto& maxKeys = _blocks[blockIndex]->maxKeys;
+    const auto it = std::upper_bound(maxKeys.begin(), maxKeys.end(), keyString);
+    return {&_blocks, blockIndex, static_cast<size_t>(it - maxKeys.begin())};
+}
+
+ChunkMap::const_iterator ChunkMap::lowerBound(const std::string& keyString) const {
+    const auto blockIt = std::lower_bound(_blockMaxKeys.begin(), _blockMaxKeys.end(), keyString);
+    if (blockIt == _blockMaxKeys.end()) {
+        return end();
+    }
+
+    const size_t blockIndex = blockIt - _blockMaxKeys.begin();
+    const auto& maxKeys = _blocks[blockIndex]->maxKeys;
+    const auto it = std::lower_bound(maxKeys.begin(), maxKeys.end(), keyString);
+    return {&_blocks, blockIndex, static_cast<size_t>(it - maxKeys.begin())};
+}
+
+void ChunkMap::replaceRange(const std::string& minKeyString,
+                            const std::string& maxKeyString,
+                            std::shared_ptr<Chunk> chunk) {
+    if (_blocks.empty()) {
+        auto block = std::make_shared<Block>();
+        block->maxKeys.push_back(maxKeyString);
+        block->chunks.push_back(std::move(chunk));
+        _blocks.push_back(std::move(block));
+        _blockMaxKeys.push_back(maxKeyString);
+        _size = 1;
+        return;
+    }
+
+    const auto low = upperBound(minKeyString);
+    const auto high = upperBound(maxKeyString);
+
+    // A chunk which sorts after all the existing ones goes at the end of the last block
+    size_t blockIndex = low._block;
+    size_t pos = low._pos;
+    if (blockIndex == _blocks.size()) {
+        blockIndex = _blocks.size() - 1;
+        pos = _blocks.back()->chunks.size();
+    }
+
+    auto& block = _getMutableBlock(blockIndex);
+    size_t numRemoved = 0;
+
+    if (high._block == blockIndex) {
+        numRemoved = high._pos - pos;
+        block.maxKeys.erase(block.maxKeys.begin() + pos, block.maxKeys.begin() + high._pos);
+        block.chunks.erase(block.chunks.begin() + pos, block.chunks.begin() + high._pos);
+    } else {
+        // The overlapped chunks span several blocks. Drop them from the tail of this block and
+        // drop the blocks in between entirely, then move the chunks after them in the last block
+        // into this one so that the last block can be dropped too.
+        numRemoved = block.chunks.size() - pos;
+        block.maxKeys.resize(pos);
+        block.chunks.resize(pos);
+
+        for (size_t i = blockIndex + 1; i < high._block; ++i) {
+            numRemoved += _blocks[i]->chunks.size();
+        }
+
+        size_t endBlockIndex = high._block;
+        if (high._block < _blocks.size()) {
+            const auto& highBlock = *_blocks[high._block];
+            numRemoved += high._pos;
+            block.maxKeys.insert(block.maxKeys.end(),
+                                 highBlock.maxKeys.begin() + high._pos,
+                                 highBlock.maxKeys.end());
+            block.chunks.insert(
+                block.chunks.end(), highBlock.chunks.begin() + high._pos, highBlock.chunks.end());
+            ++endBlockIndex;
+        }
+
+        _blocks.erase(_blocks.begin() + blockIndex + 1, _blocks.begin() + endBlockIndex);
+        _blockMaxKeys.erase(_blockMaxKeys.begin() + blockIndex + 1,
+                            _blockMaxKeys.begin() + endBlockIndex);
+    }
+
+    block.maxKeys.insert(block.maxKeys.begin() + pos, maxKeyString);
+    block.chunks.insert(block.chunks.begin() + pos, std::move(chunk));
+    _size = _size + 1 - numRemoved;
+
+    _blockMaxKeys[blockIndex] = block.maxKeys.back();
+    _rebalanceBlock(blockIndex);
+}
+
+ChunkMap::Block& ChunkMap::_getMutableBlock(size_t index) {
+    // The ChunkMap being modified is not visible to any other thread yet, so no other reference to
+    // the block can be created concurrently and a use count of one means the block is not shared.
+    auto& block = _blocks[index];
+    if (block.use_count() > 1) {
+        block = std::make_shared<Block>(*block);
+    }
+    return *block;
+}
+
+void ChunkMap::_rebalanceBlock(size_t index) {
+    auto& block = *_blocks[index];
+
+    if (block.chunks.size() > kMaxBlockSize) {
+        const auto half = block.chunks.size() / 2;
+
+        auto newBlock = std::make_shared<Block>();
+        newBlock->maxKeys.assign(std::make_move_iterator(block.maxKeys.begin() + half),
+                                 std::make_move_iterator(block.maxKeys.end()));
+        newBlock->chunks.assign(std::make_move_iterator(block.chunks.begin() + half),
+                                std::make_move_iterator(block.chunks.end()));
+        block.maxKeys.resize(half);
+        block.chunks.resize(half);
+
+        _blockMaxKeys[index] = block.maxKeys.back();
+        _blockMaxKeys.insert(_blockMaxKeys.begin() + index + 1, newBlock->maxKeys.back());
+        _blocks.insert(_blocks.begin() + index + 1, std::move(newBlock));
+        return;
+    }
+
+    if (block.chunks.size() < kMaxBlockSize / 4 && index + 1 < _blocks.size() &&
+        block.chunks.size() + _blocks[index + 1]->chunks.size() <= kMaxBlockSize) {
+        const auto& nextBlock = *_blocks[index + 1];
+        block.maxKeys.insert(
+            block.maxKeys.end(), nextBlock.maxKeys.begin(), nextBlock.maxKeys.end());
+        block.chunks.insert(block.chunks.end(), nextBlock.chunks.begin(), nextBlock.chunks.end());
+
+        _blockMaxKeys[index] = block.maxKeys.back();
+        _blockMaxKeys.erase(_blockMaxKeys.begin() + index + 1);
+        _blocks.erase(_blocks.begin() + index + 1);
+    }
+}
+
 RoutingTableHistory::RoutingTableHistory(NamespaceString nss,
                                          boost::optional<UUID> uuid,
                                          KeyPattern shardKeyPattern,
@@ -100,25 +239,25 @@ std::shared_ptr<Chunk> ChunkManager::findIntersectingChunk(const BSONObj& shardK
         }
     }
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    const auto it = _rt->getChunkMap().upperBound(_rt->_extractKeyString(shardKey));
     uassert(ErrorCodes::ShardKeyNotFound,
             str::stream() << "Cannot target single shard using key " << shardKey,
-            it != _rt->getChunkMap().end() && it->second->containsKey(shardKey));
+            it != _rt->getChunkMap().end() && (*it)->containsKey(shardKey));
 
-    return it->second;
+    return *it;
 }
 
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
 
-    const auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    const auto it = _rt->getChunkMap().upperBound(_rt->_extractKeyString(shardKey));
     if (it == _rt->getChunkMap().end())
         return false;
 
-    invariant(it->second->containsKey(shardKey));
+    invariant((*it)->containsKey(shardKey));
 
-    return it->second->getShardIdAt(_clusterTime) == shardId;
+    return (*it)->getShardIdAt(_clusterTime) == shardId;
 }
 
 void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
@@ -182,7 +321,7 @@ void ChunkManager::getShardIdsForQuery(OperationContext* opCtx,
     // For now, we satisfy that assumption by adding a shard with no matches rather than returning
     // an empty set of shards.
     if (shardIds->empty()) {
-        shardIds->insert(_rt->getChunkMap().begin()->second->getShardIdAt(_clusterTime));
+        shardIds->insert((*_rt->getChunkMap().begin())->getShardIdAt(_clusterTime));
     }
 }
 
@@ -191,7 +330,7 @@ void ChunkManager::getShardIdsForRange(const BSONObj& min,
                                        std::set<ShardId>* shardIds) const {
     const auto bounds = _rt->overlappingRanges(min, max, true);
     for (auto it = bounds.first; it != bounds.second; ++it) {
-        shardIds->insert(it->second->getShardIdAt(_clusterTime));
+        shardIds->insert((*it)->getShardIdAt(_clusterTime));
 
         // No need to iterate through the rest of the ranges, because we already know we need to use
         // all shards.
@@ -203,8 +342,8 @@ void ChunkManager::getShardIdsForRange(const BSONObj& min,
 
 bool ChunkManager::rangeOverlapsShard(const ChunkRange& range, const ShardId& shardId) const {
     const auto bounds = _rt->overlappingRanges(range.getMin(), range.getMax(), false);
-    const auto it = std::find_if(bounds.first, bounds.second, [this, &shardId](const auto& scr) {
-        return scr.second->getShardIdAt(_clusterTime) == shardId;
+    const auto it = std::find_if(bounds.first, bounds.second, [this, &shardId](const auto& chunk) {
+        return chunk->getShardIdAt(_clusterTime) == shardId;
     });
 
     return it != bounds.second;
@@ -212,10 +351,10 @@ bool ChunkManager::rangeOverlapsShard(const ChunkRange& range, const ShardId& sh
 
 ChunkManager::ConstRangeOfChunks ChunkManager::getNextChunkOnShard(const BSONObj& shardKey,
                                                                    const ShardId& shardId) const {
-    for (auto it = _rt->getChunkMap().upper_bound(_rt->_extractKeyString(shardKey));
+    for (auto it = _rt->getChunkMap().upperBound(_rt->_extractKeyString(shardKey));
          it != _rt->getChunkMap().end();
          ++it) {
-        const auto& chunk = it->second;
+        const auto& chunk = *it;
         if (chunk->getShardIdAt(_clusterTime) == shardId) {
             const auto begin = it;
             const auto end = ++it;
@@ -238,10 +377,10 @@ RoutingTableHistory::overlappingRanges(const BSONObj& min,
                                        const BSONObj& max,
                                        bool isMaxInclusive) const {
 
-    const auto itMin = _chunkMap.upper_bound(_extractKeyString(min));
+    const auto itMin = _chunkMap.upperBound(_extractKeyString(min));
     const auto itMax = [this, &max, isMaxInclusive]() {
-        auto it = isMaxInclusive ? _chunkMap.upper_bound(_extractKeyString(max))
-                                 : _chunkMap.lower_bound(_extractKeyString(max));
+        auto it = isMaxInclusive ? _chunkMap.upperBound(_extractKeyString(max))
+                                 : _chunkMap.lowerBound(_extractKeyString(max));
         return it == _chunkMap.end() ? it : ++it;
     }();
 
@@ -387,7 +526,7 @@ std::string RoutingTableHistory::toString() const {
 
     sb << "Chunks:\n";
     for (const auto& chunk : _chunkMap) {
-        sb << "\t" << chunk.second->toString() << '\n';
+        sb << "\t" << chunk->toString() << '\n';
     }
 
     sb << "Shard versions:\n";
@@ -402,13 +541,13 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap(const OID& epoch,
                                                                const ChunkMap& chunkMap,
                                                                Ordering shardKeyOrdering) {
     ShardVersionMap shardVersions;
-    ChunkMap::const_iterator current = chunkMap.cbegin();
+    ChunkMap::const_iterator current = chunkMap.begin();
 
     boost::optional<BSONObj> firstMin = boost::none;
     boost::optional<BSONObj> lastMax = boost::none;
 
-    while (current != chunkMap.cend()) {
-        const auto& firstChunkInRange = current->second;
+    while (current != chunkMap.end()) {
+        const auto& firstChunkInRange = *current;
 
         // Tracks the max shard version for the shard on which the current range will reside
         auto shardVersionIt = shardVersions.find(firstChunkInRange->getShardId());
@@ -422,10 +561,8 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap(const OID& epoch,
 
         current = std::find_if(
             current,
-            chunkMap.cend(),
-            [&firstChunkInRange, &maxShardVersion](const ChunkMap::value_type& chunkMapEntry) {
-                const auto& currentChunk = chunkMapEntry.second;
-
+            chunkMap.end(),
+            [&firstChunkInRange, &maxShardVersion](const std::shared_ptr<Chunk>& currentChunk) {
                 if (currentChunk->getShardId() != firstChunkInRange->getShardId())
                     return true;
 
@@ -438,7 +575,7 @@ ShardVersionMap RoutingTableHistory::_constructShardVersionMap(const OID& epoch,
         const auto rangeLast = std::prev(current);
 
         const BSONObj rangeMin = firstChunkInRange->getMin();
-        const BSONObj rangeMax = rangeLast->second->getMax();
+        const BSONObj rangeMax = (*rangeLast)->getMax();
 
         if (lastMax) {
             uassert(ErrorCodes::ConflictingOperationInProgress,
@@ -522,22 +659,11 @@ std::shared_ptr<RoutingTableHistory> RoutingTableHistory::makeUpdated(
         invariant(chunkVersion >= collectionVersion);
         collectionVersion = chunkVersion;
 
-        const auto chunkMinKeyString = _extractKeyString(chunk.getMin());
-        const auto chunkMaxKeyString = _extractKeyString(chunk.getMax());
-
-        // Returns the first chunk with a max key that is > min - implies that the chunk overlaps
-        // min
-        const auto low = chunkMap.upper_bound(chunkMinKeyString);
-
-        // Returns the first chunk with a max key that is > max - implies that the next chunk cannot
-        // not overlap max
-        const auto high = chunkMap.upper_bound(chunkMaxKeyString);
-
-        // Erase all chunks from the map, which overlap the chunk we got from the persistent store
-        chunkMap.erase(low, high);
-
-        // Insert only the chunk itself
-        chunkMap.insert(std::make_pair(chunkMaxKeyString, std::make_shared<Chunk>(chunk)));
+        // Replace all the chunks which overlap the chunk we got from the persistent store with the
+        // chunk itself
+        chunkMap.replaceRange(_extractKeyString(chunk.getMin()),
+                              _extractKeyString(chunk.getMax()),
+                              std::make_shared<Chunk>(chunk));
     }
 
     // If at least one diff was applied, the metadata is correct, but it might not have changed so
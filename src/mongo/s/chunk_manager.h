@@ -28,7 +28,9 @@
 
 #pragma once
 
+#include <iterator>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -49,8 +51,145 @@ struct QuerySolutionNode;
 class OperationContext;
 class ChunkManager;
 
-// Ordered map from the max for each chunk to an entry describing the chunk
-using ChunkMap = std::map<std::string, std::shared_ptr<Chunk>>;
+/**
+ * Ordered collection of the chunks of a sharded collection, keyed by the KeyString of each chunk's
+ * max.
+ *
+ * The chunks are kept in sorted contiguous blocks of bounded size, next to an array of each
+ * block's largest key, so a lookup is two binary searches over contiguous memory rather than a
+ * walk down the nodes of a tree. Copies share their blocks and modifying a copy only clones the
+ * blocks it touches, so applying an incremental refresh costs in proportion to the number of
+ * blocks and of changed chunks instead of the number of chunks.
+ */
+class ChunkMap {
+    struct Block {
+        std::vector<std::string> maxKeys;
+        std::vector<std::shared_ptr<Chunk>> chunks;
+    };
+
+    using BlockVector = std::vector<std::shared_ptr<Block>>;
+
+public:
+    // The number of chunks above which a block is split in two
+    static constexpr size_t kMaxBlockSize = 512;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::shared_ptr<Chunk>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return (*_blocks)[_block]->chunks[_pos];
+        }
+        pointer operator->() const {
+            return &operator*();
+        }
+
+        const_iterator& operator++() {
+            if (++_pos == (*_blocks)[_block]->chunks.size()) {
+                ++_block;
+                _pos = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            auto result = *this;
+            operator++();
+            return result;
+        }
+
+        const_iterator& operator--() {
+            if (_pos == 0) {
+                --_block;
+                _pos = (*_blocks)[_block]->chunks.size();
+            }
+            --_pos;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            auto result = *this;
+            operator--();
+            return result;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return _block == other._block && _pos == other._pos;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        friend class ChunkMap;
+
+        const_iterator(const BlockVector* blocks, size_t block, size_t pos)
+            : _blocks(blocks), _block(block), _pos(pos) {}
+
+        const BlockVector* _blocks = nullptr;
+        size_t _block = 0;
+        size_t _pos = 0;
+    };
+
+    const_iterator begin() const {
+        return {&_blocks, 0, 0};
+    }
+    const_iterator end() const {
+        return {&_blocks, _blocks.size(), 0};
+    }
+
+    size_t size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the first chunk whose max KeyString is greater than 'keyString', which is the chunk
+     * containing the key 'keyString' was extracted from, or end() if there is none.
+     */
+    const_iterator upperBound(const std::string& keyString) const;
+
+    /**
+     * Returns the first chunk whose max KeyString is not less than 'keyString', or end() if there
+     * is none.
+     */
+    const_iterator lowerBound(const std::string& keyString) const;
+
+    /**
+     * Removes all the chunks whose max KeyString is greater than 'minKeyString' and not greater
+     * than 'maxKeyString', which are all the chunks overlapping the range the two KeyStrings were
+     * extracted from, and inserts 'chunk' in their place.
+     */
+    void replaceRange(const std::string& minKeyString,
+                      const std::string& maxKeyString,
+                      std::shared_ptr<Chunk> chunk);
+
+private:
+    /**
+     * Returns the block at 'index', first replacing it with a private copy if it is shared with
+     * another ChunkMap.
+     */
+    Block& _getMutableBlock(size_t index);
+
+    /**
+     * Splits the block at 'index' if it has grown past kMaxBlockSize, or merges it into the block
+     * after it if it has become small enough. The block must not be shared.
+     */
+    void _rebalanceBlock(size_t index);
+
+    BlockVector _blocks;
+
+    // The largest max KeyString of each block, searched first to find the block containing a key
+    std::vector<std::string> _blockMaxKeys;
+
+    size_t _size = 0;
+};
 
 // Map from a shard is to the max chunk version on that shard
 using ShardVersionMap = std::map<ShardId, ChunkVersion>;
@@ -239,8 +378,8 @@ public:
         bool operator!=(const ConstChunkIterator& other) const {
             return !(*this == other);
         }
-        const ChunkMap::mapped_type& operator*() const {
-            return _iter->second;
+        const std::shared_ptr<Chunk>& operator*() const {
+            return *_iter;
         }
 
     private:
@@ -298,8 +437,8 @@ public:
     }
 
     ConstRangeOfChunks chunks() const {
-        return {ConstChunkIterator{_rt->getChunkMap().cbegin()},
-                ConstChunkIterator{_rt->getChunkMap().cend()}};
+        return {ConstChunkIterator{_rt->getChunkMap().begin()},
+                ConstChunkIterator{_rt->getChunkMap().end()}};
     }
 
     int numChunks() const {
@@ -0,0 +1,169 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+
+#include "mongo/platform/random.h"
+#include "mongo/s/chunk_manager.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using ReferenceMap = std::map<std::string, std::shared_ptr<Chunk>>;
+
+const NamespaceString kNss("TestDB", "TestColl");
+
+// ChunkMap never looks inside the chunks it stores, so every chunk covers the whole key space and
+// the tests identify chunks by pointer.
+std::shared_ptr<Chunk> makeChunk() {
+    ChunkType chunkType(kNss,
+                        ChunkRange(BSON("x" << MINKEY), BSON("x" << MAXKEY)),
+                        ChunkVersion(1, 0, OID::gen()),
+                        ShardId("shard0"));
+    return std::make_shared<Chunk>(chunkType);
+}
+
+// Zero padded so that the keys sort in numeric order.
+std::string makeKey(int value) {
+    auto key = std::to_string(value);
+    return std::string(8 - key.size(), '0') + key;
+}
+
+// Applies the same replacement to 'chunkMap' and to a std::map with the semantics the routing
+// table used to have.
+void replaceRange(ChunkMap* chunkMap, ReferenceMap* reference, int min, int max) {
+    auto chunk = makeChunk();
+    chunkMap->replaceRange(makeKey(min), makeKey(max), chunk);
+    reference->erase(reference->upper_bound(makeKey(min)), reference->upper_bound(makeKey(max)));
+    reference->emplace(makeKey(max), chunk);
+}
+
+void assertMatches(const ChunkMap& chunkMap, const ReferenceMap& reference, PseudoRandom* random) {
+    ASSERT_EQ(chunkMap.size(), reference.size());
+
+    auto it = chunkMap.begin();
+    for (const auto& entry : reference) {
+        ASSERT(it != chunkMap.end());
+        ASSERT_EQ(it->get(), entry.second.get());
+        ++it;
+    }
+    ASSERT(it == chunkMap.end());
+
+    for (int i = 0; i < 100; ++i) {
+        const auto key = makeKey(random->nextInt32(200000));
+
+        const auto upper = chunkMap.upperBound(key);
+        const auto expectedUpper = reference.upper_bound(key);
+        ASSERT_EQ(upper == chunkMap.end(), expectedUpper == reference.end());
+        if (expectedUpper != reference.end()) {
+            ASSERT_EQ(upper->get(), expectedUpper->second.get());
+        }
+
+        const auto lower = chunkMap.lowerBound(key);
+        const auto expectedLower = reference.lower_bound(key);
+        ASSERT_EQ(lower == chunkMap.end(), expectedLower == reference.end());
+        if (expectedLower != reference.end()) {
+            ASSERT_EQ(lower->get(), expectedLower->second.get());
+        }
+    }
+}
+
+TEST(ChunkMapTest, EmptyMap) {
+    ChunkMap chunkMap;
+    ASSERT(chunkMap.empty());
+    ASSERT(chunkMap.begin() == chunkMap.end());
+    ASSERT(chunkMap.upperBound(makeKey(0)) == chunkMap.end());
+    ASSERT(chunkMap.lowerBound(makeKey(0)) == chunkMap.end());
+}
+
+TEST(ChunkMapTest, MatchesOrderedMapAcrossManyBlocks) {
+    PseudoRandom random(12345);
+    ChunkMap chunkMap;
+    ReferenceMap reference;
+
+    const int numChunks = 10 * ChunkMap::kMaxBlockSize;
+    for (int i = 0; i < numChunks; ++i) {
+        replaceRange(&chunkMap, &reference, i * 20, (i + 1) * 20);
+    }
+    assertMatches(chunkMap, reference, &random);
+
+    // Mostly splits and merges of a few chunks, with the occasional replacement of a range that
+    // spans several blocks.
+    for (int i = 0; i < 2000; ++i) {
+        const int min = random.nextInt32(numChunks * 20);
+        const int span = (i % 20 == 0) ? random.nextInt32(numChunks * 5) + 1
+                                       : random.nextInt32(100) + 1;
+        replaceRange(&chunkMap, &reference, min, min + span);
+
+        if (i % 100 == 0) {
+            assertMatches(chunkMap, reference, &random);
+        }
+    }
+    assertMatches(chunkMap, reference, &random);
+}
+
+TEST(ChunkMapTest, CopiesAreIndependent) {
+    PseudoRandom random(12345);
+    ChunkMap original;
+    ReferenceMap originalReference;
+
+    for (int i = 0; i < 4 * static_cast<int>(ChunkMap::kMaxBlockSize); ++i) {
+        replaceRange(&original, &originalReference, i * 20, (i + 1) * 20);
+    }
+
+    ChunkMap copy = original;
+    ReferenceMap copyReference = originalReference;
+    for (int i = 0; i < 200; ++i) {
+        const int min = random.nextInt32(4 * ChunkMap::kMaxBlockSize * 20);
+        replaceRange(&copy, &copyReference, min, min + random.nextInt32(2000) + 1);
+    }
+
+    assertMatches(original, originalReference, &random);
+    assertMatches(copy, copyReference, &random);
+}
+
+TEST(ChunkMapTest, IteratesBackwardsAcrossBlocks) {
+    ChunkMap chunkMap;
+    ReferenceMap reference;
+    for (int i = 0; i < 3 * static_cast<int>(ChunkMap::kMaxBlockSize); ++i) {
+        replaceRange(&chunkMap, &reference, i * 20, (i + 1) * 20);
+    }
+
+    auto it = chunkMap.end();
+    for (auto expected = reference.rbegin(); expected != reference.rend(); ++expected) {
+        --it;
+        ASSERT_EQ(it->get(), expected->second.get());
+    }
+    ASSERT(it == chunkMap.begin());
+}
+
+}  // namespace
+}  // namespace mongo
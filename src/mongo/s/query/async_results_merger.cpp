@@ -38,6 +38,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/killcursors_request.h"
+#include "mongo/db/storage/key_string.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/util/assert_util.h"
@@ -78,6 +79,31 @@ int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPa
     return leftSortKey.woCompare(rightSortKey, sortKeyPattern, considerFieldName);
 }
 
+/**
+ * Encodes the sort key out of the $sortKey metadata field in 'obj' as a KeyString whose memcmp
+ * order matches the order compareSortKeys() gives for the sort pattern described by 'ordering'.
+ * As with compareSortKeys(), no collator is needed.
+ */
+std::string encodeSortKey(const BSONObj& obj, bool compareWholeSortKey, Ordering ordering) {
+    // KeyString interprets non-empty top-level field names as discriminators, so the key is
+    // encoded as {'': 'firstSortKey', '': 'secondSortKey', ...}, the form mongod produces.
+    auto key = obj[AsyncResultsMerger::kSortKeyField];
+    BSONObj sortKey = compareWholeSortKey ? key.wrap(""_sd) : key.Obj();
+    for (auto&& elem : sortKey) {
+        if (*elem.fieldName()) {
+            BSONObjBuilder unnamed;
+            for (auto&& field : sortKey) {
+                unnamed.appendAs(field, ""_sd);
+            }
+            sortKey = unnamed.obj();
+            break;
+        }
+    }
+
+    const KeyString ks(KeyString::Version::V1, sortKey, ordering);
+    return std::string(ks.getBuffer(), ks.getSize());
+}
+
 }  // namespace
 
 AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
@@ -90,10 +116,13 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode() ? *params.getTailableMode()
                                              : TailableModeEnum::kNormal),
-      _params(std::move(params)),
-      _mergeQueue(MergingComparator(_remotes,
-                                    _params.getSort() ? *_params.getSort() : BSONObj(),
-                                    _params.getCompareWholeSortKey())) {
+      _params(std::move(params)) {
+    // An Ordering can describe at most 32 fields. Longer sort patterns are legal, so merge them by
+    // comparing the BSON sort keys instead.
+    if (_params.getSort() && _params.getSort()->nFields() <= 32) {
+        _sortKeyOrdering = Ordering::make(*_params.getSort());
+    }
+
     size_t remoteIndex = 0;
     for (const auto& remote : _params.getRemotes()) {
         _remotes.emplace_back(remote.getHostAndPort(),
@@ -175,6 +204,7 @@ void AsyncResultsMerger::addNewShardCursors(std::vector<RemoteCursor>&& newCurso
                               remote.getCursorResponse().getNSS(),
                               remote.getCursorResponse().getCursorId());
     }
+    _mergeTreeNeedsRebuild = true;
 }
 
 bool AsyncResultsMerger::_ready(WithLock lk) {
@@ -215,13 +245,13 @@ bool AsyncResultsMerger::_readySorted(WithLock lk) {
     return true;
 }
 
-bool AsyncResultsMerger::_readySortedTailable(WithLock) {
-    if (_mergeQueue.empty()) {
+bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
+    auto smallestRemote = _getSmallestRemote(lk);
+    if (!smallestRemote) {
         return false;
     }
 
-    auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
+    const auto& smallestResult = _remotes[*smallestRemote].docBuffer.front();
     auto keyWeWantToReturn =
         extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
     for (const auto& remote : _remotes) {
@@ -273,30 +303,98 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
-    if (_mergeQueue.empty()) {
+    auto smallestRemote = _getSmallestRemote(lk);
+    if (!smallestRemote) {
         return {};
     }
 
-    size_t smallestRemote = _mergeQueue.top();
-    _mergeQueue.pop();
+    auto& remote = _remotes[*smallestRemote];
+    invariant(remote.status.isOK());
+    invariant(remote.docBuffer.size() == remote.sortKeyBuffer.size());
 
-    invariant(!_remotes[smallestRemote].docBuffer.empty());
-    invariant(_remotes[smallestRemote].status.isOK());
+    ClusterQueryResult front = std::move(remote.docBuffer.front());
+    remote.docBuffer.pop();
+    remote.sortKeyBuffer.pop();
 
-    ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
-    _remotes[smallestRemote].docBuffer.pop();
+    // 'smallestRemote' now competes with its next result, or sorts last if it has none.
+    _replayMergeTree(lk, *smallestRemote);
 
-    // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
-    // next result.
-    if (!_remotes[smallestRemote].docBuffer.empty()) {
-        _mergeQueue.push(smallestRemote);
+    return front;
+}
+
+bool AsyncResultsMerger::_remoteSortsBefore(WithLock, size_t lhs, size_t rhs) const {
+    const auto& leftRemote = _remotes[lhs];
+    const auto& rightRemote = _remotes[rhs];
+    if (leftRemote.hasNext() != rightRemote.hasNext()) {
+        return leftRemote.hasNext();
+    }
+    if (!leftRemote.hasNext()) {
+        return lhs < rhs;
     }
 
-    return front;
+    int cmp;
+    if (_sortKeyOrdering) {
+        cmp = leftRemote.sortKeyBuffer.front().compare(rightRemote.sortKeyBuffer.front());
+    } else {
+        const bool compareWholeSortKey = _params.getCompareWholeSortKey();
+        cmp = compareSortKeys(
+            extractSortKey(*leftRemote.docBuffer.front().getResult(), compareWholeSortKey),
+            extractSortKey(*rightRemote.docBuffer.front().getResult(), compareWholeSortKey),
+            *_params.getSort());
+    }
+    return cmp != 0 ? cmp < 0 : lhs < rhs;
+}
+
+void AsyncResultsMerger::_rebuildMergeTree(WithLock lk) {
+    const size_t numRemotes = _remotes.size();
+    _mergeTree.assign(numRemotes, 0);
+    _mergeTreeNeedsRebuild = false;
+    if (numRemotes == 0) {
+        return;
+    }
+
+    // 'winners[i]' is the remote that won the match at node 'i'; the leaves win trivially.
+    std::vector<size_t> winners(2 * numRemotes);
+    for (size_t remoteIndex = 0; remoteIndex < numRemotes; ++remoteIndex) {
+        winners[numRemotes + remoteIndex] = remoteIndex;
+    }
+    for (size_t node = numRemotes - 1; node >= 1; --node) {
+        const size_t left = winners[2 * node];
+        const size_t right = winners[2 * node + 1];
+        const bool leftWins = _remoteSortsBefore(lk, left, right);
+        winners[node] = leftWins ? left : right;
+        _mergeTree[node] = leftWins ? right : left;
+    }
+    _mergeTree[0] = numRemotes == 1 ? 0 : winners[1];
+}
+
+void AsyncResultsMerger::_replayMergeTree(WithLock lk, size_t remoteIndex) {
+    if (_mergeTreeNeedsRebuild) {
+        return;
+    }
+    invariant(_mergeTree[0] == remoteIndex);
+
+    size_t winner = remoteIndex;
+    for (size_t node = (remoteIndex + _remotes.size()) / 2; node >= 1; node /= 2) {
+        if (_remoteSortsBefore(lk, _mergeTree[node], winner)) {
+            std::swap(_mergeTree[node], winner);
+        }
+    }
+    _mergeTree[0] = winner;
+}
+
+boost::optional<size_t> AsyncResultsMerger::_getSmallestRemote(WithLock lk) {
+    if (_mergeTreeNeedsRebuild) {
+        _rebuildMergeTree(lk);
+    }
+    if (_mergeTree.empty() || !_remotes[_mergeTree[0]].hasNext()) {
+        return boost::none;
+    }
+    return _mergeTree[0];
 }
 
 ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
@@ -537,7 +635,12 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         // Clear the results buffer and cursor id.
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<std::string> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
         remote.cursorId = 0;
+
+        // The remote's leaf in the merge tree no longer has a result to compete with.
+        _mergeTreeNeedsRebuild = true;
     }
 }
 
@@ -605,6 +708,12 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                          << obj);
                 return false;
             }
+
+            // Encode the sort key once, here, rather than on every comparison during the merge.
+            remote.sortKeyBuffer.push(
+                _sortKeyOrdering
+                    ? encodeSortKey(obj, _params.getCompareWholeSortKey(), *_sortKeyOrdering)
+                    : std::string());
         }
 
         ClusterQueryResult result(obj);
@@ -612,10 +721,11 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
         ++remote.fetchedCount;
     }
 
-    // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
+    // If we're doing a sorted merge, then the remote's leaf in the merge tree has changed. It may
+    // not be the current winner, so the whole tree is rebuilt on next use; this happens at most
+    // once per batch rather than once per result.
     if (_params.getSort() && !response.getBatch().empty()) {
-        _mergeQueue.push(remoteIndex);
+        _mergeTreeNeedsRebuild = true;
     }
     return true;
 }
@@ -722,19 +832,6 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
     return cursorId == 0;
 }
 
-//
-// AsyncResultsMerger::MergingComparator
-//
-
-bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
-
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
-}
-
 void AsyncResultsMerger::blockingKill(OperationContext* opCtx) {
     auto killEvent = kill(opCtx);
     if (!killEvent) {
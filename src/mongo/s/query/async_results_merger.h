@@ -30,11 +30,13 @@
 
 #include <boost/optional.hpp>
 #include <queue>
+#include <string>
 #include <vector>
 
 #include "mongo/base/disallow_copying.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/query/async_results_merger_params_gen.h"
@@ -88,7 +90,7 @@ public:
      *
      * Additionally copies each remote's first batch of results, if one exists, into that remote's
      * docBuffer. If a sort is specified in the ClusterClientCursorParams, places the remotes with
-     * buffered results onto _mergeQueue.
+     * buffered results into _mergeTree.
      *
      * The TaskExecutor* must remain valid for the lifetime of the ARM.
      *
@@ -273,6 +275,12 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // Used only if there is a sort. Holds one entry per result in 'docBuffer', in the same
+        // order: the result's sort key encoded as a KeyString, so that the merge can compare
+        // buffered results with memcmp. Entries are empty if the sort pattern has too many fields
+        // to be encoded, in which case the merge falls back to comparing the BSON sort keys.
+        std::queue<std::string> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -285,26 +293,6 @@ private:
         long long fetchedCount = 0;
     };
 
-    class MergingComparator {
-    public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
-
-        bool operator()(const size_t& lhs, const size_t& rhs);
-
-    private:
-        const std::vector<RemoteCursorData>& _remotes;
-
-        const BSONObj _sort;
-
-        // When '_compareWholeSortKey' is true, $sortKey is a scalar value, rather than an object.
-        // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
-        // be {$sortKey: 1}.
-        const bool _compareWholeSortKey;
-    };
-
     enum LifecycleState { kAlive, kKillStarted, kKillComplete };
 
     /**
@@ -346,6 +334,35 @@ private:
     ClusterQueryResult _nextReadySorted(WithLock);
     ClusterQueryResult _nextReadyUnsorted(WithLock);
 
+    //
+    // Helpers for the sorted merge.
+    //
+
+    /**
+     * Returns true if the next buffered result of the remote at 'lhs' should be returned before
+     * that of the remote at 'rhs'. A remote with no buffered results sorts after every remote with
+     * buffered results. Ties are broken by remote index, so the merge is deterministic.
+     */
+    bool _remoteSortsBefore(WithLock, size_t lhs, size_t rhs) const;
+
+    /**
+     * Plays a full tournament between all remotes, leaving the overall winner in '_mergeTree[0]'
+     * and the loser of each match in the corresponding internal node.
+     */
+    void _rebuildMergeTree(WithLock);
+
+    /**
+     * Replays the matches on the path from the leaf of 'remoteIndex' to the root. Valid only if
+     * 'remoteIndex' is the current winner and its next buffered result has changed.
+     */
+    void _replayMergeTree(WithLock, size_t remoteIndex);
+
+    /**
+     * Returns the index into '_remotes' of the remote whose next buffered result sorts first, or
+     * boost::none if no remote has a buffered result. Rebuilds the merge tree first if needed.
+     */
+    boost::optional<size_t> _getSmallestRemote(WithLock);
+
     using CbData = executor::TaskExecutor::RemoteCommandCallbackArgs;
     using CbResponse = executor::TaskExecutor::ResponseStatus;
 
@@ -414,9 +431,21 @@ private:
     // Data tracking the state of our communication with each of the remote nodes.
     std::vector<RemoteCursorData> _remotes;
 
-    // The top of this priority queue is the index into '_remotes' for the remote host that has the
-    // next document to return, according to the sort order. Used only if there is a sort.
-    std::priority_queue<size_t, std::vector<size_t>, MergingComparator> _mergeQueue;
+    // Used only if there is a sort. Encodes sort key patterns into KeyStrings for comparison. Is
+    // boost::none if the sort pattern has more fields than an Ordering can describe.
+    boost::optional<Ordering> _sortKeyOrdering;
+
+    // Loser tree over the indexes into '_remotes', used only if there is a sort. '_mergeTree[0]'
+    // is the remote that has the next document to return, according to the sort order. Internal
+    // node 'i' (for 'i' in [1, _remotes.size())) holds the remote that lost the match played at
+    // that node, and the leaf of remote 'r' is node 'r + _remotes.size()'. Returning a result only
+    // replays the matches on the winner's path to the root, so each result costs log2(#remotes)
+    // comparisons.
+    std::vector<size_t> _mergeTree;
+
+    // Set when a remote other than the current winner gains or loses buffered results, or when
+    // remotes are added. The tree is then rebuilt on next use, which is amortized over the batch.
+    bool _mergeTreeNeedsRebuild = true;
 
     // The index into '_remotes' for the remote from which we are currently retrieving results.
     // Used only if there is *not* a sort.
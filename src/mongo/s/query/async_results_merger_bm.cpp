@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/query/cursor_response.h"
+#include "mongo/platform/random.h"
+#include "mongo/s/query/async_results_merger.h"
+#include "mongo/util/mongoutils/str.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.foo");
+
+/**
+ * Makes 'nRemotes' sorted batches of 'batchSize' documents each, as returned by shards for a find
+ * sorted by 'sortPattern'. 'makeSortKey' returns the $sortKey for a random number.
+ */
+template <typename SortKeyFn>
+std::vector<std::vector<BSONObj>> makeSortedBatches(int nRemotes,
+                                                    int batchSize,
+                                                    const BSONObj& sortPattern,
+                                                    SortKeyFn makeSortKey) {
+    PseudoRandom rand(12345);
+    std::vector<std::vector<BSONObj>> batches(nRemotes);
+    for (auto&& batch : batches) {
+        batch.reserve(batchSize);
+        for (int i = 0; i < batchSize; ++i) {
+            batch.push_back(BSON("_id" << i << AsyncResultsMerger::kSortKeyField
+                                       << makeSortKey(rand.nextInt64(1000000))));
+        }
+        std::sort(batch.begin(), batch.end(), [&](const BSONObj& lhs, const BSONObj& rhs) {
+            return lhs[AsyncResultsMerger::kSortKeyField].Obj().woCompare(
+                       rhs[AsyncResultsMerger::kSortKeyField].Obj(), sortPattern, false) < 0;
+        });
+    }
+    return batches;
+}
+
+/**
+ * Merges exhausted remote cursors whose results are all in their first batch, so that the
+ * measurement covers buffering the results and the sorted merge, without any networking.
+ */
+template <typename SortKeyFn>
+void runSortedMerge(benchmark::State& state, const BSONObj& sortPattern, SortKeyFn makeSortKey) {
+    const int nRemotes = state.range(0);
+    const int batchSize = state.range(1);
+    const auto batches = makeSortedBatches(nRemotes, batchSize, sortPattern, makeSortKey);
+
+    // The sort as it appears in the find command.
+    BSONObjBuilder sortBuilder;
+    int field = 0;
+    for (auto&& elem : sortPattern) {
+        sortBuilder.appendAs(elem, std::string(str::stream() << "f" << field++));
+    }
+    const BSONObj sort = sortBuilder.obj();
+
+    for (auto keepRunning : state) {
+        std::vector<RemoteCursor> remotes;
+        for (int i = 0; i < nRemotes; ++i) {
+            RemoteCursor remote;
+            remote.setShardId(str::stream() << "shard" << i);
+            remote.setHostAndPort(HostAndPort(str::stream() << "shard" << i << "Host", 27017));
+            remote.setCursorResponse(CursorResponse(kNss, CursorId(0), batches[i]));
+            remotes.push_back(std::move(remote));
+        }
+
+        AsyncResultsMergerParams params;
+        params.setNss(kNss);
+        params.setSort(sort);
+        params.setRemotes(std::move(remotes));
+        AsyncResultsMerger arm(nullptr, nullptr, std::move(params));
+
+        for (auto next = arm.nextReady(); !next.getValue().isEOF(); next = arm.nextReady()) {
+            benchmark::DoNotOptimize(next.getValue().getResult());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nRemotes * batchSize);
+}
+
+void BM_SortedMergeIntKey(benchmark::State& state) {
+    runSortedMerge(state, BSON("" << 1), [](long long n) { return BSON("" << n); });
+}
+
+void BM_SortedMergeCompoundKey(benchmark::State& state) {
+    runSortedMerge(state, BSON("" << 1 << "" << -1 << "" << 1), [](long long n) {
+        return BSON("" << std::string(str::stream() << "user" << n % 1000) << "" << n % 7 << ""
+                       << static_cast<double>(n));
+    });
+}
+
+BENCHMARK(BM_SortedMergeIntKey)
+    ->Args({2, 10000})
+    ->Args({16, 10000})
+    ->Args({128, 1000})
+    ->Args({512, 1000});
+
+BENCHMARK(BM_SortedMergeCompoundKey)
+    ->Args({2, 10000})
+    ->Args({16, 10000})
+    ->Args({128, 1000})
+    ->Args({512, 1000});
+
+}  // namespace
+}  // namespace mongo
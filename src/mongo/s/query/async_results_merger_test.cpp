@@ -635,6 +635,51 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergeOfManyRemotes) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: 1, b: -1}}");
+    const BSONObj sortPattern = BSON("" << 1 << "" << -1);
+    const int kNumRemotes = 7;
+    const int kBatchSize = 20;
+
+    // Every remote has exhausted its cursor after its first batch. Remote 3 returns no results, and
+    // odd-numbered remotes return doubles, which must compare equal to the other remotes' ints.
+    std::vector<RemoteCursor> cursors;
+    for (int remote = 0; remote < kNumRemotes; ++remote) {
+        std::vector<BSONObj> batch;
+        for (int i = 0; remote != 3 && i < kBatchSize; ++i) {
+            const int a = (remote * 7 + i * 3) % 10;
+            const int b = (remote + i) % 4;
+            batch.push_back(remote % 2 ? BSON("$sortKey" << BSON("" << a + 0.0 << "" << b))
+                                       : BSON("$sortKey" << BSON("" << a << "" << b)));
+        }
+        std::sort(batch.begin(), batch.end(), [&](const BSONObj& lhs, const BSONObj& rhs) {
+            return lhs["$sortKey"].Obj().woCompare(rhs["$sortKey"].Obj(), sortPattern, false) < 0;
+        });
+        cursors.push_back(makeRemoteCursor(
+            ShardId(str::stream() << "FakeShard" << remote),
+            HostAndPort(str::stream() << "FakeShard" << remote << "Host", 12345),
+            CursorResponse(kTestNss, CursorId(0), std::move(batch))));
+    }
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // ARM returns all results in sorted order.
+    BSONObj previousSortKey;
+    for (int i = 0; i < (kNumRemotes - 1) * kBatchSize; ++i) {
+        ASSERT_TRUE(arm->ready());
+        auto next = unittest::assertGet(arm->nextReady());
+        ASSERT_FALSE(next.isEOF());
+        BSONObj sortKey = (*next.getResult())["$sortKey"].Obj();
+        if (i > 0) {
+            ASSERT_LTE(previousSortKey.woCompare(sortKey, sortPattern, false), 0);
+        }
+        previousSortKey = sortKey.getOwned();
+    }
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(arm->remotesExhausted());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
@@ -40,6 +40,7 @@ enum class MessageCompressor : uint8_t {
     kNoop = 0,
     kSnappy = 1,
     kZlib = 2,
+    kZstd = 3,
     kExtended = 255,
 };
 
@@ -53,7 +54,7 @@ public:
     virtual ~MessageCompressorBase() = default;
 
     /*
-     * Returns the name for subclass compressors (e.g. "snappy", "zlib", or "noop")
+     * Returns the name for subclass compressors (e.g. "snappy", "zlib", "zstd", or "noop")
      */
     const std::string& getName() const {
         return _name;
@@ -87,14 +88,16 @@ public:
     virtual StatusWith<std::size_t> decompressData(ConstDataRange input, DataRange output) = 0;
 
     /*
-     * This returns the number of bytes passed in the input for compressData
+     * This returns the number of bytes passed in the input for compressData, counting only the
+     * messages that were sent compressed
      */
     int64_t getCompressorBytesIn() const {
         return _compressBytesIn.loadRelaxed();
     }
 
     /*
-     * This returns the number of bytes written to output for compressData
+     * This returns the number of bytes written to output for compressData, counting only the
+     * messages that were sent compressed
      */
     int64_t getCompressorBytesOut() const {
         return _compressBytesOut.loadRelaxed();
@@ -114,23 +117,61 @@ public:
         return _decompressBytesOut.loadRelaxed();
     }
 
+    /*
+     * This returns the number of microseconds spent in compressData
+     */
+    int64_t getCompressorMicros() const {
+        return _compressMicros.loadRelaxed();
+    }
 
-protected:
     /*
-     * This is called by sub-classes to intialize their ID/name fields.
+     * This returns the number of microseconds spent in decompressData
      */
-    MessageCompressorBase(MessageCompressor id)
-        : _id{static_cast<MessageCompressorId>(id)},
-          _name{getMessageCompressorName(id).toString()} {}
+    int64_t getDecompressorMicros() const {
+        return _decompressMicros.loadRelaxed();
+    }
+
+    /*
+     * This returns the number of messages that were sent uncompressed by this compressor's
+     * connections because they were too small or weren't expected to compress
+     */
+    int64_t getMessagesSkipped() const {
+        return _messagesSkipped.loadRelaxed();
+    }
+
+    /*
+     * Called by the MessageCompressorManager to account for the time spent compressing and
+     * decompressing messages, and for the messages it chose not to compress
+     */
+    void counterHitCompressTime(int64_t micros) {
+        _compressMicros.addAndFetch(micros);
+    }
+
+    void counterHitDecompressTime(int64_t micros) {
+        _decompressMicros.addAndFetch(micros);
+    }
+
+    void counterHitSkipped() {
+        _messagesSkipped.addAndFetch(1);
+    }
 
     /*
-     * Called by sub-classes to bump their bytesIn/bytesOut counters for compression
+     * Called by the MessageCompressorManager to bump the bytesIn/bytesOut counters for compression
+     * once it sends a message compressed
      */
     void counterHitCompress(int64_t bytesIn, int64_t bytesOut) {
         _compressBytesIn.addAndFetch(bytesIn);
         _compressBytesOut.addAndFetch(bytesOut);
     }
 
+protected:
+    /*
+     * This is called by sub-classes to intialize their ID/name fields.
+     */
+    MessageCompressorBase(MessageCompressor id)
+        : _id{static_cast<MessageCompressorId>(id)},
+          _name{getMessageCompressorName(id).toString()} {}
+
     /*
      * Called by sub-classes to bump their bytesIn/bytesOut counters for decompression
      */
@@ -148,5 +189,9 @@ private:
 
     AtomicInt64 _decompressBytesIn;
     AtomicInt64 _decompressBytesOut;
+
+    AtomicInt64 _compressMicros;
+    AtomicInt64 _decompressMicros;
+    AtomicInt64 _messagesSkipped;
 };
 }  // namespace mongo
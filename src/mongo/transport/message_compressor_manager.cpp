@@ -40,6 +40,9 @@
 #include "mongo/transport/session.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
+#include "mongo/util/timer.h"
+
+#include <algorithm>
 
 namespace mongo {
 namespace {
@@ -79,6 +82,10 @@ private:
     }
 };
 
+// The most messages a connection will send uncompressed in a row after its messages stop
+// shrinking when compressed. The backoff doubles with each incompressible message up to this cap.
+const uint32_t kMaxIncompressibleBackoff = 64;
+
 const transport::Session::Decoration<MessageCompressorManager> getForSession =
     transport::Session::declareDecoration<MessageCompressorManager>();
 }  // namespace
@@ -102,6 +109,20 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return {msg};
     }
 
+    if (static_cast<size_t>(msg.dataSize()) < _registry->getMinimumCompressibleSize()) {
+        LOG(3) << "Message is smaller than " << _registry->getMinimumCompressibleSize()
+               << " bytes, returning original uncompressed message";
+        compressor->counterHitSkipped();
+        return {msg};
+    }
+
+    const bool skipIncompressible = _registry->getSkipIncompressible();
+    if (skipIncompressible && _messagesToSkip > 0) {
+        --_messagesToSkip;
+        compressor->counterHitSkipped();
+        return {msg};
+    }
+
     LOG(3) << "Compressing message with " << compressor->getName();
 
     auto inputHeader = msg.header();
@@ -129,12 +150,31 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
     compressionHeader.serialize(&output);
     ConstDataRange input(inputHeader.data(), inputHeader.data() + inputHeader.dataLen());
 
+    Timer timer;
     auto sws = compressor->compressData(input, output);
+    compressor->counterHitCompressTime(timer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
 
     auto realCompressedSize = sws.getValue();
+    if (skipIncompressible) {
+        if (realCompressedSize + CompressionHeader::size() >= input.length()) {
+            // Back off exponentially while messages keep failing to shrink, so that connections
+            // carrying already compressed or encrypted payloads stop paying for compression.
+            ++_incompressibleStreak;
+            _messagesToSkip =
+                std::min(1u << std::min(_incompressibleStreak - 1, 6u), kMaxIncompressibleBackoff);
+            LOG(3) << "Message did not shrink when compressed, returning original uncompressed "
+                   << "message and skipping the next " << _messagesToSkip << " messages";
+            compressor->counterHitSkipped();
+            return {msg};
+        }
+        _incompressibleStreak = 0;
+    }
+
+    // Only the messages which go out compressed count towards the compressor's bytes.
+    compressor->counterHitCompress(input.length(), realCompressedSize);
     outMessage.setLen(realCompressedSize + CompressionHeader::size() + MsgData::MsgDataHeaderSize);
 
     return {Message(outputMessageBuffer)};
@@ -176,7 +216,9 @@ StatusWith<Message> MessageCompressorManager::decompressMessage(const Message& m
 
     DataRangeCursor output(outMessage.data(), outMessage.data() + outMessage.dataLen());
 
+    Timer timer;
     auto sws = compressor->decompressData(input, output);
+    compressor->counterHitDecompressTime(timer.micros());
 
     if (!sws.isOK())
         return sws.getStatus();
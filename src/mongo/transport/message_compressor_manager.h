@@ -98,6 +98,12 @@ public:
      * If _negotiated is empty (meaning compression was not negotiated or is not supported), then
      * it will return a ref-count bumped copy of the input message.
      *
+     * It will also return the input message if it is smaller than the registry's minimum
+     * compressible size, or, when the registry skips incompressible messages, if compressing it
+     * would not make it smaller or this connection is backing off after recent messages failed to
+     * shrink. Callers must therefore check the opcode of messages they receive before calling
+     * decompressMessage.
+     *
      * If an error occurs in the compressor, it will return a Status error.
      */
     StatusWith<Message> compressMessage(const Message& msg,
@@ -128,6 +134,11 @@ public:
 private:
     std::vector<MessageCompressorBase*> _negotiated;
     MessageCompressorRegistry* _registry;
+
+    // The number of consecutive messages that did not shrink when compressed, and how many more
+    // messages to send uncompressed before trying to compress again.
+    uint32_t _incompressibleStreak = 0;
+    uint32_t _messagesToSkip = 0;
 };
 
 }  // namespace mongo
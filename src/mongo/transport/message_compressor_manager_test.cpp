@@ -31,12 +31,14 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/config.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/transport/message_compressor_zstd.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/log.h"
 #include "mongo/util/net/message.h"
@@ -44,6 +46,10 @@
 #include <string>
 #include <vector>
 
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+#include <zdict.h>
+#endif
+
 namespace mongo {
 namespace {
 
@@ -233,6 +239,84 @@ TEST(ZlibMessageCompressor, Fidelity) {
     checkFidelity(testMessage, stdx::make_unique<ZlibMessageCompressor>());
 }
 
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+TEST(ZstdMessageCompressor, Fidelity) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZstdMessageCompressor>());
+}
+
+TEST(ZstdMessageCompressor, FidelityAtMaxLevel) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage, stdx::make_unique<ZstdMessageCompressor>(22));
+}
+
+// Trains a small dictionary on replies that share their field names, the way find replies do.
+std::string trainZstdDictionary() {
+    std::string samples;
+    std::vector<size_t> sampleSizes;
+    for (int i = 0; i < 1000; ++i) {
+        auto sample = BSON("cursor" << BSON("firstBatch" << BSON_ARRAY(BSON("_id" << i << "name"
+                                                                                 << "item"))
+                                                         << "id"
+                                                         << 0LL
+                                                         << "ns"
+                                                         << "test.coll")
+                                    << "ok"
+                                    << 1.0);
+        samples.append(sample.objdata(), sample.objsize());
+        sampleSizes.push_back(sample.objsize());
+    }
+
+    std::string dictionary(4096, '\0');
+    auto size = ZDICT_trainFromBuffer(&dictionary[0],
+                                      dictionary.size(),
+                                      samples.data(),
+                                      sampleSizes.data(),
+                                      sampleSizes.size());
+    ASSERT_FALSE(ZDICT_isError(size));
+    dictionary.resize(size);
+    return dictionary;
+}
+
+TEST(ZstdMessageCompressor, FidelityWithDictionary) {
+    auto testMessage = buildMessage();
+    checkFidelity(testMessage,
+                  stdx::make_unique<ZstdMessageCompressor>(
+                      ZstdMessageCompressor::kDefaultCompressionLevel, trainZstdDictionary()));
+}
+
+TEST(ZstdMessageCompressor, RejectsMessagesCompressedWithAnotherDictionary) {
+    ZstdMessageCompressor withDictionary(ZstdMessageCompressor::kDefaultCompressionLevel,
+                                         trainZstdDictionary());
+    ZstdMessageCompressor withoutDictionary;
+
+    auto reply = BSON("cursor" << BSON("firstBatch" << BSONArray() << "id" << 0LL << "ns"
+                                                    << "test.coll")
+                               << "ok"
+                               << 1.0);
+    ConstDataRange input(reply.objdata(), reply.objsize());
+    std::vector<char> compressed(withDictionary.getMaxCompressedSize(input.length()));
+    auto compressedSize = assertOk(
+        withDictionary.compressData(input, DataRange(compressed.data(), compressed.size())));
+
+    std::vector<char> output(input.length());
+    ConstDataRange compressedRange(compressed.data(), compressedSize);
+    ASSERT_NOT_OK(withoutDictionary.decompressData(compressedRange,
+                                                   DataRange(output.data(), output.size())));
+    ASSERT_EQ(assertOk(withDictionary.decompressData(compressedRange,
+                                                     DataRange(output.data(), output.size()))),
+              input.length());
+    ASSERT_EQ(memcmp(output.data(), reply.objdata(), reply.objsize()), 0);
+}
+
+TEST(ZstdMessageCompressor, RejectsUntrainedDictionary) {
+    ASSERT_THROWS_CODE(ZstdMessageCompressor(ZstdMessageCompressor::kDefaultCompressionLevel,
+                                             std::string(1024, 'a')),
+                       AssertionException,
+                       50808);
+}
+#endif
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<SnappyMessageCompressor>());
 }
@@ -241,6 +325,12 @@ TEST(ZlibMessageCompressor, Overflow) {
     checkOverflow(stdx::make_unique<ZlibMessageCompressor>());
 }
 
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+TEST(ZstdMessageCompressor, Overflow) {
+    checkOverflow(stdx::make_unique<ZstdMessageCompressor>());
+}
+#endif
+
 TEST(MessageCompressorManager, SERVER_28008) {
 
     // Create a client and server that will negotiate the same compressors,
@@ -294,6 +384,91 @@ TEST(MessageCompressorManager, SERVER_28008) {
     ASSERT_EQ(compressorId, zlibId);
 }
 
+Message buildMessage(const std::string& data) {
+    const auto bufferSize = MsgData::MsgDataHeaderSize + data.size();
+    auto buf = SharedBuffer::allocate(bufferSize);
+    MsgData::View testView(buf.get());
+    testView.setId(123456);
+    testView.setResponseToMsgId(654321);
+    testView.setOperation(dbQuery);
+    testView.setLen(bufferSize);
+    memcpy(testView.data(), data.data(), data.size());
+    return Message{buf};
+}
+
+TEST(MessageCompressorManager, SkipsMessagesBelowMinimumSize) {
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({"zlib"});
+    registry.registerImplementation(stdx::make_unique<ZlibMessageCompressor>());
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+    registry.setMinimumCompressibleSize(64);
+
+    MessageCompressorManager manager(&registry);
+    BSONObjBuilder negotiatorOut;
+    manager.serverNegotiate(BSON("isMaster" << 1 << "compression" << BSON_ARRAY("zlib")),
+                            &negotiatorOut);
+
+    auto small = assertOk(manager.compressMessage(buildMessage()));
+    ASSERT_EQ(small.operation(), dbQuery);
+    ASSERT_EQ(registry.getCompressor("zlib")->getMessagesSkipped(), 1);
+
+    auto large = assertOk(manager.compressMessage(buildMessage(std::string(1024, 'a'))));
+    ASSERT_EQ(large.operation(), dbCompressed);
+    ASSERT_EQ(registry.getCompressor("zlib")->getMessagesSkipped(), 1);
+    ASSERT_EQ(registry.getCompressor("zlib")->getCompressorBytesIn(), 1024);
+}
+
+TEST(MessageCompressorManager, BacksOffFromIncompressibleMessages) {
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({"noop"});
+    registry.registerImplementation(stdx::make_unique<NoopMessageCompressor>());
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+    registry.setSkipIncompressible(true);
+
+    MessageCompressorManager manager(&registry);
+    BSONObjBuilder negotiatorOut;
+    manager.serverNegotiate(BSON("isMaster" << 1 << "compression" << BSON_ARRAY("noop")),
+                            &negotiatorOut);
+    auto compressor = registry.getCompressor("noop");
+
+    // The noop compressor never makes a message smaller, so every message is sent uncompressed.
+    // After the first attempt the manager skips one message, then two, then four.
+    const auto msg = buildMessage(std::string(256, 'a'));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(assertOk(manager.compressMessage(msg)).operation(), dbQuery);
+    }
+    ASSERT_EQ(compressor->getMessagesSkipped(), 10);
+    // Messages which were compressed but sent uncompressed do not count as compressed bytes.
+    ASSERT_EQ(compressor->getCompressorBytesIn(), 0);
+    ASSERT_EQ(compressor->getCompressorBytesOut(), 0);
+}
+
+TEST(MessageCompressorManager, StillCompressesCompressibleMessagesWhenSkippingIncompressible) {
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({"snappy"});
+    registry.registerImplementation(stdx::make_unique<SnappyMessageCompressor>());
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+    registry.setSkipIncompressible(true);
+
+    MessageCompressorManager manager(&registry);
+    BSONObjBuilder negotiatorOut;
+    manager.serverNegotiate(BSON("isMaster" << 1 << "compression" << BSON_ARRAY("snappy")),
+                            &negotiatorOut);
+
+    const auto original = buildMessage(std::string(1024, 'a'));
+    auto compressed = assertOk(manager.compressMessage(original));
+    ASSERT_EQ(compressed.operation(), dbCompressed);
+    ASSERT_LT(compressed.size(), original.size());
+
+    auto decompressed = assertOk(manager.decompressMessage(compressed));
+    ASSERT_EQ(decompressed.size(), original.size());
+    ASSERT_EQ(memcmp(decompressed.singleData().data(),
+                     original.singleData().data(),
+                     original.singleData().dataLen()),
+              0);
+    ASSERT_EQ(registry.getCompressor("snappy")->getMessagesSkipped(), 0);
+}
+
 TEST(MessageCompressorManager, MessageSizeTooLarge) {
     auto registry = buildRegistry();
     MessageCompressorManager compManager(&registry);
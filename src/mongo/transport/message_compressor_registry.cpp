@@ -31,19 +31,36 @@
 #include "mongo/transport/message_compressor_registry.h"
 
 #include "mongo/base/init.h"
+#include "mongo/config.h"
 #include "mongo/stdx/memory.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_snappy.h"
 #include "mongo/transport/message_compressor_zlib.h"
+#include "mongo/util/mongoutils/str.h"
+#include "mongo/util/net/message.h"
 #include "mongo/util/options_parser/option_section.h"
 
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+#include "mongo/transport/message_compressor_zstd.h"
+#endif
+
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <fstream>
+#include <sstream>
 
 namespace mongo {
 namespace {
 const auto kDisabledConfigValue = "disabled"_sd;
 const auto kDefaultConfigValue = "snappy"_sd;
+const auto kMinimumCompressibleSizeName = "net.compression.minimumCompressibleSize"_sd;
+const auto kSkipIncompressibleName = "net.compression.skipIncompressible"_sd;
+const auto kZstdCompressionLevelName = "net.compression.zstdCompressionLevel"_sd;
+const auto kZstdDictionaryFileName = "net.compression.zstdDictionaryFile"_sd;
+
+// Below this size the compression header and the compressor's framing usually cost more than
+// the compressor saves.
+const int kDefaultMinimumCompressibleSize = 128;
 }  // namespace
 
 StringData getMessageCompressorName(MessageCompressor id) {
@@ -54,6 +71,8 @@ StringData getMessageCompressorName(MessageCompressor id) {
             return "snappy"_sd;
         case MessageCompressor::kZlib:
             return "zlib"_sd;
+        case MessageCompressor::kZstd:
+            return "zstd"_sd;
         default:
             fassert(40269, "Invalid message compressor ID");
     }
@@ -111,6 +130,22 @@ void MessageCompressorRegistry::setSupportedCompressors(std::vector<std::string>
     _compressorNames = std::move(names);
 }
 
+void MessageCompressorRegistry::setMinimumCompressibleSize(std::size_t bytes) {
+    _minimumCompressibleSize = bytes;
+}
+
+std::size_t MessageCompressorRegistry::getMinimumCompressibleSize() const {
+    return _minimumCompressibleSize;
+}
+
+void MessageCompressorRegistry::setSkipIncompressible(bool skip) {
+    _skipIncompressible = skip;
+}
+
+bool MessageCompressorRegistry::getSkipIncompressible() const {
+    return _skipIncompressible;
+}
+
 Status addMessageCompressionOptions(moe::OptionSection* options, bool forShell) {
     auto& ret =
         options
@@ -124,6 +159,52 @@ Status addMessageCompressionOptions(moe::OptionSection* options, bool forShell)
     } else {
         ret.setDefault(moe::Value(kDefaultConfigValue.toString()));
     }
+
+    auto& minimumSize =
+        options
+            ->addOptionChaining(kMinimumCompressibleSizeName.toString(),
+                                "networkMessageCompressionMinimumSize",
+                                moe::Int,
+                                "Network messages smaller than this many bytes are sent "
+                                "uncompressed")
+            .validRange(0, MaxMessageSizeBytes)
+            .setDefault(moe::Value(kDefaultMinimumCompressibleSize));
+    auto& skipIncompressible =
+        options
+            ->addOptionChaining(kSkipIncompressibleName.toString(),
+                                "networkMessageCompressionSkipIncompressible",
+                                moe::Bool,
+                                "Send network messages that do not shrink when compressed "
+                                "uncompressed, and back off from compressing on connections "
+                                "whose messages keep failing to shrink")
+            .setDefault(moe::Value(true));
+    if (forShell) {
+        minimumSize.hidden();
+        skipIncompressible.hidden();
+    }
+
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+    auto& zstdLevel =
+        options
+            ->addOptionChaining(kZstdCompressionLevelName.toString(),
+                                "networkMessageZstdCompressionLevel",
+                                moe::Int,
+                                "Compression level for the zstd network message compressor")
+            .validRange(1, 22)
+            .setDefault(moe::Value(ZstdMessageCompressor::kDefaultCompressionLevel));
+    auto& zstdDictionary =
+        options->addOptionChaining(kZstdDictionaryFileName.toString(),
+                                   "networkMessageZstdDictionaryFile",
+                                   moe::String,
+                                   "Path to a dictionary trained with 'zstd --train' to use with "
+                                   "the zstd network message compressor. Every process this one "
+                                   "exchanges zstd compressed messages with must load the same "
+                                   "dictionary");
+    if (forShell) {
+        zstdLevel.hidden();
+        zstdDictionary.hidden();
+    }
+#endif
     return Status::OK();
 }
 
@@ -139,6 +220,32 @@ Status storeMessageCompressionOptions(const moe::Environment& params) {
     auto& compressorFactory = MessageCompressorRegistry::get();
     compressorFactory.setSupportedCompressors(std::move(restrict));
 
+    if (params.count(kMinimumCompressibleSizeName.toString())) {
+        compressorFactory.setMinimumCompressibleSize(
+            params[kMinimumCompressibleSizeName.toString()].as<int>());
+    }
+    if (params.count(kSkipIncompressibleName.toString())) {
+        compressorFactory.setSkipIncompressible(
+            params[kSkipIncompressibleName.toString()].as<bool>());
+    }
+
+#ifdef MONGO_CONFIG_HAVE_ZSTD
+    if (params.count(kZstdCompressionLevelName.toString())) {
+        zstdMessageCompressionLevel = params[kZstdCompressionLevelName.toString()].as<int>();
+    }
+    if (params.count(kZstdDictionaryFileName.toString())) {
+        auto path = params[kZstdDictionaryFileName.toString()].as<std::string>();
+        std::ifstream dictionaryFile(path, std::ios::in | std::ios::binary);
+        if (!dictionaryFile) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Could not open zstd dictionary file " << path};
+        }
+        std::ostringstream dictionary;
+        dictionary << dictionaryFile.rdbuf();
+        zstdMessageCompressionDictionary = dictionary.str();
+    }
+#endif
+
     return Status::OK();
 }
 
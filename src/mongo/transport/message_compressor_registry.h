@@ -109,12 +109,29 @@ public:
      */
     Status finalizeSupportedCompressors();
 
+    /*
+     * Messages whose body is smaller than this many bytes are sent uncompressed. Defaults to 0,
+     * which compresses every message.
+     */
+    void setMinimumCompressibleSize(std::size_t bytes);
+    std::size_t getMinimumCompressibleSize() const;
+
+    /*
+     * When enabled, a message that doesn't get smaller when compressed is sent uncompressed, and
+     * connections whose messages keep failing to shrink back off from trying to compress them.
+     * Defaults to false.
+     */
+    void setSkipIncompressible(bool skip);
+    bool getSkipIncompressible() const;
+
 private:
     StringMap<MessageCompressorBase*> _compressorsByName;
     std::array<std::unique_ptr<MessageCompressorBase>,
                std::numeric_limits<MessageCompressorId>::max() + 1>
         _compressorsByIds;
     std::vector<std::string> _compressorNames;
+    std::size_t _minimumCompressibleSize = 0;
+    bool _skipIncompressible = false;
 };
 
 Status addMessageCompressionOptions(moe::OptionSection* options, bool forShell);
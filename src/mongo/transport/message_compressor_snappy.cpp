@@ -54,8 +54,6 @@ StatusWith<std::size_t> SnappyMessageCompressor::compressData(ConstDataRange inp
         return {ErrorCodes::BadValue, "Output too small for max size of compressed input"};
     }
     snappy::RawCompress(input.data(), input.length(), const_cast<char*>(output.data()), &outLength);
-
-    counterHitCompress(input.length(), outLength);
     return {outLength};
 }
 
@@ -57,7 +57,6 @@ StatusWith<std::size_t> ZlibMessageCompressor::compressData(ConstDataRange input
     if (ret != Z_OK) {
         return Status{ErrorCodes::BadValue, "Could not compress input"};
     }
-    counterHitCompress(input.length(), outLength);
     return {outLength};
 }
 
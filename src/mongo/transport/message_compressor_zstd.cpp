@@ -0,0 +1,200 @@
+/**
+ *    Copyright (C) 2018 MongoDB Inc.
+ *
+ *    This program is free software: you can redistribute it and/or  modify
+ *    it under the terms of the GNU Affero General Public License, version 3,
+ *    as published by the Free Software Foundation.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU Affero General Public License for more details.
+ *
+ *    You should have received a copy of the GNU Affero General Public License
+ *    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the GNU Affero General Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kNetwork
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/base/init.h"
+#include "mongo/stdx/memory.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/mongoutils/str.h"
+
+#include <memory>
+#include <zstd.h>
+
+namespace mongo {
+
+int zstdMessageCompressionLevel = ZstdMessageCompressor::kDefaultCompressionLevel;
+std::string zstdMessageCompressionDictionary;
+
+namespace {
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+// Every connection shares the one registered compressor, and each zstd context holds a workspace
+// that is costly to allocate, so every thread keeps its own contexts for all of the messages it
+// compresses and decompresses. Each compression or decompression starts a new frame, so a context
+// carries nothing over from one message to the next.
+thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> compressionContext;
+thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> decompressionContext;
+
+ZSTD_CCtx* getCompressionContext() {
+    if (!compressionContext) {
+        compressionContext.reset(ZSTD_createCCtx());
+    }
+    return compressionContext.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+    if (!decompressionContext) {
+        decompressionContext.reset(ZSTD_createDCtx());
+    }
+    return decompressionContext.get();
+}
+}  // namespace
+
+void ZstdMessageCompressor::CDictDeleter::operator()(ZSTD_CDict* dict) const {
+    ZSTD_freeCDict(dict);
+}
+
+void ZstdMessageCompressor::DDictDeleter::operator()(ZSTD_DDict* dict) const {
+    ZSTD_freeDDict(dict);
+}
+
+ZstdMessageCompressor::ZstdMessageCompressor(int compressionLevel, const std::string& dictionary)
+    : MessageCompressorBase(MessageCompressor::kZstd), _compressionLevel(compressionLevel) {
+    if (dictionary.empty()) {
+        return;
+    }
+
+    // Frames compressed with a raw content dictionary record a dictionary ID of 0, which would make
+    // them indistinguishable from frames compressed without one.
+    _dictionaryId = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+    uassert(50808,
+            "The zstd network compression dictionary was not trained with 'zstd --train'",
+            _dictionaryId != 0);
+
+    _compressionDictionary.reset(
+        ZSTD_createCDict(dictionary.data(), dictionary.size(), _compressionLevel));
+    _decompressionDictionary.reset(ZSTD_createDDict(dictionary.data(), dictionary.size()));
+    uassert(50809,
+            "Could not load the zstd network compression dictionary",
+            _compressionDictionary && _decompressionDictionary);
+}
+
+ZstdMessageCompressor::~ZstdMessageCompressor() = default;
+
+std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
+    return ZSTD_compressBound(inputSize);
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
+                                                            DataRange output) {
+    auto cctx = getCompressionContext();
+    if (!cctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate a zstd context"};
+    }
+
+    size_t ret;
+    if (_compressionDictionary) {
+        ret = ZSTD_compress_usingCDict(cctx,
+                                       const_cast<char*>(output.data()),
+                                       output.length(),
+                                       input.data(),
+                                       input.length(),
+                                       _compressionDictionary.get());
+    } else {
+        ret = ZSTD_compressCCtx(cctx,
+                                const_cast<char*>(output.data()),
+                                output.length(),
+                                input.data(),
+                                input.length(),
+                                _compressionLevel);
+    }
+
+    if (ZSTD_isError(ret)) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Could not compress input: " << ZSTD_getErrorName(ret)};
+    }
+    return {ret};
+}
+
+StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
+                                                              DataRange output) {
+    auto frameDictionaryId = ZSTD_getDictID_fromFrame(input.data(), input.length());
+    if (frameDictionaryId != 0 && frameDictionaryId != _dictionaryId) {
+        return Status{ErrorCodes::BadValue,
+                      str::stream() << "Compressed message uses zstd dictionary "
+                                    << frameDictionaryId
+                                    << ", which is not the configured dictionary"};
+    }
+
+    auto dctx = getDecompressionContext();
+    if (!dctx) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate a zstd context"};
+    }
+
+    size_t ret;
+    if (frameDictionaryId != 0) {
+        ret = ZSTD_decompress_usingDDict(dctx,
+                                         const_cast<char*>(output.data()),
+                                         output.length(),
+                                         input.data(),
+                                         input.length(),
+                                         _decompressionDictionary.get());
+    } else {
+        ret = ZSTD_decompressDCtx(
+            dctx, const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    }
+
+    if (ZSTD_isError(ret) || ret != output.length()) {
+        return Status{ErrorCodes::BadValue, "Compressed message was invalid or corrupted"};
+    }
+
+    counterHitDecompress(input.length(), output.length());
+    return {output.length()};
+}
+
+
+MONGO_INITIALIZER_GENERAL(ZstdMessageCompressorInit,
+                          ("EndStartupOptionHandling"),
+                          ("AllCompressorsRegistered"))
+(InitializerContext* context) {
+    auto& compressorRegistry = MessageCompressorRegistry::get();
+    try {
+        compressorRegistry.registerImplementation(
+            stdx::make_unique<ZstdMessageCompressor>(zstdMessageCompressionLevel,
+                                                     zstdMessageCompressionDictionary));
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+    return Status::OK();
+}
+}  // namespace mongo
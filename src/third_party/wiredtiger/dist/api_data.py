@@ -438,6 +438,12 @@ connection_runtime_config = [
                 both log_size and wait to set an upper bound for checkpoints;
                 setting this value above 0 configures periodic checkpoints''',
             min='0', max='2GB'),
+        Config('threads', '0', r'''
+            number of worker threads used to write dirty leaf pages during
+            a checkpoint.  Internal pages and checkpoint metadata are always
+            written by the thread running the checkpoint; setting this value
+            to 0 writes all pages on that thread''',
+            min='0', max='20'), # !!! Must match WT_CKPT_MAX_WORKERS
         Config('wait', '0', r'''
             seconds to wait between each checkpoint; setting this value
             above 0 configures periodic checkpoints''',
@@ -453,21 +459,6 @@ connection_runtime_config = [
         ]),
     Config('error_prefix', '', r'''
         prefix string for error messages'''),
-    Config('eviction', '', r'''
-        eviction configuration options''',
-        type='category', subconfig=[
-            Config('threads_max', '8', r'''
-                maximum number of threads WiredTiger will start to help evict
-                pages from cache. The number of threads started will vary
-                depending on the current eviction load. Each eviction worker
-                thread uses a session from the configured session_max''',
-                min=1, max=20),
-            Config('threads_min', '1', r'''
-                minimum number of threads WiredTiger will start to help evict
-                pages from cache. The number of threads currently running will
-                vary depending on the current eviction load''',
-                min=1, max=20),
-            ]),
     Config('eviction_checkpoint_target', '5', r'''
         perform eviction at the beginning of checkpoints to bring the dirty
         content in cache to this level. It is a percentage of the cache size if
@@ -592,8 +583,9 @@ connection_runtime_config = [
         intended for use with internal stress testing of WiredTiger.''',
         type='list', undoc=True,
         choices=[
-        'checkpoint_slow', 'split_race_1', 'split_race_2', 'split_race_3',
-        'split_race_4', 'split_race_5', 'split_race_6', 'split_race_7']),
+        'checkpoint_slow', 'checkpoint_worker_fail', 'split_race_1',
+        'split_race_2', 'split_race_3', 'split_race_4', 'split_race_5',
+        'split_race_6', 'split_race_7']),
     Config('verbose', '', r'''
         enable messages for various events. Options are given as a
         list, such as <code>"verbose=[evictserver,read]"</code>''',
@@ -683,6 +675,40 @@ wiredtiger_open_log_configuration = [
     ]),
 ]
 
+# wiredtiger_open and WT_CONNECTION.reconfigure eviction configurations.
+eviction_configuration_common = [
+    Config('threads_max', '8', r'''
+        maximum number of threads WiredTiger will start to help evict
+        pages from cache. The number of threads started will vary
+        depending on the current eviction load. Each eviction worker
+        thread uses a session from the configured session_max''',
+        min=1, max=20),
+    Config('threads_min', '1', r'''
+        minimum number of threads WiredTiger will start to help evict
+        pages from cache. The number of threads currently running will
+        vary depending on the current eviction load''',
+        min=1, max=20),
+]
+connection_reconfigure_eviction_configuration = [
+    Config('eviction', '', r'''
+        eviction configuration options''',
+        type='category', subconfig=
+        eviction_configuration_common)
+]
+wiredtiger_open_eviction_configuration = [
+    Config('eviction', '', r'''
+        eviction configuration options''',
+        type='category', subconfig=
+        eviction_configuration_common + [
+        Config('walk_shards', '1', r'''
+            number of shards trees are split into when searching for
+            pages to evict. Eviction worker threads walk the shards in
+            parallel, each filling its own part of the eviction queue
+            before the queue is sorted by priority''',
+            min=1, max=16),
+        ]),
+]
+
 # wiredtiger_open and WT_CONNECTION.reconfigure statistics log configurations.
 statistics_log_configuration_common = [
     Config('json', 'false', r'''
@@ -753,6 +779,7 @@ session_config = [
 
 wiredtiger_open_common =\
     connection_runtime_config +\
+    wiredtiger_open_eviction_configuration +\
     wiredtiger_open_log_configuration +\
     wiredtiger_open_statistics_log_configuration + [
     Config('buffer_alignment', '-1', r'''
@@ -825,6 +852,27 @@ wiredtiger_open_common =\
         time as each new block is written.  For example,
         <code>file_extend=(data=16MB)</code>''',
         type='list', choices=['data', 'log']),
+    Config('file_io', '', r'''
+        configure how data files are read and written''',
+        type='category', subconfig=[
+        Config('method', 'pread', r'''
+            the I/O method for data files.  The \c "aio" and \c "io_uring"
+            methods queue reads and writes from all threads to a single
+            Linux kernel queue, submitting and completing them in batches.
+            Linux native AIO is only used for files opened with \c direct_io.
+            The \c "io_uring" method falls back to \c "aio" if the kernel
+            does not support it.  Ignored for in-memory databases and
+            application file systems''',
+            choices=['aio', 'io_uring', 'pread']),
+        Config('io_uring_fail_for_test', 'false', r'''
+            fail to create an io_uring as if the kernel did not support it,
+            to test falling back to Linux native AIO''',
+            type='boolean', undoc=True),
+        Config('queue_depth', '64', r'''
+            maximum number of reads and writes in flight with the \c "aio"
+            and \c "io_uring" methods''',
+            min=1, max=4096),
+        ]),
     Config('hazard_max', '1000', r'''
         maximum number of simultaneous hazard pointers per session
         handle''',
@@ -837,6 +885,18 @@ wiredtiger_open_common =\
         RPC server for primary processes and use RPC for secondary
         processes). <b>Not yet supported in WiredTiger</b>''',
         type='boolean'),
+    Config('read_ahead', '', r'''
+        read leaf pages ahead of cursors scanning a tree sequentially''',
+        type='category', subconfig=[
+        Config('pages', '0', r'''
+            number of leaf pages to read ahead of a sequential scan;
+            setting this value to 0 disables read-ahead''',
+            min='0', max='64'),
+        Config('threads', '2', r'''
+            number of threads reading pages ahead of sequential scans.
+            Each thread uses a session from the configured session_max''',
+            min='1', max='20'),
+        ]),
     Config('readonly', 'false', r'''
         open connection in read-only mode.  The database must exist.  All
         methods that may modify a database are disabled.  See @ref readonly
@@ -1345,6 +1405,7 @@ methods = {
         print global txn information''', type='boolean'),
 ]),
 'WT_CONNECTION.reconfigure' : Method(
+    connection_reconfigure_eviction_configuration +\
     connection_reconfigure_log_configuration +\
     connection_reconfigure_statistics_log_configuration +\
     connection_runtime_config
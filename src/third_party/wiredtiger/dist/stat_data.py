@@ -178,6 +178,10 @@ connection_stats = [
     ##########################################
     # Block manager statistics
     ##########################################
+    BlockStat('block_aio_queue_full', 'asynchronous I/O queue full'),
+    BlockStat('block_aio_queued', 'asynchronous I/Os queued'),
+    BlockStat('block_aio_submit', 'asynchronous I/O submit calls'),
+    BlockStat('block_aio_wait', 'asynchronous I/O completion wait calls'),
     BlockStat('block_byte_map_read', 'mapped bytes read', 'size'),
     BlockStat('block_byte_read', 'bytes read', 'size'),
     BlockStat('block_byte_write', 'bytes written', 'size'),
@@ -204,6 +208,11 @@ connection_stats = [
     CacheStat('cache_eviction_aggressive_set', 'eviction currently operating in aggressive mode', 'no_clear,no_scale'),
     CacheStat('cache_eviction_app', 'pages evicted by application threads'),
     CacheStat('cache_eviction_app_dirty', 'modified pages evicted by application threads'),
+    CacheStat('cache_eviction_app_time_ge100000', 'application thread time waiting for cache histogram - 100ms+'),
+    CacheStat('cache_eviction_app_time_lt100', 'application thread time waiting for cache histogram - 0-99us'),
+    CacheStat('cache_eviction_app_time_lt1000', 'application thread time waiting for cache histogram - 100-999us'),
+    CacheStat('cache_eviction_app_time_lt10000', 'application thread time waiting for cache histogram - 1-9ms'),
+    CacheStat('cache_eviction_app_time_lt100000', 'application thread time waiting for cache histogram - 10-99ms'),
     CacheStat('cache_eviction_checkpoint', 'checkpoint blocked page eviction'),
     CacheStat('cache_eviction_clean', 'unmodified pages evicted'),
     CacheStat('cache_eviction_deepen', 'page split during eviction deepened the tree'),
@@ -245,6 +254,8 @@ connection_stats = [
     CacheStat('cache_eviction_walk_from_root', 'eviction walks started from root of tree'),
     CacheStat('cache_eviction_walk_passes', 'eviction passes of a file'),
     CacheStat('cache_eviction_walk_saved_pos', 'eviction walks started from saved location in tree'),
+    CacheStat('cache_eviction_walk_shards_server', 'eviction walk shards walked by the eviction server'),
+    CacheStat('cache_eviction_walk_shards_worker', 'eviction walk shards walked by eviction worker threads'),
     CacheStat('cache_eviction_walks_abandoned', 'eviction walks abandoned'),
     CacheStat('cache_eviction_walks_active', 'files with active eviction walks', 'no_clear,no_scale'),
     CacheStat('cache_eviction_walks_ended', 'eviction walks reached end of tree'),
@@ -271,6 +282,12 @@ connection_stats = [
     CacheStat('cache_read', 'pages read into cache'),
     CacheStat('cache_read_app_count', 'application threads page read from disk to cache count'),
     CacheStat('cache_read_app_time', 'application threads page read from disk to cache time (usecs)'),
+    CacheStat('cache_read_ahead', 'pages read ahead of a sequential scan'),
+    CacheStat('cache_read_ahead_hit', 'pages read ahead and used by a cursor'),
+    CacheStat('cache_read_ahead_queued', 'pages queued for read-ahead'),
+    CacheStat('cache_read_ahead_skip_full', 'pages not read ahead because the read-ahead queue was full'),
+    CacheStat('cache_read_ahead_skip_pressure', 'pages not read ahead because of cache pressure'),
+    CacheStat('cache_read_ahead_waste', 'pages read ahead and discarded unused'),
     CacheStat('cache_read_deleted', 'pages read into cache after truncate'),
     CacheStat('cache_read_deleted_prepared', 'pages read into cache after truncate in prepare state'),
     CacheStat('cache_read_lookaside', 'pages read into cache requiring lookaside entries'),
@@ -454,6 +471,11 @@ connection_stats = [
     RecStat('rec_pages_eviction', 'page reconciliation calls for eviction'),
     RecStat('rec_split_stashed_bytes', 'split bytes currently awaiting free', 'no_clear,no_scale,size'),
     RecStat('rec_split_stashed_objects', 'split objects currently awaiting free', 'no_clear,no_scale'),
+    RecStat('rec_update_chain_ge1000', 'update chain length histogram - 1000 and higher'),
+    RecStat('rec_update_chain_lt10', 'update chain length histogram - 1-9'),
+    RecStat('rec_update_chain_lt100', 'update chain length histogram - 10-99'),
+    RecStat('rec_update_chain_lt1000', 'update chain length histogram - 100-999'),
+    RecStat('rec_update_obsolete', 'obsolete updates discarded'),
 
     ##########################################
     # Session operations
@@ -495,6 +517,8 @@ connection_stats = [
     TxnStat('txn_checkpoint_fsync_post', 'transaction fsync calls for checkpoint after allocating the transaction ID'),
     TxnStat('txn_checkpoint_fsync_post_duration', 'transaction fsync duration for checkpoint after allocating the transaction ID (usecs)', 'no_clear,no_scale'),
     TxnStat('txn_checkpoint_generation', 'transaction checkpoint generation', 'no_clear,no_scale'),
+    TxnStat('txn_checkpoint_metadata_recent', 'transaction checkpoint metadata most recent time (msecs)', 'no_clear,no_scale'),
+    TxnStat('txn_checkpoint_prep_recent', 'transaction checkpoint prepare most recent time (msecs)', 'no_clear,no_scale'),
     TxnStat('txn_checkpoint_running', 'transaction checkpoint currently running', 'no_clear,no_scale'),
     TxnStat('txn_checkpoint_scrub_target', 'transaction checkpoint scrub dirty target', 'no_clear,no_scale'),
     TxnStat('txn_checkpoint_scrub_time', 'transaction checkpoint scrub time (msecs)', 'no_clear,no_scale'),
@@ -503,6 +527,8 @@ connection_stats = [
     TxnStat('txn_checkpoint_time_min', 'transaction checkpoint min time (msecs)', 'no_clear,no_scale'),
     TxnStat('txn_checkpoint_time_recent', 'transaction checkpoint most recent time (msecs)', 'no_clear,no_scale'),
     TxnStat('txn_checkpoint_time_total', 'transaction checkpoint total time (msecs)', 'no_clear,no_scale'),
+    TxnStat('txn_checkpoint_tree_recent', 'transaction checkpoint tree write most recent time (msecs)', 'no_clear,no_scale'),
+    TxnStat('txn_checkpoint_worker_pages', 'transaction checkpoint pages written by worker threads'),
     TxnStat('txn_commit', 'transactions committed'),
     TxnStat('txn_commit_queue_empty', 'commit timestamp queue insert to empty'),
     TxnStat('txn_commit_queue_tail', 'commit timestamp queue inserts to tail'),
@@ -544,6 +570,7 @@ connection_stats = [
     ##########################################
     YieldStat('application_cache_time', 'application thread time waiting for cache (usecs)'),
     YieldStat('application_evict_time', 'application thread time evicting (usecs)'),
+    YieldStat('application_evict_wait_time', 'application thread time waiting for eviction candidates (usecs)'),
     YieldStat('child_modify_blocked_page', 'page reconciliation yielded due to child modification'),
     YieldStat('conn_close_blocked_lsm', 'connection close yielded for lsm manager shutdown'),
     YieldStat('dhandle_lock_blocked', 'data handle lock yielded'),
@@ -735,6 +762,11 @@ dsrc_stats = [
     RecStat('rec_pages_eviction', 'page reconciliation calls for eviction'),
     RecStat('rec_prefix_compression', 'leaf page key bytes discarded using prefix compression', 'size'),
     RecStat('rec_suffix_compression', 'internal page key bytes discarded using suffix compression', 'size'),
+    RecStat('rec_update_chain_ge1000', 'update chain length histogram - 1000 and higher'),
+    RecStat('rec_update_chain_lt10', 'update chain length histogram - 1-9'),
+    RecStat('rec_update_chain_lt100', 'update chain length histogram - 10-99'),
+    RecStat('rec_update_chain_lt1000', 'update chain length histogram - 100-999'),
+    RecStat('rec_update_obsolete', 'obsolete updates discarded'),
 
     ##########################################
     # Session operations
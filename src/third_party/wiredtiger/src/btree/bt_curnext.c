@@ -580,6 +580,7 @@ __wt_btcur_next(WT_CURSOR_BTREE *cbt, bool truncating)
 	WT_CURSOR *cursor;
 	WT_DECL_RET;
 	WT_PAGE *page;
+	WT_REF *prev;
 	WT_SESSION_IMPL *session;
 	WT_UPDATE *upd;
 	uint32_t flags;
@@ -691,8 +692,11 @@ __wt_btcur_next(WT_CURSOR_BTREE *cbt, bool truncating)
 			__wt_page_evict_soon(session, cbt->ref);
 		cbt->page_deleted_count = 0;
 
+		prev = cbt->ref;
 		WT_ERR(__wt_tree_walk(session, &cbt->ref, flags));
 		WT_ERR_TEST(cbt->ref == NULL, WT_NOTFOUND);
+		if (!truncating)
+			__wt_read_ahead_scan(session, cbt, prev);
 	}
 #ifdef HAVE_DIAGNOSTIC
 	if (ret == 0)
@@ -44,6 +44,7 @@ __btree_clear(WT_SESSION_IMPL *session)
 	/* Destroy locks. */
 	__wt_rwlock_destroy(session, &btree->ovfl_lock);
 	__wt_spin_destroy(session, &btree->flush_lock);
+	__wt_spin_destroy(session, &btree->rec_max_lock);
 
 	/* Free allocated memory. */
 	__wt_free(session, btree->key_format);
@@ -241,6 +242,9 @@ __wt_btree_close(WT_SESSION_IMPL *session)
 		__wt_evict_file_exclusive_off(session);
 	}
 
+	/* Read-ahead threads read through the block manager, stop them. */
+	__wt_read_ahead_btree_clear(session, btree);
+
 	/* Discard any underlying block manager resources. */
 	if ((bm = btree->bm) != NULL) {
 		btree->bm = NULL;
@@ -473,6 +477,8 @@ __btree_conf(WT_SESSION_IMPL *session, WT_CKPT *ckpt)
 	/* Initialize locks. */
 	WT_RET(__wt_rwlock_init(session, &btree->ovfl_lock));
 	WT_RET(__wt_spin_init(session, &btree->flush_lock, "btree flush"));
+	WT_RET(__wt_spin_init(
+	    session, &btree->rec_max_lock, "btree reconcile max"));
 
 	btree->modified = false;			/* Clean */
 
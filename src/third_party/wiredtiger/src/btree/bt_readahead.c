@@ -0,0 +1,588 @@
+/*-
+ * Copyright (c) 2014-2018 MongoDB, Inc.
+ * Copyright (c) 2008-2014 WiredTiger, Inc.
+ *	All rights reserved.
+ *
+ * See the file LICENSE for redistribution information.
+ */
+
+#include "wt_internal.h"
+
+/*
+ * Read-ahead for sequential cursor scans.
+ *
+ * A cursor walking forward through the leaf pages of a tree queues the disk
+ * addresses of the next few leaf pages of the parent, and a group of
+ * read-ahead threads read and decompress those blocks. When the cursor gets
+ * to one of the pages, the page read finds the image already in memory and
+ * builds the in-memory page from it without waiting on I/O.
+ *
+ * Queue entries are keyed by the block address cookie rather than by WT_REF:
+ * references can be freed when the parent splits, addresses are immutable.
+ * The cookie includes the block's checksum, so an image read successfully is
+ * the block the cookie names, whenever it was read. A block can be freed and
+ * reused while its address is queued, so read-ahead threads read quietly and
+ * treat a checksum failure as a miss; the cursor won't ask for that address.
+ *
+ * Entries are hashed by address into buckets, each with its own lock, so
+ * cursors moving between leaf pages and reading pages only lock the bucket
+ * they need. Images are held outside of the cache; the number of entries
+ * bounds the memory used.
+ *
+ * Trees stay open, and a scan can stop before reaching the pages it queued,
+ * so images no cursor takes are aged out: queueing into a full bucket
+ * reclaims its oldest image, and idle read-ahead threads discard images
+ * that have waited too long.
+ */
+
+/* Leaf pages a cursor walks in order before read-ahead starts. */
+#define	WT_READ_AHEAD_MIN_PAGES	2
+
+/* Milliseconds an image waits for a cursor before it's discarded. */
+#define	WT_READ_AHEAD_MAX_AGE_MS	1000
+
+/*
+ * __read_ahead_bucket --
+ *	Return the bucket for a block address cookie.
+ */
+static inline WT_READ_AHEAD_BUCKET *
+__read_ahead_bucket(WT_READ_AHEAD *ra, const uint8_t *addr, size_t addr_size)
+{
+	return (&ra->buckets[
+	    __wt_hash_city64(addr, addr_size) % ra->bucket_count]);
+}
+
+/*
+ * __read_ahead_entry_clear --
+ *	Return an entry to the empty state. Called with the bucket lock held.
+ */
+static void
+__read_ahead_entry_clear(
+    WT_SESSION_IMPL *session, WT_READ_AHEAD *ra, WT_READ_AHEAD_ENTRY *entry)
+{
+	__wt_buf_free(session, &entry->image);
+	entry->btree = NULL;
+	entry->addr_size = 0;
+	entry->state = WT_READ_AHEAD_EMPTY;
+	(void)__wt_atomic_subv32(&ra->entries_inuse, 1);
+}
+
+/*
+ * __read_ahead_wait --
+ *	Wait for a read-ahead thread to finish reading an entry. Called with
+ *	the bucket lock held, which is dropped while waiting.
+ */
+static void
+__read_ahead_wait(WT_SESSION_IMPL *session,
+    WT_READ_AHEAD_BUCKET *bucket, WT_READ_AHEAD_ENTRY *entry)
+{
+	u_int yield_count;
+
+	for (yield_count = 0; entry->state == WT_READ_AHEAD_READING;) {
+		__wt_spin_unlock(session, &bucket->lock);
+		if (++yield_count < WT_THOUSAND)
+			__wt_yield();
+		else
+			__wt_sleep(0, 100);
+		__wt_spin_lock(session, &bucket->lock);
+	}
+}
+
+/*
+ * __read_ahead_queue --
+ *	Queue a leaf page block for the read-ahead threads.
+ */
+static bool
+__read_ahead_queue(WT_SESSION_IMPL *session, WT_READ_AHEAD *ra,
+    const uint8_t *addr, size_t addr_size)
+{
+	WT_BTREE *btree;
+	WT_READ_AHEAD_BUCKET *bucket;
+	WT_READ_AHEAD_ENTRY *empty, *entry, *oldest;
+	u_int i;
+	bool full, queued, reclaimed;
+
+	btree = S2BT(session);
+	bucket = __read_ahead_bucket(ra, addr, addr_size);
+	empty = oldest = NULL;
+	full = queued = reclaimed = false;
+
+	__wt_spin_lock(session, &bucket->lock);
+	for (i = 0; i < WT_READ_AHEAD_BUCKET_SLOTS; ++i) {
+		entry = &bucket->entries[i];
+		if (entry->state == WT_READ_AHEAD_EMPTY) {
+			if (empty == NULL)
+				empty = entry;
+			continue;
+		}
+		if (entry->btree == btree && entry->addr_size == addr_size &&
+		    memcmp(entry->addr, addr, addr_size) == 0)
+			goto done;
+		if (entry->state == WT_READ_AHEAD_READY &&
+		    (oldest == NULL || entry->seq < oldest->seq))
+			oldest = entry;
+	}
+
+	/*
+	 * If the bucket is full, the oldest image has waited longest for a
+	 * cursor: it's the least likely to be used, reclaim it. Entries being
+	 * queued or read can't be reclaimed.
+	 */
+	if (empty == NULL) {
+		if (oldest == NULL) {
+			full = true;
+			goto done;
+		}
+		__read_ahead_entry_clear(session, ra, oldest);
+		empty = oldest;
+		reclaimed = true;
+	}
+
+	empty->btree = btree;
+	empty->seq = __wt_atomic_add64(&ra->seq, 1);
+	memcpy(empty->addr, addr, addr_size);
+	empty->addr_size = addr_size;
+	empty->state = WT_READ_AHEAD_QUEUED;
+	(void)__wt_atomic_addv32(&ra->entries_inuse, 1);
+	queued = true;
+
+done:	__wt_spin_unlock(session, &bucket->lock);
+
+	if (full)
+		WT_STAT_CONN_INCR(session, cache_read_ahead_skip_full);
+	if (reclaimed)
+		WT_STAT_CONN_INCR(session, cache_read_ahead_waste);
+	return (queued);
+}
+
+/*
+ * __wt_read_ahead_scan --
+ *	A forward cursor scan moved to a new leaf page: if the scan is
+ *	sequential, queue the following leaf pages of the parent for
+ *	read-ahead.
+ */
+void
+__wt_read_ahead_scan(WT_SESSION_IMPL *session, WT_CURSOR_BTREE *cbt,
+    WT_REF *prev)
+{
+	WT_BTREE *btree;
+	WT_CONNECTION_IMPL *conn;
+	WT_PAGE_INDEX *pindex;
+	WT_READ_AHEAD *ra;
+	WT_REF *child, *ref;
+	size_t addr_size;
+	uint32_t i, queued, slot;
+	u_int type;
+	const uint8_t *addr;
+
+	conn = S2C(session);
+	ra = &conn->read_ahead;
+	btree = S2BT(session);
+	ref = cbt->ref;
+
+	if (ra->pages == 0 || ref == NULL || __wt_ref_is_root(ref) ||
+	    F_ISSET(btree, WT_BTREE_IN_MEMORY | WT_BTREE_LOOKASIDE))
+		return;
+
+	/*
+	 * The scan is sequential if the page we just left is the last page
+	 * this cursor moved to: searches and reset cursors repositioning on
+	 * the same page don't break the sequence.
+	 */
+	if (prev == NULL || prev != cbt->read_ahead_ref)
+		cbt->read_ahead_count = 0;
+	cbt->read_ahead_ref = ref;
+	if (++cbt->read_ahead_count < WT_READ_AHEAD_MIN_PAGES)
+		return;
+
+	/* Don't add to the cache's problems. */
+	if (__wt_eviction_needed(session, false, false, NULL)) {
+		WT_STAT_CONN_INCR(session, cache_read_ahead_skip_pressure);
+		return;
+	}
+
+	queued = 0;
+	WT_ENTER_PAGE_INDEX(session);
+	WT_INTL_INDEX_GET(session, ref->home, pindex);
+	slot = ref->pindex_hint;
+	if (slot < pindex->entries && pindex->index[slot] == ref)
+		for (i = 1; i <= ra->pages &&
+		    slot + i < pindex->entries; ++i) {
+			child = pindex->index[slot + i];
+			if (child->state != WT_REF_DISK)
+				continue;
+			__wt_ref_info(child, &addr, &addr_size, &type);
+			if (addr == NULL || type == WT_CELL_ADDR_INT)
+				continue;
+			if (__read_ahead_queue(session, ra, addr, addr_size))
+				++queued;
+		}
+	WT_LEAVE_PAGE_INDEX(session);
+
+	if (queued != 0) {
+		WT_STAT_CONN_INCRV(session, cache_read_ahead_queued, queued);
+		__wt_cond_signal(session, conn->read_ahead_threads.wait_cond);
+	}
+}
+
+/*
+ * __wt_read_ahead_take --
+ *	Take the image of a block read ahead, if there is one.
+ */
+bool
+__wt_read_ahead_take(WT_SESSION_IMPL *session,
+    const uint8_t *addr, size_t addr_size, WT_ITEM *buf)
+{
+	WT_BTREE *btree;
+	WT_READ_AHEAD *ra;
+	WT_READ_AHEAD_BUCKET *bucket;
+	WT_READ_AHEAD_ENTRY *entry;
+	u_int i;
+	bool found;
+
+	ra = &S2C(session)->read_ahead;
+	btree = S2BT(session);
+	found = false;
+
+	if (ra->entries_inuse == 0)
+		return (false);
+
+	bucket = __read_ahead_bucket(ra, addr, addr_size);
+	__wt_spin_lock(session, &bucket->lock);
+	for (i = 0; i < WT_READ_AHEAD_BUCKET_SLOTS; ++i) {
+		entry = &bucket->entries[i];
+		if (entry->state == WT_READ_AHEAD_EMPTY ||
+		    entry->btree != btree || entry->addr_size != addr_size ||
+		    memcmp(entry->addr, addr, addr_size) != 0)
+			continue;
+
+		/*
+		 * A read-ahead thread is reading the block: wait for it rather
+		 * than reading it twice.
+		 */
+		__read_ahead_wait(session, bucket, entry);
+
+		/*
+		 * The read may have failed or the tree may have been closed
+		 * while we waited, check the entry still matches.
+		 */
+		if (entry->state == WT_READ_AHEAD_EMPTY ||
+		    entry->btree != btree || entry->addr_size != addr_size ||
+		    memcmp(entry->addr, addr, addr_size) != 0)
+			break;
+
+		if (entry->state == WT_READ_AHEAD_READY) {
+			*buf = entry->image;
+			WT_CLEAR(entry->image);
+			found = true;
+		}
+
+		/* A queued entry is no longer needed: we're reading it. */
+		__read_ahead_entry_clear(session, ra, entry);
+		break;
+	}
+	__wt_spin_unlock(session, &bucket->lock);
+
+	if (found)
+		WT_STAT_CONN_INCR(session, cache_read_ahead_hit);
+	return (found);
+}
+
+/*
+ * __wt_read_ahead_btree_clear --
+ *	Discard read-ahead entries for a tree that is being closed.
+ */
+void
+__wt_read_ahead_btree_clear(WT_SESSION_IMPL *session, WT_BTREE *btree)
+{
+	WT_READ_AHEAD *ra;
+	WT_READ_AHEAD_BUCKET *bucket;
+	WT_READ_AHEAD_ENTRY *entry;
+	uint64_t waste;
+	uint32_t b;
+	u_int i;
+
+	ra = &S2C(session)->read_ahead;
+	waste = 0;
+
+	if (ra->buckets == NULL)
+		return;
+
+	for (b = 0; b < ra->bucket_count; ++b) {
+		bucket = &ra->buckets[b];
+		__wt_spin_lock(session, &bucket->lock);
+		for (i = 0; i < WT_READ_AHEAD_BUCKET_SLOTS; ++i) {
+			entry = &bucket->entries[i];
+			if (entry->state == WT_READ_AHEAD_EMPTY ||
+			    entry->btree != btree)
+				continue;
+
+			/* Wait for any read in progress, it uses the tree. */
+			__read_ahead_wait(session, bucket, entry);
+			if (entry->state == WT_READ_AHEAD_EMPTY ||
+			    entry->btree != btree)
+				continue;
+
+			if (entry->state == WT_READ_AHEAD_READY)
+				++waste;
+			__read_ahead_entry_clear(session, ra, entry);
+		}
+		__wt_spin_unlock(session, &bucket->lock);
+	}
+
+	if (waste != 0)
+		WT_STAT_CONN_INCRV(session, cache_read_ahead_waste, waste);
+}
+
+/*
+ * __read_ahead_thread_chk --
+ *	Check to decide if the read-ahead threads should continue running.
+ */
+static bool
+__read_ahead_thread_chk(WT_SESSION_IMPL *session)
+{
+	return (S2C(session)->read_ahead.pages != 0);
+}
+
+/*
+ * __read_ahead_claim --
+ *	Claim the oldest queued block. Entries are checked without locking,
+ *	the bucket of the oldest is locked to claim it.
+ */
+static WT_READ_AHEAD_ENTRY *
+__read_ahead_claim(WT_SESSION_IMPL *session,
+    WT_READ_AHEAD *ra, WT_READ_AHEAD_BUCKET **bucketp)
+{
+	WT_READ_AHEAD_BUCKET *bucket, *next_bucket;
+	WT_READ_AHEAD_ENTRY *entry, *next;
+	uint32_t b;
+	u_int i;
+
+	*bucketp = NULL;
+
+	next = NULL;
+	next_bucket = NULL;
+	for (b = 0; b < ra->bucket_count; ++b) {
+		bucket = &ra->buckets[b];
+		for (i = 0; i < WT_READ_AHEAD_BUCKET_SLOTS; ++i) {
+			entry = &bucket->entries[i];
+			if (entry->state == WT_READ_AHEAD_QUEUED &&
+			    (next == NULL || entry->seq < next->seq)) {
+				next = entry;
+				next_bucket = bucket;
+			}
+		}
+	}
+	if (next == NULL)
+		return (NULL);
+
+	/* Another thread or a cursor may have got there first. */
+	__wt_spin_lock(session, &next_bucket->lock);
+	if (next->state == WT_READ_AHEAD_QUEUED)
+		next->state = WT_READ_AHEAD_READING;
+	else
+		next = NULL;
+	__wt_spin_unlock(session, &next_bucket->lock);
+
+	*bucketp = next_bucket;
+	return (next);
+}
+
+/*
+ * __read_ahead_sweep --
+ *	Discard images that have waited too long for a cursor. Entries are
+ *	checked without locking, the bucket is locked to discard one.
+ */
+static void
+__read_ahead_sweep(WT_SESSION_IMPL *session, WT_READ_AHEAD *ra)
+{
+	WT_READ_AHEAD_BUCKET *bucket;
+	WT_READ_AHEAD_ENTRY *entry;
+	uint64_t now, waste;
+	uint32_t b;
+	u_int i;
+
+	now = __wt_clock(session);
+	waste = 0;
+
+	for (b = 0; b < ra->bucket_count; ++b) {
+		bucket = &ra->buckets[b];
+		for (i = 0; i < WT_READ_AHEAD_BUCKET_SLOTS; ++i) {
+			entry = &bucket->entries[i];
+			if (entry->state != WT_READ_AHEAD_READY ||
+			    WT_CLOCKDIFF_MS(now, entry->read_time) <
+			    WT_READ_AHEAD_MAX_AGE_MS)
+				continue;
+
+			/* A cursor may have taken the image. */
+			__wt_spin_lock(session, &bucket->lock);
+			if (entry->state == WT_READ_AHEAD_READY &&
+			    WT_CLOCKDIFF_MS(now, entry->read_time) >=
+			    WT_READ_AHEAD_MAX_AGE_MS) {
+				__read_ahead_entry_clear(session, ra, entry);
+				++waste;
+			}
+			__wt_spin_unlock(session, &bucket->lock);
+		}
+	}
+
+	if (waste != 0)
+		WT_STAT_CONN_INCRV(session, cache_read_ahead_waste, waste);
+}
+
+/*
+ * __read_ahead_thread_run --
+ *	Entry function for a read-ahead thread.  This is called repeatedly
+ *	from the thread group code so it does not need to loop itself.
+ */
+static int
+__read_ahead_thread_run(WT_SESSION_IMPL *session, WT_THREAD *thread)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_ITEM buf;
+	WT_READ_AHEAD *ra;
+	WT_READ_AHEAD_BUCKET *bucket;
+	WT_READ_AHEAD_ENTRY *next;
+	bool pressure;
+
+	WT_UNUSED(thread);
+
+	conn = S2C(session);
+	ra = &conn->read_ahead;
+
+	/* If we lost a race for a queued block, look for another one. */
+	bucket = NULL;
+	next = NULL;
+	if (ra->entries_inuse != 0)
+		next = __read_ahead_claim(session, ra, &bucket);
+	if (next == NULL) {
+		if (bucket == NULL) {
+			if (ra->entries_inuse != 0)
+				__read_ahead_sweep(session, ra);
+			__wt_cond_wait(session,
+			    conn->read_ahead_threads.wait_cond, 10000, NULL);
+		}
+		return (0);
+	}
+
+	/*
+	 * Check the cache again, the block may have been queued some time ago.
+	 * Closing the tree waits for entries being read, so the tree can't go
+	 * away underneath the read.
+	 *
+	 * The block may have been freed and reused since it was queued, read it
+	 * quietly: a checksum failure only means the cursor won't want it.
+	 */
+	WT_CLEAR(buf);
+	pressure = __wt_eviction_needed(session, false, false, NULL);
+	if (!pressure) {
+		F_SET(session, WT_SESSION_QUIET_CORRUPT_FILE);
+		WT_WITH_BTREE(session, next->btree, ret =
+		    __wt_bt_read(session, &buf, next->addr, next->addr_size));
+		F_CLR(session, WT_SESSION_QUIET_CORRUPT_FILE);
+	}
+
+	__wt_spin_lock(session, &bucket->lock);
+	if (!pressure && ret == 0 && WT_DATA_IN_ITEM(&buf)) {
+		next->image = buf;
+		next->read_time = __wt_clock(session);
+		next->state = WT_READ_AHEAD_READY;
+	} else {
+		/*
+		 * Mapped images don't need reading ahead; failures are misses,
+		 * a cursor that wants the block will read it again.
+		 */
+		__wt_buf_free(session, &buf);
+		__read_ahead_entry_clear(session, ra, next);
+	}
+	__wt_spin_unlock(session, &bucket->lock);
+
+	if (pressure)
+		WT_STAT_CONN_INCR(session, cache_read_ahead_skip_pressure);
+	else if (ret == 0)
+		WT_STAT_CONN_INCR(session, cache_read_ahead);
+	return (0);
+}
+
+/*
+ * __wt_read_ahead_create --
+ *	Start the read-ahead threads.
+ */
+int
+__wt_read_ahead_create(WT_SESSION_IMPL *session, const char *cfg[])
+{
+	WT_CONFIG_ITEM cval;
+	WT_CONNECTION_IMPL *conn;
+	WT_READ_AHEAD *ra;
+	uint32_t b, pages;
+
+	conn = S2C(session);
+	ra = &conn->read_ahead;
+
+	WT_RET(__wt_config_gets(session, cfg, "read_ahead.pages", &cval));
+	pages = (uint32_t)cval.val;
+	WT_RET(__wt_config_gets(session, cfg, "read_ahead.threads", &cval));
+	conn->read_ahead_threads_num = (uint32_t)cval.val;
+
+	/* There's nothing to read ahead of an in-memory database. */
+	if (pages == 0 || F_ISSET(conn, WT_CONN_IN_MEMORY))
+		return (0);
+
+	/*
+	 * Allow each thread to have a couple of scans' worth of pages queued
+	 * or waiting for a cursor.
+	 */
+	ra->bucket_count = WT_MAX(1, (2 * pages *
+	    conn->read_ahead_threads_num) / WT_READ_AHEAD_BUCKET_SLOTS);
+	WT_RET(__wt_calloc_def(session, ra->bucket_count, &ra->buckets));
+	for (b = 0; b < ra->bucket_count; ++b)
+		WT_RET(__wt_spin_init(
+		    session, &ra->buckets[b].lock, "read-ahead"));
+	ra->pages = pages;
+
+	return (__wt_thread_group_create(session, &conn->read_ahead_threads,
+	    "read-ahead", conn->read_ahead_threads_num,
+	    conn->read_ahead_threads_num,
+	    WT_THREAD_CAN_WAIT | WT_THREAD_PANIC_FAIL,
+	    __read_ahead_thread_chk, __read_ahead_thread_run, NULL));
+}
+
+/*
+ * __wt_read_ahead_destroy --
+ *	Stop the read-ahead threads and discard any images read ahead.
+ */
+int
+__wt_read_ahead_destroy(WT_SESSION_IMPL *session)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_READ_AHEAD *ra;
+	uint32_t b;
+	u_int i;
+
+	conn = S2C(session);
+	ra = &conn->read_ahead;
+
+	if (ra->buckets == NULL)
+		return (0);
+
+	/* Stop queueing, then shut down the threads. */
+	ra->pages = 0;
+	if (conn->read_ahead_threads.threads != NULL) {
+		__wt_writelock(session, &conn->read_ahead_threads.lock);
+		WT_TRET(__wt_thread_group_destroy(
+		    session, &conn->read_ahead_threads));
+	}
+
+	for (b = 0; b < ra->bucket_count; ++b) {
+		for (i = 0; i < WT_READ_AHEAD_BUCKET_SLOTS; ++i)
+			__wt_buf_free(
+			    session, &ra->buckets[b].entries[i].image);
+		__wt_spin_destroy(session, &ra->buckets[b].lock);
+	}
+	__wt_free(session, ra->buckets);
+	memset(ra, 0, sizeof(*ra));
+
+	return (ret);
+}
@@ -63,27 +63,14 @@ __sync_checkpoint_can_skip(WT_SESSION_IMPL *session, WT_PAGE *page)
 }
 
 /*
- * __sync_dup_walk --
- *	Duplicate a tree walk point.
+ * __sync_dup_hazard_pointer --
+ *	Get a duplicate hazard pointer.
  */
 static inline int
-__sync_dup_walk(
-    WT_SESSION_IMPL *session, WT_REF *walk, uint32_t flags, WT_REF **dupp)
+__sync_dup_hazard_pointer(WT_SESSION_IMPL *session, WT_REF *walk)
 {
-	WT_REF *old;
 	bool busy;
 
-	if ((old = *dupp) != NULL) {
-		*dupp = NULL;
-		WT_RET(__wt_page_release(session, old, flags));
-	}
-
-	/* It is okay to duplicate a walk before it starts. */
-	if (walk == NULL || __wt_ref_is_root(walk)) {
-		*dupp = walk;
-		return (0);
-	}
-
 	/* Get a duplicate hazard pointer. */
 	for (;;) {
 #ifdef HAVE_DIAGNOSTIC
@@ -102,11 +89,336 @@ __sync_dup_walk(
 			break;
 		__wt_yield();
 	}
+	return (0);
+}
+
+/*
+ * __sync_dup_walk --
+ *	Duplicate a tree walk point.
+ */
+static inline int
+__sync_dup_walk(
+    WT_SESSION_IMPL *session, WT_REF *walk, uint32_t flags, WT_REF **dupp)
+{
+	WT_REF *old;
+
+	if ((old = *dupp) != NULL) {
+		*dupp = NULL;
+		WT_RET(__wt_page_release(session, old, flags));
+	}
+
+	/* It is okay to duplicate a walk before it starts. */
+	if (walk == NULL || __wt_ref_is_root(walk)) {
+		*dupp = walk;
+		return (0);
+	}
 
+	WT_RET(__sync_dup_hazard_pointer(session, walk));
 	*dupp = walk;
 	return (0);
 }
 
+/*
+ * __sync_worker_snapshot --
+ *	Share the checkpoint transaction's snapshot with a worker thread.
+ */
+static void
+__sync_worker_snapshot(WT_SESSION_IMPL *session, WT_TXN *ckpt_txn)
+{
+	WT_TXN *txn;
+
+	txn = &session->txn;
+
+	/*
+	 * Workers only reconcile pages on behalf of the checkpoint, they never
+	 * update anything, so a copy of the checkpoint's snapshot is all the
+	 * transactional state they need for visibility checks.
+	 */
+	txn->isolation = ckpt_txn->isolation;
+	txn->snap_min = ckpt_txn->snap_min;
+	txn->snap_max = ckpt_txn->snap_max;
+	txn->snapshot_count = ckpt_txn->snapshot_count;
+	if (txn->snapshot_count != 0)
+		memcpy(txn->snapshot, ckpt_txn->snapshot,
+		    txn->snapshot_count * sizeof(*txn->snapshot));
+#ifdef HAVE_TIMESTAMPS
+	__wt_timestamp_set(&txn->read_timestamp, &ckpt_txn->read_timestamp);
+#endif
+	F_CLR(txn, WT_TXN_HAS_SNAPSHOT |
+	    WT_TXN_HAS_TS_READ | WT_TXN_IGNORE_PREPARE);
+	F_SET(txn, F_MASK(ckpt_txn, WT_TXN_HAS_SNAPSHOT |
+	    WT_TXN_HAS_TS_READ | WT_TXN_IGNORE_PREPARE));
+}
+
+/*
+ * __sync_work --
+ *	Reconcile pages from the checkpoint's queue until it is empty.
+ */
+static void
+__sync_work(WT_SESSION_IMPL *session, WT_CKPT_WORK *work, bool worker)
+{
+	WT_DECL_RET;
+	WT_REF *ref;
+	WT_TXN *txn;
+	uint64_t batch, snapshot_batch;
+	bool drained;
+
+	txn = &session->txn;
+	snapshot_batch = 0;
+
+	for (;;) {
+		__wt_spin_lock(session, &work->lock);
+		if (!work->running || work->next == work->entries) {
+			__wt_spin_unlock(session, &work->lock);
+			break;
+		}
+		ref = work->refs[work->next++];
+		batch = work->batch;
+		__wt_spin_unlock(session, &work->lock);
+
+		/*
+		 * The checkpoint's snapshot can't change until the page we
+		 * claimed is written: the checkpoint thread is waiting for the
+		 * queue to drain. Copy it once per batch, the checkpoint can
+		 * move on to another tree between batches.
+		 */
+		if (worker && batch != snapshot_batch) {
+			__sync_worker_snapshot(session, work->txn);
+			snapshot_batch = batch;
+		}
+
+		/*
+		 * Once a page has failed, skip the rest of the queue: the
+		 * checkpoint is going to fail anyway. Testing can fail every
+		 * queued page to exercise that path.
+		 */
+		if (work->ret == 0 &&
+		    FLD_ISSET(S2C(session)->timing_stress_flags,
+		    WT_TIMING_STRESS_CHECKPOINT_WORKER_FAIL))
+			ret = WT_ERROR;
+		else if (work->ret == 0) {
+			WT_WITH_DHANDLE(session, work->dhandle,
+			    ret = __wt_reconcile(
+			    session, ref, NULL, WT_REC_CHECKPOINT, NULL));
+			if (worker && ret == 0)
+				WT_STAT_CONN_INCR(
+				    session, txn_checkpoint_worker_pages);
+		}
+
+		__wt_spin_lock(session, &work->lock);
+		if (ret != 0 && work->ret == 0)
+			work->ret = ret;
+		drained = ++work->done == work->entries;
+		__wt_spin_unlock(session, &work->lock);
+		ret = 0;
+
+		if (drained)
+			__wt_cond_signal(session, work->done_cond);
+	}
+
+	if (snapshot_batch != 0) {
+		F_CLR(txn, WT_TXN_HAS_SNAPSHOT |
+		    WT_TXN_HAS_TS_READ | WT_TXN_IGNORE_PREPARE);
+		txn->snapshot_count = 0;
+		txn->isolation = session->isolation;
+	}
+}
+
+/*
+ * __sync_work_drain --
+ *	Hand the queued pages to the worker threads, help write them and wait
+ * for the queue to drain.
+ */
+static int
+__sync_work_drain(WT_SESSION_IMPL *session, uint32_t flags)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_CKPT_WORK *work;
+	WT_DECL_RET;
+	uint32_t i;
+
+	conn = S2C(session);
+	work = &conn->ckpt_work;
+
+	if (work->entries == 0)
+		return (0);
+
+	__wt_spin_lock(session, &work->lock);
+	work->dhandle = session->dhandle;
+	work->txn = &session->txn;
+	++work->batch;
+	work->next = work->done = 0;
+	work->ret = 0;
+	work->running = true;
+	__wt_spin_unlock(session, &work->lock);
+	__wt_cond_signal(session, conn->ckpt_threads.wait_cond);
+
+	/* The checkpoint thread writes pages too rather than just waiting. */
+	__sync_work(session, work, false);
+	while (work->done != work->entries)
+		__wt_cond_wait(session, work->done_cond, 1000, NULL);
+
+	__wt_spin_lock(session, &work->lock);
+	work->running = false;
+	ret = work->ret;
+	__wt_spin_unlock(session, &work->lock);
+
+	/* Release the hazard pointers taken when the pages were queued. */
+	for (i = 0; i < work->entries; ++i)
+		WT_TRET(__wt_page_release(session, work->refs[i], flags));
+	work->entries = 0;
+
+	return (ret);
+}
+
+/*
+ * __sync_work_queue --
+ *	Queue a dirty leaf page for the checkpoint's worker threads.
+ */
+static int
+__sync_work_queue(WT_SESSION_IMPL *session, WT_REF *ref, uint32_t flags)
+{
+	WT_CKPT_WORK *work;
+
+	work = &S2C(session)->ckpt_work;
+
+	WT_RET(__wt_realloc_def(session,
+	    &work->refs_allocated, work->entries + 1, &work->refs));
+
+	/*
+	 * The tree walk moves on, the queue holds its own hazard pointer so
+	 * the page stays in memory until it is written.
+	 */
+	WT_RET(__sync_dup_hazard_pointer(session, ref));
+	work->refs[work->entries++] = ref;
+
+	if (work->entries >= work->refs_max)
+		WT_RET(__sync_work_drain(session, flags));
+	return (0);
+}
+
+/*
+ * __sync_workers_chk --
+ *	Check to decide if the checkpoint worker threads should continue
+ *	running.
+ */
+static bool
+__sync_workers_chk(WT_SESSION_IMPL *session)
+{
+	return (S2C(session)->ckpt_work.refs_max != 0);
+}
+
+/*
+ * __wt_sync_workers_run --
+ *	Entry function for a checkpoint worker thread.  This is called
+ *	repeatedly from the thread group code so it does not need to loop
+ *	itself.
+ */
+int
+__wt_sync_workers_run(WT_SESSION_IMPL *session, WT_THREAD *thread)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_CKPT_WORK *work;
+
+	WT_UNUSED(thread);
+
+	conn = S2C(session);
+	work = &conn->ckpt_work;
+
+	/*
+	 * Like the checkpoint thread, workers keep their reconciliation and
+	 * block manager structures from one page to the next.
+	 */
+	F_SET(session, WT_SESSION_CHECKPOINT_WORKER);
+
+	if (work->running) {
+		__sync_work(session, work, true);
+		return (0);
+	}
+
+	__wt_cond_wait(session, conn->ckpt_threads.wait_cond, 10000, NULL);
+
+	/*
+	 * Once the checkpoint completes, discard those structures, as the
+	 * checkpoint thread does.
+	 */
+	if (session->reconcile != NULL &&
+	    !conn->txn_global.checkpoint_running && !work->running)
+		WT_RET(__wt_session_release_resources(session));
+	return (0);
+}
+
+/*
+ * __wt_sync_workers_config --
+ *	Start, resize or stop the checkpoint worker threads to match the
+ * configured number.  The caller must hold the checkpoint lock so no
+ * checkpoint is using the threads.
+ */
+int
+__wt_sync_workers_config(WT_SESSION_IMPL *session)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_CKPT_WORK *work;
+	uint32_t threads;
+
+	conn = S2C(session);
+	work = &conn->ckpt_work;
+	threads = conn->ckpt_threads_num;
+
+	if (threads == 0)
+		return (__wt_sync_workers_destroy(session));
+
+	/*
+	 * Queue enough pages to keep every worker busy while the checkpoint
+	 * thread walks the tree, without pinning too much of the cache.
+	 */
+	work->refs_max = threads * 16;
+
+	if (conn->ckpt_threads.threads != NULL)
+		return (__wt_thread_group_resize(
+		    session, &conn->ckpt_threads, threads, threads,
+		    WT_THREAD_CAN_WAIT | WT_THREAD_PANIC_FAIL));
+
+	WT_RET(__wt_spin_init(session, &work->lock, "checkpoint work"));
+	WT_RET(__wt_cond_alloc(session, "checkpoint work", &work->done_cond));
+	return (__wt_thread_group_create(session, &conn->ckpt_threads,
+	    "checkpoint-worker", threads, threads,
+	    WT_THREAD_CAN_WAIT | WT_THREAD_PANIC_FAIL,
+	    __sync_workers_chk, __wt_sync_workers_run, NULL));
+}
+
+/*
+ * __wt_sync_workers_destroy --
+ *	Stop the checkpoint worker threads.
+ */
+int
+__wt_sync_workers_destroy(WT_SESSION_IMPL *session)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_CKPT_WORK *work;
+	WT_DECL_RET;
+
+	conn = S2C(session);
+	work = &conn->ckpt_work;
+
+	WT_ASSERT(session, work->entries == 0 && !work->running);
+
+	/* Stop the workers before tearing down their queue. */
+	work->refs_max = 0;
+	if (conn->ckpt_threads.threads != NULL) {
+		__wt_writelock(session, &conn->ckpt_threads.lock);
+		WT_TRET(__wt_thread_group_destroy(
+		    session, &conn->ckpt_threads));
+	}
+
+	__wt_cond_destroy(session, &work->done_cond);
+	__wt_spin_destroy(session, &work->lock);
+	__wt_free(session, work->refs);
+	memset(work, 0, sizeof(*work));
+
+	return (ret);
+}
+
 /*
  * __sync_file --
  *	Flush pages for a specific file.
@@ -123,13 +435,13 @@ __sync_file(WT_SESSION_IMPL *session, WT_CACHE_OP syncop)
 	uint64_t internal_bytes, internal_pages, leaf_bytes, leaf_pages;
 	uint64_t oldest_id, saved_pinned_id, time_start, time_stop;
 	uint32_t flags;
-	bool timer, tried_eviction;
+	bool parallel, timer, tried_eviction;
 
 	conn = S2C(session);
 	btree = S2BT(session);
 	prev = walk = NULL;
 	txn = &session->txn;
-	tried_eviction = false;
+	parallel = tried_eviction = false;
 	time_start = time_stop = 0;
 
 	/* Only visit pages in cache and don't bump page read generations. */
@@ -249,6 +561,16 @@ __sync_file(WT_SESSION_IMPL *session, WT_CACHE_OP syncop)
 		/* Read pages with lookaside entries and evict them asap. */
 		LF_SET(WT_READ_LOOKASIDE | WT_READ_WONT_NEED);
 
+		/*
+		 * If the checkpoint started worker threads, queue dirty leaf
+		 * pages for them to write. Internal pages are still written by
+		 * this thread, after all of their children, and the metadata
+		 * is always written here.
+		 */
+		parallel = conn->ckpt_work.refs_max != 0 &&
+		    WT_SESSION_IS_CHECKPOINT(session) &&
+		    !WT_IS_METADATA(session->dhandle);
+
 		for (;;) {
 			WT_ERR(__sync_dup_walk(session, walk, flags, &prev));
 			WT_ERR(__wt_tree_walk(session, &walk, flags));
@@ -317,8 +639,19 @@ __sync_file(WT_SESSION_IMPL *session, WT_CACHE_OP syncop)
 			}
 			tried_eviction = false;
 
-			WT_ERR(__wt_reconcile(
-			    session, walk, NULL, WT_REC_CHECKPOINT, NULL));
+			if (!parallel)
+				WT_ERR(__wt_reconcile(session,
+				    walk, NULL, WT_REC_CHECKPOINT, NULL));
+			else if (WT_PAGE_IS_INTERNAL(page)) {
+				/*
+				 * The tree walk is post-order: the queue holds
+				 * children of this page, write them first.
+				 */
+				WT_ERR(__sync_work_drain(session, flags));
+				WT_ERR(__wt_reconcile(session,
+				    walk, NULL, WT_REC_CHECKPOINT, NULL));
+			} else
+				WT_ERR(__sync_work_queue(session, walk, flags));
 
 			/*
 			 * Update checkpoint IO tracking data if configured
@@ -335,6 +668,8 @@ __sync_file(WT_SESSION_IMPL *session, WT_CACHE_OP syncop)
 					    session, false);
 			}
 		}
+		if (parallel)
+			WT_ERR(__sync_work_drain(session, flags));
 		break;
 	case WT_SYNC_CLOSE:
 	case WT_SYNC_DISCARD:
@@ -354,7 +689,9 @@ __sync_file(WT_SESSION_IMPL *session, WT_CACHE_OP syncop)
 		    WT_CLOCKDIFF_MS(time_stop, time_start));
 	}
 
-err:	/* On error, clear any left-over tree walk. */
+err:	/* On error, clear any left-over tree walk and queued pages. */
+	if (parallel)
+		WT_TRET(__sync_work_drain(session, flags));
 	WT_TRET(__wt_page_release(session, walk, flags));
 	WT_TRET(__wt_page_release(session, prev, flags));
 
@@ -347,7 +347,7 @@ __wt_update_obsolete_check(
 	 * trim update lists independently of the page state, ensure there
 	 * is a modify structure.
 	 */
-	if (count > 20 && page->modify != NULL) {
+	if (count > WT_UPDATE_CHAIN_LONG && page->modify != NULL) {
 		page->modify->obsolete_check_txn = txn_global->last_running;
 #ifdef HAVE_TIMESTAMPS
 		if (txn_global->has_pinned_timestamp)
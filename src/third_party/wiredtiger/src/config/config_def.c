@@ -63,6 +63,7 @@ static const WT_CONFIG_CHECK
 static const WT_CONFIG_CHECK
     confchk_wiredtiger_open_checkpoint_subconfigs[] = {
 	{ "log_size", "int", NULL, "min=0,max=2GB", NULL, 0 },
+	{ "threads", "int", NULL, "min=0,max=20", NULL, 0 },
 	{ "wait", "int", NULL, "min=0,max=100000", NULL, 0 },
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
 };
@@ -74,7 +75,7 @@ static const WT_CONFIG_CHECK
 };
 
 static const WT_CONFIG_CHECK
-    confchk_wiredtiger_open_eviction_subconfigs[] = {
+    confchk_WT_CONNECTION_reconfigure_eviction_subconfigs[] = {
 	{ "threads_max", "int", NULL, "min=1,max=20", NULL, 0 },
 	{ "threads_min", "int", NULL, "min=1,max=20", NULL, 0 },
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
@@ -142,14 +143,14 @@ static const WT_CONFIG_CHECK confchk_WT_CONNECTION_reconfigure[] = {
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_checkpoint_subconfigs, 2 },
+	    confchk_wiredtiger_open_checkpoint_subconfigs, 3 },
 	{ "compatibility", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_compatibility_subconfigs, 1 },
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_eviction_subconfigs, 2 },
+	    confchk_WT_CONNECTION_reconfigure_eviction_subconfigs, 2 },
 	{ "eviction_checkpoint_target", "int",
 	    NULL, "min=0,max=10TB",
 	    NULL, 0 },
@@ -187,9 +188,10 @@ static const WT_CONFIG_CHECK confchk_WT_CONNECTION_reconfigure[] = {
 	    NULL, NULL,
 	    confchk_WT_CONNECTION_reconfigure_statistics_log_subconfigs, 5 },
 	{ "timing_stress_for_test", "list",
-	    NULL, "choices=[\"checkpoint_slow\",\"split_race_1\","
-	    "\"split_race_2\",\"split_race_3\",\"split_race_4\","
-	    "\"split_race_5\",\"split_race_6\",\"split_race_7\"]",
+	    NULL, "choices=[\"checkpoint_slow\",\"checkpoint_worker_fail\","
+	    "\"split_race_1\",\"split_race_2\",\"split_race_3\","
+	    "\"split_race_4\",\"split_race_5\",\"split_race_6\","
+	    "\"split_race_7\"]",
 	    NULL, 0 },
 	{ "verbose", "list",
 	    NULL, "choices=[\"api\",\"block\",\"checkpoint\","
@@ -755,6 +757,24 @@ static const WT_CONFIG_CHECK
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
 };
 
+static const WT_CONFIG_CHECK
+    confchk_wiredtiger_open_eviction_subconfigs[] = {
+	{ "threads_max", "int", NULL, "min=1,max=20", NULL, 0 },
+	{ "threads_min", "int", NULL, "min=1,max=20", NULL, 0 },
+	{ "walk_shards", "int", NULL, "min=1,max=16", NULL, 0 },
+	{ NULL, NULL, NULL, NULL, NULL, 0 }
+};
+
+static const WT_CONFIG_CHECK
+    confchk_wiredtiger_open_file_io_subconfigs[] = {
+	{ "io_uring_fail_for_test", "boolean", NULL, NULL, NULL, 0 },
+	{ "method", "string",
+	    NULL, "choices=[\"aio\",\"io_uring\",\"pread\"]",
+	    NULL, 0 },
+	{ "queue_depth", "int", NULL, "min=1,max=4096", NULL, 0 },
+	{ NULL, NULL, NULL, NULL, NULL, 0 }
+};
+
 static const WT_CONFIG_CHECK
     confchk_wiredtiger_open_log_subconfigs[] = {
 	{ "archive", "boolean", NULL, NULL, NULL, 0 },
@@ -770,6 +790,13 @@ static const WT_CONFIG_CHECK
 	{ NULL, NULL, NULL, NULL, NULL, 0 }
 };
 
+static const WT_CONFIG_CHECK
+    confchk_wiredtiger_open_read_ahead_subconfigs[] = {
+	{ "pages", "int", NULL, "min=0,max=64", NULL, 0 },
+	{ "threads", "int", NULL, "min=1,max=20", NULL, 0 },
+	{ NULL, NULL, NULL, NULL, NULL, 0 }
+};
+
 static const WT_CONFIG_CHECK
     confchk_wiredtiger_open_statistics_log_subconfigs[] = {
 	{ "json", "boolean", NULL, NULL, NULL, 0 },
@@ -801,7 +828,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_checkpoint_subconfigs, 2 },
+	    confchk_wiredtiger_open_checkpoint_subconfigs, 3 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "compatibility", "category",
 	    NULL, NULL,
@@ -817,7 +844,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_eviction_subconfigs, 2 },
+	    confchk_wiredtiger_open_eviction_subconfigs, 3 },
 	{ "eviction_checkpoint_target", "int",
 	    NULL, "min=0,max=10TB",
 	    NULL, 0 },
@@ -836,6 +863,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	{ "file_extend", "list",
 	    NULL, "choices=[\"data\",\"log\"]",
 	    NULL, 0 },
+	{ "file_io", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_file_io_subconfigs, 3 },
 	{ "file_manager", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_file_manager_subconfigs, 3 },
@@ -853,6 +883,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	{ "operation_tracking", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_operation_tracking_subconfigs, 2 },
+	{ "read_ahead", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_read_ahead_subconfigs, 2 },
 	{ "readonly", "boolean", NULL, NULL, NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
@@ -868,9 +901,10 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open[] = {
 	    NULL, NULL,
 	    confchk_wiredtiger_open_statistics_log_subconfigs, 6 },
 	{ "timing_stress_for_test", "list",
-	    NULL, "choices=[\"checkpoint_slow\",\"split_race_1\","
-	    "\"split_race_2\",\"split_race_3\",\"split_race_4\","
-	    "\"split_race_5\",\"split_race_6\",\"split_race_7\"]",
+	    NULL, "choices=[\"checkpoint_slow\",\"checkpoint_worker_fail\","
+	    "\"split_race_1\",\"split_race_2\",\"split_race_3\","
+	    "\"split_race_4\",\"split_race_5\",\"split_race_6\","
+	    "\"split_race_7\"]",
 	    NULL, 0 },
 	{ "transaction_sync", "category",
 	    NULL, NULL,
@@ -904,7 +938,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_checkpoint_subconfigs, 2 },
+	    confchk_wiredtiger_open_checkpoint_subconfigs, 3 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "compatibility", "category",
 	    NULL, NULL,
@@ -920,7 +954,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_eviction_subconfigs, 2 },
+	    confchk_wiredtiger_open_eviction_subconfigs, 3 },
 	{ "eviction_checkpoint_target", "int",
 	    NULL, "min=0,max=10TB",
 	    NULL, 0 },
@@ -939,6 +973,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	{ "file_extend", "list",
 	    NULL, "choices=[\"data\",\"log\"]",
 	    NULL, 0 },
+	{ "file_io", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_file_io_subconfigs, 3 },
 	{ "file_manager", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_file_manager_subconfigs, 3 },
@@ -956,6 +993,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	{ "operation_tracking", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_operation_tracking_subconfigs, 2 },
+	{ "read_ahead", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_read_ahead_subconfigs, 2 },
 	{ "readonly", "boolean", NULL, NULL, NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
@@ -971,9 +1011,10 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_all[] = {
 	    NULL, NULL,
 	    confchk_wiredtiger_open_statistics_log_subconfigs, 6 },
 	{ "timing_stress_for_test", "list",
-	    NULL, "choices=[\"checkpoint_slow\",\"split_race_1\","
-	    "\"split_race_2\",\"split_race_3\",\"split_race_4\","
-	    "\"split_race_5\",\"split_race_6\",\"split_race_7\"]",
+	    NULL, "choices=[\"checkpoint_slow\",\"checkpoint_worker_fail\","
+	    "\"split_race_1\",\"split_race_2\",\"split_race_3\","
+	    "\"split_race_4\",\"split_race_5\",\"split_race_6\","
+	    "\"split_race_7\"]",
 	    NULL, 0 },
 	{ "transaction_sync", "category",
 	    NULL, NULL,
@@ -1008,7 +1049,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_checkpoint_subconfigs, 2 },
+	    confchk_wiredtiger_open_checkpoint_subconfigs, 3 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "compatibility", "category",
 	    NULL, NULL,
@@ -1022,7 +1063,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_eviction_subconfigs, 2 },
+	    confchk_wiredtiger_open_eviction_subconfigs, 3 },
 	{ "eviction_checkpoint_target", "int",
 	    NULL, "min=0,max=10TB",
 	    NULL, 0 },
@@ -1040,6 +1081,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	{ "file_extend", "list",
 	    NULL, "choices=[\"data\",\"log\"]",
 	    NULL, 0 },
+	{ "file_io", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_file_io_subconfigs, 3 },
 	{ "file_manager", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_file_manager_subconfigs, 3 },
@@ -1056,6 +1100,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	{ "operation_tracking", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_operation_tracking_subconfigs, 2 },
+	{ "read_ahead", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_read_ahead_subconfigs, 2 },
 	{ "readonly", "boolean", NULL, NULL, NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
@@ -1071,9 +1118,10 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_basecfg[] = {
 	    NULL, NULL,
 	    confchk_wiredtiger_open_statistics_log_subconfigs, 6 },
 	{ "timing_stress_for_test", "list",
-	    NULL, "choices=[\"checkpoint_slow\",\"split_race_1\","
-	    "\"split_race_2\",\"split_race_3\",\"split_race_4\","
-	    "\"split_race_5\",\"split_race_6\",\"split_race_7\"]",
+	    NULL, "choices=[\"checkpoint_slow\",\"checkpoint_worker_fail\","
+	    "\"split_race_1\",\"split_race_2\",\"split_race_3\","
+	    "\"split_race_4\",\"split_race_5\",\"split_race_6\","
+	    "\"split_race_7\"]",
 	    NULL, 0 },
 	{ "transaction_sync", "category",
 	    NULL, NULL,
@@ -1106,7 +1154,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	{ "cache_size", "int", NULL, "min=1MB,max=10TB", NULL, 0 },
 	{ "checkpoint", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_checkpoint_subconfigs, 2 },
+	    confchk_wiredtiger_open_checkpoint_subconfigs, 3 },
 	{ "checkpoint_sync", "boolean", NULL, NULL, NULL, 0 },
 	{ "compatibility", "category",
 	    NULL, NULL,
@@ -1120,7 +1168,7 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	{ "error_prefix", "string", NULL, NULL, NULL, 0 },
 	{ "eviction", "category",
 	    NULL, NULL,
-	    confchk_wiredtiger_open_eviction_subconfigs, 2 },
+	    confchk_wiredtiger_open_eviction_subconfigs, 3 },
 	{ "eviction_checkpoint_target", "int",
 	    NULL, "min=0,max=10TB",
 	    NULL, 0 },
@@ -1138,6 +1186,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	{ "file_extend", "list",
 	    NULL, "choices=[\"data\",\"log\"]",
 	    NULL, 0 },
+	{ "file_io", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_file_io_subconfigs, 3 },
 	{ "file_manager", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_file_manager_subconfigs, 3 },
@@ -1154,6 +1205,9 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	{ "operation_tracking", "category",
 	    NULL, NULL,
 	    confchk_wiredtiger_open_operation_tracking_subconfigs, 2 },
+	{ "read_ahead", "category",
+	    NULL, NULL,
+	    confchk_wiredtiger_open_read_ahead_subconfigs, 2 },
 	{ "readonly", "boolean", NULL, NULL, NULL, 0 },
 	{ "session_max", "int", NULL, "min=1", NULL, 0 },
 	{ "session_scratch_max", "int", NULL, NULL, NULL, 0 },
@@ -1169,9 +1223,10 @@ static const WT_CONFIG_CHECK confchk_wiredtiger_open_usercfg[] = {
 	    NULL, NULL,
 	    confchk_wiredtiger_open_statistics_log_subconfigs, 6 },
 	{ "timing_stress_for_test", "list",
-	    NULL, "choices=[\"checkpoint_slow\",\"split_race_1\","
-	    "\"split_race_2\",\"split_race_3\",\"split_race_4\","
-	    "\"split_race_5\",\"split_race_6\",\"split_race_7\"]",
+	    NULL, "choices=[\"checkpoint_slow\",\"checkpoint_worker_fail\","
+	    "\"split_race_1\",\"split_race_2\",\"split_race_3\","
+	    "\"split_race_4\",\"split_race_5\",\"split_race_6\","
+	    "\"split_race_7\"]",
 	    NULL, 0 },
 	{ "transaction_sync", "category",
 	    NULL, NULL,
@@ -1242,7 +1297,7 @@ static const WT_CONFIG_ENTRY config_entries[] = {
 	},
 	{ "WT_CONNECTION.reconfigure",
 	  "async=(enabled=false,ops_max=1024,threads=2),cache_overhead=8,"
-	  "cache_size=100MB,checkpoint=(log_size=0,wait=0),"
+	  "cache_size=100MB,checkpoint=(log_size=0,threads=0,wait=0),"
 	  "compatibility=(release=),error_prefix=,eviction=(threads_max=8,"
 	  "threads_min=1),eviction_checkpoint_target=5,"
 	  "eviction_dirty_target=5,eviction_dirty_trigger=20,"
@@ -1481,102 +1536,110 @@ static const WT_CONFIG_ENTRY config_entries[] = {
 	{ "wiredtiger_open",
 	  "async=(enabled=false,ops_max=1024,threads=2),buffer_alignment=-1"
 	  ",builtin_extension_config=,cache_cursors=true,cache_overhead=8,"
-	  "cache_size=100MB,checkpoint=(log_size=0,wait=0),"
+	  "cache_size=100MB,checkpoint=(log_size=0,threads=0,wait=0),"
 	  "checkpoint_sync=true,compatibility=(release=),config_base=true,"
 	  "create=false,direct_io=,encryption=(keyid=,name=,secretkey=),"
-	  "error_prefix=,eviction=(threads_max=8,threads_min=1),"
-	  "eviction_checkpoint_target=5,eviction_dirty_target=5,"
-	  "eviction_dirty_trigger=20,eviction_target=80,eviction_trigger=95"
-	  ",exclusive=false,extensions=,file_extend=,"
+	  "error_prefix=,eviction=(threads_max=8,threads_min=1,"
+	  "walk_shards=1),eviction_checkpoint_target=5,"
+	  "eviction_dirty_target=5,eviction_dirty_trigger=20,"
+	  "eviction_target=80,eviction_trigger=95,exclusive=false,"
+	  "extensions=,file_extend=,file_io=(io_uring_fail_for_test=false,"
+	  "method=pread,queue_depth=64),"
 	  "file_manager=(close_handle_minimum=250,close_idle_time=30,"
 	  "close_scan_interval=10),hazard_max=1000,in_memory=false,"
 	  "log=(archive=true,compressor=,enabled=false,file_max=100MB,"
 	  "path=\".\",prealloc=true,recover=on,zero_fill=false),"
 	  "lsm_manager=(merge=true,worker_thread_max=4),lsm_merge=true,"
 	  "mmap=true,multiprocess=false,operation_tracking=(enabled=false,"
-	  "path=\".\"),readonly=false,session_max=100,"
-	  "session_scratch_max=2MB,session_table_cache=true,"
-	  "shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
+	  "path=\".\"),read_ahead=(pages=0,threads=2),readonly=false,"
+	  "session_max=100,session_scratch_max=2MB,session_table_cache=true"
+	  ",shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
 	  "statistics=none,statistics_log=(json=false,on_close=false,"
 	  "path=\".\",sources=,timestamp=\"%b %d %H:%M:%S\",wait=0),"
 	  "timing_stress_for_test=,transaction_sync=(enabled=false,"
 	  "method=fsync),use_environment=true,use_environment_priv=false,"
 	  "verbose=,write_through=",
-	  confchk_wiredtiger_open, 45
+	  confchk_wiredtiger_open, 47
 	},
 	{ "wiredtiger_open_all",
 	  "async=(enabled=false,ops_max=1024,threads=2),buffer_alignment=-1"
 	  ",builtin_extension_config=,cache_cursors=true,cache_overhead=8,"
-	  "cache_size=100MB,checkpoint=(log_size=0,wait=0),"
+	  "cache_size=100MB,checkpoint=(log_size=0,threads=0,wait=0),"
 	  "checkpoint_sync=true,compatibility=(release=),config_base=true,"
 	  "create=false,direct_io=,encryption=(keyid=,name=,secretkey=),"
-	  "error_prefix=,eviction=(threads_max=8,threads_min=1),"
-	  "eviction_checkpoint_target=5,eviction_dirty_target=5,"
-	  "eviction_dirty_trigger=20,eviction_target=80,eviction_trigger=95"
-	  ",exclusive=false,extensions=,file_extend=,"
+	  "error_prefix=,eviction=(threads_max=8,threads_min=1,"
+	  "walk_shards=1),eviction_checkpoint_target=5,"
+	  "eviction_dirty_target=5,eviction_dirty_trigger=20,"
+	  "eviction_target=80,eviction_trigger=95,exclusive=false,"
+	  "extensions=,file_extend=,file_io=(io_uring_fail_for_test=false,"
+	  "method=pread,queue_depth=64),"
 	  "file_manager=(close_handle_minimum=250,close_idle_time=30,"
 	  "close_scan_interval=10),hazard_max=1000,in_memory=false,"
 	  "log=(archive=true,compressor=,enabled=false,file_max=100MB,"
 	  "path=\".\",prealloc=true,recover=on,zero_fill=false),"
 	  "lsm_manager=(merge=true,worker_thread_max=4),lsm_merge=true,"
 	  "mmap=true,multiprocess=false,operation_tracking=(enabled=false,"
-	  "path=\".\"),readonly=false,session_max=100,"
-	  "session_scratch_max=2MB,session_table_cache=true,"
-	  "shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
+	  "path=\".\"),read_ahead=(pages=0,threads=2),readonly=false,"
+	  "session_max=100,session_scratch_max=2MB,session_table_cache=true"
+	  ",shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
 	  "statistics=none,statistics_log=(json=false,on_close=false,"
 	  "path=\".\",sources=,timestamp=\"%b %d %H:%M:%S\",wait=0),"
 	  "timing_stress_for_test=,transaction_sync=(enabled=false,"
 	  "method=fsync),use_environment=true,use_environment_priv=false,"
 	  "verbose=,version=(major=0,minor=0),write_through=",
-	  confchk_wiredtiger_open_all, 46
+	  confchk_wiredtiger_open_all, 48
 	},
 	{ "wiredtiger_open_basecfg",
 	  "async=(enabled=false,ops_max=1024,threads=2),buffer_alignment=-1"
 	  ",builtin_extension_config=,cache_cursors=true,cache_overhead=8,"
-	  "cache_size=100MB,checkpoint=(log_size=0,wait=0),"
+	  "cache_size=100MB,checkpoint=(log_size=0,threads=0,wait=0),"
 	  "checkpoint_sync=true,compatibility=(release=),direct_io=,"
 	  "encryption=(keyid=,name=,secretkey=),error_prefix=,"
-	  "eviction=(threads_max=8,threads_min=1),"
+	  "eviction=(threads_max=8,threads_min=1,walk_shards=1),"
 	  "eviction_checkpoint_target=5,eviction_dirty_target=5,"
 	  "eviction_dirty_trigger=20,eviction_target=80,eviction_trigger=95"
-	  ",extensions=,file_extend=,file_manager=(close_handle_minimum=250"
-	  ",close_idle_time=30,close_scan_interval=10),hazard_max=1000,"
-	  "log=(archive=true,compressor=,enabled=false,file_max=100MB,"
-	  "path=\".\",prealloc=true,recover=on,zero_fill=false),"
+	  ",extensions=,file_extend=,file_io=(io_uring_fail_for_test=false,"
+	  "method=pread,queue_depth=64),"
+	  "file_manager=(close_handle_minimum=250,close_idle_time=30,"
+	  "close_scan_interval=10),hazard_max=1000,log=(archive=true,"
+	  "compressor=,enabled=false,file_max=100MB,path=\".\","
+	  "prealloc=true,recover=on,zero_fill=false),"
 	  "lsm_manager=(merge=true,worker_thread_max=4),lsm_merge=true,"
 	  "mmap=true,multiprocess=false,operation_tracking=(enabled=false,"
-	  "path=\".\"),readonly=false,session_max=100,"
-	  "session_scratch_max=2MB,session_table_cache=true,"
-	  "shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
+	  "path=\".\"),read_ahead=(pages=0,threads=2),readonly=false,"
+	  "session_max=100,session_scratch_max=2MB,session_table_cache=true"
+	  ",shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
 	  "statistics=none,statistics_log=(json=false,on_close=false,"
 	  "path=\".\",sources=,timestamp=\"%b %d %H:%M:%S\",wait=0),"
 	  "timing_stress_for_test=,transaction_sync=(enabled=false,"
 	  "method=fsync),verbose=,version=(major=0,minor=0),write_through=",
-	  confchk_wiredtiger_open_basecfg, 40
+	  confchk_wiredtiger_open_basecfg, 42
 	},
 	{ "wiredtiger_open_usercfg",
 	  "async=(enabled=false,ops_max=1024,threads=2),buffer_alignment=-1"
 	  ",builtin_extension_config=,cache_cursors=true,cache_overhead=8,"
-	  "cache_size=100MB,checkpoint=(log_size=0,wait=0),"
+	  "cache_size=100MB,checkpoint=(log_size=0,threads=0,wait=0),"
 	  "checkpoint_sync=true,compatibility=(release=),direct_io=,"
 	  "encryption=(keyid=,name=,secretkey=),error_prefix=,"
-	  "eviction=(threads_max=8,threads_min=1),"
+	  "eviction=(threads_max=8,threads_min=1,walk_shards=1),"
 	  "eviction_checkpoint_target=5,eviction_dirty_target=5,"
 	  "eviction_dirty_trigger=20,eviction_target=80,eviction_trigger=95"
-	  ",extensions=,file_extend=,file_manager=(close_handle_minimum=250"
-	  ",close_idle_time=30,close_scan_interval=10),hazard_max=1000,"
-	  "log=(archive=true,compressor=,enabled=false,file_max=100MB,"
-	  "path=\".\",prealloc=true,recover=on,zero_fill=false),"
+	  ",extensions=,file_extend=,file_io=(io_uring_fail_for_test=false,"
+	  "method=pread,queue_depth=64),"
+	  "file_manager=(close_handle_minimum=250,close_idle_time=30,"
+	  "close_scan_interval=10),hazard_max=1000,log=(archive=true,"
+	  "compressor=,enabled=false,file_max=100MB,path=\".\","
+	  "prealloc=true,recover=on,zero_fill=false),"
 	  "lsm_manager=(merge=true,worker_thread_max=4),lsm_merge=true,"
 	  "mmap=true,multiprocess=false,operation_tracking=(enabled=false,"
-	  "path=\".\"),readonly=false,session_max=100,"
-	  "session_scratch_max=2MB,session_table_cache=true,"
-	  "shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
+	  "path=\".\"),read_ahead=(pages=0,threads=2),readonly=false,"
+	  "session_max=100,session_scratch_max=2MB,session_table_cache=true"
+	  ",shared_cache=(chunk=10MB,name=,quota=0,reserve=0,size=500MB),"
 	  "statistics=none,statistics_log=(json=false,on_close=false,"
 	  "path=\".\",sources=,timestamp=\"%b %d %H:%M:%S\",wait=0),"
 	  "timing_stress_for_test=,transaction_sync=(enabled=false,"
 	  "method=fsync),verbose=,write_through=",
-	  confchk_wiredtiger_open_usercfg, 39
+	  confchk_wiredtiger_open_usercfg, 41
 	},
 	{ NULL, NULL, NULL, 0 }
 };
@@ -2007,6 +2007,8 @@ __wt_timing_stress_config(WT_SESSION_IMPL *session, const char *cfg[])
 	 */
 	static const WT_NAME_FLAG stress_types[] = {
 		{ "checkpoint_slow",	WT_TIMING_STRESS_CHECKPOINT_SLOW },
+		{ "checkpoint_worker_fail",
+		    WT_TIMING_STRESS_CHECKPOINT_WORKER_FAIL },
 		{ "split_race_1",	WT_TIMING_STRESS_SPLIT_RACE_1 },
 		{ "split_race_2",	WT_TIMING_STRESS_SPLIT_RACE_2 },
 		{ "split_race_3",	WT_TIMING_STRESS_SPLIT_RACE_3 },
@@ -2214,6 +2216,15 @@ __conn_session_size(
 	WT_RET(__wt_config_gets(session, cfg, "eviction.threads_max", &cval));
 	v += cval.val;
 
+	WT_RET(__wt_config_gets(session, cfg, "eviction.walk_shards", &cval));
+	v += cval.val;
+
+	/*
+	 * Checkpoint worker threads can be added by reconfiguration, reserve
+	 * sessions for the most we allow.
+	 */
+	v += WT_CKPT_MAX_WORKERS;
+
 	WT_RET(__wt_config_gets(
 	    session, cfg, "lsm_manager.worker_thread_max", &cval));
 	v += cval.val;
@@ -2349,7 +2360,7 @@ wiredtiger_open(const char *home, WT_EVENT_HANDLER *event_handler,
 	WT_DECL_RET;
 	const WT_NAME_FLAG *ft;
 	WT_SESSION_IMPL *session;
-	bool config_base_set;
+	bool config_base_set, posix_file_system;
 	const char *enc_cfg[] = { NULL, NULL }, *merge_cfg;
 	char version[64];
 
@@ -2362,6 +2373,7 @@ wiredtiger_open(const char *home, WT_EVENT_HANDLER *event_handler,
 	conn = NULL;
 	session = NULL;
 	merge_cfg = NULL;
+	posix_file_system = false;
 
 	WT_RET(__wt_library_init());
 
@@ -2454,7 +2466,10 @@ wiredtiger_open(const char *home, WT_EVENT_HANDLER *event_handler,
 #if defined(_MSC_VER)
 			WT_ERR(__wt_os_win(session));
 #else
+		{
 			WT_ERR(__wt_os_posix(session));
+			posix_file_system = true;
+		}
 #endif
 	}
 	WT_ERR(
@@ -2630,6 +2645,18 @@ wiredtiger_open(const char *home, WT_EVENT_HANDLER *event_handler,
 	WT_ERR(__wt_config_gets(session, cfg, "mmap", &cval));
 	conn->mmap = cval.val != 0;
 
+	/*
+	 * Asynchronous I/O is a feature of our POSIX file system, ignore it if
+	 * the application configured its own file system or we're running in
+	 * memory.
+	 */
+#if defined(_MSC_VER)
+	WT_UNUSED(posix_file_system);
+#else
+	if (posix_file_system)
+		WT_ERR(__wt_posix_file_aio_create(session, cfg));
+#endif
+
 	WT_ERR(__wt_config_gets(session, cfg, "cache_cursors", &cval));
 	if (cval.val)
 		F_SET(conn, WT_CONN_CACHE_CURSORS);
@@ -213,7 +213,10 @@ __wt_cache_create(WT_SESSION_IMPL *session, const char *cfg[])
 {
 	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
+	WT_CONFIG_ITEM cval;
 	WT_DECL_RET;
+	WT_EVICT_SHARD *shard;
+	u_int s;
 	int i;
 
 	conn = S2C(session);
@@ -246,11 +249,28 @@ __wt_cache_create(WT_SESSION_IMPL *session, const char *cfg[])
 	WT_RET(__wt_spin_init(session, &cache->evict_pass_lock, "evict pass"));
 	WT_RET(__wt_spin_init(session,
 	    &cache->evict_queue_lock, "cache eviction queue"));
-	WT_RET(__wt_spin_init(session, &cache->evict_walk_lock, "cache walk"));
-	if ((ret = __wt_open_internal_session(conn, "evict pass",
-	    false, WT_SESSION_NO_DATA_HANDLES, &cache->walk_session)) != 0)
-		WT_RET_MSG(NULL, ret,
-		    "Failed to create session for eviction walks");
+
+	/*
+	 * Each eviction walk shard has its own session: the walk points in
+	 * the shard's trees are hazard pointers held by that session.
+	 */
+	WT_RET(__wt_config_gets(session, cfg, "eviction.walk_shards", &cval));
+	WT_ASSERT(session, cval.val > 0 && cval.val <= WT_EVICT_SHARDS_MAX);
+	WT_RET(__wt_calloc_def(
+	    session, (size_t)cval.val, &cache->evict_shards));
+	cache->evict_shard_count = (u_int)cval.val;
+	for (s = 0; s < cache->evict_shard_count; ++s) {
+		shard = &cache->evict_shards[s];
+		WT_RET(__wt_spin_init(
+		    session, &shard->lock, "cache eviction shard"));
+		WT_RET(__wt_spin_init(
+		    session, &shard->walk_lock, "cache walk"));
+		if ((ret = __wt_open_internal_session(conn, "evict pass",
+		    false, WT_SESSION_NO_DATA_HANDLES,
+		    &shard->walk_session)) != 0)
+			WT_RET_MSG(NULL, ret,
+			    "Failed to create session for eviction walks");
+	}
 
 	WT_RET(__wt_rwlock_init(session, &cache->las_sweepwalk_lock));
 	WT_RET(__wt_spin_init(session, &cache->las_lock, "lookaside table"));
@@ -290,7 +310,8 @@ __wt_cache_stats_update(WT_SESSION_IMPL *session)
 	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
 	WT_CONNECTION_STATS **stats;
-	uint64_t inuse, leaf;
+	uint64_t inuse, leaf, walks;
+	u_int s;
 
 	conn = S2C(session);
 	cache = conn->cache;
@@ -346,11 +367,13 @@ __wt_cache_stats_update(WT_SESSION_IMPL *session)
 
 	/*
 	 * The number of files with active walks ~= number of hazard pointers
-	 * in the walk session.  Note: reading without locking.
+	 * in the walk sessions.  Note: reading without locking.
 	 */
-	if (conn->evict_server_running)
-		WT_STAT_SET(session, stats, cache_eviction_walks_active,
-		    cache->walk_session->nhazard);
+	if (conn->evict_server_running) {
+		for (walks = 0, s = 0; s < cache->evict_shard_count; ++s)
+			walks += cache->evict_shards[s].walk_session->nhazard;
+		WT_STAT_SET(session, stats, cache_eviction_walks_active, walks);
+	}
 }
 
 /*
@@ -363,7 +386,9 @@ __wt_cache_destroy(WT_SESSION_IMPL *session)
 	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
+	WT_EVICT_SHARD *shard;
 	WT_SESSION *wt_session;
+	u_int s;
 	int i;
 
 	conn = S2C(session);
@@ -398,13 +423,19 @@ __wt_cache_destroy(WT_SESSION_IMPL *session)
 	__wt_cond_destroy(session, &cache->evict_cond);
 	__wt_spin_destroy(session, &cache->evict_pass_lock);
 	__wt_spin_destroy(session, &cache->evict_queue_lock);
-	__wt_spin_destroy(session, &cache->evict_walk_lock);
 	__wt_spin_destroy(session, &cache->las_lock);
 	__wt_spin_destroy(session, &cache->las_sweep_lock);
 	__wt_rwlock_destroy(session, &cache->las_sweepwalk_lock);
-	wt_session = &cache->walk_session->iface;
-	if (wt_session != NULL)
-		WT_TRET(wt_session->close(wt_session, NULL));
+	for (s = 0; s < cache->evict_shard_count; ++s) {
+		shard = &cache->evict_shards[s];
+		__wt_spin_destroy(session, &shard->lock);
+		__wt_spin_destroy(session, &shard->walk_lock);
+		if (shard->walk_session != NULL) {
+			wt_session = &shard->walk_session->iface;
+			WT_TRET(wt_session->close(wt_session, NULL));
+		}
+	}
+	__wt_free(session, cache->evict_shards);
 
 	for (i = 0; i < WT_EVICT_QUEUE_MAX; ++i) {
 		__wt_spin_destroy(session, &cache->evict_queues[i].evict_lock);
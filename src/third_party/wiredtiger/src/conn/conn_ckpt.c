@@ -30,6 +30,13 @@ __ckpt_server_config(WT_SESSION_IMPL *session, const char **cfg, bool *startp)
 	WT_RET(__wt_config_gets(session, cfg, "checkpoint.log_size", &cval));
 	conn->ckpt_logsize = (wt_off_t)cval.val;
 
+	/*
+	 * The worker threads run as long as the connection, so they are
+	 * available to application checkpoints as well as the server's.
+	 */
+	WT_RET(__wt_config_gets(session, cfg, "checkpoint.threads", &cval));
+	conn->ckpt_threads_num = (uint32_t)cval.val;
+
 	/*
 	 * The checkpoint configuration requires a wait time and/or a log size,
 	 * if neither is set, we're not running at all. Checkpoints based on log
@@ -187,6 +194,7 @@ int
 __wt_checkpoint_server_create(WT_SESSION_IMPL *session, const char *cfg[])
 {
 	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
 	bool start;
 
 	conn = S2C(session);
@@ -206,6 +214,15 @@ __wt_checkpoint_server_create(WT_SESSION_IMPL *session, const char *cfg[])
 		WT_RET(__wt_checkpoint_server_destroy(session));
 
 	WT_RET(__ckpt_server_config(session, cfg, &start));
+
+	/*
+	 * Start, resize or stop the checkpoint worker threads, they can't
+	 * change while a checkpoint is using them.
+	 */
+	WT_WITH_CHECKPOINT_LOCK(session,
+	    ret = __wt_sync_workers_config(session));
+	WT_RET(ret);
+
 	if (start)
 		WT_RET(__ckpt_server_start(conn));
 
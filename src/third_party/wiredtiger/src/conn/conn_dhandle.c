@@ -698,7 +698,8 @@ __conn_dhandle_remove(WT_SESSION_IMPL *session, bool final)
 
 	WT_ASSERT(session,
 	    F_ISSET(session, WT_SESSION_LOCKED_HANDLE_LIST_WRITE));
-	WT_ASSERT(session, dhandle != conn->cache->walk_tree);
+	WT_ASSERT(session,
+	    dhandle != __wt_evict_shard(conn->cache, dhandle)->walk_tree);
 
 	/* Check if the handle was reacquired by a session while we waited. */
 	if (!final &&
@@ -102,8 +102,10 @@ __wt_connection_close(WT_CONNECTION_IMPL *conn)
 	WT_FULL_BARRIER();
 
 	WT_TRET(__wt_checkpoint_server_destroy(session));
+	WT_TRET(__wt_sync_workers_destroy(session));
 	WT_TRET(__wt_statlog_destroy(session, true));
 	WT_TRET(__wt_sweep_destroy(session));
+	WT_TRET(__wt_read_ahead_destroy(session));
 
 	/* The eviction server is shut down last. */
 	WT_TRET(__wt_evict_destroy(session));
@@ -181,6 +183,11 @@ __wt_connection_close(WT_CONNECTION_IMPL *conn)
 				__wt_free(session, s->hazard);
 			}
 
+#if !defined(_MSC_VER)
+	/* Discard the asynchronous I/O queue, all files are closed. */
+	WT_TRET(__wt_posix_file_aio_destroy(session));
+#endif
+
 	/* Destroy the file-system configuration. */
 	if (conn->file_system != NULL && conn->file_system->terminate != NULL)
 		WT_TRET(conn->file_system->terminate(
@@ -248,6 +255,9 @@ __wt_connection_workers(WT_SESSION_IMPL *session, const char *cfg[])
 	/* Start the handle sweep thread. */
 	WT_RET(__wt_sweep_create(session));
 
+	/* Start the optional read-ahead threads. */
+	WT_RET(__wt_read_ahead_create(session, cfg));
+
 	/* Start the optional async threads. */
 	WT_RET(__wt_async_create(session, cfg));
 
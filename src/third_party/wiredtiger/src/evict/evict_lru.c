@@ -17,8 +17,11 @@ static int  __evict_pass(WT_SESSION_IMPL *);
 static int  __evict_server(WT_SESSION_IMPL *, bool *);
 static void __evict_tune_workers(WT_SESSION_IMPL *session);
 static int  __evict_walk(WT_SESSION_IMPL *, WT_EVICT_QUEUE *);
-static int  __evict_walk_tree(
-    WT_SESSION_IMPL *, WT_EVICT_QUEUE *, u_int, u_int *);
+static int  __evict_walk_shard(
+    WT_SESSION_IMPL *, WT_EVICT_QUEUE *, WT_EVICT_SHARD *);
+static void __evict_walk_shards(WT_SESSION_IMPL *, WT_EVICT_QUEUE *);
+static int  __evict_walk_tree(WT_SESSION_IMPL *,
+    WT_EVICT_QUEUE *, WT_EVICT_SHARD *, u_int, u_int *);
 
 #define	WT_EVICT_HAS_WORKERS(s)				\
 	(S2C(s)->evict_threads.current_threads > 1)
@@ -281,14 +284,10 @@ __wt_evict_thread_run(WT_SESSION_IMPL *session, WT_THREAD *thread)
 	    __wt_spin_trylock(session, &cache->evict_pass_lock) == 0) {
 		/*
 		 * Cannot use WT_WITH_PASS_LOCK because this is a try lock.
-		 * Fix when that is supported.  We set the flag on both sessions
-		 * because we may call clear_walk when we are walking with
-		 * the walk session, locked.
+		 * Fix when that is supported.
 		 */
 		F_SET(session, WT_SESSION_LOCKED_PASS);
-		F_SET(cache->walk_session, WT_SESSION_LOCKED_PASS);
 		ret = __evict_server(session, &did_work);
-		F_CLR(cache->walk_session, WT_SESSION_LOCKED_PASS);
 		F_CLR(session, WT_SESSION_LOCKED_PASS);
 		was_intr = cache->pass_intr != 0;
 		__wt_spin_unlock(session, &cache->evict_pass_lock);
@@ -802,21 +801,27 @@ static int
 __evict_clear_walk(WT_SESSION_IMPL *session)
 {
 	WT_BTREE *btree;
-	WT_CACHE *cache;
 	WT_DECL_RET;
+	WT_EVICT_SHARD *shard;
 	WT_REF *ref;
 
 	btree = S2BT(session);
-	cache = S2C(session)->cache;
+	shard = __wt_evict_shard(S2C(session)->cache, session->dhandle);
 
+	/*
+	 * Holding the pass lock means no walk round is open, but a worker
+	 * thread may still be finishing a walk of the shard: the shard lock
+	 * protects the walk point and the shard's walk session.
+	 */
 	WT_ASSERT(session, F_ISSET(session, WT_SESSION_LOCKED_PASS));
-	if (session->dhandle == cache->walk_tree) {
-		cache->walk_tree = NULL;
-		cache->walk_target = 0;
+	__wt_spin_lock(session, &shard->lock);
+	if (session->dhandle == shard->walk_tree) {
+		shard->walk_tree = NULL;
+		shard->walk_target = 0;
 	}
 
 	if ((ref = btree->evict_ref) == NULL)
-		return (0);
+		goto done;
 
 	WT_STAT_CONN_INCR(session, cache_eviction_walks_abandoned);
 	WT_STAT_DATA_INCR(session, cache_eviction_walks_abandoned);
@@ -827,9 +832,11 @@ __evict_clear_walk(WT_SESSION_IMPL *session)
 	 */
 	btree->evict_ref = NULL;
 
-	WT_WITH_DHANDLE(cache->walk_session, session->dhandle,
-	    (ret = __wt_page_release(cache->walk_session,
+	WT_WITH_DHANDLE(shard->walk_session, session->dhandle,
+	    (ret = __wt_page_release(shard->walk_session,
 	    ref, WT_READ_NO_EVICT)));
+
+done:	__wt_spin_unlock(session, &shard->lock);
 	return (ret);
 }
 
@@ -865,15 +872,17 @@ __wt_evict_file_exclusive_on(WT_SESSION_IMPL *session)
 	WT_CACHE *cache;
 	WT_DECL_RET;
 	WT_EVICT_ENTRY *evict;
+	WT_EVICT_SHARD *shard;
 	u_int i, elem, q;
 
 	btree = S2BT(session);
 	cache = S2C(session)->cache;
+	shard = __wt_evict_shard(cache, session->dhandle);
 
 	/* Hold the walk lock to turn off eviction. */
-	__wt_spin_lock(session, &cache->evict_walk_lock);
+	__wt_spin_lock(session, &shard->walk_lock);
 	if (++btree->evict_disabled > 1) {
-		__wt_spin_unlock(session, &cache->evict_walk_lock);
+		__wt_spin_unlock(session, &shard->walk_lock);
 		return (0);
 	}
 
@@ -914,7 +923,7 @@ __wt_evict_file_exclusive_on(WT_SESSION_IMPL *session)
 	if (0) {
 err:		--btree->evict_disabled;
 	}
-	__wt_spin_unlock(session, &cache->evict_walk_lock);
+	__wt_spin_unlock(session, &shard->walk_lock);
 	return (ret);
 }
 
@@ -1161,20 +1170,28 @@ done:	cache->evict_tune_last_time = current_time;
 static int
 __evict_lru_pages(WT_SESSION_IMPL *session, bool is_server)
 {
+	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
 	WT_DECL_RET;
 	WT_TRACK_OP_DECL;
 
 	WT_TRACK_OP_INIT(session);
 	conn = S2C(session);
+	cache = conn->cache;
 
 	/*
 	 * Reconcile and discard some pages: EBUSY is returned if a page fails
 	 * eviction because it's unavailable, continue in that case.
+	 *
+	 * Worker threads help the eviction server walk trees for candidates
+	 * when it has a walk round open.
 	 */
-	while (F_ISSET(conn, WT_CONN_EVICTION_RUN) && ret == 0)
+	while (F_ISSET(conn, WT_CONN_EVICTION_RUN) && ret == 0) {
+		if (!is_server && cache->evict_walk_queue != NULL)
+			__evict_walk_shards(session, NULL);
 		if ((ret = __evict_page(session, is_server)) == EBUSY)
 			ret = 0;
+	}
 
 	/* If a worker thread found the queue empty, pause. */
 	if (ret == WT_NOTFOUND && !is_server &&
@@ -1244,7 +1261,7 @@ __evict_lru_walk(WT_SESSION_IMPL *session)
 	 * If the walk is interrupted, we still need to sort the queue: the
 	 * next walk assumes there are no entries beyond WT_EVICT_WALK_BASE.
 	 */
-	if ((ret = __evict_walk(cache->walk_session, queue)) == EBUSY)
+	if ((ret = __evict_walk(session, queue)) == EBUSY)
 		ret = 0;
 	WT_ERR_NOTFOUND_OK(ret);
 
@@ -1356,23 +1373,20 @@ err:	WT_TRACK_OP_END(session);
 static int
 __evict_walk(WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue)
 {
-	WT_BTREE *btree;
 	WT_CACHE *cache;
 	WT_CONNECTION_IMPL *conn;
-	WT_DATA_HANDLE *dhandle;
 	WT_DECL_RET;
+	WT_EVICT_SHARD *shard;
 	WT_TRACK_OP_DECL;
-	u_int max_entries, retries, slot, start_slot, total_candidates;
-	bool dhandle_locked, incr;
+	uint64_t round;
+	u_int count, first, i, max_entries, s, slot, span, start_slot;
+	u_int total_candidates, walk_count;
 
 	WT_TRACK_OP_INIT(session);
 
 	conn = S2C(session);
 	cache = conn->cache;
-	btree = NULL;
-	dhandle = NULL;
-	dhandle_locked = incr = false;
-	retries = 0;
+	count = cache->evict_shard_count;
 
 	/*
 	 * Set the starting slot in the queue and the maximum pages added
@@ -1389,6 +1403,178 @@ __evict_walk(WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue)
 	    __wt_cache_pages_inuse(cache) : cache->pages_dirty_leaf);
 	max_entries = WT_MIN(max_entries, 1 + total_candidates / 2);
 
+	/*
+	 * Give each shard of trees walked this round its own range of the free
+	 * slots: shards are walked in parallel, and sorting the queue merges
+	 * the candidates they find by priority.  If there aren't enough free
+	 * slots to go around, walk fewer shards, starting where the last round
+	 * stopped so every shard is walked in turn.  Shards not walked this
+	 * round are marked as done with an empty range.
+	 */
+	round = cache->evict_walk_round + 1;
+	span = max_entries > start_slot ? max_entries - start_slot : 0;
+	walk_count = WT_MIN(count, WT_MAX(1, span / WT_EVICT_SHARD_MIN_SLOTS));
+	first = cache->evict_shard_next;
+	cache->evict_shard_next = (first + walk_count) % count;
+	for (i = 0; i < count; ++i) {
+		shard = &cache->evict_shards[(first + i) % count];
+		if (i < walk_count) {
+			shard->slot_start =
+			    start_slot + (span * i) / walk_count;
+			shard->slot_end =
+			    start_slot + (span * (i + 1)) / walk_count;
+		} else {
+			shard->slot_start = shard->slot_end = start_slot;
+			shard->walk_round = round;
+		}
+		shard->walk_ret = 0;
+	}
+
+	/*
+	 * With more than one shard, open a walk round so worker threads can
+	 * claim shards, and wake any that are waiting for candidates.  The
+	 * server walks whichever shards it can claim itself, then closes the
+	 * round and waits for walks in progress to finish before the queue is
+	 * sorted.
+	 */
+	cache->evict_walk_round = round;
+	if (count > 1) {
+		WT_WRITE_BARRIER();
+		cache->evict_walk_queue = queue;
+		__wt_cond_signal(session, conn->evict_threads.wait_cond);
+	}
+
+	__evict_walk_shards(session, queue);
+
+	if (count > 1) {
+		cache->evict_walk_queue = NULL;
+		WT_FULL_BARRIER();
+		for (s = 0; s < count; ++s) {
+			shard = &cache->evict_shards[s];
+			__wt_spin_lock(session, &shard->lock);
+			__wt_spin_unlock(session, &shard->lock);
+		}
+	}
+
+	/*
+	 * Shards that weren't walked this round (including any whose lock was
+	 * held to clear a walk point) leave their range empty.  Empty slots
+	 * sort to the end of the queue and are trimmed, so the entries cover
+	 * the last slot any shard filled.
+	 */
+	for (s = 0; s < count; ++s) {
+		shard = &cache->evict_shards[s];
+		if (shard->walk_round != round ||
+		    shard->slot_start == shard->slot_end)
+			continue;
+		if (ret == 0 && shard->walk_ret != 0)
+			ret = shard->walk_ret;
+		if (shard->slot > shard->slot_start)
+			slot = WT_MAX(slot, shard->slot);
+	}
+
+	/*
+	 * If we didn't find any entries on a walk when we weren't interrupted,
+	 * let our caller know.
+	 */
+	if (queue->evict_entries == slot && cache->pass_intr == 0)
+		ret = WT_NOTFOUND;
+
+	queue->evict_entries = slot;
+	WT_TRACK_OP_END(session);
+	return (ret);
+}
+
+/*
+ * __evict_walk_shards --
+ *	Walk shards of trees that haven't been walked in the current round.
+ *	The eviction server passes the queue it is filling, worker threads
+ *	find it through the open round.
+ */
+static void
+__evict_walk_shards(WT_SESSION_IMPL *session, WT_EVICT_QUEUE *server_queue)
+{
+	WT_CACHE *cache;
+	WT_EVICT_QUEUE *queue;
+	WT_EVICT_SHARD *shard;
+	WT_SESSION_IMPL *walk_session;
+	uint64_t round;
+	u_int i, s;
+
+	cache = S2C(session)->cache;
+
+	/*
+	 * Start with the shard this thread owns (by session ID), then help
+	 * with any others no thread has claimed.
+	 */
+	for (i = 0; i < cache->evict_shard_count; ++i) {
+		s = (session->id + i) % cache->evict_shard_count;
+		shard = &cache->evict_shards[s];
+		if (shard->walk_round == cache->evict_walk_round ||
+		    __wt_spin_trylock(session, &shard->lock) != 0)
+			continue;
+
+		/*
+		 * The server closes a round before waiting for the shard locks:
+		 * check the round is still open now that we hold the lock.
+		 */
+		if ((queue = server_queue) == NULL) {
+			queue = cache->evict_walk_queue;
+			WT_READ_BARRIER();
+		}
+		round = cache->evict_walk_round;
+		if (queue != NULL && shard->walk_round != round) {
+			shard->walk_round = round;
+			walk_session = shard->walk_session;
+
+			/*
+			 * We set the pass lock flag on the walk session when
+			 * the server walks, because we may call clear_walk
+			 * when we are walking with the walk session, locked.
+			 */
+			if (server_queue != NULL) {
+				F_SET(walk_session, WT_SESSION_LOCKED_PASS);
+				WT_STAT_CONN_INCR(
+				    session, cache_eviction_walk_shards_server);
+			} else
+				WT_STAT_CONN_INCR(
+				    session, cache_eviction_walk_shards_worker);
+			shard->walk_ret =
+			    __evict_walk_shard(walk_session, queue, shard);
+			F_CLR(walk_session, WT_SESSION_LOCKED_PASS);
+		}
+		__wt_spin_unlock(session, &shard->lock);
+	}
+}
+
+/*
+ * __evict_walk_shard --
+ *	Fill in a shard's range of the array by walking the next set of pages
+ *	in the shard's trees.
+ */
+static int
+__evict_walk_shard(
+    WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue, WT_EVICT_SHARD *shard)
+{
+	WT_BTREE *btree;
+	WT_CACHE *cache;
+	WT_CONNECTION_IMPL *conn;
+	WT_DATA_HANDLE *dhandle;
+	WT_DECL_RET;
+	u_int max_entries, retries, slot, start_slot;
+	bool dhandle_locked, incr;
+
+	conn = S2C(session);
+	cache = conn->cache;
+	btree = NULL;
+	dhandle = NULL;
+	dhandle_locked = incr = false;
+	retries = 0;
+
+	/* The slots in the queue this shard fills. */
+	start_slot = slot = shard->slot_start;
+	max_entries = shard->slot_end;
+
 retry:	while (slot < max_entries) {
 		/*
 		 * If another thread is waiting on the eviction server to clear
@@ -1412,11 +1598,11 @@ retry:	while (slot < max_entries) {
 			 * scan last time through.  If we don't have a saved
 			 * handle, start from the beginning of the list.
 			 */
-			if ((dhandle = cache->walk_tree) != NULL)
-				cache->walk_tree = NULL;
+			if ((dhandle = shard->walk_tree) != NULL)
+				shard->walk_tree = NULL;
 			else {
 				dhandle = TAILQ_FIRST(&conn->dhqh);
-				cache->walk_target = 0;
+				shard->walk_target = 0;
 			}
 		} else {
 			if (incr) {
@@ -1424,10 +1610,10 @@ retry:	while (slot < max_entries) {
 				(void)__wt_atomic_subi32(
 				    &dhandle->session_inuse, 1);
 				incr = false;
-				cache->walk_tree = NULL;
+				shard->walk_tree = NULL;
 			}
 			dhandle = TAILQ_NEXT(dhandle, q);
-			cache->walk_target = 0;
+			shard->walk_target = 0;
 		}
 
 		/* If we reach the end of the list, we're done. */
@@ -1439,6 +1625,10 @@ retry:	while (slot < max_entries) {
 		    !F_ISSET(dhandle, WT_DHANDLE_OPEN))
 			continue;
 
+		/* Skip trees that belong to other shards. */
+		if (__wt_evict_shard(cache, dhandle) != shard)
+			continue;
+
 		/* Skip files that don't allow eviction. */
 		btree = dhandle->handle;
 		if (btree->evict_disabled > 0)
@@ -1500,21 +1690,21 @@ retry:	while (slot < max_entries) {
 		 * but won't have a root page.
 		 */
 		if (btree->evict_disabled == 0 &&
-		    !__wt_spin_trylock(session, &cache->evict_walk_lock)) {
+		    !__wt_spin_trylock(session, &shard->walk_lock)) {
 			if (btree->evict_disabled == 0 &&
 			    btree->root.page != NULL) {
 				/*
 				 * Remember the file to visit first, next loop.
 				 */
-				cache->walk_tree = dhandle;
+				shard->walk_tree = dhandle;
 				WT_WITH_DHANDLE(session, dhandle,
-				    ret = __evict_walk_tree(
-				    session, queue, max_entries, &slot));
+				    ret = __evict_walk_tree(session,
+				    queue, shard, max_entries, &slot));
 
 				WT_ASSERT(session, __wt_session_gen(
 				    session, WT_GEN_SPLIT) == 0);
 			}
-			__wt_spin_unlock(session, &cache->evict_walk_lock);
+			__wt_spin_unlock(session, &shard->walk_lock);
 			WT_ERR(ret);
 		}
 	}
@@ -1532,7 +1722,7 @@ retry:	while (slot < max_entries) {
 	 */
 	if (slot < max_entries && (retries < 2 ||
 	    (retries < WT_RETRY_MAX &&
-	    (slot == queue->evict_entries || slot > start_slot)))) {
+	    (slot == shard->slot_start || slot > start_slot)))) {
 		start_slot = slot;
 		++retries;
 		goto retry;
@@ -1541,15 +1731,7 @@ retry:	while (slot < max_entries) {
 err:	if (dhandle_locked)
 		__wt_readunlock(session, &conn->dhandle_lock);
 
-	/*
-	 * If we didn't find any entries on a walk when we weren't interrupted,
-	 * let our caller know.
-	 */
-	if (queue->evict_entries == slot && cache->pass_intr == 0)
-		ret = WT_NOTFOUND;
-
-	queue->evict_entries = slot;
-	WT_TRACK_OP_END(session);
+	shard->slot = slot;
 	return (ret);
 }
 
@@ -1561,6 +1743,7 @@ static bool
 __evict_push_candidate(WT_SESSION_IMPL *session,
     WT_EVICT_QUEUE *queue, WT_EVICT_ENTRY *evict, WT_REF *ref)
 {
+	uint32_t max;
 	uint8_t orig_flags, new_flags;
 	u_int slot;
 
@@ -1574,10 +1757,14 @@ __evict_push_candidate(WT_SESSION_IMPL *session,
 	    !__wt_atomic_cas8(&ref->page->flags_atomic, orig_flags, new_flags))
 		return (false);
 
-	/* Keep track of the maximum slot we are using. */
+	/*
+	 * Keep track of the maximum slot we are using.  Shards of trees can be
+	 * walked into the same queue concurrently, don't lose an update.
+	 */
 	slot = (u_int)(evict - queue->evict_queue);
-	if (slot >= queue->evict_max)
-		queue->evict_max = slot + 1;
+	while ((max = queue->evict_max) <= slot &&
+	    !__wt_atomic_casv32(&queue->evict_max, max, slot + 1))
+		;
 
 	if (evict->ref != NULL)
 		__evict_list_clear(session, evict);
@@ -1601,17 +1788,14 @@ __evict_push_candidate(WT_SESSION_IMPL *session,
  *	Calculate how many pages to queue for a given tree.
  */
 static uint32_t
-__evict_walk_target(
-    WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue, u_int max_entries)
+__evict_walk_target(WT_SESSION_IMPL *session, uint32_t total_slots)
 {
 	WT_CACHE *cache;
 	uint64_t btree_inuse, bytes_per_slot, cache_inuse;
 	uint32_t target_pages_clean, target_pages_dirty, target_pages;
-	uint32_t total_slots;
 
 	cache = S2C(session)->cache;
 	target_pages_clean = target_pages_dirty = 0;
-	total_slots = max_entries - queue->evict_entries;
 
 	/*
 	 * The number of times we should fill the queue by the end of
@@ -1689,8 +1873,8 @@ __evict_walk_target(
  *	Get a few page eviction candidates from a single underlying file.
  */
 static int
-__evict_walk_tree(WT_SESSION_IMPL *session,
-    WT_EVICT_QUEUE *queue, u_int max_entries, u_int *slotp)
+__evict_walk_tree(WT_SESSION_IMPL *session, WT_EVICT_QUEUE *queue,
+    WT_EVICT_SHARD *shard, u_int max_entries, u_int *slotp)
 {
 	WT_BTREE *btree;
 	WT_CACHE *cache;
@@ -1717,13 +1901,13 @@ __evict_walk_tree(WT_SESSION_IMPL *session,
 	 */
 	start = queue->evict_queue + *slotp;
 	remaining_slots = max_entries - *slotp;
-	if (cache->walk_target != 0) {
-		WT_ASSERT(session, cache->walk_progress <= cache->walk_target);
-		target_pages = cache->walk_target - cache->walk_progress;
+	if (shard->walk_target != 0) {
+		WT_ASSERT(session, shard->walk_progress <= shard->walk_target);
+		target_pages = shard->walk_target - shard->walk_progress;
 	} else {
-		target_pages = cache->walk_target =
-		    __evict_walk_target(session, queue, max_entries);
-		cache->walk_progress = 0;
+		target_pages = shard->walk_target = __evict_walk_target(
+		    session, shard->slot_end - shard->slot_start);
+		shard->walk_progress = 0;
 	}
 
 	if (target_pages > remaining_slots)
@@ -2017,7 +2201,7 @@ fast:		/* If the page can't be evicted, give up. */
 			continue;
 		++evict;
 		++pages_queued;
-		++cache->walk_progress;
+		++shard->walk_progress;
 
 		__wt_verbose(session, WT_VERB_EVICTSERVER,
 		    "select: %p, size %" WT_SIZET_FMT,
@@ -2067,8 +2251,7 @@ fast:		/* If the page can't be evicted, give up. */
 			if (restarts == 0)
 				WT_STAT_CONN_INCR(
 				    session, cache_eviction_walks_abandoned);
-			WT_RET(__wt_page_release(
-			    cache->walk_session, ref, walk_flags));
+			WT_RET(__wt_page_release(session, ref, walk_flags));
 			ref = NULL;
 		} else
 			while (ref != NULL && (ref->state != WT_REF_MEM ||
@@ -2346,6 +2529,7 @@ __wt_cache_eviction_worker(
 	WT_TXN_GLOBAL *txn_global;
 	WT_TXN_STATE *txn_state;
 	uint64_t initial_progress, max_progress, time_start, time_stop;
+	uint64_t elapsed, wait_start;
 	bool timer;
 
 	WT_TRACK_OP_INIT(session);
@@ -2428,9 +2612,15 @@ __wt_cache_eviction_worker(
 			break;
 		case WT_NOTFOUND:
 			/* Allow the queue to re-populate before retrying. */
+			wait_start = timer ? __wt_clock(session) : 0;
 			__wt_cond_wait(session,
 			    conn->evict_threads.wait_cond, 10000, NULL);
 			cache->app_waits++;
+			if (timer)
+				WT_STAT_CONN_INCRV(session,
+				    application_evict_wait_time,
+				    WT_CLOCKDIFF_US(
+				    __wt_clock(session), wait_start));
 			break;
 		default:
 			goto err;
@@ -2439,9 +2629,23 @@ __wt_cache_eviction_worker(
 
 err:	if (timer) {
 		time_stop = __wt_clock(session);
-		WT_STAT_CONN_INCRV(session,
-		    application_cache_time,
-		    WT_CLOCKDIFF_US(time_stop, time_start));
+		elapsed = WT_CLOCKDIFF_US(time_stop, time_start);
+		WT_STAT_CONN_INCRV(session, application_cache_time, elapsed);
+		if (elapsed < 100)
+			WT_STAT_CONN_INCR(
+			    session, cache_eviction_app_time_lt100);
+		else if (elapsed < WT_THOUSAND)
+			WT_STAT_CONN_INCR(
+			    session, cache_eviction_app_time_lt1000);
+		else if (elapsed < 10 * WT_THOUSAND)
+			WT_STAT_CONN_INCR(
+			    session, cache_eviction_app_time_lt10000);
+		else if (elapsed < 100 * WT_THOUSAND)
+			WT_STAT_CONN_INCR(
+			    session, cache_eviction_app_time_lt100000);
+		else
+			WT_STAT_CONN_INCR(
+			    session, cache_eviction_app_time_ge100000);
 	}
 
 done:	WT_TRACK_OP_END(session);
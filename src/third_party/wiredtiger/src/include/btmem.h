@@ -1075,6 +1075,13 @@ struct __wt_update {
  */
 #define	WT_MAX_MODIFY_UPDATE	10
 
+/*
+ * WT_UPDATE_CHAIN_LONG --
+ *	Update chains longer than this are candidates for discarding obsolete
+ * updates outside of the normal update path.
+ */
+#define	WT_UPDATE_CHAIN_LONG	20
+
 /*
  * WT_INSERT --
  *
@@ -150,6 +150,7 @@ struct __wt_btree {
 	u_int	 block_header;		/* WT_PAGE_HEADER_BYTE_SIZE */
 
 	uint64_t write_gen;		/* Write generation */
+	WT_SPINLOCK rec_max_lock;	/* Lock for maximum txn/timestamp */
 	uint64_t rec_max_txn;		/* Maximum txn seen (clean trees) */
 	WT_DECL_TIMESTAMP(rec_max_timestamp)
 
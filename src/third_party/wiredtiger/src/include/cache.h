@@ -46,6 +46,28 @@ struct __wt_evict_queue {
 	volatile uint32_t evict_max;	/* LRU maximum eviction slot used */
 };
 
+/*
+ * WT_EVICT_SHARD --
+ *	A subset of the trees in the cache, walked for eviction candidates by
+ * one thread at a time.
+ */
+struct __wt_evict_shard {
+	WT_SPINLOCK lock;		/* Shard walk lock */
+	WT_SPINLOCK walk_lock;		/* Exclusive tree access */
+
+	WT_SESSION_IMPL *walk_session;	/* Walk session */
+	WT_DATA_HANDLE *walk_tree;	/* LRU walk current tree */
+	uint32_t walk_progress, walk_target;/* Progress in current tree */
+
+	uint64_t walk_round;		/* Last round walked */
+	u_int	 slot_start, slot_end;	/* Queue slots for this round */
+	u_int	 slot;			/* Next free slot */
+	int	 walk_ret;		/* Result of the last walk */
+};
+
+#define	WT_EVICT_SHARDS_MAX	16	/* Maximum walk shards */
+#define	WT_EVICT_SHARD_MIN_SLOTS 10	/* Minimum slots per shard walk */
+
 /* Cache operations. */
 typedef enum __wt_cache_op {
 	WT_SYNC_CHECKPOINT,
@@ -54,6 +76,50 @@ typedef enum __wt_cache_op {
 	WT_SYNC_WRITE_LEAVES
 } WT_CACHE_OP;
 
+/*
+ * WT_READ_AHEAD_ENTRY --
+ *	A leaf page block queued for, or read by, a read-ahead thread.
+ */
+struct __wt_read_ahead_entry {
+	WT_BTREE *btree;		/* Enclosing btree */
+	uint64_t  seq;			/* Queue order */
+	uint64_t  read_time;		/* Time the image was read */
+	WT_ITEM	  image;		/* Page image, once read */
+
+	size_t	  addr_size;		/* Block address cookie */
+	uint8_t	  addr[WT_BTREE_MAX_ADDR_COOKIE];
+
+#define	WT_READ_AHEAD_EMPTY	0	/* Slot is free */
+#define	WT_READ_AHEAD_QUEUED	1	/* Waiting for a read-ahead thread */
+#define	WT_READ_AHEAD_READING	2	/* Being read */
+#define	WT_READ_AHEAD_READY	3	/* Image waiting for a cursor */
+	volatile uint32_t state;
+};
+
+/*
+ * WT_READ_AHEAD_BUCKET --
+ *	The read-ahead entries a block address cookie hashes to.
+ */
+#define	WT_READ_AHEAD_BUCKET_SLOTS	4
+struct __wt_read_ahead_bucket {
+	WT_SPINLOCK lock;		/* Entry lock */
+
+	WT_READ_AHEAD_ENTRY entries[WT_READ_AHEAD_BUCKET_SLOTS];
+};
+
+/*
+ * WT_READ_AHEAD --
+ *	Leaf pages read ahead of sequential cursor scans.
+ */
+struct __wt_read_ahead {
+	uint32_t pages;			/* Pages read ahead of a scan */
+
+	WT_READ_AHEAD_BUCKET *buckets;	/* Queued and ready pages */
+	uint32_t bucket_count;
+	volatile uint32_t entries_inuse;/* Entries that aren't empty */
+	uint64_t seq;			/* Next queue order */
+};
+
 /*
  * WiredTiger cache structure.
  */
@@ -103,7 +169,6 @@ struct __wt_cache {
 	 * Eviction thread information.
 	 */
 	WT_CONDVAR *evict_cond;		/* Eviction server condition */
-	WT_SPINLOCK evict_walk_lock;	/* Eviction walk location */
 
 	/*
 	 * Eviction threshold percentages use double type to allow for
@@ -143,9 +208,18 @@ struct __wt_cache {
 	 * LRU eviction list information.
 	 */
 	WT_SPINLOCK evict_pass_lock;	/* Eviction pass lock */
-	WT_SESSION_IMPL *walk_session;	/* Eviction pass session */
-	WT_DATA_HANDLE *walk_tree;	/* LRU walk current tree */
-	uint32_t walk_progress, walk_target;/* Progress in current tree */
+
+	/*
+	 * Trees are split into shards, each with its own walk state. When
+	 * there is more than one shard, the eviction server opens a walk
+	 * round for the queue being filled and worker threads walk shards
+	 * into separate ranges of its slots.
+	 */
+	WT_EVICT_SHARD *evict_shards;	/* Eviction walk shards */
+	u_int evict_shard_count;	/* Eviction walk shard count */
+	u_int evict_shard_next;		/* Next shard to walk */
+	WT_EVICT_QUEUE * volatile evict_walk_queue;/* Queue being walked */
+	volatile uint64_t evict_walk_round;/* Current walk round */
 
 	WT_SPINLOCK evict_queue_lock;	/* Eviction current queue lock */
 	WT_EVICT_QUEUE evict_queues[WT_EVICT_QUEUE_MAX];
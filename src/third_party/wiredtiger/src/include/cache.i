@@ -105,6 +105,17 @@ __wt_page_evict_soon(WT_SESSION_IMPL *session, WT_REF *ref)
 	ref->page->read_gen = WT_READGEN_OLDEST;
 }
 
+/*
+ * __wt_evict_shard --
+ *	Return the eviction walk shard a data handle belongs to.
+ */
+static inline WT_EVICT_SHARD *
+__wt_evict_shard(WT_CACHE *cache, WT_DATA_HANDLE *dhandle)
+{
+	return (&cache->evict_shards[
+	    dhandle->name_hash % cache->evict_shard_count]);
+}
+
 /*
  * __wt_cache_pages_inuse --
  *	Return the number of pages in use.
@@ -29,6 +29,29 @@ struct __wt_process {
 };
 extern WT_PROCESS __wt_process;
 
+/*
+ * WT_CKPT_WORK --
+ *	Dirty leaf pages a checkpoint has queued for its worker threads.
+ */
+struct __wt_ckpt_work {
+	WT_SPINLOCK	 lock;		/* Queue lock */
+	WT_CONDVAR	*done_cond;	/* Signalled when the queue drains */
+
+	WT_DATA_HANDLE	*dhandle;	/* Tree being checkpointed */
+	WT_TXN		*txn;		/* Checkpoint transaction */
+
+	WT_REF	       **refs;		/* Queued pages */
+	size_t		 refs_allocated;
+	uint32_t	 refs_max;	/* Pages queued before a drain */
+
+	uint64_t	 batch;		/* Queue drain generation */
+	uint32_t	 entries;	/* Pages in the queue */
+	uint32_t	 next;		/* Next page to claim */
+	volatile uint32_t done;		/* Pages written */
+	volatile bool	 running;	/* Workers may claim pages */
+	int		 ret;		/* First error */
+};
+
 /*
  * WT_KEYED_ENCRYPTOR --
  *	An list entry for an encryptor with a unique (name, keyid).
@@ -273,6 +296,11 @@ struct __wt_connection_impl {
 	uint64_t ckpt_write_bytes;
 	uint64_t ckpt_write_pages;
 
+#define	WT_CKPT_MAX_WORKERS	20
+	WT_THREAD_GROUP  ckpt_threads;	/* Checkpoint worker threads */
+	uint32_t	 ckpt_threads_num;/* Configured worker threads */
+	WT_CKPT_WORK	 ckpt_work;	/* Checkpoint worker page queue */
+
 	uint32_t stat_flags;		/* Options declared in flags.py */
 
 					/* Connection statistics */
@@ -294,6 +322,10 @@ struct __wt_connection_impl {
 	uint32_t	 evict_threads_max;/* Max eviction threads */
 	uint32_t	 evict_threads_min;/* Min eviction threads */
 
+	WT_READ_AHEAD	 read_ahead;	/* Read-ahead queue */
+	WT_THREAD_GROUP  read_ahead_threads;
+	uint32_t	 read_ahead_threads_num;/* Read-ahead threads */
+
 #define	WT_STATLOG_FILENAME	"WiredTigerStat.%d.%H"
 	WT_SESSION_IMPL *stat_session;	/* Statistics log session */
 	wt_thread_t	 stat_tid;	/* Statistics log thread */
@@ -396,6 +428,7 @@ struct __wt_connection_impl {
 /* AUTOMATIC FLAG VALUE GENERATION STOP */
 	uint64_t direct_io;		/* O_DIRECT, FILE_FLAG_NO_BUFFERING */
 	uint64_t write_through;		/* FILE_FLAG_WRITE_THROUGH */
+	void	*file_aio;		/* Asynchronous data file I/O queue */
 
 	bool	 mmap;			/* mmap configuration */
 	int page_size;			/* OS page size for mmap alignment */
@@ -442,14 +475,15 @@ struct __wt_connection_impl {
 	 * delays have been requested.
 	 */
 /* AUTOMATIC FLAG VALUE GENERATION START */
-#define	WT_TIMING_STRESS_CHECKPOINT_SLOW	0x01u
-#define	WT_TIMING_STRESS_SPLIT_RACE_1		0x02u
-#define	WT_TIMING_STRESS_SPLIT_RACE_2		0x04u
-#define	WT_TIMING_STRESS_SPLIT_RACE_3		0x08u
-#define	WT_TIMING_STRESS_SPLIT_RACE_4		0x10u
-#define	WT_TIMING_STRESS_SPLIT_RACE_5		0x20u
-#define	WT_TIMING_STRESS_SPLIT_RACE_6		0x40u
-#define	WT_TIMING_STRESS_SPLIT_RACE_7		0x80u
+#define	WT_TIMING_STRESS_CHECKPOINT_SLOW	0x001u
+#define	WT_TIMING_STRESS_CHECKPOINT_WORKER_FAIL	0x002u
+#define	WT_TIMING_STRESS_SPLIT_RACE_1		0x004u
+#define	WT_TIMING_STRESS_SPLIT_RACE_2		0x008u
+#define	WT_TIMING_STRESS_SPLIT_RACE_3		0x010u
+#define	WT_TIMING_STRESS_SPLIT_RACE_4		0x020u
+#define	WT_TIMING_STRESS_SPLIT_RACE_5		0x040u
+#define	WT_TIMING_STRESS_SPLIT_RACE_6		0x080u
+#define	WT_TIMING_STRESS_SPLIT_RACE_7		0x100u
 /* AUTOMATIC FLAG VALUE GENERATION STOP */
 	uint64_t timing_stress_flags;
 
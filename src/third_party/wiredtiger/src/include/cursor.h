@@ -117,6 +117,14 @@ struct __wt_cursor_btree {
 
 	uint32_t page_deleted_count;	/* Deleted items on the page */
 
+	/*
+	 * Sequential scan tracking for read-ahead: the last leaf page a
+	 * forward scan moved to and how many leaf pages in a row it has
+	 * walked. The reference is only compared, never dereferenced.
+	 */
+	WT_REF	*read_ahead_ref;
+	uint32_t read_ahead_count;
+
 	uint64_t recno;			/* Record number */
 
 	/*
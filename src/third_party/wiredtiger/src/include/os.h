@@ -140,6 +140,7 @@ struct __wt_file_handle_posix {
 	int	 fd;				/* POSIX file handle */
 
 	bool	 direct_io;			/* O_DIRECT configured */
+	bool	 file_aio;			/* Asynchronous I/O queue */
 };
 #endif
 
@@ -336,6 +336,10 @@ struct __wt_connection_stats {
 	int64_t async_op_remove;
 	int64_t async_op_search;
 	int64_t async_op_update;
+	int64_t block_aio_wait;
+	int64_t block_aio_queue_full;
+	int64_t block_aio_submit;
+	int64_t block_aio_queued;
 	int64_t block_preload;
 	int64_t block_read;
 	int64_t block_write;
@@ -344,6 +348,11 @@ struct __wt_connection_stats {
 	int64_t block_byte_write_checkpoint;
 	int64_t block_map_read;
 	int64_t block_byte_map_read;
+	int64_t cache_eviction_app_time_lt100;
+	int64_t cache_eviction_app_time_lt10000;
+	int64_t cache_eviction_app_time_lt100000;
+	int64_t cache_eviction_app_time_lt1000;
+	int64_t cache_eviction_app_time_ge100000;
 	int64_t cache_read_app_count;
 	int64_t cache_read_app_time;
 	int64_t cache_write_app_count;
@@ -367,6 +376,8 @@ struct __wt_connection_stats {
 	int64_t cache_eviction_server_slept;
 	int64_t cache_eviction_slow;
 	int64_t cache_eviction_state;
+	int64_t cache_eviction_walk_shards_worker;
+	int64_t cache_eviction_walk_shards_server;
 	int64_t cache_eviction_target_page_lt10;
 	int64_t cache_eviction_target_page_lt32;
 	int64_t cache_eviction_target_page_ge128;
@@ -415,9 +426,15 @@ struct __wt_connection_stats {
 	int64_t cache_eviction_force_delete;
 	int64_t cache_eviction_force_delete_time;
 	int64_t cache_eviction_app;
+	int64_t cache_read_ahead_skip_pressure;
+	int64_t cache_read_ahead_skip_full;
 	int64_t cache_eviction_pages_queued;
+	int64_t cache_read_ahead_queued;
 	int64_t cache_eviction_pages_queued_urgent;
 	int64_t cache_eviction_pages_queued_oldest;
+	int64_t cache_read_ahead_waste;
+	int64_t cache_read_ahead_hit;
+	int64_t cache_read_ahead;
 	int64_t cache_read;
 	int64_t cache_read_deleted;
 	int64_t cache_read_deleted_prepared;
@@ -574,11 +591,16 @@ struct __wt_connection_stats {
 	int64_t perf_hist_opwrite_latency_lt10000;
 	int64_t perf_hist_opwrite_latency_gt10000;
 	int64_t rec_page_delete_fast;
+	int64_t rec_update_obsolete;
 	int64_t rec_pages;
 	int64_t rec_pages_eviction;
 	int64_t rec_page_delete;
 	int64_t rec_split_stashed_bytes;
 	int64_t rec_split_stashed_objects;
+	int64_t rec_update_chain_lt10;
+	int64_t rec_update_chain_lt100;
+	int64_t rec_update_chain_lt1000;
+	int64_t rec_update_chain_ge1000;
 	int64_t session_cursor_open;
 	int64_t session_open;
 	int64_t session_table_alter_fail;
@@ -605,6 +627,7 @@ struct __wt_connection_stats {
 	int64_t thread_write_active;
 	int64_t application_evict_time;
 	int64_t application_cache_time;
+	int64_t application_evict_wait_time;
 	int64_t txn_release_blocked;
 	int64_t conn_close_blocked_lsm;
 	int64_t dhandle_lock_blocked;
@@ -647,11 +670,15 @@ struct __wt_connection_stats {
 	int64_t txn_checkpoint_running;
 	int64_t txn_checkpoint_generation;
 	int64_t txn_checkpoint_time_max;
+	int64_t txn_checkpoint_metadata_recent;
 	int64_t txn_checkpoint_time_min;
 	int64_t txn_checkpoint_time_recent;
+	int64_t txn_checkpoint_worker_pages;
+	int64_t txn_checkpoint_prep_recent;
 	int64_t txn_checkpoint_scrub_target;
 	int64_t txn_checkpoint_scrub_time;
 	int64_t txn_checkpoint_time_total;
+	int64_t txn_checkpoint_tree_recent;
 	int64_t txn_checkpoint;
 	int64_t txn_checkpoint_skipped;
 	int64_t txn_fail_cache;
@@ -807,11 +834,16 @@ struct __wt_dsrc_stats {
 	int64_t rec_multiblock_leaf;
 	int64_t rec_overflow_key_leaf;
 	int64_t rec_multiblock_max;
+	int64_t rec_update_obsolete;
 	int64_t rec_overflow_value;
 	int64_t rec_page_match;
 	int64_t rec_pages;
 	int64_t rec_pages_eviction;
 	int64_t rec_page_delete;
+	int64_t rec_update_chain_lt10;
+	int64_t rec_update_chain_lt100;
+	int64_t rec_update_chain_lt1000;
+	int64_t rec_update_chain_ge1000;
 	int64_t session_cursor_cached;
 	int64_t session_compact;
 	int64_t session_cursor_open;
@@ -103,6 +103,8 @@ struct __wt_cell_unpack;
     typedef struct __wt_cell_unpack WT_CELL_UNPACK;
 struct __wt_ckpt;
     typedef struct __wt_ckpt WT_CKPT;
+struct __wt_ckpt_work;
+    typedef struct __wt_ckpt_work WT_CKPT_WORK;
 struct __wt_col;
     typedef struct __wt_col WT_COL;
 struct __wt_col_rle;
@@ -173,6 +175,8 @@ struct __wt_evict_entry;
     typedef struct __wt_evict_entry WT_EVICT_ENTRY;
 struct __wt_evict_queue;
     typedef struct __wt_evict_queue WT_EVICT_QUEUE;
+struct __wt_evict_shard;
+    typedef struct __wt_evict_shard WT_EVICT_SHARD;
 struct __wt_ext;
     typedef struct __wt_ext WT_EXT;
 struct __wt_extlist;
@@ -269,6 +273,12 @@ struct __wt_page_modify;
     typedef struct __wt_page_modify WT_PAGE_MODIFY;
 struct __wt_process;
     typedef struct __wt_process WT_PROCESS;
+struct __wt_read_ahead;
+    typedef struct __wt_read_ahead WT_READ_AHEAD;
+struct __wt_read_ahead_bucket;
+    typedef struct __wt_read_ahead_bucket WT_READ_AHEAD_BUCKET;
+struct __wt_read_ahead_entry;
+    typedef struct __wt_read_ahead_entry WT_READ_AHEAD_ENTRY;
 struct __wt_ref;
     typedef struct __wt_ref WT_REF;
 struct __wt_row;
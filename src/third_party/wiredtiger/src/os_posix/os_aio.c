@@ -0,0 +1,786 @@
+/*-
+ * Copyright (c) 2014-2018 MongoDB, Inc.
+ * Copyright (c) 2008-2014 WiredTiger, Inc.
+ *	All rights reserved.
+ *
+ * See the file LICENSE for redistribution information.
+ */
+
+#include "wt_internal.h"
+
+#if defined(__linux__)
+#ifdef HAVE_LINUX_AIO_ABI_H
+#include <linux/aio_abi.h>
+#endif
+#ifdef HAVE_LINUX_IO_URING_H
+#include <linux/io_uring.h>
+#endif
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+/*
+ * Asynchronous data file I/O.
+ *
+ * The block manager's callers read and write one block at a time through the
+ * synchronous WT_FILE_HANDLE interface, but with eviction, checkpoint and
+ * read-ahead worker threads many of those calls are in flight at once. When
+ * configured, POSIX data file reads and writes are queued to a single
+ * connection-wide kernel queue, either an io_uring or a Linux native AIO
+ * context, and the calling thread waits for its own completion.
+ *
+ * Queueing is separate from submission: a thread queues its request and then
+ * submits everything queued and not yet submitted, so requests queued by other
+ * threads in the meantime go to the kernel in the same system call, and a
+ * thread that finds its request already submitted skips the call. Completions
+ * are reaped by whichever waiting thread holds the reap lock, in batches, and
+ * handed back to their owners.
+ *
+ * Linux native AIO is only asynchronous for files opened for direct I/O, other
+ * files continue to use pread and pwrite with that method.
+ */
+
+#define	WT_FILE_AIO_AIO		1		/* Linux native AIO */
+#define	WT_FILE_AIO_URING	2		/* io_uring */
+
+/*
+ * WT_FILE_AIO_REQ --
+ *	A single queued read or write, owned by the thread waiting for it.
+ */
+typedef struct {
+#if defined(__linux__)
+	struct iovec iov;			/* io_uring buffer */
+#ifdef HAVE_LINUX_AIO_ABI_H
+	struct iocb iocb;			/* Linux AIO control block */
+#endif
+#endif
+	int64_t res;				/* Bytes transferred, -errno */
+	volatile bool done;			/* Request complete */
+} WT_FILE_AIO_REQ;
+
+/*
+ * WT_FILE_AIO --
+ *	Connection-wide asynchronous I/O queue.
+ */
+typedef struct {
+	int	 method;			/* WT_FILE_AIO_XXX */
+	uint32_t depth;				/* Maximum requests in flight */
+	volatile uint32_t inflight;		/* Requests in flight */
+
+	WT_SPINLOCK submit_lock;		/* Queue and submit requests */
+	WT_SPINLOCK reap_lock;			/* Reap completions */
+
+	/* io_uring. */
+	int	 ring_fd;			/* Ring file descriptor */
+	void	*sq_ring, *cq_ring, *sqes;	/* Mapped rings */
+	size_t	 sq_ring_size, cq_ring_size, sqes_size;
+	volatile uint32_t *sq_head, *sq_tail, *cq_head, *cq_tail;
+	uint32_t sq_mask, cq_mask;
+	uint32_t *sq_array;
+	void	*cqes;
+
+	/* Linux native AIO. */
+	uint64_t aio_ctx;			/* AIO context */
+	void	**pending;			/* Queued, not yet submitted */
+	uint32_t pending_cnt;
+	void	*events;			/* Completion events */
+} WT_FILE_AIO;
+
+#if defined(__linux__) && \
+    defined(HAVE_LINUX_IO_URING_H) && defined(SYS_io_uring_setup)
+#define	WT_HAVE_FILE_AIO_URING	1
+
+/*
+ * __uring_enter --
+ *	io_uring_enter system call.
+ */
+static int
+__uring_enter(WT_FILE_AIO *aio,
+    uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+	WT_DECL_RET;
+
+	WT_SYSCALL_RETRY(syscall(SYS_io_uring_enter, aio->ring_fd,
+	    to_submit, min_complete, flags, NULL, 0) < 0 ? -1 : 0, ret);
+	return (ret);
+}
+
+/*
+ * __uring_open --
+ *	Create and map an io_uring.
+ */
+static int
+__uring_open(WT_SESSION_IMPL *session, WT_FILE_AIO *aio)
+{
+	struct io_uring_params p;
+	WT_DECL_RET;
+	uint8_t *cq, *sq;
+	void *map;
+
+	memset(&p, 0, sizeof(p));
+	WT_SYSCALL(((aio->ring_fd = (int)syscall(
+	    SYS_io_uring_setup, aio->depth, &p)) == -1 ? -1 : 0), ret);
+	if (ret != 0) {
+		aio->ring_fd = -1;
+		WT_RET_MSG(session, ret, "io_uring_setup");
+	}
+
+	/*
+	 * Map the rings separately, the single mapping feature of newer kernels
+	 * isn't required.
+	 */
+	aio->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+	aio->cq_ring_size =
+	    p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+	aio->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+
+	if ((map = mmap(NULL, aio->sq_ring_size, PROT_READ | PROT_WRITE,
+	    MAP_SHARED | MAP_POPULATE, aio->ring_fd,
+	    (off_t)IORING_OFF_SQ_RING)) == MAP_FAILED)
+		WT_RET_MSG(session, __wt_errno(), "io_uring: mmap");
+	aio->sq_ring = map;
+	if ((map = mmap(NULL, aio->cq_ring_size, PROT_READ | PROT_WRITE,
+	    MAP_SHARED | MAP_POPULATE, aio->ring_fd,
+	    (off_t)IORING_OFF_CQ_RING)) == MAP_FAILED)
+		WT_RET_MSG(session, __wt_errno(), "io_uring: mmap");
+	aio->cq_ring = map;
+	if ((map = mmap(NULL, aio->sqes_size, PROT_READ | PROT_WRITE,
+	    MAP_SHARED | MAP_POPULATE, aio->ring_fd,
+	    (off_t)IORING_OFF_SQES)) == MAP_FAILED)
+		WT_RET_MSG(session, __wt_errno(), "io_uring: mmap");
+	aio->sqes = map;
+
+	sq = aio->sq_ring;
+	aio->sq_head = (uint32_t *)(sq + p.sq_off.head);
+	aio->sq_tail = (uint32_t *)(sq + p.sq_off.tail);
+	aio->sq_mask = *(uint32_t *)(sq + p.sq_off.ring_mask);
+	aio->sq_array = (uint32_t *)(sq + p.sq_off.array);
+
+	cq = aio->cq_ring;
+	aio->cq_head = (uint32_t *)(cq + p.cq_off.head);
+	aio->cq_tail = (uint32_t *)(cq + p.cq_off.tail);
+	aio->cq_mask = *(uint32_t *)(cq + p.cq_off.ring_mask);
+	aio->cqes = cq + p.cq_off.cqes;
+
+	return (0);
+}
+
+/*
+ * __uring_close --
+ *	Unmap and close an io_uring.
+ */
+static int
+__uring_close(WT_SESSION_IMPL *session, WT_FILE_AIO *aio)
+{
+	WT_DECL_RET;
+
+	if (aio->sqes != NULL)
+		(void)munmap(aio->sqes, aio->sqes_size);
+	if (aio->cq_ring != NULL)
+		(void)munmap(aio->cq_ring, aio->cq_ring_size);
+	if (aio->sq_ring != NULL)
+		(void)munmap(aio->sq_ring, aio->sq_ring_size);
+	if (aio->ring_fd != -1) {
+		WT_SYSCALL(close(aio->ring_fd), ret);
+		if (ret != 0)
+			__wt_err(session, ret, "io_uring: close");
+	}
+	return (ret);
+}
+
+/*
+ * __uring_queue --
+ *	Queue a request on the submission ring.
+ */
+static void
+__uring_queue(WT_FILE_AIO *aio, WT_FILE_AIO_REQ *req,
+    int fd, bool write, wt_off_t offset, void *buf, size_t len)
+{
+	struct io_uring_sqe *sqe;
+	uint32_t idx, tail;
+
+	/*
+	 * The caller reserved a slot in the in-flight count, which is never
+	 * larger than the ring, so there's always space.
+	 */
+	tail = *aio->sq_tail;
+	idx = tail & aio->sq_mask;
+	sqe = (struct io_uring_sqe *)aio->sqes + idx;
+	memset(sqe, 0, sizeof(*sqe));
+
+	req->iov.iov_base = buf;
+	req->iov.iov_len = len;
+	sqe->opcode = write ? IORING_OP_WRITEV : IORING_OP_READV;
+	sqe->fd = fd;
+	sqe->off = (uint64_t)offset;
+	sqe->addr = (uint64_t)(uintptr_t)&req->iov;
+	sqe->len = 1;
+	sqe->user_data = (uint64_t)(uintptr_t)req;
+	aio->sq_array[idx] = idx;
+
+	WT_PUBLISH(*aio->sq_tail, tail + 1);
+}
+
+/*
+ * __uring_submit --
+ *	Submit any queued requests, returning the number submitted.
+ */
+static int
+__uring_submit(WT_FILE_AIO *aio, uint32_t *submittedp)
+{
+	WT_DECL_RET;
+	uint32_t pending;
+
+	*submittedp = 0;
+	if ((pending = *aio->sq_tail - *aio->sq_head) == 0)
+		return (0);
+
+	/*
+	 * If the kernel is temporarily out of resources, the requests stay
+	 * queued and are submitted by the next thread to wait for completions.
+	 */
+	if ((ret = __uring_enter(aio, pending, 0, 0)) == 0)
+		*submittedp = pending;
+	else if (ret == EAGAIN || ret == EBUSY)
+		ret = 0;
+	return (ret);
+}
+
+/*
+ * __uring_reap --
+ *	Reap completions, optionally waiting for at least one.
+ */
+static int
+__uring_reap(WT_FILE_AIO *aio, bool wait, uint32_t *reapedp)
+{
+	struct io_uring_cqe *cqe;
+	WT_FILE_AIO_REQ *req;
+	uint32_t head, n, tail;
+
+	*reapedp = 0;
+
+	/* Submit anything queued since the last submission as we wait. */
+	if (wait) {
+		n = *aio->sq_tail - *aio->sq_head;
+		WT_RET_ERROR_OK(__uring_enter(
+		    aio, n, 1, IORING_ENTER_GETEVENTS), EAGAIN);
+	}
+
+	head = *aio->cq_head;
+	tail = *aio->cq_tail;
+	WT_READ_BARRIER();
+	for (n = 0; head != tail; ++head, ++n) {
+		cqe = (struct io_uring_cqe *)aio->cqes + (head & aio->cq_mask);
+		req = (WT_FILE_AIO_REQ *)(uintptr_t)cqe->user_data;
+		req->res = cqe->res;
+		(void)__wt_atomic_subv32(&aio->inflight, 1);
+		WT_PUBLISH(req->done, true);
+	}
+	WT_FULL_BARRIER();
+	*aio->cq_head = head;
+	*reapedp = n;
+	return (0);
+}
+#endif
+
+#if defined(__linux__) && \
+    defined(HAVE_LINUX_AIO_ABI_H) && defined(SYS_io_setup)
+#define	WT_HAVE_FILE_AIO_LINUX	1
+
+/*
+ * __linux_aio_open --
+ *	Create a Linux native AIO context.
+ */
+static int
+__linux_aio_open(WT_SESSION_IMPL *session, WT_FILE_AIO *aio)
+{
+	aio_context_t ctx;
+	WT_DECL_RET;
+
+	ctx = 0;
+	WT_SYSCALL(syscall(SYS_io_setup, aio->depth, &ctx), ret);
+	if (ret != 0)
+		WT_RET_MSG(session, ret, "io_setup");
+	aio->aio_ctx = (uint64_t)ctx;
+
+	WT_RET(__wt_calloc_def(session, aio->depth, &aio->pending));
+	WT_RET(__wt_calloc(
+	    session, aio->depth, sizeof(struct io_event), &aio->events));
+	return (0);
+}
+
+/*
+ * __linux_aio_close --
+ *	Destroy a Linux native AIO context.
+ */
+static int
+__linux_aio_close(WT_SESSION_IMPL *session, WT_FILE_AIO *aio)
+{
+	WT_DECL_RET;
+
+	if (aio->aio_ctx != 0) {
+		WT_SYSCALL(syscall(
+		    SYS_io_destroy, (aio_context_t)aio->aio_ctx), ret);
+		if (ret != 0)
+			__wt_err(session, ret, "io_destroy");
+	}
+	__wt_free(session, aio->pending);
+	__wt_free(session, aio->events);
+	return (ret);
+}
+
+/*
+ * __linux_aio_queue --
+ *	Queue a request for the next submission.
+ */
+static void
+__linux_aio_queue(WT_FILE_AIO *aio, WT_FILE_AIO_REQ *req,
+    int fd, bool write, wt_off_t offset, void *buf, size_t len)
+{
+	struct iocb *cb;
+
+	cb = &req->iocb;
+	memset(cb, 0, sizeof(*cb));
+	cb->aio_lio_opcode = write ? IOCB_CMD_PWRITE : IOCB_CMD_PREAD;
+	cb->aio_fildes = (uint32_t)fd;
+	cb->aio_buf = (uint64_t)(uintptr_t)buf;
+	cb->aio_nbytes = len;
+	cb->aio_offset = offset;
+	cb->aio_data = (uint64_t)(uintptr_t)req;
+
+	aio->pending[aio->pending_cnt++] = cb;
+}
+
+/*
+ * __linux_aio_submit --
+ *	Submit any queued requests, returning the number submitted. Called with
+ * the submit lock held.
+ *
+ *	If the kernel is temporarily out of resources, the requests stay queued
+ * and are submitted by the next thread to wait for completions.
+ */
+static int
+__linux_aio_submit(WT_FILE_AIO *aio, uint32_t *submittedp)
+{
+	struct iocb *cb, **pending;
+	WT_DECL_RET;
+	WT_FILE_AIO_REQ *req;
+	long n;
+
+	*submittedp = 0;
+	pending = (struct iocb **)aio->pending;
+	while (aio->pending_cnt > 0) {
+		n = syscall(SYS_io_submit, (aio_context_t)aio->aio_ctx,
+		    (long)aio->pending_cnt, pending);
+		if (n < 0) {
+			if ((ret = __wt_errno()) == EINTR)
+				continue;
+			if (ret == EAGAIN)
+				break;
+
+			/*
+			 * Fail the first request back to its owner and keep
+			 * going, the error belongs to that request.
+			 */
+			cb = pending[0];
+			req = (WT_FILE_AIO_REQ *)(uintptr_t)cb->aio_data;
+			req->res = -ret;
+			(void)__wt_atomic_subv32(&aio->inflight, 1);
+			WT_PUBLISH(req->done, true);
+			n = 1;
+			ret = 0;
+		} else
+			*submittedp += (uint32_t)n;
+		aio->pending_cnt -= (uint32_t)n;
+		memmove(pending, pending + n,
+		    aio->pending_cnt * sizeof(struct iocb *));
+	}
+	return (0);
+}
+
+/*
+ * __linux_aio_reap --
+ *	Reap completions, optionally waiting for at least one. If requests the
+ * kernel couldn't take are still queued, wait for a millisecond at most, so
+ * they're retried even if nothing completes.
+ */
+static int
+__linux_aio_reap(
+    WT_FILE_AIO *aio, bool wait, bool backlog, uint32_t *reapedp)
+{
+	struct io_event *ev;
+	struct timespec ts;
+	WT_DECL_RET;
+	WT_FILE_AIO_REQ *req;
+	long i, n;
+
+	*reapedp = 0;
+	ts.tv_sec = 0;
+	ts.tv_nsec = wait ? WT_MILLION : 0;
+	WT_SYSCALL_RETRY(((n = syscall(SYS_io_getevents,
+	    (aio_context_t)aio->aio_ctx, wait ? 1L : 0L, (long)aio->depth,
+	    aio->events, wait && !backlog ? NULL : &ts)) < 0 ? -1 : 0), ret);
+	WT_RET(ret);
+
+	for (i = 0, ev = aio->events; i < n; ++i, ++ev) {
+		req = (WT_FILE_AIO_REQ *)(uintptr_t)ev->data;
+		req->res = ev->res;
+		(void)__wt_atomic_subv32(&aio->inflight, 1);
+		WT_PUBLISH(req->done, true);
+	}
+	*reapedp = (uint32_t)n;
+	return (0);
+}
+#endif
+
+/*
+ * __file_aio_reserve --
+ *	Reserve a slot in the in-flight count, waiting if the queue is full.
+ */
+static int
+__file_aio_reserve(WT_SESSION_IMPL *session, WT_FILE_AIO *aio)
+{
+	uint64_t yield_count;
+	uint32_t inflight;
+
+	for (yield_count = 0;; ++yield_count) {
+		inflight = aio->inflight;
+		if (inflight < aio->depth && __wt_atomic_casv32(
+		    &aio->inflight, inflight, inflight + 1))
+			return (0);
+		if (inflight < aio->depth)
+			continue;
+
+		/*
+		 * The queue is full, every slot belongs to a thread that's
+		 * waiting for its request and reaping completions.
+		 */
+		if (yield_count == 0)
+			WT_STAT_CONN_INCR(session, block_aio_queue_full);
+		if (yield_count < WT_THOUSAND)
+			__wt_yield();
+		else
+			__wt_sleep(0, 10);
+	}
+}
+
+/*
+ * __file_aio_wait --
+ *	Wait for a request to complete, reaping completions for other threads.
+ */
+static int
+__file_aio_wait(
+    WT_SESSION_IMPL *session, WT_FILE_AIO *aio, WT_FILE_AIO_REQ *req)
+{
+	WT_DECL_RET;
+	uint64_t yield_count;
+	uint32_t reaped;
+#ifdef WT_HAVE_FILE_AIO_LINUX
+	uint32_t submitted;
+	bool backlog;
+#endif
+
+	for (yield_count = 0; !req->done;) {
+		if (__wt_spin_trylock(session, &aio->reap_lock) == 0) {
+			/*
+			 * Collect anything already complete, then block in the
+			 * kernel if our request is still outstanding. Requests
+			 * the kernel couldn't take when they were queued are
+			 * submitted first, so the kernel will always wake us.
+			 */
+			ret = 0;
+			reaped = 0;
+			switch (aio->method) {
+#ifdef WT_HAVE_FILE_AIO_URING
+			case WT_FILE_AIO_URING:
+				ret = __uring_reap(aio, false, &reaped);
+				if (ret == 0 && !req->done) {
+					WT_STAT_CONN_INCR(
+					    session, block_aio_wait);
+					ret = __uring_reap(aio, true, &reaped);
+				}
+				break;
+#endif
+#ifdef WT_HAVE_FILE_AIO_LINUX
+			case WT_FILE_AIO_AIO:
+				__wt_spin_lock(session, &aio->submit_lock);
+				ret = __linux_aio_submit(aio, &submitted);
+				backlog = aio->pending_cnt != 0;
+				__wt_spin_unlock(session, &aio->submit_lock);
+				if (submitted != 0)
+					WT_STAT_CONN_INCR(
+					    session, block_aio_submit);
+				if (ret == 0)
+					ret = __linux_aio_reap(
+					    aio, false, false, &reaped);
+				if (ret == 0 && reaped == 0 && !req->done) {
+					WT_STAT_CONN_INCR(
+					    session, block_aio_wait);
+					ret = __linux_aio_reap(
+					    aio, true, backlog, &reaped);
+				}
+				break;
+#endif
+			default:
+				ret = ENOTSUP;
+				break;
+			}
+			__wt_spin_unlock(session, &aio->reap_lock);
+
+			/*
+			 * Queued requests reference their owners' stacks, there
+			 * is no safe way to continue if the kernel queue fails.
+			 */
+			if (ret != 0)
+				WT_PANIC_RET(session, ret,
+				    "file AIO: failed to reap completions");
+			yield_count = 0;
+			continue;
+		}
+
+		/*
+		 * Another thread is reaping: it wakes on any completion, so
+		 * our request will be marked done without another system
+		 * call.
+		 */
+		if (++yield_count < WT_THOUSAND)
+			__wt_yield();
+		else
+			__wt_sleep(0, 10);
+	}
+	return (0);
+}
+
+/*
+ * __file_aio_rw --
+ *	Read or write a buffer through the asynchronous I/O queue.
+ */
+static int
+__file_aio_rw(WT_SESSION_IMPL *session, WT_FILE_HANDLE_POSIX *pfh,
+    bool write, wt_off_t offset, size_t len, void *buf)
+{
+	WT_DECL_RET;
+	WT_FILE_AIO *aio;
+	WT_FILE_AIO_REQ req;
+	size_t chunk;
+	uint32_t submitted;
+	uint8_t *addr;
+
+	aio = S2C(session)->file_aio;
+
+	/* Break I/O larger than 1GB into 1GB chunks. */
+	for (addr = buf; len > 0;
+	    addr += req.res, len -= (size_t)req.res, offset += req.res) {
+		chunk = WT_MIN(len, WT_GIGABYTE);
+		memset(&req, 0, sizeof(req));
+
+		WT_RET(__file_aio_reserve(session, aio));
+
+		__wt_spin_lock(session, &aio->submit_lock);
+		submitted = 0;
+		switch (aio->method) {
+#ifdef WT_HAVE_FILE_AIO_URING
+		case WT_FILE_AIO_URING:
+			__uring_queue(aio,
+			    &req, pfh->fd, write, offset, addr, chunk);
+			__wt_spin_unlock(session, &aio->submit_lock);
+
+			/*
+			 * Submit outside the lock so other threads can queue
+			 * requests to be submitted with ours.
+			 */
+			ret = __uring_submit(aio, &submitted);
+			break;
+#endif
+#ifdef WT_HAVE_FILE_AIO_LINUX
+		case WT_FILE_AIO_AIO:
+			__linux_aio_queue(aio,
+			    &req, pfh->fd, write, offset, addr, chunk);
+			ret = __linux_aio_submit(aio, &submitted);
+			__wt_spin_unlock(session, &aio->submit_lock);
+			break;
+#endif
+		default:
+			WT_UNUSED(pfh);
+			__wt_spin_unlock(session, &aio->submit_lock);
+			(void)__wt_atomic_subv32(&aio->inflight, 1);
+			return (__wt_illegal_value(session, NULL));
+		}
+		if (ret != 0)
+			WT_PANIC_RET(session, ret,
+			    "%s: handle-%s: file AIO: failed to submit",
+			    pfh->iface.name, write ? "write" : "read");
+		WT_STAT_CONN_INCR(session, block_aio_queued);
+		if (submitted != 0)
+			WT_STAT_CONN_INCR(session, block_aio_submit);
+
+		WT_RET(__file_aio_wait(session, aio, &req));
+
+		if (req.res <= 0)
+			WT_RET_MSG(session,
+			    req.res == 0 ? WT_ERROR : (int)-req.res,
+			    "%s: handle-%s: file AIO: failed to %s %"
+			    WT_SIZET_FMT " bytes at offset %" PRIuMAX,
+			    pfh->iface.name, write ? "write" : "read",
+			    write ? "write" : "read",
+			    chunk, (uintmax_t)offset);
+	}
+	return (0);
+}
+
+/*
+ * __wt_posix_file_aio_read --
+ *	Read through the asynchronous I/O queue.
+ */
+int
+__wt_posix_file_aio_read(WT_SESSION_IMPL *session,
+    WT_FILE_HANDLE_POSIX *pfh, wt_off_t offset, size_t len, void *buf)
+{
+	return (__file_aio_rw(session, pfh, false, offset, len, buf));
+}
+
+/*
+ * __wt_posix_file_aio_write --
+ *	Write through the asynchronous I/O queue.
+ */
+int
+__wt_posix_file_aio_write(WT_SESSION_IMPL *session,
+    WT_FILE_HANDLE_POSIX *pfh, wt_off_t offset, size_t len, const void *buf)
+{
+	/* The kernel's request structures don't distinguish const buffers. */
+	return (__file_aio_rw(
+	    session, pfh, true, offset, len, (void *)(uintptr_t)buf));
+}
+
+/*
+ * __wt_posix_file_aio_create --
+ *	Configure asynchronous data file I/O.
+ */
+int
+__wt_posix_file_aio_create(WT_SESSION_IMPL *session, const char *cfg[])
+{
+	WT_CONFIG_ITEM cval;
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_FILE_AIO *aio;
+	int method;
+
+	conn = S2C(session);
+
+	WT_RET(__wt_config_gets(session, cfg, "file_io.method", &cval));
+	if (WT_STRING_MATCH("aio", cval.str, cval.len))
+		method = WT_FILE_AIO_AIO;
+	else if (WT_STRING_MATCH("io_uring", cval.str, cval.len))
+		method = WT_FILE_AIO_URING;
+	else
+		return (0);
+
+#ifndef WT_HAVE_FILE_AIO_LINUX
+	if (method == WT_FILE_AIO_AIO)
+		WT_RET_MSG(session, ENOTSUP,
+		    "file_io.method=aio is not supported by this build");
+#endif
+#ifndef WT_HAVE_FILE_AIO_URING
+	if (method == WT_FILE_AIO_URING)
+		WT_RET_MSG(session, ENOTSUP,
+		    "file_io.method=io_uring is not supported by this build");
+#endif
+
+	WT_RET(__wt_calloc_one(session, &aio));
+	aio->ring_fd = -1;
+	WT_ERR(__wt_spin_init(session, &aio->submit_lock, "file AIO submit"));
+	WT_ERR(__wt_spin_init(session, &aio->reap_lock, "file AIO reap"));
+
+	WT_ERR(__wt_config_gets(session, cfg, "file_io.queue_depth", &cval));
+	aio->depth = (uint32_t)cval.val;
+
+#ifdef WT_HAVE_FILE_AIO_URING
+	/*
+	 * Kernels without io_uring, or where it's been disabled, fall back to
+	 * Linux native AIO.
+	 */
+	if (method == WT_FILE_AIO_URING) {
+		WT_ERR(__wt_config_gets(
+		    session, cfg, "file_io.io_uring_fail_for_test", &cval));
+		if ((ret = cval.val != 0 ?
+		    ENOSYS : __uring_open(session, aio)) == 0) {
+			aio->method = method;
+			goto done;
+		}
+		WT_TRET(__uring_close(session, aio));
+		aio->ring_fd = -1;
+		aio->sq_ring = aio->cq_ring = aio->sqes = NULL;
+#ifndef WT_HAVE_FILE_AIO_LINUX
+		WT_ERR(ret);
+#endif
+		__wt_verbose(session, WT_VERB_FILEOPS, "%s",
+		    "io_uring unavailable, falling back to Linux native AIO");
+		ret = 0;
+		method = WT_FILE_AIO_AIO;
+	}
+#endif
+#ifdef WT_HAVE_FILE_AIO_LINUX
+	if (method == WT_FILE_AIO_AIO) {
+		WT_ERR(__linux_aio_open(session, aio));
+		aio->method = method;
+	}
+#endif
+
+#ifdef WT_HAVE_FILE_AIO_URING
+done:
+#endif
+	conn->file_aio = aio;
+	return (0);
+
+err:	conn->file_aio = aio;
+	WT_TRET(__wt_posix_file_aio_destroy(session));
+	return (ret);
+}
+
+/*
+ * __wt_posix_file_aio_destroy --
+ *	Discard asynchronous data file I/O, called once all files are closed.
+ */
+int
+__wt_posix_file_aio_destroy(WT_SESSION_IMPL *session)
+{
+	WT_CONNECTION_IMPL *conn;
+	WT_DECL_RET;
+	WT_FILE_AIO *aio;
+
+	conn = S2C(session);
+
+	if ((aio = conn->file_aio) == NULL)
+		return (0);
+	conn->file_aio = NULL;
+
+	WT_ASSERT(session, aio->inflight == 0);
+
+#ifdef WT_HAVE_FILE_AIO_URING
+	WT_TRET(__uring_close(session, aio));
+#endif
+#ifdef WT_HAVE_FILE_AIO_LINUX
+	WT_TRET(__linux_aio_close(session, aio));
+#endif
+	__wt_spin_destroy(session, &aio->submit_lock);
+	__wt_spin_destroy(session, &aio->reap_lock);
+	__wt_free(session, aio);
+	return (ret);
+}
+
+/*
+ * __wt_posix_file_aio_enabled --
+ *	Return if a file opened with the given direct I/O setting uses the
+ * asynchronous I/O queue.
+ */
+bool
+__wt_posix_file_aio_enabled(WT_SESSION_IMPL *session, bool direct_io)
+{
+	WT_FILE_AIO *aio;
+
+	if ((aio = S2C(session)->file_aio) == NULL)
+		return (false);
+
+	/* Linux native AIO blocks in io_submit unless using direct I/O. */
+	return (aio->method == WT_FILE_AIO_URING || direct_io);
+}
@@ -400,6 +400,10 @@ __posix_file_read(WT_FILE_HANDLE *file_handle,
 	    len >= S2C(session)->buffer_alignment &&
 	    len % S2C(session)->buffer_alignment == 0));
 
+	if (pfh->file_aio)
+		return (
+		    __wt_posix_file_aio_read(session, pfh, offset, len, buf));
+
 	/* Break reads larger than 1GB into 1GB chunks. */
 	for (addr = buf; len > 0; addr += nr, len -= (size_t)nr, offset += nr) {
 		chunk = WT_MIN(len, WT_GIGABYTE);
@@ -527,6 +531,10 @@ __posix_file_write(WT_FILE_HANDLE *file_handle, WT_SESSION *wt_session,
 	    len >= S2C(session)->buffer_alignment &&
 	    len % S2C(session)->buffer_alignment == 0));
 
+	if (pfh->file_aio)
+		return (
+		    __wt_posix_file_aio_write(session, pfh, offset, len, buf));
+
 	/* Break writes larger than 1GB into 1GB chunks. */
 	for (addr = buf; len > 0; addr += nw, len -= (size_t)nw, offset += nw) {
 		chunk = WT_MIN(len, WT_GIGABYTE);
@@ -683,6 +691,11 @@ __posix_open_file(WT_FILE_SYSTEM *file_system, WT_SESSION *wt_session,
 
 	WT_ERR(__posix_open_file_cloexec(session, pfh->fd, name));
 
+	/* Data files can use the asynchronous I/O queue. */
+	if (file_type == WT_FS_OPEN_FILE_TYPE_DATA)
+		pfh->file_aio =
+		    __wt_posix_file_aio_enabled(session, pfh->direct_io);
+
 #if defined(HAVE_POSIX_FADVISE)
 	/*
 	 * If the user set an access pattern hint, call fadvise now.
@@ -53,6 +53,10 @@ typedef struct {
 
 	u_int updates_seen;		/* Count of updates seen. */
 	u_int updates_unstable;		/* Count of updates not visible_all. */
+	u_int updates_obsolete;		/* Count of obsolete updates freed. */
+
+	/* Update chain length histogram: 1-9, 10-99, 100-999, 1000+. */
+	u_int update_chain_hist[4];
 
 	bool update_uncommitted;	/* An update was uncommitted */
 	bool update_used;		/* An update could be used */
@@ -401,7 +405,9 @@ __wt_reconcile(WT_SESSION_IMPL *session, WT_REF *ref,
 	/*
 	 * Reconciliation locks the page for three reasons:
 	 *    Reconciliation reads the lists of page updates, obsolete updates
-	 * cannot be discarded while reconciliation is in progress;
+	 * cannot be discarded by other threads while reconciliation is in
+	 * progress (reconciliation discards obsolete updates from long update
+	 * lists itself, before it saves any references into those lists);
 	 *    The compaction process reads page modification information, which
 	 * reconciliation modifies;
 	 *    In-memory splits: reconciliation of an internal page cannot handle
@@ -512,6 +518,28 @@ __wt_reconcile(WT_SESSION_IMPL *session, WT_REF *ref,
 		WT_STAT_CONN_INCR(session, cache_write_restore);
 		WT_STAT_DATA_INCR(session, cache_write_restore);
 	}
+	if (r->updates_obsolete != 0) {
+		WT_STAT_CONN_INCRV(
+		    session, rec_update_obsolete, r->updates_obsolete);
+		WT_STAT_DATA_INCRV(
+		    session, rec_update_obsolete, r->updates_obsolete);
+	}
+	WT_STAT_CONN_INCRV(
+	    session, rec_update_chain_lt10, r->update_chain_hist[0]);
+	WT_STAT_DATA_INCRV(
+	    session, rec_update_chain_lt10, r->update_chain_hist[0]);
+	WT_STAT_CONN_INCRV(
+	    session, rec_update_chain_lt100, r->update_chain_hist[1]);
+	WT_STAT_DATA_INCRV(
+	    session, rec_update_chain_lt100, r->update_chain_hist[1]);
+	WT_STAT_CONN_INCRV(
+	    session, rec_update_chain_lt1000, r->update_chain_hist[2]);
+	WT_STAT_DATA_INCRV(
+	    session, rec_update_chain_lt1000, r->update_chain_hist[2]);
+	WT_STAT_CONN_INCRV(
+	    session, rec_update_chain_ge1000, r->update_chain_hist[3]);
+	WT_STAT_DATA_INCRV(
+	    session, rec_update_chain_ge1000, r->update_chain_hist[3]);
 	if (r->multi_next > btree->rec_multiblock_max)
 		btree->rec_multiblock_max = r->multi_next;
 
@@ -521,11 +549,12 @@ __wt_reconcile(WT_SESSION_IMPL *session, WT_REF *ref,
 	/*
 	 * When threads perform eviction, don't cache block manager structures
 	 * (even across calls), we can have a significant number of threads
-	 * doing eviction at the same time with large items. Ignore checkpoints,
-	 * once the checkpoint completes, all unnecessary session resources will
-	 * be discarded.
+	 * doing eviction at the same time with large items. Ignore checkpoints
+	 * and their worker threads, once the checkpoint completes, all
+	 * unnecessary session resources will be discarded.
 	 */
-	if (!WT_SESSION_IS_CHECKPOINT(session)) {
+	if (!WT_SESSION_IS_CHECKPOINT(session) &&
+	    !F_ISSET(session, WT_SESSION_CHECKPOINT_WORKER)) {
 		/*
 		 * Clean up the underlying block manager memory too: it's not
 		 * reconciliation, but threads discarding reconciliation
@@ -733,8 +762,11 @@ __rec_write_page_status(WT_SESSION_IMPL *session, WT_RECONCILE *r)
 		 * ID when doing a checkpoint. That's sufficient, we only care
 		 * about the maximum transaction ID of current updates in the
 		 * tree, and checkpoint visits every dirty page in the tree.
+		 * Checkpoint worker threads can write leaf pages concurrently,
+		 * lock the update.
 		 */
 		if (!F_ISSET(r, WT_REC_EVICT)) {
+			__wt_spin_lock(session, &btree->rec_max_lock);
 			if (WT_TXNID_LT(btree->rec_max_txn, r->max_txn))
 				btree->rec_max_txn = r->max_txn;
 #ifdef HAVE_TIMESTAMPS
@@ -743,6 +775,7 @@ __rec_write_page_status(WT_SESSION_IMPL *session, WT_RECONCILE *r)
 				__wt_timestamp_set(&btree->rec_max_timestamp,
 				    &r->max_timestamp);
 #endif
+			__wt_spin_unlock(session, &btree->rec_max_lock);
 		}
 
 		/*
@@ -1011,7 +1044,8 @@ __rec_init(WT_SESSION_IMPL *session,
 	__wt_timestamp_set_inf(&r->min_saved_timestamp);
 
 	/* Track if updates were used and/or uncommitted. */
-	r->updates_seen = r->updates_unstable = 0;
+	r->updates_seen = r->updates_unstable = r->updates_obsolete = 0;
+	memset(r->update_chain_hist, 0, sizeof(r->update_chain_hist));
 	r->update_uncommitted = r->update_used = false;
 
 	/* Track if the page can be marked clean. */
@@ -1287,15 +1321,15 @@ __rec_txn_read(WT_SESSION_IMPL *session, WT_RECONCILE *r,
     bool *upd_savedp, WT_UPDATE **updp)
 {
 	WT_PAGE *page;
-	WT_UPDATE *first_txn_upd, *first_upd, *upd;
+	WT_UPDATE *first_txn_upd, *first_upd, *obsolete, *upd;
 	wt_timestamp_t *timestampp;
-	size_t upd_memsize;
+	size_t obsolete_size, upd_memsize;
 	uint64_t max_txn, txnid;
-	bool all_visible, skipped_birthmark, uncommitted;
+	u_int chain_len, obsolete_count, updates_seen, updates_unstable;
+	bool all_visible, obsolete_checked, skipped_birthmark, uncommitted;
 
 #ifdef HAVE_TIMESTAMPS
 	WT_UPDATE *first_ts_upd;
-	first_ts_upd = NULL;
 #endif
 
 	if (upd_savedp != NULL)
@@ -1303,10 +1337,6 @@ __rec_txn_read(WT_SESSION_IMPL *session, WT_RECONCILE *r,
 	*updp = NULL;
 
 	page = r->page;
-	first_txn_upd = NULL;
-	upd_memsize = 0;
-	max_txn = WT_TXN_NONE;
-	skipped_birthmark = uncommitted = false;
 
 	/*
 	 * If called with a WT_INSERT item, use its WT_UPDATE list (which must
@@ -1318,7 +1348,22 @@ __rec_txn_read(WT_SESSION_IMPL *session, WT_RECONCILE *r,
 	else if ((first_upd = WT_ROW_UPDATE(page, ripcip)) == NULL)
 		return (0);
 
-	for (upd = first_upd; upd != NULL; upd = upd->next) {
+	updates_seen = r->updates_seen;
+	updates_unstable = r->updates_unstable;
+	obsolete_checked = false;
+
+restart:
+	*updp = NULL;
+	first_txn_upd = NULL;
+	upd_memsize = 0;
+	max_txn = WT_TXN_NONE;
+	skipped_birthmark = uncommitted = false;
+#ifdef HAVE_TIMESTAMPS
+	first_ts_upd = NULL;
+#endif
+
+	for (chain_len = 0,
+	    upd = first_upd; upd != NULL; upd = upd->next, ++chain_len) {
 		if ((txnid = upd->txnid) == WT_TXN_ABORTED)
 			continue;
 
@@ -1417,6 +1462,45 @@ __rec_txn_read(WT_SESSION_IMPL *session, WT_RECONCILE *r,
 			*updp = upd;
 	}
 
+	/*
+	 * Long update lists penalize every reader walking them, and hot items
+	 * can collect thousands of updates between reconciliations.  We hold
+	 * the page lock, discard any updates no running transaction can read
+	 * (everything after the first globally visible, self-contained value),
+	 * then start over, the list we walked has changed.  Only check once,
+	 * the list may still be long if older readers need its updates.
+	 */
+	if (chain_len > WT_UPDATE_CHAIN_LONG && !obsolete_checked) {
+		obsolete_checked = true;
+		if ((obsolete = __wt_update_obsolete_check(
+		    session, page, first_upd)) != NULL) {
+			obsolete_count = 0;
+			obsolete_size = 0;
+			for (upd = obsolete; upd != NULL; upd = upd->next) {
+				++obsolete_count;
+				obsolete_size += WT_UPDATE_MEMSIZE(upd);
+			}
+			__wt_cache_page_inmem_decr(
+			    session, page, obsolete_size);
+			__wt_free_update_list(session, obsolete);
+
+			r->updates_obsolete += obsolete_count;
+			r->updates_seen = updates_seen;
+			r->updates_unstable = updates_unstable;
+			goto restart;
+		}
+	}
+
+	/* Track the update list length. */
+	if (chain_len < 10)
+		++r->update_chain_hist[0];
+	else if (chain_len < 100)
+		++r->update_chain_hist[1];
+	else if (chain_len < 1000)
+		++r->update_chain_hist[2];
+	else
+		++r->update_chain_hist[3];
+
 	/* Keep track of the selected update. */
 	upd = *updp;
 
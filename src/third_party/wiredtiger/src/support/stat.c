@@ -137,11 +137,16 @@ static const char * const __stats_dsrc_desc[] = {
 	"reconciliation: leaf page multi-block writes",
 	"reconciliation: leaf-page overflow keys",
 	"reconciliation: maximum blocks required for a page",
+	"reconciliation: obsolete updates discarded",
 	"reconciliation: overflow values written",
 	"reconciliation: page checksum matches",
 	"reconciliation: page reconciliation calls",
 	"reconciliation: page reconciliation calls for eviction",
 	"reconciliation: pages deleted",
+	"reconciliation: update chain length histogram - 1-9",
+	"reconciliation: update chain length histogram - 10-99",
+	"reconciliation: update chain length histogram - 100-999",
+	"reconciliation: update chain length histogram - 1000 and higher",
 	"session: cached cursor count",
 	"session: object compaction",
 	"session: open cursor count",
@@ -322,11 +327,16 @@ __wt_stat_dsrc_clear_single(WT_DSRC_STATS *stats)
 	stats->rec_multiblock_leaf = 0;
 	stats->rec_overflow_key_leaf = 0;
 	stats->rec_multiblock_max = 0;
+	stats->rec_update_obsolete = 0;
 	stats->rec_overflow_value = 0;
 	stats->rec_page_match = 0;
 	stats->rec_pages = 0;
 	stats->rec_pages_eviction = 0;
 	stats->rec_page_delete = 0;
+	stats->rec_update_chain_lt10 = 0;
+	stats->rec_update_chain_lt100 = 0;
+	stats->rec_update_chain_lt1000 = 0;
+	stats->rec_update_chain_ge1000 = 0;
 		/* not clearing session_cursor_cached */
 	stats->session_compact = 0;
 		/* not clearing session_cursor_open */
@@ -509,11 +519,16 @@ __wt_stat_dsrc_aggregate_single(
 	to->rec_overflow_key_leaf += from->rec_overflow_key_leaf;
 	if (from->rec_multiblock_max > to->rec_multiblock_max)
 		to->rec_multiblock_max = from->rec_multiblock_max;
+	to->rec_update_obsolete += from->rec_update_obsolete;
 	to->rec_overflow_value += from->rec_overflow_value;
 	to->rec_page_match += from->rec_page_match;
 	to->rec_pages += from->rec_pages;
 	to->rec_pages_eviction += from->rec_pages_eviction;
 	to->rec_page_delete += from->rec_page_delete;
+	to->rec_update_chain_lt10 += from->rec_update_chain_lt10;
+	to->rec_update_chain_lt100 += from->rec_update_chain_lt100;
+	to->rec_update_chain_lt1000 += from->rec_update_chain_lt1000;
+	to->rec_update_chain_ge1000 += from->rec_update_chain_ge1000;
 	to->session_cursor_cached += from->session_cursor_cached;
 	to->session_compact += from->session_compact;
 	to->session_cursor_open += from->session_cursor_open;
@@ -734,11 +749,20 @@ __wt_stat_dsrc_aggregate(
 	if ((v = WT_STAT_READ(from, rec_multiblock_max)) >
 	    to->rec_multiblock_max)
 		to->rec_multiblock_max = v;
+	to->rec_update_obsolete += WT_STAT_READ(from, rec_update_obsolete);
 	to->rec_overflow_value += WT_STAT_READ(from, rec_overflow_value);
 	to->rec_page_match += WT_STAT_READ(from, rec_page_match);
 	to->rec_pages += WT_STAT_READ(from, rec_pages);
 	to->rec_pages_eviction += WT_STAT_READ(from, rec_pages_eviction);
 	to->rec_page_delete += WT_STAT_READ(from, rec_page_delete);
+	to->rec_update_chain_lt10 +=
+	    WT_STAT_READ(from, rec_update_chain_lt10);
+	to->rec_update_chain_lt100 +=
+	    WT_STAT_READ(from, rec_update_chain_lt100);
+	to->rec_update_chain_lt1000 +=
+	    WT_STAT_READ(from, rec_update_chain_lt1000);
+	to->rec_update_chain_ge1000 +=
+	    WT_STAT_READ(from, rec_update_chain_ge1000);
 	to->session_cursor_cached +=
 	    WT_STAT_READ(from, session_cursor_cached);
 	to->session_compact += WT_STAT_READ(from, session_compact);
@@ -770,6 +794,10 @@ static const char * const __stats_connection_desc[] = {
 	"async: total remove calls",
 	"async: total search calls",
 	"async: total update calls",
+	"block-manager: asynchronous I/O completion wait calls",
+	"block-manager: asynchronous I/O queue full",
+	"block-manager: asynchronous I/O submit calls",
+	"block-manager: asynchronous I/Os queued",
 	"block-manager: blocks pre-loaded",
 	"block-manager: blocks read",
 	"block-manager: blocks written",
@@ -778,6 +806,11 @@ static const char * const __stats_connection_desc[] = {
 	"block-manager: bytes written for checkpoint",
 	"block-manager: mapped blocks read",
 	"block-manager: mapped bytes read",
+	"cache: application thread time waiting for cache histogram - 0-99us",
+	"cache: application thread time waiting for cache histogram - 1-9ms",
+	"cache: application thread time waiting for cache histogram - 10-99ms",
+	"cache: application thread time waiting for cache histogram - 100-999us",
+	"cache: application thread time waiting for cache histogram - 100ms+",
 	"cache: application threads page read from disk to cache count",
 	"cache: application threads page read from disk to cache time (usecs)",
 	"cache: application threads page write from cache to disk count",
@@ -801,6 +834,8 @@ static const char * const __stats_connection_desc[] = {
 	"cache: eviction server slept, because we did not make progress with eviction",
 	"cache: eviction server unable to reach eviction goal",
 	"cache: eviction state",
+	"cache: eviction walk shards walked by eviction worker threads",
+	"cache: eviction walk shards walked by the eviction server",
 	"cache: eviction walk target pages histogram - 0-9",
 	"cache: eviction walk target pages histogram - 10-31",
 	"cache: eviction walk target pages histogram - 128 and higher",
@@ -849,9 +884,15 @@ static const char * const __stats_connection_desc[] = {
 	"cache: pages evicted because they had chains of deleted items count",
 	"cache: pages evicted because they had chains of deleted items time (usecs)",
 	"cache: pages evicted by application threads",
+	"cache: pages not read ahead because of cache pressure",
+	"cache: pages not read ahead because the read-ahead queue was full",
 	"cache: pages queued for eviction",
+	"cache: pages queued for read-ahead",
 	"cache: pages queued for urgent eviction",
 	"cache: pages queued for urgent eviction during walk",
+	"cache: pages read ahead and discarded unused",
+	"cache: pages read ahead and used by a cursor",
+	"cache: pages read ahead of a sequential scan",
 	"cache: pages read into cache",
 	"cache: pages read into cache after truncate",
 	"cache: pages read into cache after truncate in prepare state",
@@ -1008,11 +1049,16 @@ static const char * const __stats_connection_desc[] = {
 	"perf: operation write latency histogram (bucket 4) - 1000-9999us",
 	"perf: operation write latency histogram (bucket 5) - 10000us+",
 	"reconciliation: fast-path pages deleted",
+	"reconciliation: obsolete updates discarded",
 	"reconciliation: page reconciliation calls",
 	"reconciliation: page reconciliation calls for eviction",
 	"reconciliation: pages deleted",
 	"reconciliation: split bytes currently awaiting free",
 	"reconciliation: split objects currently awaiting free",
+	"reconciliation: update chain length histogram - 1-9",
+	"reconciliation: update chain length histogram - 10-99",
+	"reconciliation: update chain length histogram - 100-999",
+	"reconciliation: update chain length histogram - 1000 and higher",
 	"session: open cursor count",
 	"session: open session count",
 	"session: table alter failed calls",
@@ -1039,6 +1085,7 @@ static const char * const __stats_connection_desc[] = {
 	"thread-state: active filesystem write calls",
 	"thread-yield: application thread time evicting (usecs)",
 	"thread-yield: application thread time waiting for cache (usecs)",
+	"thread-yield: application thread time waiting for eviction candidates (usecs)",
 	"thread-yield: connection close blocked waiting for transaction state stabilization",
 	"thread-yield: connection close yielded for lsm manager shutdown",
 	"thread-yield: data handle lock yielded",
@@ -1081,11 +1128,15 @@ static const char * const __stats_connection_desc[] = {
 	"transaction: transaction checkpoint currently running",
 	"transaction: transaction checkpoint generation",
 	"transaction: transaction checkpoint max time (msecs)",
+	"transaction: transaction checkpoint metadata most recent time (msecs)",
 	"transaction: transaction checkpoint min time (msecs)",
 	"transaction: transaction checkpoint most recent time (msecs)",
+	"transaction: transaction checkpoint pages written by worker threads",
+	"transaction: transaction checkpoint prepare most recent time (msecs)",
 	"transaction: transaction checkpoint scrub dirty target",
 	"transaction: transaction checkpoint scrub time (msecs)",
 	"transaction: transaction checkpoint total time (msecs)",
+	"transaction: transaction checkpoint tree write most recent time (msecs)",
 	"transaction: transaction checkpoints",
 	"transaction: transaction checkpoints skipped because database was clean",
 	"transaction: transaction failures due to cache overflow",
@@ -1165,6 +1216,10 @@ __wt_stat_connection_clear_single(WT_CONNECTION_STATS *stats)
 	stats->async_op_remove = 0;
 	stats->async_op_search = 0;
 	stats->async_op_update = 0;
+	stats->block_aio_wait = 0;
+	stats->block_aio_queue_full = 0;
+	stats->block_aio_submit = 0;
+	stats->block_aio_queued = 0;
 	stats->block_preload = 0;
 	stats->block_read = 0;
 	stats->block_write = 0;
@@ -1173,6 +1228,11 @@ __wt_stat_connection_clear_single(WT_CONNECTION_STATS *stats)
 	stats->block_byte_write_checkpoint = 0;
 	stats->block_map_read = 0;
 	stats->block_byte_map_read = 0;
+	stats->cache_eviction_app_time_lt100 = 0;
+	stats->cache_eviction_app_time_lt10000 = 0;
+	stats->cache_eviction_app_time_lt100000 = 0;
+	stats->cache_eviction_app_time_lt1000 = 0;
+	stats->cache_eviction_app_time_ge100000 = 0;
 	stats->cache_read_app_count = 0;
 	stats->cache_read_app_time = 0;
 	stats->cache_write_app_count = 0;
@@ -1196,6 +1256,8 @@ __wt_stat_connection_clear_single(WT_CONNECTION_STATS *stats)
 	stats->cache_eviction_server_slept = 0;
 	stats->cache_eviction_slow = 0;
 		/* not clearing cache_eviction_state */
+	stats->cache_eviction_walk_shards_worker = 0;
+	stats->cache_eviction_walk_shards_server = 0;
 	stats->cache_eviction_target_page_lt10 = 0;
 	stats->cache_eviction_target_page_lt32 = 0;
 	stats->cache_eviction_target_page_ge128 = 0;
@@ -1244,9 +1306,15 @@ __wt_stat_connection_clear_single(WT_CONNECTION_STATS *stats)
 	stats->cache_eviction_force_delete = 0;
 	stats->cache_eviction_force_delete_time = 0;
 	stats->cache_eviction_app = 0;
+	stats->cache_read_ahead_skip_pressure = 0;
+	stats->cache_read_ahead_skip_full = 0;
 	stats->cache_eviction_pages_queued = 0;
+	stats->cache_read_ahead_queued = 0;
 	stats->cache_eviction_pages_queued_urgent = 0;
 	stats->cache_eviction_pages_queued_oldest = 0;
+	stats->cache_read_ahead_waste = 0;
+	stats->cache_read_ahead_hit = 0;
+	stats->cache_read_ahead = 0;
 	stats->cache_read = 0;
 	stats->cache_read_deleted = 0;
 	stats->cache_read_deleted_prepared = 0;
@@ -1403,11 +1471,16 @@ __wt_stat_connection_clear_single(WT_CONNECTION_STATS *stats)
 	stats->perf_hist_opwrite_latency_lt10000 = 0;
 	stats->perf_hist_opwrite_latency_gt10000 = 0;
 	stats->rec_page_delete_fast = 0;
+	stats->rec_update_obsolete = 0;
 	stats->rec_pages = 0;
 	stats->rec_pages_eviction = 0;
 	stats->rec_page_delete = 0;
 		/* not clearing rec_split_stashed_bytes */
 		/* not clearing rec_split_stashed_objects */
+	stats->rec_update_chain_lt10 = 0;
+	stats->rec_update_chain_lt100 = 0;
+	stats->rec_update_chain_lt1000 = 0;
+	stats->rec_update_chain_ge1000 = 0;
 		/* not clearing session_cursor_open */
 		/* not clearing session_open */
 		/* not clearing session_table_alter_fail */
@@ -1434,6 +1507,7 @@ __wt_stat_connection_clear_single(WT_CONNECTION_STATS *stats)
 		/* not clearing thread_write_active */
 	stats->application_evict_time = 0;
 	stats->application_cache_time = 0;
+	stats->application_evict_wait_time = 0;
 	stats->txn_release_blocked = 0;
 	stats->conn_close_blocked_lsm = 0;
 	stats->dhandle_lock_blocked = 0;
@@ -1476,11 +1550,15 @@ __wt_stat_connection_clear_single(WT_CONNECTION_STATS *stats)
 		/* not clearing txn_checkpoint_running */
 		/* not clearing txn_checkpoint_generation */
 		/* not clearing txn_checkpoint_time_max */
+		/* not clearing txn_checkpoint_metadata_recent */
 		/* not clearing txn_checkpoint_time_min */
 		/* not clearing txn_checkpoint_time_recent */
+	stats->txn_checkpoint_worker_pages = 0;
+		/* not clearing txn_checkpoint_prep_recent */
 		/* not clearing txn_checkpoint_scrub_target */
 		/* not clearing txn_checkpoint_scrub_time */
 		/* not clearing txn_checkpoint_time_total */
+		/* not clearing txn_checkpoint_tree_recent */
 	stats->txn_checkpoint = 0;
 	stats->txn_checkpoint_skipped = 0;
 	stats->txn_fail_cache = 0;
@@ -1540,6 +1618,10 @@ __wt_stat_connection_aggregate(
 	to->async_op_remove += WT_STAT_READ(from, async_op_remove);
 	to->async_op_search += WT_STAT_READ(from, async_op_search);
 	to->async_op_update += WT_STAT_READ(from, async_op_update);
+	to->block_aio_wait += WT_STAT_READ(from, block_aio_wait);
+	to->block_aio_queue_full += WT_STAT_READ(from, block_aio_queue_full);
+	to->block_aio_submit += WT_STAT_READ(from, block_aio_submit);
+	to->block_aio_queued += WT_STAT_READ(from, block_aio_queued);
 	to->block_preload += WT_STAT_READ(from, block_preload);
 	to->block_read += WT_STAT_READ(from, block_read);
 	to->block_write += WT_STAT_READ(from, block_write);
@@ -1549,6 +1631,16 @@ __wt_stat_connection_aggregate(
 	    WT_STAT_READ(from, block_byte_write_checkpoint);
 	to->block_map_read += WT_STAT_READ(from, block_map_read);
 	to->block_byte_map_read += WT_STAT_READ(from, block_byte_map_read);
+	to->cache_eviction_app_time_lt100 +=
+	    WT_STAT_READ(from, cache_eviction_app_time_lt100);
+	to->cache_eviction_app_time_lt10000 +=
+	    WT_STAT_READ(from, cache_eviction_app_time_lt10000);
+	to->cache_eviction_app_time_lt100000 +=
+	    WT_STAT_READ(from, cache_eviction_app_time_lt100000);
+	to->cache_eviction_app_time_lt1000 +=
+	    WT_STAT_READ(from, cache_eviction_app_time_lt1000);
+	to->cache_eviction_app_time_ge100000 +=
+	    WT_STAT_READ(from, cache_eviction_app_time_ge100000);
 	to->cache_read_app_count += WT_STAT_READ(from, cache_read_app_count);
 	to->cache_read_app_time += WT_STAT_READ(from, cache_read_app_time);
 	to->cache_write_app_count +=
@@ -1585,6 +1677,10 @@ __wt_stat_connection_aggregate(
 	    WT_STAT_READ(from, cache_eviction_server_slept);
 	to->cache_eviction_slow += WT_STAT_READ(from, cache_eviction_slow);
 	to->cache_eviction_state += WT_STAT_READ(from, cache_eviction_state);
+	to->cache_eviction_walk_shards_worker +=
+	    WT_STAT_READ(from, cache_eviction_walk_shards_worker);
+	to->cache_eviction_walk_shards_server +=
+	    WT_STAT_READ(from, cache_eviction_walk_shards_server);
 	to->cache_eviction_target_page_lt10 +=
 	    WT_STAT_READ(from, cache_eviction_target_page_lt10);
 	to->cache_eviction_target_page_lt32 +=
@@ -1672,12 +1768,22 @@ __wt_stat_connection_aggregate(
 	to->cache_eviction_force_delete_time +=
 	    WT_STAT_READ(from, cache_eviction_force_delete_time);
 	to->cache_eviction_app += WT_STAT_READ(from, cache_eviction_app);
+	to->cache_read_ahead_skip_pressure +=
+	    WT_STAT_READ(from, cache_read_ahead_skip_pressure);
+	to->cache_read_ahead_skip_full +=
+	    WT_STAT_READ(from, cache_read_ahead_skip_full);
 	to->cache_eviction_pages_queued +=
 	    WT_STAT_READ(from, cache_eviction_pages_queued);
+	to->cache_read_ahead_queued +=
+	    WT_STAT_READ(from, cache_read_ahead_queued);
 	to->cache_eviction_pages_queued_urgent +=
 	    WT_STAT_READ(from, cache_eviction_pages_queued_urgent);
 	to->cache_eviction_pages_queued_oldest +=
 	    WT_STAT_READ(from, cache_eviction_pages_queued_oldest);
+	to->cache_read_ahead_waste +=
+	    WT_STAT_READ(from, cache_read_ahead_waste);
+	to->cache_read_ahead_hit += WT_STAT_READ(from, cache_read_ahead_hit);
+	to->cache_read_ahead += WT_STAT_READ(from, cache_read_ahead);
 	to->cache_read += WT_STAT_READ(from, cache_read);
 	to->cache_read_deleted += WT_STAT_READ(from, cache_read_deleted);
 	to->cache_read_deleted_prepared +=
@@ -1896,6 +2002,7 @@ __wt_stat_connection_aggregate(
 	to->perf_hist_opwrite_latency_gt10000 +=
 	    WT_STAT_READ(from, perf_hist_opwrite_latency_gt10000);
 	to->rec_page_delete_fast += WT_STAT_READ(from, rec_page_delete_fast);
+	to->rec_update_obsolete += WT_STAT_READ(from, rec_update_obsolete);
 	to->rec_pages += WT_STAT_READ(from, rec_pages);
 	to->rec_pages_eviction += WT_STAT_READ(from, rec_pages_eviction);
 	to->rec_page_delete += WT_STAT_READ(from, rec_page_delete);
@@ -1903,6 +2010,14 @@ __wt_stat_connection_aggregate(
 	    WT_STAT_READ(from, rec_split_stashed_bytes);
 	to->rec_split_stashed_objects +=
 	    WT_STAT_READ(from, rec_split_stashed_objects);
+	to->rec_update_chain_lt10 +=
+	    WT_STAT_READ(from, rec_update_chain_lt10);
+	to->rec_update_chain_lt100 +=
+	    WT_STAT_READ(from, rec_update_chain_lt100);
+	to->rec_update_chain_lt1000 +=
+	    WT_STAT_READ(from, rec_update_chain_lt1000);
+	to->rec_update_chain_ge1000 +=
+	    WT_STAT_READ(from, rec_update_chain_ge1000);
 	to->session_cursor_open += WT_STAT_READ(from, session_cursor_open);
 	to->session_open += WT_STAT_READ(from, session_open);
 	to->session_table_alter_fail +=
@@ -1950,6 +2065,8 @@ __wt_stat_connection_aggregate(
 	    WT_STAT_READ(from, application_evict_time);
 	to->application_cache_time +=
 	    WT_STAT_READ(from, application_cache_time);
+	to->application_evict_wait_time +=
+	    WT_STAT_READ(from, application_evict_wait_time);
 	to->txn_release_blocked += WT_STAT_READ(from, txn_release_blocked);
 	to->conn_close_blocked_lsm +=
 	    WT_STAT_READ(from, conn_close_blocked_lsm);
@@ -2014,16 +2131,24 @@ __wt_stat_connection_aggregate(
 	    WT_STAT_READ(from, txn_checkpoint_generation);
 	to->txn_checkpoint_time_max +=
 	    WT_STAT_READ(from, txn_checkpoint_time_max);
+	to->txn_checkpoint_metadata_recent +=
+	    WT_STAT_READ(from, txn_checkpoint_metadata_recent);
 	to->txn_checkpoint_time_min +=
 	    WT_STAT_READ(from, txn_checkpoint_time_min);
 	to->txn_checkpoint_time_recent +=
 	    WT_STAT_READ(from, txn_checkpoint_time_recent);
+	to->txn_checkpoint_worker_pages +=
+	    WT_STAT_READ(from, txn_checkpoint_worker_pages);
+	to->txn_checkpoint_prep_recent +=
+	    WT_STAT_READ(from, txn_checkpoint_prep_recent);
 	to->txn_checkpoint_scrub_target +=
 	    WT_STAT_READ(from, txn_checkpoint_scrub_target);
 	to->txn_checkpoint_scrub_time +=
 	    WT_STAT_READ(from, txn_checkpoint_scrub_time);
 	to->txn_checkpoint_time_total +=
 	    WT_STAT_READ(from, txn_checkpoint_time_total);
+	to->txn_checkpoint_tree_recent +=
+	    WT_STAT_READ(from, txn_checkpoint_tree_recent);
 	to->txn_checkpoint += WT_STAT_READ(from, txn_checkpoint);
 	to->txn_checkpoint_skipped +=
 	    WT_STAT_READ(from, txn_checkpoint_skipped);
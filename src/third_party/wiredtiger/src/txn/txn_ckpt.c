@@ -870,9 +870,13 @@ __txn_checkpoint(WT_SESSION_IMPL *session, const char *cfg[])
 	 * Hold the schema lock while starting the transaction and gathering
 	 * handles so the set we get is complete and correct.
 	 */
+	time_start = __wt_clock(session);
 	WT_WITH_SCHEMA_LOCK(session,
 	    ret = __checkpoint_prepare(session, &tracking, cfg));
 	WT_ERR(ret);
+	time_stop = __wt_clock(session);
+	WT_STAT_CONN_SET(session, txn_checkpoint_prep_recent,
+	    WT_CLOCKDIFF_MS(time_stop, time_start));
 
 	WT_ASSERT(session, txn->isolation == WT_ISO_SNAPSHOT);
 
@@ -890,7 +894,11 @@ __txn_checkpoint(WT_SESSION_IMPL *session, const char *cfg[])
 
 	__checkpoint_timing_stress(session);
 
+	time_start = __wt_clock(session);
 	WT_ERR(__checkpoint_apply(session, cfg, __checkpoint_tree_helper));
+	time_stop = __wt_clock(session);
+	WT_STAT_CONN_SET(session, txn_checkpoint_tree_recent,
+	    WT_CLOCKDIFF_MS(time_stop, time_start));
 
 	/*
 	 * Clear the dhandle so the visibility check doesn't get confused about
@@ -956,6 +964,7 @@ __txn_checkpoint(WT_SESSION_IMPL *session, const char *cfg[])
 	 * This is very similar to __wt_meta_track_off, ideally they would be
 	 * merged.
 	 */
+	time_start = __wt_clock(session);
 	if (full || !logging) {
 		session->isolation = txn->isolation = WT_ISO_READ_UNCOMMITTED;
 		/* Disable metadata tracking during the metadata checkpoint. */
@@ -979,6 +988,9 @@ __txn_checkpoint(WT_SESSION_IMPL *session, const char *cfg[])
 		    WT_SESSION_META_DHANDLE(session),
 		    ret = __wt_txn_checkpoint_log(
 		    session, false, WT_TXN_LOG_CKPT_SYNC, NULL));
+	time_stop = __wt_clock(session);
+	WT_STAT_CONN_SET(session, txn_checkpoint_metadata_recent,
+	    WT_CLOCKDIFF_MS(time_stop, time_start));
 
 	/*
 	 * Now that the metadata is stable, re-open the metadata file for
@@ -161,6 +161,10 @@ static CONFIG c[] = {
 	  "the maximum number of eviction workers",
 	  0x0, 0, 5, 100, &g.c_evict_max, NULL },
 
+	{ "evict_walk_shards",
+	  "the number of shards eviction walks trees in",
+	  0x0, 1, 4, 16, &g.c_evict_walk_shards, NULL },
+
 	{ "file_type",
 	  "type of store to create (fix | var | row)",
 	  C_IGNORE|C_STRING, 0, 0, 0, NULL, &g.c_file_type },
@@ -170,6 +170,7 @@ typedef struct {
 	uint32_t c_direct_io;
 	char	*c_encryption;
 	uint32_t c_evict_max;
+	uint32_t c_evict_walk_shards;
 	char	*c_file_type;
 	uint32_t c_firstfit;
 	uint32_t c_huffman_key;
@@ -192,9 +192,11 @@ wts_open(const char *home, bool set_api, WT_CONNECTION **connp)
 		    g.c_checkpoint_wait, MEGABYTE(g.c_checkpoint_log_size));
 
 	/* Eviction worker configuration. */
+	CONFIG_APPEND(p,
+	    ",eviction=(walk_shards=%" PRIu32, g.c_evict_walk_shards);
 	if (g.c_evict_max != 0)
-		CONFIG_APPEND(p,
-		    ",eviction=(threads_max=%" PRIu32 ")", g.c_evict_max);
+		CONFIG_APPEND(p, ",threads_max=%" PRIu32, g.c_evict_max);
+	CONFIG_APPEND(p, ")");
 
 	/* Logging configuration. */
 	if (g.c_logging)
@@ -0,0 +1,102 @@
+#!/usr/bin/env python
+#
+# Public Domain 2014-2018 MongoDB, Inc.
+# Public Domain 2008-2014 WiredTiger, Inc.
+#
+# This is free and unencumbered software released into the public domain.
+#
+# Anyone is free to copy, modify, publish, use, compile, sell, or
+# distribute this software, either in source code form or as a compiled
+# binary, for any purpose, commercial or non-commercial, and by any
+# means.
+#
+# In jurisdictions that recognize copyright laws, the author or authors
+# of this software dedicate any and all copyright interest in the
+# software to the public domain. We make this dedication for the benefit
+# of the public at large and to the detriment of our heirs and
+# successors. We intend this dedication to be an overt act of
+# relinquishment in perpetuity of all present and future rights to this
+# software under copyright law.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+# MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+# IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+# OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+# ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+
+import wiredtiger, wttest
+from wtscenario import make_scenarios
+
+# test_checkpoint03.py
+#   Checkpoint with worker threads writing the leaf pages, including a
+#   checkpoint where writing the queued pages fails.
+class test_checkpoint03(wttest.WiredTigerTestCase):
+    uri = 'table:test_checkpoint03'
+    nentries = 20000
+
+    types = [
+        ('col', dict(key_format='r')),
+        ('row', dict(key_format='S')),
+    ]
+    threads = [
+        ('threads-1', dict(threads=1)),
+        ('threads-4', dict(threads=4)),
+        ('threads-20', dict(threads=20)),
+    ]
+    scenarios = make_scenarios(types, threads)
+
+    def conn_config(self):
+        return 'cache_size=50MB,checkpoint=(threads=%d)' % self.threads
+
+    def key(self, i):
+        if self.key_format == 'S':
+            return str(i).zfill(15)
+        return i
+
+    def update(self, value):
+        cursor = self.session.open_cursor(self.uri, None)
+        for i in range(1, self.nentries + 1):
+            cursor[self.key(i)] = value + str(i)
+        cursor.close()
+
+    def check(self, value, config=None):
+        cursor = self.session.open_cursor(self.uri, None, config)
+        i = 0
+        for k, v in cursor:
+            i += 1
+            self.assertEqual(k, self.key(i))
+            self.assertEqual(v, value + str(i))
+        self.assertEqual(i, self.nentries)
+        cursor.close()
+
+    def test_checkpoint03(self):
+        ckpt = 'checkpoint=WiredTigerCheckpoint'
+        self.session.create(self.uri,
+            'key_format=%s,value_format=S,leaf_page_max=4KB' % self.key_format)
+        self.update('a')
+        self.session.checkpoint()
+        self.check('a', ckpt)
+
+        # Fail every page queued for the workers: the checkpoint fails and
+        # the previous checkpoint is still the one the table reads.
+        self.update('b')
+        self.conn.reconfigure(
+            'timing_stress_for_test=[checkpoint_worker_fail]')
+        self.assertRaises(wiredtiger.WiredTigerError,
+            lambda: self.session.checkpoint())
+        self.conn.reconfigure('timing_stress_for_test=[]')
+        self.check('b')
+        self.check('a', ckpt)
+
+        # The workers are still usable once the failed queue has drained.
+        self.session.checkpoint()
+        self.check('b', ckpt)
+
+        self.reopen_conn()
+        self.session.verify(self.uri, None)
+        self.check('b')
+
+if __name__ == '__main__':
+    wttest.run()
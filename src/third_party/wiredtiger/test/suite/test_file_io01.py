@@ -0,0 +1,134 @@
+#!/usr/bin/env python
+#
+# Public Domain 2014-2018 MongoDB, Inc.
+# Public Domain 2008-2014 WiredTiger, Inc.
+#
+# This is free and unencumbered software released into the public domain.
+#
+# Anyone is free to copy, modify, publish, use, compile, sell, or
+# distribute this software, either in source code form or as a compiled
+# binary, for any purpose, commercial or non-commercial, and by any
+# means.
+#
+# In jurisdictions that recognize copyright laws, the author or authors
+# of this software dedicate any and all copyright interest in the
+# software to the public domain. We make this dedication for the benefit
+# of the public at large and to the detriment of our heirs and
+# successors. We intend this dedication to be an overt act of
+# relinquishment in perpetuity of all present and future rights to this
+# software under copyright law.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+# EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+# MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+# IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+# OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+# ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+#
+# test_file_io01.py
+#       Read and write data files through the file_io methods: write a
+#       table with eviction and checkpoints, then reopen and check it.
+#
+
+import sys
+import wiredtiger, wttest
+from wiredtiger import stat
+from wtdataset import SimpleDataSet
+from wtscenario import make_scenarios
+
+class test_file_io01(wttest.WiredTigerTestCase):
+    uri = 'table:test_file_io01'
+    nentries = 50000
+
+    # Linux native AIO only takes files opened with direct I/O, other files
+    # are still read and written with pread and pwrite. Whether io_uring
+    # takes buffered files depends on the kernel supporting it.
+    methods = [
+        ('aio', dict(method='aio', uring_fail=False, buffered_queued=False)),
+        ('io_uring', dict(method='io_uring', uring_fail=False,
+            buffered_queued=None)),
+        ('io_uring-fallback', dict(method='io_uring', uring_fail=True,
+            buffered_queued=False)),
+    ]
+    direct = [
+        ('buffered', dict(direct_io=False)),
+        ('direct', dict(direct_io=True)),
+    ]
+    depth = [
+        ('depth-1', dict(queue_depth=1)),
+        ('depth-64', dict(queue_depth=64)),
+    ]
+    scenarios = make_scenarios(methods, direct, depth)
+
+    def file_io_config(self):
+        config = 'cache_size=2MB,statistics=(fast),' + \
+            'file_io=(method=%s,queue_depth=%d,io_uring_fail_for_test=%s)' % \
+            (self.method, self.queue_depth, str(self.uring_fail).lower())
+        if self.direct_io:
+            config += ',direct_io=[data]'
+        return config
+
+    def open_file_io_conn(self):
+        self.close_conn()
+        try:
+            self.conn = self.wiredtiger_open('.', self.file_io_config())
+        except wiredtiger.WiredTigerError as e:
+            if 'not supported by this build' in str(e):
+                self.skipTest('file_io.method=%s not supported' % self.method)
+            raise
+        self.session = self.conn.open_session()
+
+    def get_stat(self, s):
+        cursor = self.session.open_cursor('statistics:', None, None)
+        value = cursor[s][2]
+        cursor.close()
+        return value
+
+    def check_queued(self):
+        queued = self.get_stat(stat.conn.block_aio_queued)
+        if self.direct_io:
+            self.assertGreater(queued, 0)
+        elif self.buffered_queued == False:
+            self.assertEqual(queued, 0)
+
+    def test_file_io(self):
+        if not sys.platform.startswith('linux'):
+            self.skipTest('file_io methods are Linux specific')
+        self.open_file_io_conn()
+
+        # Direct I/O isn't supported by every file system (e.g., tmpfs).
+        ds = SimpleDataSet(self, self.uri, self.nentries,
+            config='leaf_page_max=4KB,internal_page_max=4KB')
+        try:
+            ds.populate()
+        except wiredtiger.WiredTigerError as e:
+            if self.direct_io and 'Invalid argument' in str(e):
+                self.skipTest('direct I/O not supported by the file system')
+            raise
+        self.session.checkpoint()
+
+        # Overwrite part of the table so a second checkpoint frees and
+        # reuses blocks, reading pages evicted from the small cache.
+        cursor = self.session.open_cursor(self.uri, None)
+        for i in range(1, self.nentries + 1, 3):
+            cursor[ds.key(i)] = ds.value(i)
+        cursor.close()
+        self.session.checkpoint()
+        ds.check()
+        self.check_queued()
+
+        # Everything read back after reopening comes from the data files.
+        self.open_file_io_conn()
+        self.session.verify(self.uri, None)
+        ds.check()
+        self.check_queued()
+
+        # And the files are readable without the queue.
+        self.close_conn()
+        self.conn = self.wiredtiger_open('.', 'cache_size=2MB')
+        self.session = self.conn.open_session()
+        ds.check()
+
+if __name__ == '__main__':
+    wttest.run()
@@ -83,6 +83,12 @@ class test_reconfig01(wttest.WiredTigerTestCase):
         # Set eviction checkpoint target with an absolute value
         self.conn.reconfigure("eviction_checkpoint_target=50M")
 
+    # Eviction: the number of walk shards is set at open.
+    def test_reconfig_eviction_fail(self):
+        msg = '/unknown configuration key/'
+        self.assertRaisesWithMessage(wiredtiger.WiredTigerError,
+            lambda: self.conn.reconfigure("eviction=(walk_shards=4)"), msg)
+
     def test_reconfig_lsm_manager(self):
         # We create and populate a tiny LSM so that we can start off with
         # the LSM threads running and change the numbers of threads.